@@ -0,0 +1,172 @@
+// Builds an asset pack from one or more directories. Entries are keyed by their path relative
+// to the working directory, so run it from the directory the game runs from.
+// LDR textures are cooked to block compressed .ktx2 files stored next to their source, which
+// Texture2D::Decode picks up instead; an existing .ktx2 in the input is packed as it is.
+// Usage: AssetCooker <output.hpk> <directory>... [--store] [--alignment <bytes>] [--block-size <bytes>]
+//                    [--no-textures] [--bc7] [--strip-sources]
+
+#include "Hazel/Core/Base.h"
+#include "Hazel/Core/Timer.h"
+#include "Hazel/FileSystem/AssetPack.h"
+#include "Hazel/FileSystem/FileSystem.h"
+#include "Hazel/Asset/TextureCooker.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <unordered_set>
+
+using namespace Hazel;
+
+static void PrintUsage()
+{
+	printf("Usage: AssetCooker <output.hpk> <directory>... [--store] [--alignment <bytes>] [--block-size <bytes>]\n");
+	printf("                   [--no-textures] [--bc7] [--strip-sources]\n");
+	printf("  --no-textures    Pack textures as they are instead of cooking them\n");
+	printf("  --bc7            Cook color textures to BC7 rather than BC1/BC3\n");
+	printf("  --strip-sources  Leave out source images that were cooked\n");
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::string output = argv[1];
+	std::vector<std::string> directories;
+	bool compress = true;
+	uint32_t alignment = 64;
+	uint32_t blockSize = 256 * 1024;
+	bool cookTextures = true;
+	bool stripSources = false;
+	TextureCookSettings cookSettings;
+
+	for (int i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--store") == 0)
+			compress = false;
+		else if (strcmp(argv[i], "--alignment") == 0 && i + 1 < argc)
+			alignment = (uint32_t)atoi(argv[++i]);
+		else if (strcmp(argv[i], "--block-size") == 0 && i + 1 < argc)
+			blockSize = (uint32_t)atoi(argv[++i]);
+		else if (strcmp(argv[i], "--no-textures") == 0)
+			cookTextures = false;
+		else if (strcmp(argv[i], "--bc7") == 0)
+			cookSettings.HighQuality = true;
+		else if (strcmp(argv[i], "--strip-sources") == 0)
+			stripSources = true;
+		else
+			directories.push_back(argv[i]);
+	}
+
+	if (directories.empty() || alignment == 0 || (alignment & (alignment - 1)) != 0 || blockSize == 0)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	InitializeCore();
+
+	// Sorted so the same input always produces the same pack
+	std::string outputPath = FileSystem::NormalizePath(output);
+	std::vector<std::filesystem::path> files;
+	for (const auto& directory : directories)
+	{
+		if (!std::filesystem::is_directory(directory))
+		{
+			printf("'%s' is not a directory\n", directory.c_str());
+			return 1;
+		}
+
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+		{
+			if (entry.is_regular_file() && FileSystem::NormalizePath(entry.path().string()) != outputPath)
+				files.push_back(entry.path());
+		}
+	}
+	std::sort(files.begin(), files.end());
+
+	Timer timer;
+	AssetPackWriter writer(alignment, blockSize);
+	if (!writer.Open(output))
+	{
+		printf("Could not create %s\n", output.c_str());
+		return 1;
+	}
+
+	std::unordered_set<std::string> inputPaths;
+	for (const auto& file : files)
+		inputPaths.insert(FileSystem::NormalizePath(file.string()));
+
+	// Loose cooked files are packed as they are, unless their source has changed since; those are cooked again
+	std::unordered_set<std::string> staleCookedPaths;
+	for (const auto& file : files)
+	{
+		std::string cookedPath = FileSystem::NormalizePath(Texture2D::GetCookedPath(file.string()));
+		if (cookTextures && TextureCooker::IsCookable(file.string()) && inputPaths.find(cookedPath) != inputPaths.end() && Texture2D::FindCookedPath(file.string()).empty())
+			staleCookedPaths.insert(cookedPath);
+	}
+
+	static const char* s_FormatNames[] = { "None", "RGB", "RGBA", "Float16", "BC1", "BC3", "BC4", "BC5", "BC7" };
+	uint32_t cookedCount = 0;
+	for (const auto& file : files)
+	{
+		if (staleCookedPaths.find(FileSystem::NormalizePath(file.string())) != staleCookedPaths.end())
+			continue;
+
+		std::string cookedPath = FileSystem::NormalizePath(Texture2D::GetCookedPath(file.string()));
+		bool alreadyCooked = inputPaths.find(cookedPath) != inputPaths.end() && staleCookedPaths.find(cookedPath) == staleCookedPaths.end();
+		if (cookTextures && TextureCooker::IsCookable(file.string()) && !alreadyCooked)
+		{
+			std::vector<uint8_t> cooked;
+			TextureCookResult result;
+			if (!TextureCooker::Cook(file.string(), cookSettings, cooked, &result))
+			{
+				printf("Could not cook %s\n", file.string().c_str());
+				return 1;
+			}
+
+			printf("  %s -> %s, %ux%u, %u mips\n", file.string().c_str(), s_FormatNames[(int)result.Format], result.Width, result.Height, result.MipCount);
+			if (!writer.AddFile(cookedPath, cooked.data(), cooked.size(), compress))
+			{
+				printf("Could not write %s\n", output.c_str());
+				return 1;
+			}
+			cookedCount++;
+
+			if (stripSources)
+				continue;
+		}
+
+		FileData data = FileSystem::ReadFile(file.string());
+		if (!data)
+		{
+			printf("Could not read %s\n", file.string().c_str());
+			return 1;
+		}
+
+		if (!writer.AddFile(FileSystem::NormalizePath(file.string()), data.GetData(), data.GetSize(), compress))
+		{
+			printf("Could not write %s\n", output.c_str());
+			return 1;
+		}
+	}
+
+	if (!writer.Finalize())
+	{
+		printf("Could not write %s\n", output.c_str());
+		return 1;
+	}
+
+	double ratio = writer.GetTotalSize() ? (double)writer.GetStoredSize() / (double)writer.GetTotalSize() : 1.0;
+	printf("Cooked %zu files (%u textures) into %s: %.2f MB -> %.2f MB (%.1f%%) in %.2f s\n", files.size(), cookedCount, output.c_str(),
+		writer.GetTotalSize() / (1024.0 * 1024.0), writer.GetStoredSize() / (1024.0 * 1024.0), ratio * 100.0, timer.Elapsed());
+
+	ShutdownCore();
+	return 0;
+}
@@ -0,0 +1,190 @@
+// Compares Hazel::HashMap against std::unordered_map on the access patterns the engine has:
+// UUID lookups (entity and script instance maps) and string lookups (bones, shaders).
+// Usage: HashMapBenchmark [elementCount] [lookupCount]
+
+#include "Hazel/Core/HashMap.h"
+#include "Hazel/Core/Timer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace Hazel;
+
+// Keeps the optimizer from dropping the loops being timed
+static volatile uint64_t s_Sink;
+
+static void PrintResult(const char* name, float milliseconds, float baselineMilliseconds, uint64_t operations)
+{
+	float nsPerOperation = milliseconds * 1000000.0f / (float)operations;
+	printf("  %-28s %10.3f ms  %7.2f ns/op  %6.2fx\n", name, milliseconds, nsPerOperation, baselineMilliseconds / milliseconds);
+}
+
+template<typename Map>
+static float Insert(Map& map, const std::vector<uint64_t>& keys)
+{
+	Timer timer;
+	for (uint64_t key : keys)
+		map[key] = key;
+	return timer.ElapsedMillis();
+}
+
+template<typename Map>
+static float Lookup(const Map& map, const std::vector<uint64_t>& keys, uint64_t& found)
+{
+	found = 0;
+	uint64_t sum = 0;
+	Timer timer;
+	for (uint64_t key : keys)
+	{
+		auto it = map.find(key);
+		if (it != map.end())
+		{
+			sum += it->second;
+			found++;
+		}
+	}
+	float elapsed = timer.ElapsedMillis();
+	s_Sink = sum;
+	return elapsed;
+}
+
+template<typename Map>
+static float Iterate(const Map& map, uint32_t passes)
+{
+	uint64_t sum = 0;
+	Timer timer;
+	for (uint32_t i = 0; i < passes; i++)
+	{
+		for (const auto& [key, value] : map)
+			sum += value;
+	}
+	float elapsed = timer.ElapsedMillis();
+	s_Sink = sum;
+	return elapsed;
+}
+
+template<typename Map>
+static float EraseAndInsert(Map& map, const std::vector<uint64_t>& keys)
+{
+	// Churn as entities are destroyed and created
+	Timer timer;
+	for (size_t i = 0; i < keys.size(); i++)
+	{
+		map.erase(keys[i]);
+		map[keys[i] ^ 0x5555555555555555ull] = i;
+	}
+	return timer.ElapsedMillis();
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t elementCount = argc > 1 ? (uint32_t)atoi(argv[1]) : 10000;
+	uint32_t lookupCount = argc > 2 ? (uint32_t)atoi(argv[2]) : 1000000;
+
+	printf("HashMapBenchmark: %u elements, %u lookups\n\n", elementCount, lookupCount);
+
+	std::mt19937_64 rng(1337);
+	std::vector<uint64_t> keys(elementCount);
+	for (uint64_t& key : keys)
+		key = rng();
+
+	std::vector<uint64_t> hits(lookupCount), misses(lookupCount);
+	std::uniform_int_distribution<uint32_t> index(0, elementCount - 1);
+	for (uint32_t i = 0; i < lookupCount; i++)
+	{
+		hits[i] = keys[index(rng)];
+		misses[i] = rng();
+	}
+
+	uint32_t mismatches = 0;
+
+	// UUID style keys
+	{
+		std::unordered_map<uint64_t, uint64_t> stdMap;
+		HashMap<uint64_t, uint64_t> hashMap;
+
+		printf("Insert\n");
+		float baseline = Insert(stdMap, keys);
+		PrintResult("std::unordered_map", baseline, baseline, elementCount);
+		PrintResult("HashMap", Insert(hashMap, keys), baseline, elementCount);
+		mismatches += stdMap.size() != hashMap.size();
+		printf("\n");
+
+		printf("Lookup (hits)\n");
+		uint64_t stdFound, found;
+		baseline = Lookup(stdMap, hits, stdFound);
+		PrintResult("std::unordered_map", baseline, baseline, lookupCount);
+		PrintResult("HashMap", Lookup(hashMap, hits, found), baseline, lookupCount);
+		mismatches += stdFound != found;
+		printf("\n");
+
+		printf("Lookup (misses)\n");
+		baseline = Lookup(stdMap, misses, stdFound);
+		PrintResult("std::unordered_map", baseline, baseline, lookupCount);
+		PrintResult("HashMap", Lookup(hashMap, misses, found), baseline, lookupCount);
+		mismatches += stdFound != found;
+		printf("\n");
+
+		printf("Iterate\n");
+		uint32_t passes = 100;
+		baseline = Iterate(stdMap, passes);
+		PrintResult("std::unordered_map", baseline, baseline, (uint64_t)elementCount * passes);
+		PrintResult("HashMap", Iterate(hashMap, passes), baseline, (uint64_t)elementCount * passes);
+		printf("\n");
+
+		printf("Erase and insert\n");
+		baseline = EraseAndInsert(stdMap, keys);
+		PrintResult("std::unordered_map", baseline, baseline, elementCount);
+		PrintResult("HashMap", EraseAndInsert(hashMap, keys), baseline, elementCount);
+		mismatches += stdMap.size() != hashMap.size();
+		printf("\n");
+	}
+
+	// String keys, looked up the way bone names are: from a char buffer, not a std::string
+	{
+		std::vector<std::string> names(elementCount);
+		for (uint32_t i = 0; i < elementCount; i++)
+			names[i] = "mixamorig:Bone_" + std::to_string(keys[i] % 100000) + "_" + std::to_string(i);
+
+		std::unordered_map<std::string, uint32_t> stdMap;
+		HashMap<std::string, uint32_t> hashMap;
+		for (uint32_t i = 0; i < elementCount; i++)
+		{
+			stdMap[names[i]] = i;
+			hashMap[names[i]] = i;
+		}
+
+		std::vector<const char*> lookups(lookupCount);
+		for (uint32_t i = 0; i < lookupCount; i++)
+			lookups[i] = names[index(rng)].c_str();
+
+		printf("String lookup (hits)\n");
+		uint64_t stdSum = 0, sum = 0;
+		Timer timer;
+		for (const char* name : lookups)
+			stdSum += stdMap.find(name)->second;
+		float baseline = timer.ElapsedMillis();
+		PrintResult("std::unordered_map", baseline, baseline, lookupCount);
+
+		timer.Reset();
+		for (const char* name : lookups)
+			sum += hashMap.find(std::string_view(name))->second;
+		PrintResult("HashMap (string_view)", timer.ElapsedMillis(), baseline, lookupCount);
+		mismatches += stdSum != sum;
+		s_Sink = sum;
+		printf("\n");
+	}
+
+	if (mismatches)
+	{
+		printf("FAILED: %u results differ from std::unordered_map\n", mismatches);
+		return 1;
+	}
+
+	printf("All results match std::unordered_map\n");
+	return 0;
+}
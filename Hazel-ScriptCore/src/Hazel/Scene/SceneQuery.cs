@@ -0,0 +1,63 @@
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace Hazel
+{
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SceneRaycastHit
+    {
+        public ulong EntityID { get; private set; }
+        public float Distance { get; private set; }
+    }
+
+    // Queries against the bounds of mesh entities in the current scene. Unlike Physics
+    // these don't require colliders and test against the actual mesh geometry for raycasts.
+    public static class SceneQuery
+    {
+        public static bool Raycast(Vector3 origin, Vector3 direction, float maxDistance, out SceneRaycastHit hit)
+        {
+            return Raycast_Native(ref origin, ref direction, maxDistance, out hit);
+        }
+
+        public static Entity[] OverlapBox(Vector3 origin, Vector3 halfSize)
+        {
+            return ToEntities(OverlapBox_Native(ref origin, ref halfSize));
+        }
+
+        public static Entity[] OverlapSphere(Vector3 origin, float radius)
+        {
+            return ToEntities(OverlapSphere_Native(ref origin, radius));
+        }
+
+        // Entities whose bounds are at least partly inside the view frustum of an OpenGL style view-projection matrix
+        public static Entity[] Frustum(Matrix4 viewProjection)
+        {
+            return ToEntities(Frustum_Native(ref viewProjection));
+        }
+
+        public static Entity[] FindNearest(Vector3 point, int count)
+        {
+            return ToEntities(FindNearest_Native(ref point, count));
+        }
+
+        private static Entity[] ToEntities(ulong[] entityIDs)
+        {
+            Entity[] entities = new Entity[entityIDs.Length];
+            for (int i = 0; i < entityIDs.Length; i++)
+                entities[i] = new Entity(entityIDs[i]);
+            return entities;
+        }
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern bool Raycast_Native(ref Vector3 origin, ref Vector3 direction, float maxDistance, out SceneRaycastHit hit);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern ulong[] OverlapBox_Native(ref Vector3 origin, ref Vector3 halfSize);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern ulong[] OverlapSphere_Native(ref Vector3 origin, float radius);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern ulong[] Frustum_Native(ref Matrix4 viewProjection);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern ulong[] FindNearest_Native(ref Vector3 point, int count);
+    }
+}
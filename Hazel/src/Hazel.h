@@ -9,6 +9,9 @@
 #include "Hazel/Core/Input.h"
 #include "Hazel/Core/Timestep.h"
 #include "Hazel/Core/Timer.h"
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Core/ObjectPool.h"
+#include "Hazel/Core/Profiler.h"
 
 #include "Hazel/Core/Events/Event.h"
 #include "Hazel/Core/Events/ApplicationEvent.h"
@@ -35,6 +38,10 @@
 #include "Hazel/Renderer/Material.h"
 // ---------------------------------------------------
 
+// Assets
+#include "Hazel/Asset/AssetManager.h"
+#include "Hazel/FileSystem/FileSystem.h"
+
 // Scenes
 #include "Hazel/Scene/Entity.h"
 #include "Hazel/Scene/Scene.h"
@@ -0,0 +1,770 @@
+#include "hzpch.h"
+#include "AssetManager.h"
+
+#include "Hazel/Renderer/MeshFactory.h"
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+namespace Hazel {
+
+	struct AssetEntry
+	{
+		AssetType Type = AssetType::None;
+		std::string FilePath;
+
+		// Only the member matching Type is set. Meshes are held weakly: users get instances, which
+		// keep this shared source alive, so it goes as soon as the last of them does.
+		WeakRef<Hazel::Mesh> Mesh;
+		Ref<Hazel::Texture2D> Texture;
+		Hazel::Environment Environment;
+
+		uint64_t MemorySize = 0;
+		uint64_t LastAccess = 0;
+	};
+
+	struct AssetManagerData
+	{
+		std::unordered_map<AssetHandle, AssetEntry> Assets;
+		uint64_t MemoryBudget = 0;
+		uint64_t MemoryUsage = 0;
+		uint64_t AccessCounter = 0;
+	};
+
+	static AssetManagerData s_Data;
+
+	// Finishes an async load on the main thread; Size estimates the bytes it uploads
+	struct AssetUpload
+	{
+		uint64_t Size = 0;
+		std::function<void()> Finalize;
+	};
+
+	struct AssetLoaderData
+	{
+		std::vector<std::thread> Workers;
+		std::deque<std::function<void()>> Jobs;
+		std::mutex JobMutex;
+		std::condition_variable JobCondition;
+		bool Running = false;
+
+		std::deque<AssetUpload> Uploads;
+		std::mutex UploadMutex;
+		uint64_t UploadBudget = 64 * 1024 * 1024;
+
+		uint32_t PendingCount = 0;
+
+		Ref<Hazel::Mesh> PlaceholderMesh;
+		Ref<Texture2D> PlaceholderTexture;
+	};
+
+	static AssetLoaderData s_Loader;
+
+	static uint64_t HashFNV1a(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	static uint64_t GetTextureMemorySize(const Ref<Texture>& texture, uint32_t faces = 1)
+	{
+		if (!texture)
+			return 0;
+
+		TextureFormat format = texture->GetFormat();
+		if (Texture::IsCompressed(format))
+		{
+			// Streamed textures only count the mips they have resident
+			uint64_t size = 0;
+			for (uint32_t mip = texture->GetFirstResidentMip(); mip < texture->GetMipLevelCount(); mip++)
+				size += Texture::GetCompressedSize(format, std::max(texture->GetWidth() >> mip, 1u), std::max(texture->GetHeight() >> mip, 1u));
+			return size * faces;
+		}
+
+		uint64_t size = (uint64_t)texture->GetWidth() * texture->GetHeight() * Texture::GetBPP(format) * faces;
+		// A full mip chain adds roughly a third
+		if (texture->GetMipLevelCount() > 1)
+			size += size / 3;
+		return size;
+	}
+
+	static uint64_t GetMemorySize(const AssetEntry& entry)
+	{
+		switch (entry.Type)
+		{
+			case AssetType::Mesh:
+			{
+				Ref<Mesh> mesh = entry.Mesh.Lock();
+				if (!mesh)
+					return 0;
+
+				MeshMemoryStats stats = mesh->GetMemoryStats();
+				return stats.GetCPUTotal() + stats.GetGPUTotal();
+			}
+			case AssetType::Texture2D:
+				return GetTextureMemorySize(entry.Texture);
+			case AssetType::Environment:
+				return GetTextureMemorySize(entry.Environment.RadianceMap, 6);
+		}
+		return 0;
+	}
+
+	// The cache holds one reference itself, except to meshes
+	static bool IsReferenced(const AssetEntry& entry)
+	{
+		switch (entry.Type)
+		{
+			case AssetType::Mesh:        return entry.Mesh.IsValid();
+			case AssetType::Texture2D:   return entry.Texture->GetRefCount() > 1;
+			case AssetType::Environment:
+			{
+				const auto& radiance = entry.Environment.RadianceMap;
+				return radiance && radiance->GetRefCount() > 1;
+			}
+		}
+		return false;
+	}
+
+	static AssetEntry* FindAsset(AssetHandle handle)
+	{
+		auto it = s_Data.Assets.find(handle);
+		if (it == s_Data.Assets.end())
+			return nullptr;
+
+		it->second.LastAccess = ++s_Data.AccessCounter;
+		return &it->second;
+	}
+
+	static void RemoveAsset(AssetHandle handle)
+	{
+		auto it = s_Data.Assets.find(handle);
+		s_Data.MemoryUsage -= it->second.MemorySize;
+		s_Data.Assets.erase(it);
+	}
+
+	// The shared source of a cached mesh, if any of its instances are still around
+	static Ref<Mesh> FindMeshSource(AssetHandle handle)
+	{
+		AssetEntry* entry = FindAsset(handle);
+		if (!entry)
+			return nullptr;
+
+		Ref<Mesh> source = entry->Mesh.Lock();
+		if (!source)
+			RemoveAsset(handle);
+		return source;
+	}
+
+	static void AddAsset(AssetHandle handle, AssetEntry&& entry)
+	{
+		// Replacing an expired mesh
+		if (s_Data.Assets.find(handle) != s_Data.Assets.end())
+			RemoveAsset(handle);
+
+		entry.MemorySize = GetMemorySize(entry);
+		entry.LastAccess = ++s_Data.AccessCounter;
+		s_Data.MemoryUsage += entry.MemorySize;
+		s_Data.Assets[handle] = std::move(entry);
+	}
+
+	static void LoaderThread()
+	{
+		HZ_PROFILE_THREAD("Asset Loader");
+
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(s_Loader.JobMutex);
+				s_Loader.JobCondition.wait(lock, []() { return !s_Loader.Running || !s_Loader.Jobs.empty(); });
+				if (!s_Loader.Running)
+					return;
+
+				job = std::move(s_Loader.Jobs.front());
+				s_Loader.Jobs.pop_front();
+			}
+			job();
+		}
+	}
+
+	static void SubmitJob(std::function<void()>&& job)
+	{
+		// Without loader threads (Init not called) loads still work, they just block
+		if (!s_Loader.Running)
+		{
+			job();
+			return;
+		}
+
+		{
+			std::scoped_lock<std::mutex> lock(s_Loader.JobMutex);
+			s_Loader.Jobs.push_back(std::move(job));
+		}
+		s_Loader.JobCondition.notify_one();
+	}
+
+	// Called from loader threads. The finalizer runs on the main thread, which is the only one with
+	// a GL context and the only one that may change the asset caches, so that work goes in here
+	static void SubmitUpload(uint64_t size, std::function<void()>&& finalize)
+	{
+		std::scoped_lock<std::mutex> lock(s_Loader.UploadMutex);
+		s_Loader.Uploads.push_back({ size, std::move(finalize) });
+	}
+
+	template<typename T>
+	static std::unordered_map<AssetHandle, Ref<AssetLoadState<T>>>& GetPendingLoads()
+	{
+		static std::unordered_map<AssetHandle, Ref<AssetLoadState<T>>> s_PendingLoads;
+		return s_PendingLoads;
+	}
+
+	static bool FindCachedAsset(AssetHandle handle, Ref<Mesh>& outValue)
+	{
+		outValue = FindMeshSource(handle);
+		return (bool)outValue;
+	}
+
+	static bool FindCachedAsset(AssetHandle handle, Ref<Texture2D>& outValue)
+	{
+		AssetEntry* entry = FindAsset(handle);
+		if (entry)
+			outValue = entry->Texture;
+		return entry != nullptr;
+	}
+
+	static bool FindCachedAsset(AssetHandle handle, Environment& outValue)
+	{
+		AssetEntry* entry = FindAsset(handle);
+		if (entry)
+			outValue = entry->Environment;
+		return entry != nullptr;
+	}
+
+	// What each user is handed: every mesh user gets an instance of its own, other assets are shared as they are
+	static Ref<Mesh> GetUserValue(const Ref<Mesh>& source) { return source ? Ref<Mesh>::Create(source) : nullptr; }
+	static const Ref<Texture2D>& GetUserValue(const Ref<Texture2D>& texture) { return texture; }
+	static const Environment& GetUserValue(const Environment& environment) { return environment; }
+
+	// Returns false if nothing needs loading, either because the asset is cached or already in flight
+	template<typename T>
+	static bool BeginLoad(AssetHandle handle, const AssetLoadCallback<T>& callback, AssetFuture<T>& outFuture)
+	{
+		auto& pendingLoads = GetPendingLoads<T>();
+		auto it = pendingLoads.find(handle);
+		if (it != pendingLoads.end())
+		{
+			if (callback)
+				it->second->Callbacks.push_back(callback);
+			outFuture = AssetFuture<T>(it->second);
+			return false;
+		}
+
+		Ref<AssetLoadState<T>> state = Ref<AssetLoadState<T>>::Create();
+		state->Handle = handle;
+		outFuture = AssetFuture<T>(state);
+
+		typename AssetValue<T>::Type cached;
+		if (FindCachedAsset(handle, cached))
+		{
+			state->Value = GetUserValue(cached);
+			state->Ready = true;
+			if (callback)
+				callback(GetUserValue(cached));
+			return false;
+		}
+
+		if (callback)
+			state->Callbacks.push_back(callback);
+		pendingLoads[handle] = state;
+		s_Loader.PendingCount++;
+		return true;
+	}
+
+	template<typename T>
+	static void CompleteLoad(AssetHandle handle, const typename AssetValue<T>::Type& value)
+	{
+		auto& pendingLoads = GetPendingLoads<T>();
+		auto it = pendingLoads.find(handle);
+		HZ_CORE_ASSERT(it != pendingLoads.end(), "Completing an asset load that was never started!");
+
+		Ref<AssetLoadState<T>> state = it->second;
+		pendingLoads.erase(it);
+		s_Loader.PendingCount--;
+
+		state->Value = GetUserValue(value);
+		state->Ready = true;
+		for (auto& callback : state->Callbacks)
+			callback(GetUserValue(value));
+		state->Callbacks.clear();
+	}
+
+	void AssetManager::Init()
+	{
+		uint32_t threadCount = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+		s_Loader.Running = true;
+		for (uint32_t i = 0; i < threadCount; i++)
+			s_Loader.Workers.emplace_back(LoaderThread);
+
+		HZ_CORE_INFO("AssetManager: {0} loader threads", threadCount);
+	}
+
+	void AssetManager::Shutdown()
+	{
+		{
+			std::scoped_lock<std::mutex> lock(s_Loader.JobMutex);
+			s_Loader.Running = false;
+			s_Loader.Jobs.clear();
+		}
+		s_Loader.JobCondition.notify_all();
+		for (auto& worker : s_Loader.Workers)
+			worker.join();
+		s_Loader.Workers.clear();
+
+		// Loads still in flight are dropped; their callbacks never run
+		s_Loader.Uploads.clear();
+		GetPendingLoads<Mesh>().clear();
+		GetPendingLoads<Texture2D>().clear();
+		GetPendingLoads<Environment>().clear();
+		s_Loader.PendingCount = 0;
+
+		s_Loader.PlaceholderMesh = nullptr;
+		s_Loader.PlaceholderTexture = nullptr;
+
+		s_Data.Assets.clear();
+		s_Data.MemoryUsage = 0;
+	}
+
+	Ref<Mesh> AssetManager::LoadMesh(const std::string& filepath, MeshResidency residency)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		AssetHandle handle = GetHandle(AssetType::Mesh, filepath, (uint64_t)residency);
+		if (Ref<Mesh> source = FindMeshSource(handle))
+			return Ref<Mesh>::Create(source);
+
+		Ref<Mesh> source = Ref<Mesh>::Create(filepath, residency);
+
+		// Don't cache failures, the file might show up later
+		if (!source->Loaded())
+			return source;
+
+		AssetEntry entry;
+		entry.Type = AssetType::Mesh;
+		entry.FilePath = NormalizePath(filepath);
+		entry.Mesh = source;
+		AddAsset(handle, std::move(entry));
+		return Ref<Mesh>::Create(source);
+	}
+
+	Ref<Texture2D> AssetManager::LoadTexture2D(const std::string& filepath, bool srgb)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		AssetHandle handle = GetHandle(AssetType::Texture2D, filepath, srgb ? 1 : 0);
+		if (AssetEntry* entry = FindAsset(handle))
+			return entry->Texture;
+
+		Ref<Texture2D> texture = Texture2D::Create(filepath, srgb);
+
+		// Don't cache failures, the file might show up later
+		if (!texture->Loaded())
+			return texture;
+
+		AssetEntry entry;
+		entry.Type = AssetType::Texture2D;
+		entry.FilePath = NormalizePath(filepath);
+		entry.Texture = texture;
+		AddAsset(handle, std::move(entry));
+		return texture;
+	}
+
+	std::vector<Ref<Texture2D>> AssetManager::LoadTextures2D(const std::vector<std::pair<std::string, bool>>& textures)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		std::vector<Ref<Texture2D>> result(textures.size());
+		std::vector<AssetHandle> handles(textures.size());
+
+		// The first request for each texture that isn't loaded yet decodes it; later ones share the result
+		std::unordered_map<AssetHandle, size_t> decodeIndices;
+		for (size_t i = 0; i < textures.size(); i++)
+		{
+			const auto& [filepath, srgb] = textures[i];
+			handles[i] = GetHandle(AssetType::Texture2D, filepath, srgb ? 1 : 0);
+			if (AssetEntry* entry = FindAsset(handles[i]))
+				result[i] = entry->Texture;
+			else
+				decodeIndices.emplace(handles[i], i);
+		}
+
+		std::vector<TextureData> decoded(textures.size());
+		uint32_t remaining = (uint32_t)decodeIndices.size();
+		std::mutex mutex;
+		std::condition_variable condition;
+		for (const auto& [handle, index] : decodeIndices)
+		{
+			std::string filepath = textures[index].first;
+			bool srgb = textures[index].second;
+			TextureData& data = decoded[index];
+			SubmitJob([&data, &remaining, &mutex, &condition, filepath, srgb]()
+			{
+				HZ_PROFILE_SCOPE("AssetManager::DecodeTexture");
+				if (Texture2D::Decode(filepath, srgb, data))
+					TextureUploader::Stage(data);
+
+				std::scoped_lock<std::mutex> lock(mutex);
+				if (--remaining == 0)
+					condition.notify_one();
+			});
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [&]() { return remaining == 0; });
+		}
+
+		for (size_t i = 0; i < textures.size(); i++)
+		{
+			if (result[i])
+				continue;
+
+			auto it = decodeIndices.find(handles[i]);
+			if (it->second != i)
+			{
+				result[i] = result[it->second];
+				continue;
+			}
+
+			// Failures aren't cached, same as LoadTexture2D
+			result[i] = Texture2D::Create(decoded[i]);
+			if (!result[i]->Loaded())
+				continue;
+
+			AssetEntry entry;
+			entry.Type = AssetType::Texture2D;
+			entry.FilePath = NormalizePath(textures[i].first);
+			entry.Texture = result[i];
+			AddAsset(handles[i], std::move(entry));
+		}
+		return result;
+	}
+
+	Environment AssetManager::LoadEnvironment(const std::string& filepath)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		AssetHandle handle = GetHandle(AssetType::Environment, filepath);
+		if (AssetEntry* entry = FindAsset(handle))
+			return entry->Environment;
+
+		AssetEntry entry;
+		entry.Type = AssetType::Environment;
+		entry.FilePath = NormalizePath(filepath);
+		entry.Environment = Environment::Load(filepath);
+		Environment environment = entry.Environment;
+		AddAsset(handle, std::move(entry));
+		return environment;
+	}
+
+	template<>
+	AssetFuture<Mesh> AssetManager::LoadAsync<Mesh>(const std::string& filepath, const AssetImportSettings& settings, const AssetLoadCallback<Mesh>& callback)
+	{
+		AssetHandle handle = GetHandle(AssetType::Mesh, filepath, (uint64_t)settings.Residency);
+		AssetFuture<Mesh> future;
+		if (!BeginLoad<Mesh>(handle, callback, future))
+			return future;
+
+		MeshResidency residency = settings.Residency;
+		SubmitJob([handle, filepath, residency]()
+		{
+			HZ_PROFILE_SCOPE("AssetManager::ImportMesh");
+			Ref<Mesh> mesh = Ref<Mesh>(new Mesh());
+			if (!mesh->Import(filepath))
+			{
+				// Same as a blocking load: nothing gets uploaded and the failed mesh is never cached
+				SubmitUpload(0, [handle]() { CompleteLoad<Mesh>(handle, nullptr); });
+				return;
+			}
+
+			uint64_t size = mesh->m_StaticVertices.size() * sizeof(Vertex) + mesh->m_AnimatedVertices.size() * sizeof(AnimatedVertex) + mesh->m_Indices.size() * sizeof(Index);
+			SubmitUpload(size, [handle, filepath, residency, mesh = std::move(mesh)]() mutable
+			{
+				HZ_PROFILE_SCOPE("AssetManager::FinalizeMesh");
+				mesh->CreateGPUResources(residency, true);
+
+				AssetEntry entry;
+				entry.Type = AssetType::Mesh;
+				entry.FilePath = NormalizePath(filepath);
+				entry.Mesh = mesh;
+				AddAsset(handle, std::move(entry));
+				CompleteLoad<Mesh>(handle, mesh);
+			});
+		});
+		return future;
+	}
+
+	template<>
+	AssetFuture<Texture2D> AssetManager::LoadAsync<Texture2D>(const std::string& filepath, const AssetImportSettings& settings, const AssetLoadCallback<Texture2D>& callback)
+	{
+		AssetHandle handle = GetHandle(AssetType::Texture2D, filepath, settings.SRGB ? 1 : 0);
+		AssetFuture<Texture2D> future;
+		if (!BeginLoad<Texture2D>(handle, callback, future))
+			return future;
+
+		bool srgb = settings.SRGB;
+		SubmitJob([handle, filepath, srgb]()
+		{
+			HZ_PROFILE_SCOPE("AssetManager::DecodeTexture");
+			TextureData data;
+			if (Texture2D::Decode(filepath, srgb, data))
+				TextureUploader::Stage(data);
+
+			SubmitUpload(data.Data.Size, [handle, filepath, data]() mutable
+			{
+				HZ_PROFILE_SCOPE("AssetManager::FinalizeTexture");
+				// Failures aren't cached, same as LoadTexture2D
+				if (!data.Data)
+				{
+					CompleteLoad<Texture2D>(handle, nullptr);
+					return;
+				}
+
+				AssetEntry entry;
+				entry.Type = AssetType::Texture2D;
+				entry.FilePath = NormalizePath(filepath);
+				entry.Texture = Texture2D::Create(data);
+				Ref<Texture2D> texture = entry.Texture;
+				AddAsset(handle, std::move(entry));
+				CompleteLoad<Texture2D>(handle, texture);
+			});
+		});
+		return future;
+	}
+
+	template<>
+	AssetFuture<Environment> AssetManager::LoadAsync<Environment>(const std::string& filepath, const AssetImportSettings& settings, const AssetLoadCallback<Environment>& callback)
+	{
+		AssetHandle handle = GetHandle(AssetType::Environment, filepath);
+		AssetFuture<Environment> future;
+		if (!BeginLoad<Environment>(handle, callback, future))
+			return future;
+
+		SubmitJob([handle, filepath]()
+		{
+			HZ_PROFILE_SCOPE("AssetManager::DecodeEnvironment");
+			EnvironmentData data;
+			bool decoded = Environment::Decode(filepath, data);
+
+			SubmitUpload(data.GetSize(), [handle, filepath, data, decoded]() mutable
+			{
+				HZ_PROFILE_SCOPE("AssetManager::FinalizeEnvironment");
+				if (!decoded)
+				{
+					CompleteLoad<Environment>(handle, Environment());
+					return;
+				}
+
+				AssetEntry entry;
+				entry.Type = AssetType::Environment;
+				entry.FilePath = NormalizePath(filepath);
+				entry.Environment = Environment::Create(data);
+				Environment environment = entry.Environment;
+				AddAsset(handle, std::move(entry));
+				CompleteLoad<Environment>(handle, environment);
+			});
+		});
+		return future;
+	}
+
+	Ref<Mesh> AssetManager::CreatePlaceholderMesh(const std::string& filepath, MeshResidency residency)
+	{
+		if (!s_Loader.PlaceholderMesh)
+			s_Loader.PlaceholderMesh = MeshFactory::CreateBox(glm::vec3(1.0f));
+
+		const Ref<Mesh>& box = s_Loader.PlaceholderMesh;
+		Ref<Mesh> placeholder = Ref<Mesh>(new Mesh());
+		placeholder->m_FilePath = filepath;
+		placeholder->m_Residency = residency;
+		placeholder->m_Submeshes = box->m_Submeshes;
+		placeholder->m_VertexBuffer = box->m_VertexBuffer;
+		placeholder->m_IndexBuffer = box->m_IndexBuffer;
+		placeholder->m_Pipeline = box->m_Pipeline;
+		placeholder->m_MeshShader = box->m_MeshShader;
+		placeholder->m_BaseMaterial = box->m_BaseMaterial;
+		placeholder->m_Materials = box->m_Materials;
+		placeholder->m_Textures = box->m_Textures;
+		placeholder->m_Loaded = true;
+		return placeholder;
+	}
+
+	Ref<Texture2D> AssetManager::GetPlaceholderTexture()
+	{
+		if (!s_Loader.PlaceholderTexture)
+		{
+			s_Loader.PlaceholderTexture = Texture2D::Create(TextureFormat::RGBA, 1, 1);
+			s_Loader.PlaceholderTexture->Lock();
+			Buffer buffer = s_Loader.PlaceholderTexture->GetWriteableBuffer();
+			memset(buffer.Data, 0xff, buffer.Size);
+			s_Loader.PlaceholderTexture->Unlock();
+		}
+		return s_Loader.PlaceholderTexture;
+	}
+
+	void AssetManager::SetUploadBudget(uint64_t bytes)
+	{
+		s_Loader.UploadBudget = bytes;
+	}
+
+	uint32_t AssetManager::GetPendingLoadCount()
+	{
+		return s_Loader.PendingCount;
+	}
+
+	void AssetManager::SubmitBackgroundJob(std::function<void()> job)
+	{
+		SubmitJob(std::move(job));
+	}
+
+	void AssetManager::SubmitMainThreadJob(uint64_t size, std::function<void()> job)
+	{
+		SubmitUpload(size, std::move(job));
+	}
+
+	void AssetManager::Update()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		uint64_t uploaded = 0;
+		while (true)
+		{
+			AssetUpload upload;
+			{
+				std::scoped_lock<std::mutex> lock(s_Loader.UploadMutex);
+				if (s_Loader.Uploads.empty())
+					break;
+
+				// Always finish at least one so a single large asset can't stall forever
+				if (uploaded > 0 && uploaded + s_Loader.Uploads.front().Size > s_Loader.UploadBudget)
+					break;
+
+				upload = std::move(s_Loader.Uploads.front());
+				s_Loader.Uploads.pop_front();
+			}
+
+			upload.Finalize();
+			uploaded += upload.Size;
+		}
+	}
+
+	AssetHandle AssetManager::GetHandle(AssetType type, const std::string& filepath, uint64_t settings)
+	{
+		std::string path = NormalizePath(filepath);
+		uint64_t hash = HashFNV1a(&type, sizeof(type));
+		hash = HashFNV1a(path.data(), path.size(), hash);
+		hash = HashFNV1a(&settings, sizeof(settings), hash);
+		return hash;
+	}
+
+	bool AssetManager::IsLoaded(AssetHandle handle)
+	{
+		return s_Data.Assets.find(handle) != s_Data.Assets.end();
+	}
+
+	std::string AssetManager::NormalizePath(const std::string& filepath)
+	{
+		std::filesystem::path path = std::filesystem::absolute(filepath).lexically_normal();
+		std::string result = path.generic_string();
+#ifdef HZ_PLATFORM_WINDOWS
+		// Paths are case insensitive on Windows
+		std::transform(result.begin(), result.end(), result.begin(), [](char c) { return (char)::tolower(c); });
+#endif
+		return result;
+	}
+
+	void AssetManager::CollectGarbage()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		// Meshes nobody has an instance of are gone already, budget or not
+		for (auto it = s_Data.Assets.begin(); it != s_Data.Assets.end(); )
+		{
+			if (!IsReferenced(it->second) && (s_Data.MemoryBudget == 0 || it->second.Type == AssetType::Mesh))
+			{
+				s_Data.MemoryUsage -= it->second.MemorySize;
+				it = s_Data.Assets.erase(it);
+			}
+			else
+			{
+				it++;
+			}
+		}
+
+		if (s_Data.MemoryBudget == 0 || s_Data.MemoryUsage <= s_Data.MemoryBudget)
+			return;
+
+		std::vector<std::pair<uint64_t, AssetHandle>> candidates;
+		for (auto& [handle, entry] : s_Data.Assets)
+		{
+			if (!IsReferenced(entry))
+				candidates.emplace_back(entry.LastAccess, handle);
+		}
+
+		std::sort(candidates.begin(), candidates.end());
+		for (auto& [lastAccess, handle] : candidates)
+		{
+			if (s_Data.MemoryUsage <= s_Data.MemoryBudget)
+				break;
+
+			auto it = s_Data.Assets.find(handle);
+			HZ_CORE_TRACE("AssetManager: evicting {0}", it->second.FilePath);
+			s_Data.MemoryUsage -= it->second.MemorySize;
+			s_Data.Assets.erase(it);
+		}
+	}
+
+	void AssetManager::SetMemoryBudget(uint64_t bytes)
+	{
+		s_Data.MemoryBudget = bytes;
+	}
+
+	uint64_t AssetManager::GetMemoryBudget()
+	{
+		return s_Data.MemoryBudget;
+	}
+
+	uint64_t AssetManager::GetMemoryUsage()
+	{
+		return s_Data.MemoryUsage;
+	}
+
+	std::vector<AssetInfo> AssetManager::GetLoadedAssets()
+	{
+		std::vector<AssetInfo> result;
+		result.reserve(s_Data.Assets.size());
+
+		s_Data.MemoryUsage = 0;
+		for (auto& [handle, entry] : s_Data.Assets)
+		{
+			// Sizes can change after loading, e.g. when a mesh's residency is lowered
+			entry.MemorySize = GetMemorySize(entry);
+			s_Data.MemoryUsage += entry.MemorySize;
+
+			AssetInfo& info = result.emplace_back();
+			info.Handle = handle;
+			info.Type = entry.Type;
+			info.FilePath = entry.FilePath;
+			info.MemorySize = entry.MemorySize;
+			info.Referenced = IsReferenced(entry);
+		}
+		return result;
+	}
+
+}
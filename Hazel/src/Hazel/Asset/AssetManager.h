@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Hazel/Renderer/Mesh.h"
+#include "Hazel/Renderer/Texture.h"
+#include "Hazel/Renderer/SceneEnvironment.h"
+
+#include <functional>
+
+namespace Hazel {
+
+	// Stable across runs: derived from the asset type, normalized path and import settings
+	using AssetHandle = uint64_t;
+
+	enum class AssetType
+	{
+		None = 0, Mesh, Texture2D, Environment
+	};
+
+	struct AssetInfo
+	{
+		AssetHandle Handle = 0;
+		AssetType Type = AssetType::None;
+		std::string FilePath;
+		uint64_t MemorySize = 0;
+		bool Referenced = false;
+	};
+
+	struct AssetImportSettings
+	{
+		MeshResidency Residency = MeshResidency::KeepAll; // Meshes only
+		bool SRGB = false;                                 // Textures only
+	};
+
+	template<typename T>
+	struct AssetValue { using Type = Ref<T>; };
+
+	// Environments are a plain radiance map and irradiance SH rather than a ref counted object
+	template<>
+	struct AssetValue<Environment> { using Type = Environment; };
+
+	template<typename T>
+	using AssetLoadCallback = std::function<void(const typename AssetValue<T>::Type&)>;
+
+	// Only ever touched on the main thread
+	template<typename T>
+	struct AssetLoadState : public RefCounted
+	{
+		AssetHandle Handle = 0;
+		bool Ready = false;
+		typename AssetValue<T>::Type Value;
+		std::vector<AssetLoadCallback<T>> Callbacks;
+	};
+
+	template<typename T>
+	class AssetFuture
+	{
+	public:
+		AssetFuture() = default;
+		AssetFuture(const Ref<AssetLoadState<T>>& state)
+			: m_State(state) {}
+
+		AssetHandle GetHandle() const { return m_State ? m_State->Handle : 0; }
+		bool IsReady() const { return m_State && m_State->Ready; }
+
+		// Empty until ready, and also afterwards if the load failed
+		const typename AssetValue<T>::Type& Get() const { return m_State->Value; }
+	private:
+		Ref<AssetLoadState<T>> m_State;
+	};
+
+	// Deduplicates file-backed assets. Each (path, settings) pair is imported once and shared by
+	// every caller while it's alive. Assets nobody else references are released by CollectGarbage,
+	// or, when a memory budget is set, kept around until the budget is exceeded and then evicted
+	// least recently used first.
+	// Meshes carry per-entity state, so every caller gets an instance of its own that shares the
+	// imported geometry and GPU buffers. The cache doesn't keep a mesh alive by itself: it is released
+	// along with its last instance, whatever the budget.
+	class AssetManager
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		static Ref<Mesh> LoadMesh(const std::string& filepath, MeshResidency residency = MeshResidency::KeepAll);
+		static Ref<Texture2D> LoadTexture2D(const std::string& filepath, bool srgb = false);
+		static Environment LoadEnvironment(const std::string& filepath);
+
+		// Blocking like LoadTexture2D, but decodes everything that isn't loaded yet in parallel on
+		// the loader threads. Takes (path, srgb) pairs and returns the textures in the same order.
+		static std::vector<Ref<Texture2D>> LoadTextures2D(const std::vector<std::pair<std::string, bool>>& textures);
+
+		// Reading and decoding happen on a loader thread; GPU resources are created on the main thread
+		// in Update, spread over frames. The callback runs on the main thread once the asset is ready,
+		// immediately if it already is, and receives an empty value if loading failed. For meshes the
+		// future and each callback get separate instances.
+		template<typename T>
+		static AssetFuture<T> LoadAsync(const std::string& filepath, const AssetImportSettings& settings = {}, const AssetLoadCallback<T>& callback = nullptr);
+
+		// Stand-ins to render while the real asset is loading. Placeholder meshes share one box's GPU
+		// resources but keep the path and residency of the mesh they stand in for, so scenes can be
+		// saved before loading has finished.
+		static Ref<Mesh> CreatePlaceholderMesh(const std::string& filepath, MeshResidency residency = MeshResidency::KeepAll);
+		static Ref<Texture2D> GetPlaceholderTexture();
+
+		// Bytes of async loads finished per frame; at least one load always completes
+		static void SetUploadBudget(uint64_t bytes);
+		static uint32_t GetPendingLoadCount();
+
+		// For other streaming systems sharing the loader threads. The main thread job counts
+		// against the upload budget; GPU resources and the asset caches may only be touched there.
+		static void SubmitBackgroundJob(std::function<void()> job);
+		static void SubmitMainThreadJob(uint64_t size, std::function<void()> job);
+
+		static AssetHandle GetHandle(AssetType type, const std::string& filepath, uint64_t settings = 0);
+		static bool IsLoaded(AssetHandle handle);
+		static std::string NormalizePath(const std::string& filepath);
+
+		// Called once per frame by the application
+		static void Update();
+		static void CollectGarbage();
+
+		// 0 disables the budget, releasing unreferenced assets as soon as garbage is collected
+		static void SetMemoryBudget(uint64_t bytes);
+		static uint64_t GetMemoryBudget();
+		static uint64_t GetMemoryUsage();
+
+		static std::vector<AssetInfo> GetLoadedAssets();
+	};
+
+	template<> AssetFuture<Mesh> AssetManager::LoadAsync<Mesh>(const std::string& filepath, const AssetImportSettings& settings, const AssetLoadCallback<Mesh>& callback);
+	template<> AssetFuture<Texture2D> AssetManager::LoadAsync<Texture2D>(const std::string& filepath, const AssetImportSettings& settings, const AssetLoadCallback<Texture2D>& callback);
+	template<> AssetFuture<Environment> AssetManager::LoadAsync<Environment>(const std::string& filepath, const AssetImportSettings& settings, const AssetLoadCallback<Environment>& callback);
+
+}
@@ -0,0 +1,428 @@
+#include "hzpch.h"
+#include "BlockCompression.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	// Principal axis fit over the 16 texels of a block, in the first 'channels' channels.
+	// The endpoints are where the texels' projections onto the axis start and end.
+	static void FitEndpoints(const uint8_t texels[64], uint32_t channels, float outStart[4], float outEnd[4])
+	{
+		float mean[4] = {};
+		for (uint32_t i = 0; i < 16; i++)
+			for (uint32_t c = 0; c < channels; c++)
+				mean[c] += texels[i * 4 + c];
+		for (uint32_t c = 0; c < channels; c++)
+			mean[c] /= 16.0f;
+
+		float covariance[4][4] = {};
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			float d[4];
+			for (uint32_t c = 0; c < channels; c++)
+				d[c] = texels[i * 4 + c] - mean[c];
+			for (uint32_t a = 0; a < channels; a++)
+				for (uint32_t b = 0; b < channels; b++)
+					covariance[a][b] += d[a] * d[b];
+		}
+
+		// Power iteration, starting from the diagonal so grey ramps converge immediately
+		float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		for (uint32_t iteration = 0; iteration < 8; iteration++)
+		{
+			float next[4] = {};
+			float length = 0.0f;
+			for (uint32_t a = 0; a < channels; a++)
+			{
+				for (uint32_t b = 0; b < channels; b++)
+					next[a] += covariance[a][b] * axis[b];
+				length = std::max(length, std::abs(next[a]));
+			}
+
+			if (length < 1e-6f)
+				break;
+
+			for (uint32_t c = 0; c < channels; c++)
+				axis[c] = next[c] / length;
+		}
+
+		float lengthSq = 0.0f;
+		for (uint32_t c = 0; c < channels; c++)
+			lengthSq += axis[c] * axis[c];
+
+		float minT = 0.0f, maxT = 0.0f;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			float t = 0.0f;
+			for (uint32_t c = 0; c < channels; c++)
+				t += (texels[i * 4 + c] - mean[c]) * axis[c];
+			t /= lengthSq;
+			minT = std::min(minT, t);
+			maxT = std::max(maxT, t);
+		}
+
+		for (uint32_t c = 0; c < channels; c++)
+		{
+			outStart[c] = glm::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+			outEnd[c] = glm::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+		}
+	}
+
+	// Least squares endpoints for fixed indices. weights[i] is how much of the end endpoint
+	// texel i gets, 0..1. Returns false if the system is degenerate (every texel on one weight).
+	static bool RefineEndpoints(const uint8_t texels[64], uint32_t channels, const float weights[16], float outStart[4], float outEnd[4])
+	{
+		float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+		float ax[4] = {}, bx[4] = {};
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			float b = weights[i], a = 1.0f - b;
+			aa += a * a;
+			ab += a * b;
+			bb += b * b;
+			for (uint32_t c = 0; c < channels; c++)
+			{
+				ax[c] += a * texels[i * 4 + c];
+				bx[c] += b * texels[i * 4 + c];
+			}
+		}
+
+		float determinant = aa * bb - ab * ab;
+		if (std::abs(determinant) < 1e-6f)
+			return false;
+
+		for (uint32_t c = 0; c < channels; c++)
+		{
+			outStart[c] = glm::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+			outEnd[c] = glm::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+		}
+		return true;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////////
+	// BC1
+	//////////////////////////////////////////////////////////////////////////////////
+
+	static uint16_t To565(const float color[3])
+	{
+		uint32_t r = (uint32_t)(color[0] * 31.0f / 255.0f + 0.5f);
+		uint32_t g = (uint32_t)(color[1] * 63.0f / 255.0f + 0.5f);
+		uint32_t b = (uint32_t)(color[2] * 31.0f / 255.0f + 0.5f);
+		return (uint16_t)((r << 11) | (g << 5) | b);
+	}
+
+	static void From565(uint16_t color, int outColor[3])
+	{
+		int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+		outColor[0] = (r << 3) | (r >> 2);
+		outColor[1] = (g << 2) | (g >> 4);
+		outColor[2] = (b << 3) | (b >> 2);
+	}
+
+	// Picks the closest of the four colors for every texel; returns the total squared error
+	static uint32_t SelectBC1Indices(const uint8_t texels[64], uint16_t c0, uint16_t c1, uint32_t& outIndices)
+	{
+		int palette[4][3];
+		From565(c0, palette[0]);
+		From565(c1, palette[1]);
+		for (uint32_t c = 0; c < 3; c++)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+
+		uint32_t totalError = 0;
+		outIndices = 0;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			uint32_t bestError = UINT32_MAX, bestIndex = 0;
+			for (uint32_t p = 0; p < 4; p++)
+			{
+				uint32_t error = 0;
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					int d = texels[i * 4 + c] - palette[p][c];
+					error += d * d;
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					bestIndex = p;
+				}
+			}
+			outIndices |= bestIndex << (i * 2);
+			totalError += bestError;
+		}
+		return totalError;
+	}
+
+	// Always four color mode (c0 > c1), so the same block is valid as the color half of BC3
+	static uint32_t EncodeBC1Color(const uint8_t texels[64], uint8_t outBlock[8])
+	{
+		float start[4], end[4];
+		FitEndpoints(texels, 3, start, end);
+
+		uint16_t c0 = To565(start), c1 = To565(end);
+		uint32_t indices;
+		uint32_t error = SelectBC1Indices(texels, c0, c1, indices);
+
+		static const float s_Weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+		float weights[16];
+		for (uint32_t i = 0; i < 16; i++)
+			weights[i] = s_Weights[(indices >> (i * 2)) & 3];
+
+		if (RefineEndpoints(texels, 3, weights, start, end))
+		{
+			uint16_t r0 = To565(start), r1 = To565(end);
+			uint32_t refinedIndices;
+			uint32_t refinedError = SelectBC1Indices(texels, r0, r1, refinedIndices);
+			if (refinedError < error)
+			{
+				c0 = r0;
+				c1 = r1;
+				indices = refinedIndices;
+				error = refinedError;
+			}
+		}
+
+		if (c0 < c1)
+		{
+			// Swapping the endpoints swaps palette entries 0 <-> 1 and 2 <-> 3
+			std::swap(c0, c1);
+			indices ^= 0x55555555;
+		}
+		else if (c0 == c1)
+		{
+			indices = 0;
+		}
+
+		outBlock[0] = (uint8_t)c0;
+		outBlock[1] = (uint8_t)(c0 >> 8);
+		outBlock[2] = (uint8_t)c1;
+		outBlock[3] = (uint8_t)(c1 >> 8);
+		memcpy(outBlock + 4, &indices, 4);
+		return error;
+	}
+
+	void BlockCompression::EncodeBC1(const uint8_t texels[64], uint8_t outBlock[8])
+	{
+		EncodeBC1Color(texels, outBlock);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////////
+	// BC4 / BC3 alpha / BC5
+	//////////////////////////////////////////////////////////////////////////////////
+
+	void BlockCompression::EncodeBC4(const uint8_t texels[64], uint32_t channel, uint8_t outBlock[8])
+	{
+		uint8_t minValue = 255, maxValue = 0;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			minValue = std::min(minValue, texels[i * 4 + channel]);
+			maxValue = std::max(maxValue, texels[i * 4 + channel]);
+		}
+
+		// a0 > a1 selects the eight value ramp: index 0 is a0, 1 is a1 and 2..7 step from a0 to a1
+		outBlock[0] = maxValue;
+		outBlock[1] = minValue;
+
+		uint64_t indices = 0;
+		if (maxValue != minValue)
+		{
+			float scale = 7.0f / (maxValue - minValue);
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				uint32_t step = (uint32_t)((texels[i * 4 + channel] - minValue) * scale + 0.5f); // 0 = a1 .. 7 = a0
+				uint64_t index = step == 7 ? 0 : step == 0 ? 1 : 8 - step;
+				indices |= index << (i * 3);
+			}
+		}
+
+		for (uint32_t i = 0; i < 6; i++)
+			outBlock[2 + i] = (uint8_t)(indices >> (i * 8));
+	}
+
+	void BlockCompression::EncodeBC3(const uint8_t texels[64], uint8_t outBlock[16])
+	{
+		EncodeBC4(texels, 3, outBlock);
+		EncodeBC1Color(texels, outBlock + 8);
+	}
+
+	void BlockCompression::EncodeBC5(const uint8_t texels[64], uint8_t outBlock[16])
+	{
+		EncodeBC4(texels, 0, outBlock);
+		EncodeBC4(texels, 1, outBlock + 8);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////////
+	// BC7 (mode 6)
+	//////////////////////////////////////////////////////////////////////////////////
+
+	static const uint32_t s_BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	struct BC7Mode6Block
+	{
+		uint8_t Endpoints[2][4]; // 7 bits each
+		uint8_t PBits[2];
+		uint8_t Indices[16];
+		uint32_t Error = UINT32_MAX;
+	};
+
+	static void QuantizeBC7Endpoints(const float start[4], const float end[4], uint32_t p0, uint32_t p1, BC7Mode6Block& block)
+	{
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			block.Endpoints[0][c] = (uint8_t)glm::clamp((int)((start[c] - p0) * 0.5f + 0.5f), 0, 127);
+			block.Endpoints[1][c] = (uint8_t)glm::clamp((int)((end[c] - p1) * 0.5f + 0.5f), 0, 127);
+		}
+		block.PBits[0] = (uint8_t)p0;
+		block.PBits[1] = (uint8_t)p1;
+	}
+
+	static void SelectBC7Indices(const uint8_t texels[64], BC7Mode6Block& block)
+	{
+		int palette[16][4];
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			int e0 = (block.Endpoints[0][c] << 1) | block.PBits[0];
+			int e1 = (block.Endpoints[1][c] << 1) | block.PBits[1];
+			for (uint32_t p = 0; p < 16; p++)
+				palette[p][c] = ((64 - s_BC7Weights[p]) * e0 + s_BC7Weights[p] * e1 + 32) >> 6;
+		}
+
+		block.Error = 0;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			uint32_t bestError = UINT32_MAX, bestIndex = 0;
+			for (uint32_t p = 0; p < 16; p++)
+			{
+				uint32_t error = 0;
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					int d = texels[i * 4 + c] - palette[p][c];
+					error += d * d;
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					bestIndex = p;
+				}
+			}
+			block.Indices[i] = (uint8_t)bestIndex;
+			block.Error += bestError;
+		}
+	}
+
+	static BC7Mode6Block FindBestBC7Block(const uint8_t texels[64], const float start[4], const float end[4])
+	{
+		BC7Mode6Block best;
+		for (uint32_t pbits = 0; pbits < 4; pbits++)
+		{
+			BC7Mode6Block block;
+			QuantizeBC7Endpoints(start, end, pbits & 1, pbits >> 1, block);
+			SelectBC7Indices(texels, block);
+			if (block.Error < best.Error)
+				best = block;
+		}
+		return best;
+	}
+
+	class BitWriter
+	{
+	public:
+		BitWriter(uint8_t* data)
+			: m_Data(data) {}
+
+		void Write(uint32_t value, uint32_t bits)
+		{
+			for (uint32_t i = 0; i < bits; i++, m_Position++)
+			{
+				if ((value >> i) & 1)
+					m_Data[m_Position >> 3] |= (uint8_t)(1 << (m_Position & 7));
+			}
+		}
+	private:
+		uint8_t* m_Data;
+		uint32_t m_Position = 0;
+	};
+
+	void BlockCompression::EncodeBC7(const uint8_t texels[64], uint8_t outBlock[16])
+	{
+		float start[4], end[4];
+		FitEndpoints(texels, 4, start, end);
+		BC7Mode6Block block = FindBestBC7Block(texels, start, end);
+
+		float weights[16];
+		for (uint32_t i = 0; i < 16; i++)
+			weights[i] = s_BC7Weights[block.Indices[i]] / 64.0f;
+
+		if (RefineEndpoints(texels, 4, weights, start, end))
+		{
+			BC7Mode6Block refined = FindBestBC7Block(texels, start, end);
+			if (refined.Error < block.Error)
+				block = refined;
+		}
+
+		// The first texel's index is stored with its top bit implied zero
+		if (block.Indices[0] & 8)
+		{
+			for (uint32_t c = 0; c < 4; c++)
+				std::swap(block.Endpoints[0][c], block.Endpoints[1][c]);
+			std::swap(block.PBits[0], block.PBits[1]);
+			for (uint32_t i = 0; i < 16; i++)
+				block.Indices[i] = 15 - block.Indices[i];
+		}
+
+		memset(outBlock, 0, 16);
+		BitWriter writer(outBlock);
+		writer.Write(1 << 6, 7);
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			writer.Write(block.Endpoints[0][c], 7);
+			writer.Write(block.Endpoints[1][c], 7);
+		}
+		writer.Write(block.PBits[0], 1);
+		writer.Write(block.PBits[1], 1);
+		writer.Write(block.Indices[0], 3);
+		for (uint32_t i = 1; i < 16; i++)
+			writer.Write(block.Indices[i], 4);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////////
+
+	void BlockCompression::Encode(TextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* outData)
+	{
+		uint32_t blockSize = Texture::GetBlockSize(format);
+		HZ_CORE_ASSERT(blockSize, "Not a block compressed format!");
+
+		uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+		uint8_t texels[64];
+		for (uint32_t by = 0; by < blocksY; by++)
+		{
+			for (uint32_t bx = 0; bx < blocksX; bx++)
+			{
+				for (uint32_t y = 0; y < 4; y++)
+				{
+					uint32_t sy = std::min(by * 4 + y, height - 1);
+					for (uint32_t x = 0; x < 4; x++)
+					{
+						uint32_t sx = std::min(bx * 4 + x, width - 1);
+						memcpy(&texels[(y * 4 + x) * 4], &rgba[((size_t)sy * width + sx) * 4], 4);
+					}
+				}
+
+				uint8_t* block = outData + ((size_t)by * blocksX + bx) * blockSize;
+				switch (format)
+				{
+					case TextureFormat::BC1: EncodeBC1(texels, block); break;
+					case TextureFormat::BC3: EncodeBC3(texels, block); break;
+					case TextureFormat::BC4: EncodeBC4(texels, 0, block); break;
+					case TextureFormat::BC5: EncodeBC5(texels, block); break;
+					case TextureFormat::BC7: EncodeBC7(texels, block); break;
+				}
+			}
+		}
+	}
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Hazel/Renderer/Texture.h"
+
+namespace Hazel {
+
+	// CPU encoders for the block compressed formats, used when cooking textures. Quality is
+	// "good enough for a fast cook": endpoints come from the principal axis of each block and
+	// are refined once, not searched exhaustively. BC7 always uses mode 6 (one RGBA subset).
+	class BlockCompression
+	{
+	public:
+		// texels: 4x4 RGBA8 texels, row by row
+		static void EncodeBC1(const uint8_t texels[64], uint8_t outBlock[8]);
+		static void EncodeBC3(const uint8_t texels[64], uint8_t outBlock[16]);
+		static void EncodeBC4(const uint8_t texels[64], uint32_t channel, uint8_t outBlock[8]);
+		static void EncodeBC5(const uint8_t texels[64], uint8_t outBlock[16]);
+		static void EncodeBC7(const uint8_t texels[64], uint8_t outBlock[16]);
+
+		// Encodes a whole RGBA8 image; edge blocks are padded by clamping.
+		// outData must hold Texture::GetCompressedSize(format, width, height) bytes
+		static void Encode(TextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* outData);
+	};
+
+}
@@ -0,0 +1,318 @@
+#include "hzpch.h"
+#include "TextureCooker.h"
+
+#include "Hazel/Asset/BlockCompression.h"
+#include "Hazel/Renderer/KTX2.h"
+#include "Hazel/FileSystem/FileSystem.h"
+
+#include "stb_image.h"
+
+#include <glm/glm.hpp>
+
+#include <filesystem>
+
+namespace Hazel {
+
+	//////////////////////////////////////////////////////////////////////////////////
+	// sRGB conversion
+	//////////////////////////////////////////////////////////////////////////////////
+
+	static const uint32_t s_LinearToSRGBSize = 4096;
+
+	struct SRGBTables
+	{
+		float ToLinear[256];
+		uint8_t ToSRGB[s_LinearToSRGBSize];
+
+		SRGBTables()
+		{
+			for (uint32_t i = 0; i < 256; i++)
+			{
+				float c = i / 255.0f;
+				ToLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+
+			for (uint32_t i = 0; i < s_LinearToSRGBSize; i++)
+			{
+				float c = i / (float)(s_LinearToSRGBSize - 1);
+				float srgb = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+				ToSRGB[i] = (uint8_t)(srgb * 255.0f + 0.5f);
+			}
+		}
+	};
+
+	static const SRGBTables& GetSRGBTables()
+	{
+		static SRGBTables s_Tables;
+		return s_Tables;
+	}
+
+	static glm::vec3 DecodeNormal(const uint8_t* texel)
+	{
+		return glm::vec3(texel[0], texel[1], texel[2]) / 127.5f - 1.0f;
+	}
+
+	// Normalizes; degenerate vectors (from opposing normals averaging out) point straight up
+	static void EncodeNormal(const glm::vec3& normal, uint8_t* outTexel)
+	{
+		glm::vec3 n = glm::dot(normal, normal) > 1e-8f ? glm::normalize(normal) : glm::vec3(0.0f, 0.0f, 1.0f);
+		for (uint32_t c = 0; c < 3; c++)
+			outTexel[c] = (uint8_t)glm::clamp((n[c] + 1.0f) * 127.5f + 0.5f, 0.0f, 255.0f);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////////
+	// Usage heuristics
+	//////////////////////////////////////////////////////////////////////////////////
+
+	// Lower case words of the file name, e.g. "Cerberus_N" -> { "cerberus", "n" }
+	static std::vector<std::string> GetNameTokens(const std::string& path)
+	{
+		std::string name = std::filesystem::path(path).stem().string();
+		std::vector<std::string> tokens;
+		std::string token;
+		for (size_t i = 0; i <= name.size(); i++)
+		{
+			// CamelCase boundaries split too, so "BaseColor" gives "base" and "color"
+			char c = i < name.size() ? name[i] : '\0';
+			bool boundary = !std::isalnum((unsigned char)c) || (std::isupper((unsigned char)c) && i > 0 && std::islower((unsigned char)name[i - 1]));
+			if (boundary && !token.empty())
+			{
+				tokens.push_back(token);
+				token.clear();
+			}
+			if (std::isalnum((unsigned char)c))
+				token += (char)std::tolower((unsigned char)c);
+		}
+		return tokens;
+	}
+
+	static TextureUsage GuessUsageFromName(const std::string& path)
+	{
+		// Single letters are only trusted as an explicit suffix, e.g. "Cerberus_R"
+		std::string stem = std::filesystem::path(path).stem().string();
+		bool letterSuffix = stem.size() > 2 && stem[stem.size() - 2] == '_' && std::isalpha((unsigned char)stem.back());
+
+		static const char* s_NormalNames[] = { "normal", "normals", "normalmap", "nrm", "norm", "nor", "ddn", "n" };
+		static const char* s_MaskNames[] = { "roughness", "rough", "metalness", "metallic", "metal", "ao", "occlusion", "gloss", "glossiness", "specular", "spec", "height", "displacement", "disp", "mask", "r", "m" };
+		static const char* s_ColorNames[] = { "albedo", "diffuse", "diff", "dif", "color", "colour", "basecolor", "base", "col", "a", "d", "c" };
+
+		auto matches = [](const std::string& token, const auto& names)
+		{
+			for (const char* name : names)
+			{
+				if (token == name)
+					return true;
+			}
+			return false;
+		};
+
+		// Suffixes are the most telling, so search from the end
+		std::vector<std::string> tokens = GetNameTokens(path);
+		for (auto it = tokens.rbegin(); it != tokens.rend(); ++it)
+		{
+			// Single letters only count as the last word ("rock_n", not "n_rock" or "rockN")
+			if (it->size() == 1 && (it != tokens.rbegin() || !letterSuffix))
+				continue;
+
+			if (matches(*it, s_NormalNames))
+				return TextureUsage::Normal;
+			if (matches(*it, s_MaskNames))
+				return TextureUsage::Mask;
+			if (matches(*it, s_ColorNames))
+				return TextureUsage::Color;
+		}
+		return TextureUsage::Auto;
+	}
+
+	static bool HasAlpha(const uint8_t* rgba, uint32_t width, uint32_t height)
+	{
+		uint64_t pixelCount = (uint64_t)width * height;
+		for (uint64_t i = 0; i < pixelCount; i++)
+		{
+			if (rgba[i * 4 + 3] != 255)
+				return true;
+		}
+		return false;
+	}
+
+	// Grey pixels alone don't make a mask: grey albedo and UI art would come out as BC4, so only
+	// file names pick masks, and anything not a normal map is cooked as color
+	static TextureUsage GuessUsageFromPixels(const uint8_t* rgba, uint32_t width, uint32_t height)
+	{
+		uint64_t pixelCount = (uint64_t)width * height;
+		uint64_t normalCount = 0;
+		for (uint64_t i = 0; i < pixelCount; i++)
+		{
+			const uint8_t* p = rgba + i * 4;
+
+			// Unit length and facing out of the surface
+			glm::vec3 n = DecodeNormal(p);
+			float length = glm::length(n);
+			if (n.z > 0.0f && length > 0.85f && length < 1.15f)
+				normalCount++;
+		}
+
+		if (normalCount >= pixelCount * 95 / 100)
+			return TextureUsage::Normal;
+		return TextureUsage::Color;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////////
+
+	bool TextureCooker::IsCookable(const std::string& path)
+	{
+		std::string extension = std::filesystem::path(path).extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+		if (extension != ".png" && extension != ".tga" && extension != ".jpg" && extension != ".jpeg" && extension != ".bmp" && extension != ".psd")
+			return false;
+
+		// Lookup tables such as BRDF_LUT need every bit of precision they have
+		std::vector<std::string> tokens = GetNameTokens(path);
+		return std::find(tokens.begin(), tokens.end(), "lut") == tokens.end();
+	}
+
+	TextureUsage TextureCooker::GuessUsage(const std::string& path, const uint8_t* rgba, uint32_t width, uint32_t height)
+	{
+		TextureUsage usage = GuessUsageFromName(path);
+		return usage != TextureUsage::Auto ? usage : GuessUsageFromPixels(rgba, width, height);
+	}
+
+	TextureFormat TextureCooker::SelectFormat(TextureUsage usage, bool hasAlpha, bool highQuality)
+	{
+		switch (usage)
+		{
+			case TextureUsage::Normal: return TextureFormat::BC5;
+			case TextureUsage::Mask:   return TextureFormat::BC4;
+		}
+
+		if (highQuality)
+			return TextureFormat::BC7;
+		return hasAlpha ? TextureFormat::BC3 : TextureFormat::BC1;
+	}
+
+	bool TextureCooker::Cook(const std::string& path, const TextureCookSettings& settings, std::vector<uint8_t>& outFile, TextureCookResult* outResult)
+	{
+		FileData file = FileSystem::ReadFile(path);
+		if (!file || file.GetSize() > INT32_MAX || stbi_is_hdr_from_memory(file.GetData(), (int)file.GetSize()))
+			return false;
+
+		int width, height, channels;
+		stbi_uc* rgba = stbi_load_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &channels, STBI_rgb_alpha);
+		if (!rgba)
+		{
+			HZ_CORE_ERROR("Could not decode {0} for cooking: {1}", path, stbi_failure_reason());
+			return false;
+		}
+
+		TextureUsage usage = settings.Usage != TextureUsage::Auto ? settings.Usage : GuessUsage(path, rgba, width, height);
+		TextureFormat format = SelectFormat(usage, HasAlpha(rgba, width, height), settings.HighQuality);
+
+		TextureData data;
+		data.Path = path;
+		Cook(rgba, width, height, usage, format, data);
+		stbi_image_free(rgba);
+
+		bool written = KTX2::Write(data, outFile);
+		if (outResult)
+			*outResult = { usage, format, data.Width, data.Height, (uint32_t)data.Mips.size() };
+		data.Data.Release();
+		return written;
+	}
+
+	void TextureCooker::Cook(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage, TextureFormat format, TextureData& outData)
+	{
+		HZ_CORE_ASSERT(Texture::IsCompressed(format), "Textures are cooked to block compressed formats");
+
+		uint32_t mipCount = Texture::CalculateMipMapCount(width, height);
+		uint32_t totalSize = 0;
+		for (uint32_t i = 0; i < mipCount; i++)
+			totalSize += Texture::GetCompressedSize(format, std::max(width >> i, 1u), std::max(height >> i, 1u));
+
+		outData.Format = format;
+		outData.Width = width;
+		outData.Height = height;
+		outData.HDR = false;
+		outData.SRGB = usage == TextureUsage::Color;
+		outData.Data.Allocate(totalSize);
+		outData.Mips.resize(mipCount);
+		outData.FirstMip = 0;
+		outData.MipCount = mipCount;
+
+		std::vector<uint8_t> level, next;
+		const uint8_t* pixels = rgba;
+
+		// Normal maps are renormalized up front so the top level is consistent with its mips
+		if (usage == TextureUsage::Normal)
+		{
+			level.assign(rgba, rgba + (size_t)width * height * 4);
+			for (size_t i = 0; i < level.size(); i += 4)
+				EncodeNormal(DecodeNormal(&level[i]), &level[i]);
+			pixels = level.data();
+		}
+		uint32_t offset = 0;
+		for (uint32_t i = 0; i < mipCount; i++)
+		{
+			TextureMip& mip = outData.Mips[i];
+			mip.Width = std::max(width >> i, 1u);
+			mip.Height = std::max(height >> i, 1u);
+			mip.Offset = offset;
+			mip.Size = Texture::GetCompressedSize(format, mip.Width, mip.Height);
+			BlockCompression::Encode(format, pixels, mip.Width, mip.Height, outData.Data.Data + offset);
+			offset += mip.Size;
+
+			// Each level is filtered from the uncompressed level above it, not from the encoded one
+			if (i + 1 < mipCount)
+			{
+				GenerateMip(pixels, mip.Width, mip.Height, usage, next);
+				level.swap(next);
+				pixels = level.data();
+			}
+		}
+	}
+
+	void TextureCooker::GenerateMip(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage, std::vector<uint8_t>& outMip)
+	{
+		const SRGBTables& tables = GetSRGBTables();
+
+		uint32_t mipWidth = std::max(width / 2, 1u), mipHeight = std::max(height / 2, 1u);
+		outMip.resize((size_t)mipWidth * mipHeight * 4);
+		for (uint32_t y = 0; y < mipHeight; y++)
+		{
+			uint32_t y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+			for (uint32_t x = 0; x < mipWidth; x++)
+			{
+				uint32_t x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+				const uint8_t* texels[4] =
+				{
+					rgba + ((size_t)y0 * width + x0) * 4, rgba + ((size_t)y0 * width + x1) * 4,
+					rgba + ((size_t)y1 * width + x0) * 4, rgba + ((size_t)y1 * width + x1) * 4
+				};
+
+				uint8_t* out = &outMip[((size_t)y * mipWidth + x) * 4];
+				out[3] = (uint8_t)((texels[0][3] + texels[1][3] + texels[2][3] + texels[3][3] + 2) / 4);
+
+				if (usage == TextureUsage::Color)
+				{
+					for (uint32_t c = 0; c < 3; c++)
+					{
+						float linear = (tables.ToLinear[texels[0][c]] + tables.ToLinear[texels[1][c]] + tables.ToLinear[texels[2][c]] + tables.ToLinear[texels[3][c]]) * 0.25f;
+						out[c] = tables.ToSRGB[(uint32_t)(linear * (s_LinearToSRGBSize - 1) + 0.5f)];
+					}
+				}
+				else if (usage == TextureUsage::Normal)
+				{
+					glm::vec3 sum(0.0f);
+					for (uint32_t t = 0; t < 4; t++)
+						sum += DecodeNormal(texels[t]);
+					EncodeNormal(sum, out);
+				}
+				else
+				{
+					for (uint32_t c = 0; c < 3; c++)
+						out[c] = (uint8_t)((texels[0][c] + texels[1][c] + texels[2][c] + texels[3][c] + 2) / 4);
+				}
+			}
+		}
+	}
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Hazel/Renderer/Texture.h"
+
+namespace Hazel {
+
+	// What a texture is sampled as decides its compressed format and how its mips are filtered
+	enum class TextureUsage
+	{
+		Auto = 0, // Guessed from the file name, then from the pixels, which only tell normal maps from color
+		Color,    // sRGB albedo: BC1, BC3 with alpha, or BC7; mips are filtered in linear space
+		Normal,   // Tangent space normals: BC5 (XY only); mips are renormalized
+		Mask      // Single channel data such as roughness or metalness: BC4 of the red channel, sampled as grey
+	};
+
+	struct TextureCookSettings
+	{
+		TextureUsage Usage = TextureUsage::Auto;
+		bool HighQuality = false; // BC7 rather than BC1/BC3 for color textures, at twice the size of BC1
+	};
+
+	struct TextureCookResult
+	{
+		TextureUsage Usage = TextureUsage::Auto;
+		TextureFormat Format = TextureFormat::None;
+		uint32_t Width = 0, Height = 0;
+		uint32_t MipCount = 0;
+	};
+
+	// Turns source images into block compressed KTX2 files with a full, precomputed mip chain.
+	// Texture2D::Decode loads the cooked file in place of the source image when one exists.
+	class TextureCooker
+	{
+	public:
+		// LDR images stb_image can decode; HDR images and lookup tables are left alone
+		static bool IsCookable(const std::string& path);
+
+		static TextureUsage GuessUsage(const std::string& path, const uint8_t* rgba, uint32_t width, uint32_t height);
+		static TextureFormat SelectFormat(TextureUsage usage, bool hasAlpha, bool highQuality);
+
+		static bool Cook(const std::string& path, const TextureCookSettings& settings, std::vector<uint8_t>& outFile, TextureCookResult* outResult = nullptr);
+		// outData.Data is allocated with new[]
+		static void Cook(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage, TextureFormat format, TextureData& outData);
+
+		// Halves an RGBA8 image with a 2x2 box filter, in linear space for Color
+		static void GenerateMip(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage, std::vector<uint8_t>& outMip);
+	};
+
+}
@@ -0,0 +1,70 @@
+#include "hzpch.h"
+#include "AllocationCounter.h"
+
+#include <atomic>
+
+namespace Hazel {
+
+	// Constant initialized, so it can count allocations made before main
+	static std::atomic<uint64_t> s_AllocationCount = 0;
+	static uint64_t s_FrameStartCount = 0;
+	static uint64_t s_LastFrameCount = 0;
+
+	void AllocationCounter::BeginFrame()
+	{
+		uint64_t count = s_AllocationCount.load(std::memory_order_relaxed);
+		s_LastFrameCount = count - s_FrameStartCount;
+		s_FrameStartCount = count;
+	}
+
+	uint64_t AllocationCounter::GetTotalCount()
+	{
+		return s_AllocationCount.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AllocationCounter::GetLastFrameCount()
+	{
+		return s_LastFrameCount;
+	}
+
+}
+
+#if HZ_TRACK_ALLOCATIONS
+
+// The nothrow forms forward to these. Defined in the same file as the functions the
+// application calls, so the linker always takes them over the CRT's.
+void* operator new(size_t size)
+{
+	Hazel::s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = malloc(size ? size : 1))
+		return memory;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+#endif
@@ -0,0 +1,26 @@
+#pragma once
+
+// Counting replaces the global operator new, so it's left out of distribution builds
+#ifndef HZ_TRACK_ALLOCATIONS
+	#ifdef HZ_DIST
+		#define HZ_TRACK_ALLOCATIONS 0
+	#else
+		#define HZ_TRACK_ALLOCATIONS 1
+	#endif
+#endif
+
+namespace Hazel {
+
+	// Counts general purpose heap allocations (operator new) on every thread. A steady state
+	// frame should make none; the application shows the count for the last frame.
+	class AllocationCounter
+	{
+	public:
+		// Called by the application at the start of every frame
+		static void BeginFrame();
+
+		static uint64_t GetTotalCount();
+		static uint64_t GetLastFrameCount();
+	};
+
+}
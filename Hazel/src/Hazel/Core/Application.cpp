@@ -9,6 +9,16 @@
 
 #include "Hazel/Script/ScriptEngine.h"
 #include "Hazel/Physics/Physics.h"
+#include "Hazel/Asset/AssetManager.h"
+#include "Hazel/Core/AllocationCounter.h"
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Core/ObjectPool.h"
+#include "Hazel/Core/Profiler.h"
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Renderer/TextureStreamer.h"
+#include "Hazel/Renderer/TextureUploader.h"
+#include "Hazel/Renderer/StreamingBuffer.h"
+#include "Hazel/FileSystem/FileSystem.h"
 
 #include "Input.h"
 
@@ -25,6 +35,10 @@ namespace Hazel {
 	Application::Application(const ApplicationProps& props)
 	{
 		s_Instance = this;
+		HZ_PROFILE_THREAD("Main Thread");
+
+		FileSystem::Init();
+		FrameAllocator::Init();
 
 		m_Window = std::unique_ptr<Window>(Window::Create(WindowProps(props.Name, props.WindowWidth, props.WindowHeight)));
 		m_Window->SetEventCallback(BIND_EVENT_FN(OnEvent));
@@ -39,6 +53,9 @@ namespace Hazel {
 
 		Renderer::Init();
 		Renderer::WaitAndRender();
+
+		JobSystem::Init();
+		AssetManager::Init();
 	}
 
 	Application::~Application()
@@ -46,8 +63,16 @@ namespace Hazel {
 		for (Layer* layer : m_LayerStack)
 			layer->OnDetach();
 
+		AssetManager::Shutdown();
+		JobSystem::Shutdown();
+		TextureStreamer::Shutdown();
+		TextureUploader::Shutdown();
+		StreamingBuffer::Shutdown();
+		Renderer::StopStatsCapture();
 		Physics::Shutdown();
 		ScriptEngine::Shutdown();
+		FileSystem::Shutdown();
+		FrameAllocator::Shutdown();
 	}
 
 	void Application::PushLayer(Layer* layer)
@@ -64,6 +89,8 @@ namespace Hazel {
 
 	void Application::RenderImGui()
 	{
+		HZ_PROFILE_FUNCTION();
+
 		m_ImGuiLayer->Begin();
 
 		ImGui::Begin("Renderer");
@@ -72,11 +99,53 @@ namespace Hazel {
 		ImGui::Text("Renderer: %s", caps.Renderer.c_str());
 		ImGui::Text("Version: %s", caps.Version.c_str());
 		ImGui::Text("Frame Time: %.2fms\n", m_TimeStep.GetMilliseconds());
+		ImGui::Text("Heap Allocations: %llu last frame", AllocationCounter::GetLastFrameCount());
+		ImGui::Text("Frame Memory: %.2f / %.2f MB", FrameAllocator::GetUsedSize() / (1024.0f * 1024.0f), FrameAllocator::GetSize() / (1024.0f * 1024.0f));
+		ImGui::Text("Streaming Memory: %.2f / %.2f MB", StreamingBuffer::GetUsedSize() / (1024.0f * 1024.0f), StreamingBuffer::GetFrameSize() / (1024.0f * 1024.0f));
+		if (ImGui::TreeNode("Object Pools"))
+		{
+			for (const ObjectPoolStats& pool : ObjectPool::GetAllStats())
+				ImGui::Text("%s: %llu live, %llu peak, %llu capacity", pool.Name, pool.LiveCount, pool.PeakCount, pool.Capacity);
+			ImGui::TreePop();
+		}
+		if (ImGui::TreeNode("Frame Stats"))
+		{
+			const RendererFrameStats& stats = Renderer::GetFrameStats();
+			ImGui::Text("Draw Calls: %u", stats.DrawCalls);
+			ImGui::Text("Triangles: %llu", stats.Triangles);
+			ImGui::Text("Lines: %llu", stats.Lines);
+			ImGui::Text("Meshes: %u", stats.Instances);
+			ImGui::Text("Pipeline Binds: %u", stats.PipelineBinds);
+			ImGui::Text("Material Binds: %u", stats.MaterialBinds);
+			ImGui::Text("Texture Binds: %u", stats.TextureBinds);
+			ImGui::Text("Uniform Uploads: %u (%.2f KB)", stats.UniformUploads, stats.UniformBytes / 1024.0f);
+			ImGui::Text("Commands: %u (%.2f KB)", stats.Commands, stats.CommandBytes / 1024.0f);
+			ImGui::Text("Buffer Uploads: %.2f KB", stats.BufferBytesUploaded / 1024.0f);
+			for (uint32_t i = 0; i < stats.PassCount; i++)
+			{
+				const RenderPassStats& pass = stats.Passes[i];
+				ImGui::Text("%s: %u draws, %llu triangles, %u/%u meshes culled", pass.Name.c_str(), pass.DrawCalls, pass.Triangles, pass.Culled, pass.Submitted);
+			}
+
+			bool capturing = Renderer::IsCapturingStats();
+			if (ImGui::Checkbox("Capture to CSV", &capturing))
+			{
+				if (capturing)
+					Renderer::StartStatsCapture("HazelFrameStats.csv");
+				else
+					Renderer::StopStatsCapture();
+			}
+			ImGui::TreePop();
+		}
 		ImGui::End();
 
 		for (Layer* layer : m_LayerStack)
 			layer->OnImGuiRender();
 
+#if HZ_ENABLE_PROFILING
+		Profiler::OnImGuiRender();
+#endif
+
 		m_ImGuiLayer->End();
 	}
 
@@ -85,10 +154,28 @@ namespace Hazel {
 		OnInit();
 		while (m_Running)
 		{
+#if HZ_ENABLE_PROFILING
+			Profiler::BeginFrame();
+#endif
+			HZ_PROFILE_SCOPE("Frame");
+
+			AllocationCounter::BeginFrame();
+
 			if (!m_Minimized)
 			{
+				// Only frames that execute the command queue swap; minimised frames leave
+				// their commands, and the frame memory they point at, for the next one
+				FrameAllocator::BeginFrame();
+
+				JobSystem::Update();
+				AssetManager::Update();
+				TextureStreamer::Update();
+
 				for (Layer* layer : m_LayerStack)
+				{
+					HZ_PROFILE_SCOPE("Layer::OnUpdate");
 					layer->OnUpdate(m_TimeStep);
+				}
 
 				// Render ImGui on render thread
 				Application* app = this;
@@ -96,7 +183,12 @@ namespace Hazel {
 
 				Renderer::WaitAndRender();
 			}
-			m_Window->OnUpdate();
+			AssetManager::CollectGarbage();
+			{
+				// Includes waiting for vsync
+				HZ_PROFILE_SCOPE("Window::OnUpdate");
+				m_Window->OnUpdate();
+			}
 
 			float time = GetTime();
 			m_TimeStep = time - m_LastFrameTime;
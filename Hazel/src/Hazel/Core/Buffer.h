@@ -4,6 +4,8 @@
 
 namespace Hazel {
 
+	// Pointer and size with no ownership: whoever made the buffer decides when it is freed.
+	// See ScopedBuffer for memory that should be released with its owner.
 	struct Buffer
 	{
 		byte* Data;
@@ -31,6 +33,7 @@ namespace Hazel {
 		{
 			delete[] Data;
 			Data = nullptr;
+			Size = 0;
 
 			if (size == 0)
 				return;
@@ -39,6 +42,13 @@ namespace Hazel {
 			Size = size;
 		}
 
+		void Release()
+		{
+			delete[] Data;
+			Data = nullptr;
+			Size = 0;
+		}
+
 		void ZeroInitialize()
 		{
 			if (Data)
@@ -81,4 +91,136 @@ namespace Hazel {
 		inline uint32_t GetSize() const { return Size; }
 	};
 
+	// Read only view of memory owned by someone else, for passing data to functions that only
+	// read it during the call (or copy what they need to keep)
+	struct BufferView
+	{
+		const byte* Data = nullptr;
+		uint32_t Size = 0;
+
+		BufferView() = default;
+		BufferView(const void* data, uint32_t size)
+			: Data((const byte*)data), Size(size)
+		{
+		}
+
+		BufferView(const Buffer& buffer)
+			: Data(buffer.Data), Size(buffer.Size)
+		{
+		}
+
+		BufferView Slice(uint32_t offset, uint32_t size) const
+		{
+			HZ_CORE_ASSERT(offset + size <= Size, "Buffer overflow!");
+			return BufferView(Data + offset, size);
+		}
+
+		template<typename T>
+		const T& Read(uint32_t offset = 0) const
+		{
+			return *(const T*)(Data + offset);
+		}
+
+		template<typename T>
+		const T* As() const
+		{
+			return (const T*)Data;
+		}
+
+		operator bool() const { return Data; }
+
+		inline uint32_t GetSize() const { return Size; }
+	};
+
+	// Owning buffer, freed when it goes out of scope. Move only, so it can be handed over
+	// (into a render command, say) but never ends up with two owners.
+	class ScopedBuffer
+	{
+	public:
+		ScopedBuffer() = default;
+		explicit ScopedBuffer(uint32_t size)
+		{
+			m_Buffer.Allocate(size);
+		}
+
+		// Takes ownership of memory allocated with new[]
+		explicit ScopedBuffer(Buffer buffer)
+			: m_Buffer(buffer)
+		{
+		}
+
+		ScopedBuffer(ScopedBuffer&& other) noexcept
+			: m_Buffer(other.m_Buffer)
+		{
+			other.m_Buffer = Buffer();
+		}
+
+		ScopedBuffer& operator=(ScopedBuffer&& other) noexcept
+		{
+			if (this != &other)
+			{
+				m_Buffer.Release();
+				m_Buffer = other.m_Buffer;
+				other.m_Buffer = Buffer();
+			}
+			return *this;
+		}
+
+		ScopedBuffer(const ScopedBuffer&) = delete;
+		ScopedBuffer& operator=(const ScopedBuffer&) = delete;
+
+		~ScopedBuffer()
+		{
+			m_Buffer.Release();
+		}
+
+		static ScopedBuffer Copy(BufferView data)
+		{
+			ScopedBuffer buffer(data.Size);
+			if (data.Size)
+				memcpy(buffer.m_Buffer.Data, data.Data, data.Size);
+			return buffer;
+		}
+
+		// Drops the current contents
+		void Allocate(uint32_t size)
+		{
+			m_Buffer.Release();
+			m_Buffer.Allocate(size);
+		}
+
+		void Release() { m_Buffer.Release(); }
+
+		// Gives up ownership; the caller has to release the returned buffer
+		Buffer Detach()
+		{
+			Buffer buffer = m_Buffer;
+			m_Buffer = Buffer();
+			return buffer;
+		}
+
+		void ZeroInitialize() { m_Buffer.ZeroInitialize(); }
+
+		void Write(const void* data, uint32_t size, uint32_t offset = 0) { m_Buffer.Write((void*)data, size, offset); }
+
+		template<typename T>
+		T& Read(uint32_t offset = 0) { return m_Buffer.Read<T>(offset); }
+		template<typename T>
+		const T& Read(uint32_t offset = 0) const { return *(const T*)(m_Buffer.Data + offset); }
+
+		template<typename T>
+		T* As() { return m_Buffer.As<T>(); }
+
+		byte* GetData() { return m_Buffer.Data; }
+		const byte* GetData() const { return m_Buffer.Data; }
+		uint32_t GetSize() const { return m_Buffer.Size; }
+
+		BufferView View() const { return BufferView(m_Buffer); }
+		operator BufferView() const { return View(); }
+
+		operator bool() const { return m_Buffer; }
+	private:
+		Buffer m_Buffer;
+	};
+
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "hzpch.h"
+#include "CPUFeatures.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#define HZ_CPU_X86 1
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#else
+	#define HZ_CPU_X86 0
+#endif
+
+namespace Hazel {
+
+	struct CPUFeatureFlags
+	{
+		bool AVX = false;
+		bool AVX2 = false;
+		bool F16C = false;
+	};
+
+#if HZ_CPU_X86
+	static void CPUID(uint32_t leaf, uint32_t subleaf, uint32_t info[4])
+	{
+#ifdef _MSC_VER
+		__cpuidex((int*)info, leaf, subleaf);
+#else
+		__cpuid_count(leaf, subleaf, info[0], info[1], info[2], info[3]);
+#endif
+	}
+
+	static uint64_t XGETBV(uint32_t index)
+	{
+#ifdef _MSC_VER
+		return _xgetbv(index);
+#else
+		uint32_t eax, edx;
+		__asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+		return ((uint64_t)edx << 32) | eax;
+#endif
+	}
+#endif
+
+	static CPUFeatureFlags DetectFeatures()
+	{
+		CPUFeatureFlags flags;
+#if HZ_CPU_X86
+		uint32_t info[4];
+		CPUID(0, 0, info);
+		uint32_t maxLeaf = info[0];
+
+		CPUID(1, 0, info);
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		bool f16c = (info[2] & (1 << 29)) != 0;
+
+		// AVX registers are only usable if the OS saves YMM state on context switches
+		if (!osxsave || !avx || (XGETBV(0) & 0x6) != 0x6)
+			return flags;
+
+		flags.AVX = true;
+		flags.F16C = f16c;
+
+		if (maxLeaf >= 7)
+		{
+			CPUID(7, 0, info);
+			flags.AVX2 = (info[1] & (1 << 5)) != 0;
+		}
+#endif
+		return flags;
+	}
+
+	static const CPUFeatureFlags& GetFeatures()
+	{
+		static CPUFeatureFlags flags = DetectFeatures();
+		return flags;
+	}
+
+	bool CPUFeatures::HasAVX()
+	{
+		return GetFeatures().AVX;
+	}
+
+	bool CPUFeatures::HasAVX2()
+	{
+		return GetFeatures().AVX2;
+	}
+
+	bool CPUFeatures::HasF16C()
+	{
+		return GetFeatures().F16C;
+	}
+
+}
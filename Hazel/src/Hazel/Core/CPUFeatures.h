@@ -0,0 +1,15 @@
+#pragma once
+
+namespace Hazel {
+
+	// Instruction set extensions the CPU and OS support, for picking SIMD code paths at run time.
+	// Detected on first use, so it's safe to call from static initializers.
+	class CPUFeatures
+	{
+	public:
+		static bool HasAVX();
+		static bool HasAVX2();
+		static bool HasF16C();
+	};
+
+}
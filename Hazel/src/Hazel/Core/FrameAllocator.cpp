@@ -0,0 +1,142 @@
+#include "hzpch.h"
+#include "FrameAllocator.h"
+
+#include <mutex>
+
+namespace Hazel {
+
+	// Enough for any type the engine allocates, SIMD and cache line aligned ones included
+	static const uint64_t s_BlockAlignment = 64;
+
+	LinearAllocator::LinearAllocator(uint64_t size)
+		: m_Size(size)
+	{
+		m_Buffer = (uint8_t*)::operator new(size, std::align_val_t(s_BlockAlignment));
+	}
+
+	LinearAllocator::~LinearAllocator()
+	{
+		::operator delete(m_Buffer, std::align_val_t(s_BlockAlignment));
+	}
+
+	void* LinearAllocator::Allocate(uint64_t size, uint64_t alignment)
+	{
+		HZ_CORE_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0 && alignment <= s_BlockAlignment, "Invalid alignment!");
+
+		uint64_t offset = m_Offset.load(std::memory_order_relaxed);
+		uint64_t alignedOffset;
+		do
+		{
+			alignedOffset = (offset + alignment - 1) & ~(alignment - 1);
+			if (alignedOffset + size > m_Size)
+				return nullptr;
+		} while (!m_Offset.compare_exchange_weak(offset, alignedOffset + size, std::memory_order_relaxed));
+
+		return m_Buffer + alignedOffset;
+	}
+
+	void LinearAllocator::Reset()
+	{
+		m_Offset.store(0, std::memory_order_relaxed);
+	}
+
+	struct FrameAllocatorData
+	{
+		Scope<LinearAllocator> Blocks[2];
+		uint32_t Current = 0;
+
+		// Heap allocations made once a block was full, freed when it is next reset
+		std::mutex OverflowMutex;
+		std::vector<void*> Overflow[2];
+		uint64_t OverflowSize[2] = {};
+	};
+
+	static FrameAllocatorData s_Data;
+
+	void FrameAllocator::Init(uint64_t size)
+	{
+		HZ_CORE_ASSERT(!s_Data.Blocks[0], "Frame allocator is already initialized!");
+		s_Data.Blocks[0] = CreateScope<LinearAllocator>(size);
+		s_Data.Blocks[1] = CreateScope<LinearAllocator>(size);
+		s_Data.Current = 0;
+	}
+
+	static void FreeOverflow(uint32_t block)
+	{
+		for (void* memory : s_Data.Overflow[block])
+			::operator delete(memory, std::align_val_t(s_BlockAlignment));
+		s_Data.Overflow[block].clear();
+		s_Data.OverflowSize[block] = 0;
+	}
+
+	void FrameAllocator::Shutdown()
+	{
+		FreeOverflow(0);
+		FreeOverflow(1);
+		s_Data.Blocks[0].reset();
+		s_Data.Blocks[1].reset();
+	}
+
+	void FrameAllocator::BeginFrame()
+	{
+		HZ_CORE_ASSERT(s_Data.Blocks[0], "Frame allocator is not initialized!");
+
+		uint32_t previous = s_Data.Current;
+		if (s_Data.OverflowSize[previous] > 0)
+			HZ_CORE_WARN("FrameAllocator: {0} bytes didn't fit in the {1} byte block and came from the heap", s_Data.OverflowSize[previous], s_Data.Blocks[previous]->GetSize());
+
+		s_Data.Current = previous ^ 1;
+		s_Data.Blocks[s_Data.Current]->Reset();
+		FreeOverflow(s_Data.Current);
+	}
+
+	void* FrameAllocator::Allocate(uint64_t size, uint64_t alignment)
+	{
+		HZ_CORE_ASSERT(s_Data.Blocks[0], "Frame allocator is not initialized!");
+
+		uint32_t current = s_Data.Current;
+		if (void* memory = s_Data.Blocks[current]->Allocate(size, alignment))
+			return memory;
+
+		void* memory = ::operator new(size, std::align_val_t(s_BlockAlignment));
+		std::scoped_lock<std::mutex> lock(s_Data.OverflowMutex);
+		s_Data.Overflow[current].push_back(memory);
+		s_Data.OverflowSize[current] += size;
+		return memory;
+	}
+
+	const char* FrameAllocator::CopyString(std::string_view string)
+	{
+		char* copy = Allocate<char>(string.size() + 1);
+		memcpy(copy, string.data(), string.size());
+		copy[string.size()] = '\0';
+		return copy;
+	}
+
+	const void* FrameAllocator::Stage(const void* data, uint64_t size)
+	{
+		if (Owns(data))
+			return data;
+
+		void* copy = Allocate(size);
+		memcpy(copy, data, size);
+		return copy;
+	}
+
+	bool FrameAllocator::Owns(const void* memory)
+	{
+		// Overflow allocations aren't tracked; staging those only costs a copy
+		return s_Data.Blocks[s_Data.Current] && s_Data.Blocks[s_Data.Current]->Contains(memory);
+	}
+
+	uint64_t FrameAllocator::GetSize()
+	{
+		return s_Data.Blocks[s_Data.Current] ? s_Data.Blocks[s_Data.Current]->GetSize() : 0;
+	}
+
+	uint64_t FrameAllocator::GetUsedSize()
+	{
+		return s_Data.Blocks[s_Data.Current] ? s_Data.Blocks[s_Data.Current]->GetUsedSize() : 0;
+	}
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Hazel {
+
+	// Hands out memory by bumping an offset into a fixed block, and frees all of it at once.
+	// Allocate is safe to call from several threads; Reset is not.
+	class LinearAllocator
+	{
+	public:
+		LinearAllocator(uint64_t size);
+		~LinearAllocator();
+
+		LinearAllocator(const LinearAllocator&) = delete;
+		LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+		// Returns nullptr once the block is full
+		void* Allocate(uint64_t size, uint64_t alignment);
+		void Reset();
+
+		bool Contains(const void* memory) const { return memory >= m_Buffer && memory < m_Buffer + m_Size; }
+
+		uint64_t GetSize() const { return m_Size; }
+		uint64_t GetUsedSize() const { return std::min(m_Offset.load(std::memory_order_relaxed), m_Size); }
+	private:
+		uint8_t* m_Buffer = nullptr;
+		uint64_t m_Size = 0;
+		std::atomic<uint64_t> m_Offset = 0;
+	};
+
+	// Memory for things that only live for a frame: draw lists, render command payloads,
+	// formatted names. There are two blocks, swapped at the start of every rendered frame, so memory
+	// handed out during frame N stays valid until frame N + 2 begins and the render thread can
+	// still read what the main thread recorded. Nothing is destructed; only use it for types
+	// whose destructors don't need to run, or run them yourself.
+	// Allocations past the end of the block fall back to the heap, and are released when the
+	// block is reused. That is a sign the block should be bigger, so it gets logged.
+	class FrameAllocator
+	{
+	public:
+		static const uint64_t DefaultSize = 16ull * 1024 * 1024;
+
+		static void Init(uint64_t size = DefaultSize);
+		static void Shutdown();
+
+		// Called by the application at the start of every frame that renders, with no frame work in flight
+		static void BeginFrame();
+
+		static void* Allocate(uint64_t size, uint64_t alignment = alignof(std::max_align_t));
+
+		template<typename T>
+		static T* Allocate(uint64_t count = 1)
+		{
+			return (T*)Allocate(sizeof(T) * count, alignof(T));
+		}
+
+		// Null terminated copy, for passing names on to render commands
+		static const char* CopyString(std::string_view string);
+
+		// Memory holding size bytes of data that stays valid until the render thread has run
+		// this frame's commands: data itself if it already is frame memory, otherwise a copy
+		static const void* Stage(const void* data, uint64_t size);
+		static bool Owns(const void* memory);
+
+		// Of the block the current frame allocates from
+		static uint64_t GetSize();
+		static uint64_t GetUsedSize();
+	};
+
+	// Standard library allocator over the frame allocator. Deallocating does nothing, so a
+	// container that grows leaves its old storage behind until the block is reset; reserve
+	// up front where the size is known. Containers using it must be emptied, and their storage
+	// dropped, before the frame after next.
+	template<typename T>
+	struct FrameStlAllocator
+	{
+		using value_type = T;
+
+		FrameStlAllocator() = default;
+		template<typename U>
+		FrameStlAllocator(const FrameStlAllocator<U>&) {}
+
+		T* allocate(size_t count) { return FrameAllocator::Allocate<T>(count); }
+		void deallocate(T*, size_t) {}
+
+		template<typename U>
+		bool operator==(const FrameStlAllocator<U>&) const { return true; }
+		template<typename U>
+		bool operator!=(const FrameStlAllocator<U>&) const { return false; }
+	};
+
+	template<typename T>
+	using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+	using FrameString = std::basic_string<char, std::char_traits<char>, FrameStlAllocator<char>>;
+
+}
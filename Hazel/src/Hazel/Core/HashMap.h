@@ -0,0 +1,696 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "Hazel/Core/Base.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#define HZ_HASH_TABLE_SSE2 1
+	#include <emmintrin.h>
+#else
+	#define HZ_HASH_TABLE_SSE2 0
+#endif
+
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+namespace Hazel {
+
+	// Default hasher for the hash tables below. Strings hash as string_views, so string keyed
+	// tables can be searched with a string_view or a literal without building a std::string.
+	template<typename T>
+	struct Hash
+	{
+		size_t operator()(const T& value) const { return std::hash<T>()(value); }
+	};
+
+	template<>
+	struct Hash<std::string>
+	{
+		using is_transparent = void;
+		size_t operator()(std::string_view value) const { return std::hash<std::string_view>()(value); }
+	};
+
+	namespace HashTableDetail {
+
+		// One per slot: Empty, Deleted, or the low 7 bits of the hash of the key stored there
+		using ControlByte = int8_t;
+		static constexpr ControlByte Empty = -128;
+		static constexpr ControlByte Deleted = -2;
+
+		static constexpr size_t GroupWidth = 16;
+
+		// Spreads the bits of hashes that don't (std::hash of an integer is often the integer)
+		inline uint64_t Mix(uint64_t hash)
+		{
+			hash *= 0x9E3779B97F4A7C15ull;
+			return hash ^ (hash >> 32);
+		}
+
+		inline uint32_t LowestBit(uint32_t mask)
+		{
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return (uint32_t)index;
+#else
+			return (uint32_t)__builtin_ctz(mask);
+#endif
+		}
+
+		// The control bytes of GroupWidth consecutive slots, tested all at once
+		struct Group
+		{
+#if HZ_HASH_TABLE_SSE2
+			__m128i Control;
+
+			explicit Group(const ControlByte* control)
+				: Control(_mm_load_si128((const __m128i*)control))
+			{
+			}
+
+			// Bit i is set if slot i holds a key with these hash bits
+			uint32_t Match(ControlByte h2) const { return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), Control)); }
+			uint32_t MatchEmpty() const { return Match(Empty); }
+			// Empty and Deleted are the only negative values
+			uint32_t MatchNonFull() const { return (uint32_t)_mm_movemask_epi8(Control); }
+#else
+			const ControlByte* Control;
+
+			explicit Group(const ControlByte* control)
+				: Control(control)
+			{
+			}
+
+			uint32_t Match(ControlByte h2) const
+			{
+				uint32_t mask = 0;
+				for (uint32_t i = 0; i < GroupWidth; i++)
+					mask |= (uint32_t)(Control[i] == h2) << i;
+				return mask;
+			}
+			uint32_t MatchEmpty() const { return Match(Empty); }
+			uint32_t MatchNonFull() const
+			{
+				uint32_t mask = 0;
+				for (uint32_t i = 0; i < GroupWidth; i++)
+					mask |= (uint32_t)(Control[i] < 0) << i;
+				return mask;
+			}
+#endif
+		};
+
+		// How a table stores its elements. Flat tables keep them in the slot array, node tables
+		// keep a pointer to a separate allocation so elements don't move when the table grows.
+		template<typename K, typename V>
+		struct FlatMapPolicy
+		{
+			using Key = K;
+			using Value = std::pair<const K, V>;
+			using Slot = Value;
+
+			static const K& GetKey(const Value& value) { return value.first; }
+			static Value& Get(Slot& slot) { return slot; }
+			static const Value& Get(const Slot& slot) { return slot; }
+
+			template<typename... Args>
+			static void Construct(Slot* slot, Args&&... args) { new (slot) Value(std::forward<Args>(args)...); }
+			static void Destroy(Slot* slot) { slot->~Value(); }
+			static void Transfer(Slot* destination, Slot* source)
+			{
+				// The key is moved out of an element that is destroyed right after
+				new (destination) Value(std::move(const_cast<K&>(source->first)), std::move(source->second));
+				source->~Value();
+			}
+		};
+
+		template<typename K, typename V>
+		struct NodeMapPolicy
+		{
+			using Key = K;
+			using Value = std::pair<const K, V>;
+			using Slot = Value*;
+
+			static const K& GetKey(const Value& value) { return value.first; }
+			static Value& Get(Slot& slot) { return *slot; }
+			static const Value& Get(const Slot& slot) { return *slot; }
+
+			template<typename... Args>
+			static void Construct(Slot* slot, Args&&... args) { *slot = new Value(std::forward<Args>(args)...); }
+			static void Destroy(Slot* slot) { delete *slot; }
+			static void Transfer(Slot* destination, Slot* source) { *destination = *source; }
+		};
+
+		template<typename K>
+		struct FlatSetPolicy
+		{
+			using Key = K;
+			using Value = K;
+			using Slot = K;
+
+			static const K& GetKey(const Value& value) { return value; }
+			static Value& Get(Slot& slot) { return slot; }
+			static const Value& Get(const Slot& slot) { return slot; }
+
+			template<typename... Args>
+			static void Construct(Slot* slot, Args&&... args) { new (slot) K(std::forward<Args>(args)...); }
+			static void Destroy(Slot* slot) { slot->~K(); }
+			static void Transfer(Slot* destination, Slot* source)
+			{
+				new (destination) K(std::move(*source));
+				source->~K();
+			}
+		};
+
+	}
+
+	// Open addressing hash table in the style of Swiss tables. Every slot has a control byte
+	// holding 7 bits of its key's hash; a lookup loads the control bytes of a group of 16 slots
+	// at once, compares all of them against the hash in a couple of instructions and only
+	// compares keys for the matches. Elements live in one array rather than a node each, so a
+	// lookup usually touches two cache lines. The table grows at 7/8 full.
+	// Inserting can move every element (not in node tables) and invalidates iterators; erasing
+	// only invalidates the erased element.
+	template<typename Policy, typename HashT, typename EqualT>
+	class HashTable
+	{
+		using ControlByte = HashTableDetail::ControlByte;
+		using Slot = typename Policy::Slot;
+		static constexpr size_t GroupWidth = HashTableDetail::GroupWidth;
+		static constexpr size_t NotFound = ~(size_t)0;
+	public:
+		using key_type = typename Policy::Key;
+		using value_type = typename Policy::Value;
+		using size_type = size_t;
+		using hasher = HashT;
+		using key_equal = EqualT;
+
+		template<bool IsConst>
+		class Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = typename Policy::Value;
+			using difference_type = ptrdiff_t;
+			using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+			using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+
+			Iterator() = default;
+			// Iterator to const iterator
+			template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+			Iterator(const Iterator<OtherConst>& other)
+				: m_Control(other.m_Control), m_Slot(other.m_Slot), m_End(other.m_End)
+			{
+			}
+
+			reference operator*() const { return Policy::Get(*m_Slot); }
+			pointer operator->() const { return &Policy::Get(*m_Slot); }
+
+			Iterator& operator++()
+			{
+				m_Control++;
+				m_Slot++;
+				SkipNonFull();
+				return *this;
+			}
+
+			Iterator operator++(int)
+			{
+				Iterator previous = *this;
+				++*this;
+				return previous;
+			}
+
+			bool operator==(const Iterator& other) const { return m_Slot == other.m_Slot; }
+			bool operator!=(const Iterator& other) const { return m_Slot != other.m_Slot; }
+		private:
+			Iterator(const ControlByte* control, Slot* slot, const ControlByte* end)
+				: m_Control(control), m_Slot(slot), m_End(end)
+			{
+			}
+
+			void SkipNonFull()
+			{
+				while (m_Control != m_End && *m_Control < 0)
+				{
+					m_Control++;
+					m_Slot++;
+				}
+			}
+		private:
+			const ControlByte* m_Control = nullptr;
+			Slot* m_Slot = nullptr;
+			const ControlByte* m_End = nullptr;
+
+			template<bool>
+			friend class Iterator;
+			friend class HashTable;
+		};
+
+		using iterator = Iterator<false>;
+		using const_iterator = Iterator<true>;
+
+		HashTable() = default;
+
+		HashTable(const HashTable& other)
+		{
+			reserve(other.m_Size);
+			for (const value_type& value : other)
+				InsertUnique(value);
+		}
+
+		HashTable(HashTable&& other) noexcept
+		{
+			Swap(other);
+		}
+
+		~HashTable()
+		{
+			DestroyAll();
+			Deallocate();
+		}
+
+		HashTable& operator=(const HashTable& other)
+		{
+			if (this != &other)
+			{
+				HashTable copy(other);
+				Swap(copy);
+			}
+			return *this;
+		}
+
+		HashTable& operator=(HashTable&& other) noexcept
+		{
+			if (this != &other)
+			{
+				HashTable moved(std::move(other));
+				Swap(moved);
+			}
+			return *this;
+		}
+
+		iterator begin()
+		{
+			iterator it(m_Control, m_Slots, m_Control + m_Capacity);
+			it.SkipNonFull();
+			return it;
+		}
+		iterator end() { return iterator(m_Control + m_Capacity, m_Slots + m_Capacity, m_Control + m_Capacity); }
+
+		const_iterator begin() const { return const_cast<HashTable*>(this)->begin(); }
+		const_iterator end() const { return const_cast<HashTable*>(this)->end(); }
+		const_iterator cbegin() const { return begin(); }
+		const_iterator cend() const { return end(); }
+
+		size_t size() const { return m_Size; }
+		bool empty() const { return m_Size == 0; }
+		size_t capacity() const { return m_Capacity; }
+
+		void clear()
+		{
+			DestroyAll();
+			if (m_Capacity)
+				memset(m_Control, HashTableDetail::Empty, m_Capacity);
+			m_Size = 0;
+			m_GrowthLeft = MaxLoad(m_Capacity);
+		}
+
+		// Makes room for count elements without growing
+		void reserve(size_t count)
+		{
+			size_t capacity = GroupWidth;
+			while (MaxLoad(capacity) < count)
+				capacity *= 2;
+			if (capacity > m_Capacity)
+				Rehash(capacity);
+		}
+
+		iterator find(const key_type& key) { return MakeIterator(FindIndex(key, HashOf(key))); }
+		const_iterator find(const key_type& key) const { return const_cast<HashTable*>(this)->find(key); }
+
+		template<typename Q, typename H = HashT, typename = typename H::is_transparent>
+		iterator find(const Q& key) { return MakeIterator(FindIndex(key, HashOf(key))); }
+		template<typename Q, typename H = HashT, typename = typename H::is_transparent>
+		const_iterator find(const Q& key) const { return const_cast<HashTable*>(this)->find(key); }
+
+		bool contains(const key_type& key) const { return FindIndex(key, HashOf(key)) != NotFound; }
+		template<typename Q, typename H = HashT, typename = typename H::is_transparent>
+		bool contains(const Q& key) const { return FindIndex(key, HashOf(key)) != NotFound; }
+
+		size_t count(const key_type& key) const { return contains(key) ? 1 : 0; }
+		template<typename Q, typename H = HashT, typename = typename H::is_transparent>
+		size_t count(const Q& key) const { return contains(key) ? 1 : 0; }
+
+		std::pair<iterator, bool> insert(const value_type& value)
+		{
+			auto [index, inserted] = FindOrPrepareInsert(Policy::GetKey(value));
+			if (inserted)
+				Policy::Construct(&m_Slots[index], value);
+			return { MakeIterator(index), inserted };
+		}
+
+		std::pair<iterator, bool> insert(value_type&& value)
+		{
+			auto [index, inserted] = FindOrPrepareInsert(Policy::GetKey(value));
+			if (inserted)
+				Policy::Construct(&m_Slots[index], std::move(value));
+			return { MakeIterator(index), inserted };
+		}
+
+		template<typename... Args>
+		std::pair<iterator, bool> emplace(Args&&... args)
+		{
+			// The key has to be known before there is a slot to build the element in
+			value_type value(std::forward<Args>(args)...);
+			return insert(std::move(value));
+		}
+
+		iterator erase(const_iterator position)
+		{
+			size_t index = position.m_Slot - m_Slots;
+			EraseIndex(index);
+			iterator next(m_Control + index, m_Slots + index, m_Control + m_Capacity);
+			next.SkipNonFull();
+			return next;
+		}
+
+		iterator erase(iterator position) { return erase(const_iterator(position)); }
+
+		size_t erase(const key_type& key)
+		{
+			size_t index = FindIndex(key, HashOf(key));
+			if (index == NotFound)
+				return 0;
+
+			EraseIndex(index);
+			return 1;
+		}
+	protected:
+		template<typename Q>
+		uint64_t HashOf(const Q& key) const
+		{
+			return HashTableDetail::Mix((uint64_t)HashT()(key));
+		}
+
+		static ControlByte H2(uint64_t hash) { return (ControlByte)(hash & 0x7f); }
+		static size_t MaxLoad(size_t capacity) { return capacity - capacity / 8; }
+
+		iterator MakeIterator(size_t index)
+		{
+			if (index == NotFound)
+				return end();
+
+			return iterator(m_Control + index, m_Slots + index, m_Control + m_Capacity);
+		}
+
+		// Groups are probed in a quadratic sequence, which visits every group as the group
+		// count is a power of two. The table never fills up, so a lookup always reaches an
+		// empty slot.
+		template<typename Q>
+		size_t FindIndex(const Q& key, uint64_t hash) const
+		{
+			if (m_Capacity == 0)
+				return NotFound;
+
+			size_t groupMask = m_Capacity / GroupWidth - 1;
+			size_t group = (size_t)(hash >> 7) & groupMask;
+			ControlByte h2 = H2(hash);
+			for (size_t step = 1; ; step++)
+			{
+				size_t first = group * GroupWidth;
+				HashTableDetail::Group controls(m_Control + first);
+				for (uint32_t mask = controls.Match(h2); mask; mask &= mask - 1)
+				{
+					size_t index = first + HashTableDetail::LowestBit(mask);
+					if (EqualT()(Policy::GetKey(Policy::Get(m_Slots[index])), key))
+						return index;
+				}
+
+				if (controls.MatchEmpty())
+					return NotFound;
+
+				group = (group + step) & groupMask;
+			}
+		}
+
+		// First empty or deleted slot on the key's probe sequence
+		size_t FindInsertIndex(uint64_t hash) const
+		{
+			size_t groupMask = m_Capacity / GroupWidth - 1;
+			size_t group = (size_t)(hash >> 7) & groupMask;
+			for (size_t step = 1; ; step++)
+			{
+				HashTableDetail::Group controls(m_Control + group * GroupWidth);
+				if (uint32_t mask = controls.MatchNonFull())
+					return group * GroupWidth + HashTableDetail::LowestBit(mask);
+
+				group = (group + step) & groupMask;
+			}
+		}
+
+		// Returns the slot holding the key, or claims a slot for it that the caller must construct
+		template<typename Q>
+		std::pair<size_t, bool> FindOrPrepareInsert(const Q& key)
+		{
+			uint64_t hash = HashOf(key);
+			size_t index = FindIndex(key, hash);
+			if (index != NotFound)
+				return { index, false };
+
+			if (m_Capacity == 0)
+				Rehash(GroupWidth);
+
+			index = FindInsertIndex(hash);
+			if (m_GrowthLeft == 0 && m_Control[index] == HashTableDetail::Empty)
+			{
+				// Mostly deleted slots? Then rehashing in place reclaims them
+				Rehash(m_Size < MaxLoad(m_Capacity) / 2 ? m_Capacity : m_Capacity * 2);
+				index = FindInsertIndex(hash);
+			}
+
+			if (m_Control[index] == HashTableDetail::Empty)
+				m_GrowthLeft--;
+			m_Control[index] = H2(hash);
+			m_Size++;
+			return { index, true };
+		}
+
+		void InsertUnique(const value_type& value)
+		{
+			size_t index = FindOrPrepareInsert(Policy::GetKey(value)).first;
+			Policy::Construct(&m_Slots[index], value);
+		}
+
+		void EraseIndex(size_t index)
+		{
+			Policy::Destroy(&m_Slots[index]);
+			m_Size--;
+
+			// Lookups stop at a group with an empty slot, so if this group has one already no
+			// probe sequence continues past it and the slot can become empty too. Otherwise it
+			// has to stay marked, or keys further along would no longer be found.
+			size_t first = index / GroupWidth * GroupWidth;
+			if (HashTableDetail::Group(m_Control + first).MatchEmpty())
+			{
+				m_Control[index] = HashTableDetail::Empty;
+				m_GrowthLeft++;
+			}
+			else
+			{
+				m_Control[index] = HashTableDetail::Deleted;
+			}
+		}
+
+		void Rehash(size_t capacity)
+		{
+			ControlByte* oldControl = m_Control;
+			Slot* oldSlots = m_Slots;
+			size_t oldCapacity = m_Capacity;
+
+			Allocate(capacity);
+			for (size_t i = 0; i < oldCapacity; i++)
+			{
+				if (oldControl[i] < 0)
+					continue;
+
+				uint64_t hash = HashOf(Policy::GetKey(Policy::Get(oldSlots[i])));
+				size_t index = FindInsertIndex(hash);
+				m_Control[index] = H2(hash);
+				Policy::Transfer(&m_Slots[index], &oldSlots[i]);
+			}
+			m_GrowthLeft = MaxLoad(m_Capacity) - m_Size;
+
+			if (oldControl)
+				::operator delete(oldControl, std::align_val_t(Alignment));
+		}
+
+		// Control bytes and slots share one allocation, control bytes first
+		static constexpr size_t Alignment = alignof(Slot) > GroupWidth ? alignof(Slot) : GroupWidth;
+
+		void Allocate(size_t capacity)
+		{
+			size_t slotOffset = (capacity + alignof(Slot) - 1) & ~(alignof(Slot) - 1);
+			uint8_t* memory = (uint8_t*)::operator new(slotOffset + capacity * sizeof(Slot), std::align_val_t(Alignment));
+			m_Control = (ControlByte*)memory;
+			m_Slots = (Slot*)(memory + slotOffset);
+			m_Capacity = capacity;
+			memset(m_Control, HashTableDetail::Empty, capacity);
+		}
+
+		void Deallocate()
+		{
+			if (m_Control)
+				::operator delete(m_Control, std::align_val_t(Alignment));
+			m_Control = nullptr;
+			m_Slots = nullptr;
+			m_Capacity = 0;
+			m_GrowthLeft = 0;
+		}
+
+		void DestroyAll()
+		{
+			if (m_Size == 0)
+				return;
+
+			for (size_t i = 0; i < m_Capacity; i++)
+			{
+				if (m_Control[i] >= 0)
+					Policy::Destroy(&m_Slots[i]);
+			}
+		}
+
+		void Swap(HashTable& other)
+		{
+			std::swap(m_Control, other.m_Control);
+			std::swap(m_Slots, other.m_Slots);
+			std::swap(m_Capacity, other.m_Capacity);
+			std::swap(m_Size, other.m_Size);
+			std::swap(m_GrowthLeft, other.m_GrowthLeft);
+		}
+	protected:
+		ControlByte* m_Control = nullptr;
+		Slot* m_Slots = nullptr;
+		size_t m_Capacity = 0;
+		size_t m_Size = 0;
+		// Empty slots that can still be used before the table has to grow
+		size_t m_GrowthLeft = 0;
+	};
+
+	// Hash table keyed map, a drop-in replacement for std::unordered_map where pointers to the
+	// elements don't need to stay valid across inserts
+	template<typename K, typename V, typename HashT = Hash<K>, typename EqualT = std::equal_to<>>
+	class HashMap : public HashTable<HashTableDetail::FlatMapPolicy<K, V>, HashT, EqualT>
+	{
+		using Base = HashTable<HashTableDetail::FlatMapPolicy<K, V>, HashT, EqualT>;
+	public:
+		using mapped_type = V;
+		using Base::Base;
+
+		template<typename... Args>
+		std::pair<typename Base::iterator, bool> try_emplace(const K& key, Args&&... args)
+		{
+			auto [index, inserted] = this->FindOrPrepareInsert(key);
+			if (inserted)
+				HashTableDetail::FlatMapPolicy<K, V>::Construct(&this->m_Slots[index], std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+			return { this->MakeIterator(index), inserted };
+		}
+
+		template<typename... Args>
+		std::pair<typename Base::iterator, bool> try_emplace(K&& key, Args&&... args)
+		{
+			auto [index, inserted] = this->FindOrPrepareInsert(key);
+			if (inserted)
+				HashTableDetail::FlatMapPolicy<K, V>::Construct(&this->m_Slots[index], std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+			return { this->MakeIterator(index), inserted };
+		}
+
+		V& operator[](const K& key) { return try_emplace(key).first->second; }
+		V& operator[](K&& key) { return try_emplace(std::move(key)).first->second; }
+
+		template<typename Q>
+		V& at(const Q& key)
+		{
+			auto it = this->find(key);
+			HZ_CORE_ASSERT(it != this->end(), "Key not found!");
+			return it->second;
+		}
+
+		template<typename Q>
+		const V& at(const Q& key) const
+		{
+			auto it = this->find(key);
+			HZ_CORE_ASSERT(it != this->end(), "Key not found!");
+			return it->second;
+		}
+	};
+
+	// As HashMap, but every element has its own allocation: elements never move, so pointers
+	// and references to them stay valid until they are erased. Lookups are still probed
+	// through the control bytes and only dereference the matches.
+	template<typename K, typename V, typename HashT = Hash<K>, typename EqualT = std::equal_to<>>
+	class NodeHashMap : public HashTable<HashTableDetail::NodeMapPolicy<K, V>, HashT, EqualT>
+	{
+		using Base = HashTable<HashTableDetail::NodeMapPolicy<K, V>, HashT, EqualT>;
+	public:
+		using mapped_type = V;
+		using Base::Base;
+
+		template<typename... Args>
+		std::pair<typename Base::iterator, bool> try_emplace(const K& key, Args&&... args)
+		{
+			auto [index, inserted] = this->FindOrPrepareInsert(key);
+			if (inserted)
+				HashTableDetail::NodeMapPolicy<K, V>::Construct(&this->m_Slots[index], std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+			return { this->MakeIterator(index), inserted };
+		}
+
+		template<typename... Args>
+		std::pair<typename Base::iterator, bool> try_emplace(K&& key, Args&&... args)
+		{
+			auto [index, inserted] = this->FindOrPrepareInsert(key);
+			if (inserted)
+				HashTableDetail::NodeMapPolicy<K, V>::Construct(&this->m_Slots[index], std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+			return { this->MakeIterator(index), inserted };
+		}
+
+		V& operator[](const K& key) { return try_emplace(key).first->second; }
+		V& operator[](K&& key) { return try_emplace(std::move(key)).first->second; }
+
+		template<typename Q>
+		V& at(const Q& key)
+		{
+			auto it = this->find(key);
+			HZ_CORE_ASSERT(it != this->end(), "Key not found!");
+			return it->second;
+		}
+
+		template<typename Q>
+		const V& at(const Q& key) const
+		{
+			auto it = this->find(key);
+			HZ_CORE_ASSERT(it != this->end(), "Key not found!");
+			return it->second;
+		}
+	};
+
+	template<typename K, typename HashT = Hash<K>, typename EqualT = std::equal_to<>>
+	class HashSet : public HashTable<HashTableDetail::FlatSetPolicy<K>, HashT, EqualT>
+	{
+		using Base = HashTable<HashTableDetail::FlatSetPolicy<K>, HashT, EqualT>;
+	public:
+		using Base::Base;
+	};
+
+}
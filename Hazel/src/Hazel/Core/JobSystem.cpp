@@ -0,0 +1,313 @@
+#include "hzpch.h"
+#include "JobSystem.h"
+
+#include "Profiler.h"
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace Hazel {
+
+	struct JobEntry
+	{
+		Job Function;
+		JobCounter* Counter = nullptr;
+	};
+
+	struct JobQueue
+	{
+		std::mutex Mutex;
+		std::deque<JobEntry> Jobs;
+	};
+
+	struct JobSystemData
+	{
+		std::vector<std::thread> Workers;
+		std::vector<Scope<JobQueue>> WorkerQueues;
+		JobQueue SharedQueue;
+		JobQueue MainThreadQueue;
+
+		// Jobs in the shared and worker queues, so idle workers know when to wake up
+		std::atomic<uint32_t> QueuedCount = 0;
+		std::mutex SleepMutex;
+		std::condition_variable SleepCondition;
+
+		std::atomic<bool> Running = false;
+		std::thread::id MainThreadID;
+	};
+
+	static JobSystemData s_Data;
+
+	static thread_local uint32_t t_ThreadIndex = 0;
+
+	static void Execute(JobEntry& entry);
+
+	static void Schedule(JobEntry&& entry)
+	{
+		if (!s_Data.Running)
+		{
+			Execute(entry);
+			return;
+		}
+
+		// Workers keep what they spawn on their own deque, which is likely still in cache
+		JobQueue& queue = t_ThreadIndex > 0 ? *s_Data.WorkerQueues[t_ThreadIndex - 1] : s_Data.SharedQueue;
+		{
+			std::scoped_lock<std::mutex> lock(queue.Mutex);
+			queue.Jobs.push_back(std::move(entry));
+		}
+		s_Data.QueuedCount.fetch_add(1, std::memory_order_release);
+
+		// Taking the lock orders this against a worker checking QueuedCount before going to sleep
+		{
+			std::scoped_lock<std::mutex> lock(s_Data.SleepMutex);
+		}
+		s_Data.SleepCondition.notify_one();
+	}
+
+	// Called once per job with a counter. The decrement happens under the lock, and Wait takes the lock once it sees zero, so a
+	// counter is never touched again after a waiter has been let go and may have destroyed it
+	void FinishJob(JobCounter* counter)
+	{
+		std::vector<std::pair<Job, JobCounter*>> waiting;
+		{
+			std::scoped_lock<std::mutex> lock(counter->m_WaitingMutex);
+			if (counter->m_Count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				return;
+
+			waiting.swap(counter->m_Waiting);
+		}
+		for (auto& [job, jobCounter] : waiting)
+			Schedule({ std::move(job), jobCounter });
+	}
+
+	static void Execute(JobEntry& entry)
+	{
+		{
+			HZ_PROFILE_SCOPE("Job");
+			entry.Function();
+		}
+		if (entry.Counter)
+			FinishJob(entry.Counter);
+	}
+
+	static bool PopFront(JobQueue& queue, JobEntry& outEntry)
+	{
+		std::scoped_lock<std::mutex> lock(queue.Mutex);
+		if (queue.Jobs.empty())
+			return false;
+
+		outEntry = std::move(queue.Jobs.front());
+		queue.Jobs.pop_front();
+		return true;
+	}
+
+	static bool PopBack(JobQueue& queue, JobEntry& outEntry)
+	{
+		std::scoped_lock<std::mutex> lock(queue.Mutex);
+		if (queue.Jobs.empty())
+			return false;
+
+		outEntry = std::move(queue.Jobs.back());
+		queue.Jobs.pop_back();
+		return true;
+	}
+
+	// Own deque newest first, then the shared queue, then the oldest job of another worker
+	static bool TryRunJob()
+	{
+		if (s_Data.QueuedCount.load(std::memory_order_acquire) == 0)
+			return false;
+
+		JobEntry entry;
+		uint32_t workerCount = (uint32_t)s_Data.WorkerQueues.size();
+		bool found = t_ThreadIndex > 0 && PopBack(*s_Data.WorkerQueues[t_ThreadIndex - 1], entry);
+		if (!found)
+			found = PopFront(s_Data.SharedQueue, entry);
+		for (uint32_t i = 0; i < workerCount && !found; i++)
+		{
+			uint32_t victim = (t_ThreadIndex + i) % workerCount;
+			if (victim + 1 != t_ThreadIndex)
+				found = PopFront(*s_Data.WorkerQueues[victim], entry);
+		}
+
+		if (!found)
+			return false;
+
+		s_Data.QueuedCount.fetch_sub(1, std::memory_order_acq_rel);
+		Execute(entry);
+		return true;
+	}
+
+	static bool TryRunMainThreadJob()
+	{
+		JobEntry entry;
+		if (!PopFront(s_Data.MainThreadQueue, entry))
+			return false;
+
+		Execute(entry);
+		return true;
+	}
+
+	static void WorkerThread(uint32_t index)
+	{
+		t_ThreadIndex = index;
+
+		// Shows up in the debugger and in profiler captures
+		std::wstring name = L"Hazel Worker " + std::to_wstring(index);
+		SetThreadDescription(GetCurrentThread(), name.c_str());
+		HZ_PROFILE_THREAD("Hazel Worker");
+
+		while (s_Data.Running)
+		{
+			if (TryRunJob())
+				continue;
+
+			std::unique_lock<std::mutex> lock(s_Data.SleepMutex);
+			s_Data.SleepCondition.wait(lock, []() { return !s_Data.Running || s_Data.QueuedCount.load(std::memory_order_acquire) > 0; });
+		}
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		HZ_CORE_ASSERT(!s_Data.Running, "Job system is already running!");
+
+		if (workerCount == 0)
+			workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		s_Data.MainThreadID = std::this_thread::get_id();
+		for (uint32_t i = 0; i < workerCount; i++)
+			s_Data.WorkerQueues.push_back(CreateScope<JobQueue>());
+
+		s_Data.Running = true;
+		for (uint32_t i = 0; i < workerCount; i++)
+			s_Data.Workers.emplace_back(WorkerThread, i + 1);
+
+		HZ_CORE_INFO("JobSystem: {0} worker threads", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		{
+			std::scoped_lock<std::mutex> lock(s_Data.SleepMutex);
+			s_Data.Running = false;
+		}
+		s_Data.SleepCondition.notify_all();
+		for (auto& worker : s_Data.Workers)
+			worker.join();
+		s_Data.Workers.clear();
+
+		// Jobs still queued are dropped, and their counters never reach zero
+		s_Data.WorkerQueues.clear();
+		s_Data.SharedQueue.Jobs.clear();
+		s_Data.MainThreadQueue.Jobs.clear();
+		s_Data.QueuedCount = 0;
+	}
+
+	void JobSystem::Submit(Job job, JobCounter* counter, JobCounter* dependency)
+	{
+		if (counter)
+			counter->m_Count.fetch_add(1, std::memory_order_acq_rel);
+
+		if (dependency)
+		{
+			// Checked under the lock, so a job can't be added after FinishJob has taken the list
+			std::scoped_lock<std::mutex> lock(dependency->m_WaitingMutex);
+			if (!dependency->IsDone())
+			{
+				dependency->m_Waiting.push_back({ std::move(job), counter });
+				return;
+			}
+		}
+
+		Schedule({ std::move(job), counter });
+	}
+
+	void JobSystem::SubmitMainThread(Job job, JobCounter* counter)
+	{
+		if (counter)
+			counter->m_Count.fetch_add(1, std::memory_order_acq_rel);
+
+		JobEntry entry = { std::move(job), counter };
+		if (!s_Data.Running)
+		{
+			Execute(entry);
+			return;
+		}
+
+		std::scoped_lock<std::mutex> lock(s_Data.MainThreadQueue.Mutex);
+		s_Data.MainThreadQueue.Jobs.push_back(std::move(entry));
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		bool mainThread = IsMainThread();
+		while (!counter.IsDone())
+		{
+			if (TryRunJob())
+				continue;
+			if (mainThread && TryRunMainThreadJob())
+				continue;
+
+			std::this_thread::yield();
+		}
+
+		// Wait for the job that finished the counter to let go of it
+		std::scoped_lock<std::mutex> lock(counter.m_WaitingMutex);
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& func)
+	{
+		if (count == 0)
+			return;
+
+		grainSize = std::max(grainSize, 1u);
+		if (count <= grainSize || !s_Data.Running)
+		{
+			func(0, count);
+			return;
+		}
+
+		JobCounter counter;
+		for (uint32_t begin = grainSize; begin < count; begin += grainSize)
+		{
+			uint32_t end = std::min(begin + grainSize, count);
+			Submit([&func, begin, end]() { func(begin, end); }, &counter);
+		}
+
+		func(0, grainSize);
+		Wait(counter);
+	}
+
+	void JobSystem::Update()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		// Jobs these submit wait for the next frame
+		size_t count;
+		{
+			std::scoped_lock<std::mutex> lock(s_Data.MainThreadQueue.Mutex);
+			count = s_Data.MainThreadQueue.Jobs.size();
+		}
+
+		for (size_t i = 0; i < count && TryRunMainThreadJob(); i++)
+			;
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return (uint32_t)s_Data.Workers.size();
+	}
+
+	uint32_t JobSystem::GetThreadIndex()
+	{
+		return t_ThreadIndex;
+	}
+
+	bool JobSystem::IsMainThread()
+	{
+		return std::this_thread::get_id() == s_Data.MainThreadID;
+	}
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Hazel {
+
+	using Job = std::function<void()>;
+
+	// Counts unfinished jobs. Submitting against a counter increments it and the job finishing
+	// decrements it; jobs can be made to wait for a counter to reach zero, and so can threads,
+	// which run other jobs while they wait. A counter must outlive the jobs using it, so Wait on
+	// it before destroying it, and should only be reused once it has reached zero.
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		bool IsDone() const { return m_Count.load(std::memory_order_acquire) == 0; }
+		uint32_t GetCount() const { return m_Count.load(std::memory_order_acquire); }
+	private:
+		std::atomic<uint32_t> m_Count = 0;
+
+		// Jobs submitted with this counter as their dependency before it reached zero, with their own counters
+		std::mutex m_WaitingMutex;
+		std::vector<std::pair<Job, JobCounter*>> m_Waiting;
+
+		friend class JobSystem;
+		friend void FinishJob(JobCounter* counter);
+	};
+
+	// Work-stealing thread pool. Every worker has its own deque: jobs a worker submits go on the
+	// back of its deque and it takes work from there too, while idle workers steal from the front
+	// of the others'. Jobs from other threads go through a shared queue. Main thread jobs are
+	// run once per frame by the application, for work that must touch main thread state
+	// (anything ref counted, the renderer).
+	// Without Init every job runs inline on the submitting thread, so code using the job
+	// system still works in tools and tests that never start it.
+	class JobSystem
+	{
+	public:
+		// 0 picks one worker per hardware thread, leaving one for the main thread
+		static void Init(uint32_t workerCount = 0);
+		static void Shutdown();
+
+		static void Submit(Job job, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+		static void SubmitMainThread(Job job, JobCounter* counter = nullptr);
+
+		// Runs jobs until the counter reaches zero. On the main thread this includes main thread jobs.
+		static void Wait(JobCounter& counter);
+
+		// Splits [0, count) into ranges of at most grainSize and calls func(begin, end) for each,
+		// returning once all are done. The calling thread takes part.
+		static void ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& func);
+
+		// Called once per frame by the application
+		static void Update();
+
+		static uint32_t GetWorkerCount();
+		// 0 for the main thread (and any other thread outside the pool), 1 + index for workers
+		static uint32_t GetThreadIndex();
+		static bool IsMainThread();
+	};
+
+}
@@ -14,7 +14,47 @@ namespace Hazel {
 		AABB(const glm::vec3& min, const glm::vec3& max)
 			: Min(min), Max(max) {}
 
+		glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+		glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+		float GetSurfaceArea() const
+		{
+			glm::vec3 size = Max - Min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		bool Contains(const AABB& other) const
+		{
+			return glm::all(glm::lessThanEqual(Min, other.Min)) && glm::all(glm::greaterThanEqual(Max, other.Max));
+		}
+
+		bool Overlaps(const AABB& other) const
+		{
+			return glm::all(glm::lessThanEqual(Min, other.Max)) && glm::all(glm::greaterThanEqual(Max, other.Min));
+		}
+
+		// Squared distance from a point to the box (0 if the point is inside)
+		float DistanceSquared(const glm::vec3& point) const
+		{
+			glm::vec3 delta = glm::max(glm::max(Min - point, point - Max), glm::vec3(0.0f));
+			return glm::dot(delta, delta);
+		}
+
+		static AABB Union(const AABB& a, const AABB& b)
+		{
+			return AABB(glm::min(a.Min, b.Min), glm::max(a.Max, b.Max));
+		}
+
+		// Bounds of this box after an affine transform (Arvo's method)
+		AABB Transform(const glm::mat4& transform) const
+		{
+			glm::vec3 center = transform * glm::vec4(GetCenter(), 1.0f);
+			glm::vec3 extents = GetExtents();
+			glm::mat3 absolute = glm::mat3(glm::abs(transform[0]), glm::abs(transform[1]), glm::abs(transform[2]));
+			glm::vec3 newExtents = absolute * extents;
+			return AABB(center - newExtents, center + newExtents);
+		}
 	};
 
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,279 @@
+#include "hzpch.h"
+#include "DynamicAABBTree.h"
+
+namespace Hazel {
+
+	DynamicAABBTree::DynamicAABBTree(float margin)
+		: m_Margin(margin)
+	{
+	}
+
+	int32_t DynamicAABBTree::AllocateNode()
+	{
+		if (m_FreeList == NullNode)
+		{
+			m_Nodes.emplace_back();
+			m_FreeList = (int32_t)m_Nodes.size() - 1;
+		}
+
+		int32_t nodeID = m_FreeList;
+		Node& node = m_Nodes[nodeID];
+		m_FreeList = node.Parent;
+		node.Parent = NullNode;
+		node.Child1 = NullNode;
+		node.Child2 = NullNode;
+		node.Height = 0;
+		node.UserData = 0;
+		return nodeID;
+	}
+
+	void DynamicAABBTree::FreeNode(int32_t nodeID)
+	{
+		Node& node = m_Nodes[nodeID];
+		node.Parent = m_FreeList;
+		node.Height = -1;
+		m_FreeList = nodeID;
+	}
+
+	int32_t DynamicAABBTree::CreateProxy(const AABB& aabb, uint32_t userData)
+	{
+		int32_t proxyID = AllocateNode();
+		Node& node = m_Nodes[proxyID];
+		node.Bounds = AABB(aabb.Min - glm::vec3(m_Margin), aabb.Max + glm::vec3(m_Margin));
+		node.UserData = userData;
+
+		InsertLeaf(proxyID);
+		m_ProxyCount++;
+		return proxyID;
+	}
+
+	void DynamicAABBTree::DestroyProxy(int32_t proxyID)
+	{
+		HZ_CORE_ASSERT(proxyID >= 0 && proxyID < (int32_t)m_Nodes.size() && m_Nodes[proxyID].IsLeaf());
+
+		RemoveLeaf(proxyID);
+		FreeNode(proxyID);
+		m_ProxyCount--;
+	}
+
+	bool DynamicAABBTree::MoveProxy(int32_t proxyID, const AABB& aabb)
+	{
+		HZ_CORE_ASSERT(proxyID >= 0 && proxyID < (int32_t)m_Nodes.size() && m_Nodes[proxyID].IsLeaf());
+
+		if (m_Nodes[proxyID].Bounds.Contains(aabb))
+			return false;
+
+		RemoveLeaf(proxyID);
+		m_Nodes[proxyID].Bounds = AABB(aabb.Min - glm::vec3(m_Margin), aabb.Max + glm::vec3(m_Margin));
+		InsertLeaf(proxyID);
+		return true;
+	}
+
+	void DynamicAABBTree::Clear()
+	{
+		m_Nodes.clear();
+		m_Root = NullNode;
+		m_FreeList = NullNode;
+		m_ProxyCount = 0;
+	}
+
+	void DynamicAABBTree::InsertLeaf(int32_t leaf)
+	{
+		if (m_Root == NullNode)
+		{
+			m_Root = leaf;
+			m_Nodes[m_Root].Parent = NullNode;
+			return;
+		}
+
+		// Find the best sibling using the surface area heuristic
+		AABB leafBounds = m_Nodes[leaf].Bounds;
+		int32_t index = m_Root;
+		while (!m_Nodes[index].IsLeaf())
+		{
+			const Node& node = m_Nodes[index];
+			int32_t child1 = node.Child1;
+			int32_t child2 = node.Child2;
+
+			float area = node.Bounds.GetSurfaceArea();
+			float combinedArea = AABB::Union(node.Bounds, leafBounds).GetSurfaceArea();
+
+			// Cost of creating a new parent for this node and the new leaf
+			float cost = 2.0f * combinedArea;
+
+			// Minimum cost of pushing the leaf further down the tree
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto descendCost = [&](int32_t child)
+			{
+				const Node& childNode = m_Nodes[child];
+				float unionArea = AABB::Union(leafBounds, childNode.Bounds).GetSurfaceArea();
+				if (childNode.IsLeaf())
+					return unionArea + inheritanceCost;
+
+				return (unionArea - childNode.Bounds.GetSurfaceArea()) + inheritanceCost;
+			};
+
+			float cost1 = descendCost(child1);
+			float cost2 = descendCost(child2);
+
+			if (cost < cost1 && cost < cost2)
+				break;
+
+			index = cost1 < cost2 ? child1 : child2;
+		}
+
+		int32_t sibling = index;
+
+		// Create a new parent
+		int32_t oldParent = m_Nodes[sibling].Parent;
+		int32_t newParent = AllocateNode();
+		m_Nodes[newParent].Parent = oldParent;
+		m_Nodes[newParent].Bounds = AABB::Union(leafBounds, m_Nodes[sibling].Bounds);
+		m_Nodes[newParent].Height = m_Nodes[sibling].Height + 1;
+		m_Nodes[newParent].Child1 = sibling;
+		m_Nodes[newParent].Child2 = leaf;
+		m_Nodes[sibling].Parent = newParent;
+		m_Nodes[leaf].Parent = newParent;
+
+		if (oldParent != NullNode)
+		{
+			if (m_Nodes[oldParent].Child1 == sibling)
+				m_Nodes[oldParent].Child1 = newParent;
+			else
+				m_Nodes[oldParent].Child2 = newParent;
+		}
+		else
+		{
+			m_Root = newParent;
+		}
+
+		RefitAncestors(m_Nodes[leaf].Parent);
+	}
+
+	void DynamicAABBTree::RemoveLeaf(int32_t leaf)
+	{
+		if (leaf == m_Root)
+		{
+			m_Root = NullNode;
+			return;
+		}
+
+		int32_t parent = m_Nodes[leaf].Parent;
+		int32_t grandParent = m_Nodes[parent].Parent;
+		int32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+		if (grandParent != NullNode)
+		{
+			// Connect the sibling to the grandparent and discard the parent
+			if (m_Nodes[grandParent].Child1 == parent)
+				m_Nodes[grandParent].Child1 = sibling;
+			else
+				m_Nodes[grandParent].Child2 = sibling;
+
+			m_Nodes[sibling].Parent = grandParent;
+			FreeNode(parent);
+
+			RefitAncestors(grandParent);
+		}
+		else
+		{
+			m_Root = sibling;
+			m_Nodes[sibling].Parent = NullNode;
+			FreeNode(parent);
+		}
+	}
+
+	void DynamicAABBTree::RefitAncestors(int32_t nodeID)
+	{
+		while (nodeID != NullNode)
+		{
+			nodeID = Balance(nodeID);
+
+			Node& node = m_Nodes[nodeID];
+			const Node& child1 = m_Nodes[node.Child1];
+			const Node& child2 = m_Nodes[node.Child2];
+			node.Height = 1 + glm::max(child1.Height, child2.Height);
+			node.Bounds = AABB::Union(child1.Bounds, child2.Bounds);
+
+			nodeID = node.Parent;
+		}
+	}
+
+	// Performs a left or right rotation if node A is imbalanced. Returns the new subtree root.
+	int32_t DynamicAABBTree::Balance(int32_t iA)
+	{
+		Node& A = m_Nodes[iA];
+		if (A.IsLeaf() || A.Height < 2)
+			return iA;
+
+		int32_t iB = A.Child1;
+		int32_t iC = A.Child2;
+		Node& B = m_Nodes[iB];
+		Node& C = m_Nodes[iC];
+
+		int32_t balance = C.Height - B.Height;
+
+		auto rotate = [&](int32_t iUp, int32_t iOther, bool upIsChild2)
+		{
+			// iUp is promoted to replace A, A takes the place of one of iUp's children
+			Node& up = m_Nodes[iUp];
+			int32_t iF = up.Child1;
+			int32_t iG = up.Child2;
+			Node& F = m_Nodes[iF];
+			Node& G = m_Nodes[iG];
+
+			up.Child1 = iA;
+			up.Parent = A.Parent;
+			A.Parent = iUp;
+
+			if (up.Parent != NullNode)
+			{
+				if (m_Nodes[up.Parent].Child1 == iA)
+					m_Nodes[up.Parent].Child1 = iUp;
+				else
+					m_Nodes[up.Parent].Child2 = iUp;
+			}
+			else
+			{
+				m_Root = iUp;
+			}
+
+			const Node& other = m_Nodes[iOther];
+			int32_t iKeep = F.Height > G.Height ? iF : iG;
+			int32_t iGive = F.Height > G.Height ? iG : iF;
+			Node& keep = m_Nodes[iKeep];
+			Node& give = m_Nodes[iGive];
+
+			up.Child2 = iKeep;
+			if (upIsChild2)
+				A.Child2 = iGive;
+			else
+				A.Child1 = iGive;
+			give.Parent = iA;
+
+			A.Bounds = AABB::Union(other.Bounds, give.Bounds);
+			up.Bounds = AABB::Union(A.Bounds, keep.Bounds);
+
+			A.Height = 1 + glm::max(other.Height, give.Height);
+			up.Height = 1 + glm::max(A.Height, keep.Height);
+		};
+
+		// Rotate C up
+		if (balance > 1)
+		{
+			rotate(iC, iB, true);
+			return iC;
+		}
+
+		// Rotate B up
+		if (balance < -1)
+		{
+			rotate(iB, iC, false);
+			return iB;
+		}
+
+		return iA;
+	}
+
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <limits>
+
+#include "AABB.h"
+#include "Ray.h"
+
+namespace Hazel {
+
+	// Incrementally updated bounding volume hierarchy over moving objects.
+	// Leaves store "fat" AABBs (enlarged by a margin) so small movements don't
+	// touch the tree at all; when an object leaves its fat AABB it is reinserted
+	// and the path to the root is refitted and rebalanced with tree rotations.
+	class DynamicAABBTree
+	{
+	public:
+		static constexpr int32_t NullNode = -1;
+		static constexpr uint32_t MaxQueryStackSize = 256;
+
+		DynamicAABBTree(float margin = 0.1f);
+
+		int32_t CreateProxy(const AABB& aabb, uint32_t userData);
+		void DestroyProxy(int32_t proxyID);
+		// Returns true if the proxy had to be reinserted
+		bool MoveProxy(int32_t proxyID, const AABB& aabb);
+		void Clear();
+
+		uint32_t GetUserData(int32_t proxyID) const { return m_Nodes[proxyID].UserData; }
+		const AABB& GetFatAABB(int32_t proxyID) const { return m_Nodes[proxyID].Bounds; }
+
+		uint32_t GetProxyCount() const { return m_ProxyCount; }
+		int32_t GetHeight() const { return m_Root == NullNode ? 0 : m_Nodes[m_Root].Height; }
+
+		// Visits every proxy whose fat AABB passes nodeTest. callback(proxyID) returns false to stop.
+		template<typename NodeTest, typename Callback>
+		void Query(NodeTest nodeTest, Callback callback) const
+		{
+			if (m_Root == NullNode)
+				return;
+
+			int32_t stack[MaxQueryStackSize];
+			uint32_t stackSize = 0;
+			stack[stackSize++] = m_Root;
+			while (stackSize > 0)
+			{
+				int32_t nodeID = stack[--stackSize];
+
+				const Node& node = m_Nodes[nodeID];
+				if (!nodeTest(node.Bounds))
+					continue;
+
+				if (node.IsLeaf())
+				{
+					if (!callback(nodeID))
+						return;
+				}
+				else
+				{
+					HZ_CORE_ASSERT(stackSize + 2 <= MaxQueryStackSize, "DynamicAABBTree query stack overflow!");
+					stack[stackSize++] = node.Child1;
+					stack[stackSize++] = node.Child2;
+				}
+			}
+		}
+
+		template<typename Callback>
+		void QueryAABB(const AABB& aabb, Callback callback) const
+		{
+			Query([&aabb](const AABB& bounds) { return bounds.Overlaps(aabb); }, callback);
+		}
+
+		// callback(proxyID, maxDistance) returns the new max distance: the hit distance to clip
+		// the ray, maxDistance to ignore the proxy, or 0 to terminate.
+		template<typename Callback>
+		void Raycast(const Ray& ray, float maxDistance, Callback callback) const
+		{
+			glm::vec3 inverseDirection = 1.0f / ray.Direction;
+			auto nodeTest = [&](const AABB& bounds)
+			{
+				glm::vec3 t0 = (bounds.Min - ray.Origin) * inverseDirection;
+				glm::vec3 t1 = (bounds.Max - ray.Origin) * inverseDirection;
+				glm::vec3 tmin = glm::min(t0, t1);
+				glm::vec3 tmax = glm::max(t0, t1);
+				float tnear = glm::max(glm::max(tmin.x, tmin.y), glm::max(tmin.z, 0.0f));
+				float tfar = glm::min(glm::min(tmax.x, tmax.y), glm::min(tmax.z, maxDistance));
+				return tnear <= tfar;
+			};
+
+			Query(nodeTest, [&](int32_t proxyID)
+			{
+				maxDistance = callback(proxyID, maxDistance);
+				return maxDistance > 0.0f;
+			});
+		}
+
+		// Best-first search for the count proxies closest to point. distance(proxyID) returns the
+		// exact squared distance for a proxy and must not be less than the distance to its fat AABB.
+		template<typename Distance>
+		void QueryNearest(const glm::vec3& point, uint32_t count, Distance distance, std::vector<int32_t>& outProxies) const
+		{
+			if (m_Root == NullNode || count == 0)
+				return;
+
+			struct Candidate
+			{
+				float DistanceSquared;
+				int32_t NodeID;
+				bool Exact;
+
+				bool operator>(const Candidate& other) const { return DistanceSquared > other.DistanceSquared; }
+			};
+
+			std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> queue;
+			queue.push({ m_Nodes[m_Root].Bounds.DistanceSquared(point), m_Root, false });
+			while (!queue.empty() && outProxies.size() < count)
+			{
+				Candidate candidate = queue.top();
+				queue.pop();
+
+				const Node& node = m_Nodes[candidate.NodeID];
+				if (candidate.Exact)
+				{
+					outProxies.push_back(candidate.NodeID);
+				}
+				else if (node.IsLeaf())
+				{
+					queue.push({ distance(candidate.NodeID), candidate.NodeID, true });
+				}
+				else
+				{
+					queue.push({ m_Nodes[node.Child1].Bounds.DistanceSquared(point), node.Child1, false });
+					queue.push({ m_Nodes[node.Child2].Bounds.DistanceSquared(point), node.Child2, false });
+				}
+			}
+		}
+	private:
+		struct Node
+		{
+			AABB Bounds;
+			int32_t Parent = NullNode; // Next free node while on the free list
+			int32_t Child1 = NullNode;
+			int32_t Child2 = NullNode;
+			int32_t Height = -1; // Leaf = 0, free node = -1
+			uint32_t UserData = 0;
+
+			bool IsLeaf() const { return Child1 == NullNode; }
+		};
+
+		int32_t AllocateNode();
+		void FreeNode(int32_t nodeID);
+
+		void InsertLeaf(int32_t leaf);
+		void RemoveLeaf(int32_t leaf);
+		void RefitAncestors(int32_t nodeID);
+		int32_t Balance(int32_t nodeID);
+	private:
+		std::vector<Node> m_Nodes;
+		int32_t m_Root = NullNode;
+		int32_t m_FreeList = NullNode;
+		uint32_t m_ProxyCount = 0;
+		float m_Margin;
+	};
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "AABB.h"
+
+namespace Hazel {
+
+	// View frustum as six inward-facing planes (xyz = normal, w = distance),
+	// extracted from an OpenGL-style (-w..w clip depth) view-projection matrix
+	struct Frustum
+	{
+		enum Plane { Left = 0, Right, Bottom, Top, Near, Far };
+
+		glm::vec4 Planes[6];
+
+		Frustum() = default;
+
+		Frustum(const glm::mat4& viewProjection)
+		{
+			glm::vec4 row0 = { viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0] };
+			glm::vec4 row1 = { viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1] };
+			glm::vec4 row2 = { viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2] };
+			glm::vec4 row3 = { viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3] };
+
+			Planes[Left] = row3 + row0;
+			Planes[Right] = row3 - row0;
+			Planes[Bottom] = row3 + row1;
+			Planes[Top] = row3 - row1;
+			Planes[Near] = row3 + row2;
+			Planes[Far] = row3 - row2;
+
+			for (auto& plane : Planes)
+				plane /= glm::length(glm::vec3(plane));
+		}
+
+		bool Intersects(const AABB& aabb) const
+		{
+			for (const auto& plane : Planes)
+			{
+				// Test the corner furthest along the plane normal
+				glm::vec3 positive = {
+					plane.x >= 0.0f ? aabb.Max.x : aabb.Min.x,
+					plane.y >= 0.0f ? aabb.Max.y : aabb.Min.y,
+					plane.z >= 0.0f ? aabb.Max.z : aabb.Min.z
+				};
+
+				if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+					return false;
+			}
+			return true;
+		}
+
+		bool Intersects(const glm::vec3& center, float radius) const
+		{
+			for (const auto& plane : Planes)
+			{
+				if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+					return false;
+			}
+			return true;
+		}
+	};
+
+}
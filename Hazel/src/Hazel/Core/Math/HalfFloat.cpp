@@ -0,0 +1,197 @@
+#include "hzpch.h"
+#include "HalfFloat.h"
+
+#include "Hazel/Core/CPUFeatures.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#define HZ_HALF_FLOAT_X86 1
+	#include <immintrin.h>
+	#ifdef _MSC_VER
+		// MSVC doesn't need a per-function target; the F16C paths only run when CPUFeatures reports it
+		#define HZ_TARGET_F16C
+	#else
+		#define HZ_TARGET_F16C __attribute__((target("avx,f16c")))
+	#endif
+#else
+	#define HZ_HALF_FLOAT_X86 0
+#endif
+
+namespace Hazel {
+
+	static uint32_t FloatBits(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	static float BitsToFloat(uint32_t bits)
+	{
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	uint16_t HalfFloat::FromFloat(float value)
+	{
+		uint32_t bits = FloatBits(value);
+		uint32_t sign = bits & 0x80000000u;
+		bits ^= sign;
+
+		uint32_t result;
+		if (bits >= 0x47800000u) // Too large for a half, infinity or NaN
+		{
+			result = bits > 0x7f800000u ? 0x7e00 : 0x7c00;
+		}
+		else if (bits < 0x38800000u) // Subnormal half or zero: let the FPU round by adding 0.5
+		{
+			result = FloatBits(BitsToFloat(bits) + 0.5f) - 0x3f000000u;
+		}
+		else
+		{
+			// Rebias the exponent and round the mantissa, to even on ties
+			uint32_t mantissaOdd = (bits >> 13) & 1;
+			bits += 0xc8000fffu + mantissaOdd; // ((15 - 127) << 23) + 0xfff
+			result = bits >> 13;
+		}
+		return (uint16_t)(result | (sign >> 16));
+	}
+
+	float HalfFloat::ToFloat(uint16_t value)
+	{
+		const uint32_t shiftedExponent = 0x7c00u << 13;
+
+		uint32_t bits = (value & 0x7fffu) << 13;
+		uint32_t exponent = bits & shiftedExponent;
+		bits += (127 - 15) << 23;
+
+		if (exponent == shiftedExponent) // Infinity or NaN
+			bits += (128 - 16) << 23;
+		else if (exponent == 0) // Zero or subnormal: renormalize through the FPU
+			bits = FloatBits(BitsToFloat(bits + (1 << 23)) - BitsToFloat(113 << 23));
+
+		return BitsToFloat(bits | ((uint32_t)(value & 0x8000u) << 16));
+	}
+
+#if HZ_HALF_FLOAT_X86
+
+	// The scalar FromFloat, four at a time. Results come out sign extended so that
+	// _mm_packs_epi32 narrows them without saturating.
+	static __m128i FromFloatSSE2(__m128 value)
+	{
+		const __m128i f16Max = _mm_set1_epi32(0x47800000);
+		const __m128i minNormal = _mm_set1_epi32(0x38800000);
+		const __m128i subnormalMagic = _mm_set1_epi32(0x3f000000);
+		const __m128i normalBias = _mm_set1_epi32((int)0xc8000fffu);
+		const __m128i infinity = _mm_set1_epi32(0x7c00);
+		const __m128i nanBit = _mm_set1_epi32(0x200);
+
+		__m128 sign = _mm_and_ps(value, _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u)));
+		__m128 absolute = _mm_xor_ps(value, sign);
+		__m128i bits = _mm_castps_si128(absolute);
+
+		__m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+		__m128i isFinite = _mm_cmpgt_epi32(f16Max, bits);
+		__m128i isSubnormal = _mm_cmpgt_epi32(minNormal, bits);
+		__m128i special = _mm_or_si128(infinity, _mm_and_si128(isNaN, nanBit));
+
+		__m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+
+		__m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(bits, 18), 31); // -1 if odd
+		__m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(bits, normalBias), mantissaOdd), 13);
+
+		__m128i result = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+		result = _mm_or_si128(_mm_and_si128(isFinite, result), _mm_andnot_si128(isFinite, special));
+		return _mm_or_si128(result, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+	}
+
+	// Every iteration loads its floats before storing halves over the first part of them,
+	// which is what makes in place conversion work
+	static size_t FromFloatSSE2(const float* src, uint16_t* dst, size_t count)
+	{
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128 a = _mm_loadu_ps(src + i);
+			__m128 b = _mm_loadu_ps(src + i + 4);
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(FromFloatSSE2(a), FromFloatSSE2(b)));
+		}
+		return i;
+	}
+
+	// The scalar ToFloat, four at a time, with the subnormal case done by a float multiply
+	static __m128 ToFloatSSE2(__m128i value)
+	{
+		const __m128i infNaNThreshold = _mm_set1_epi32(0x7bff);
+		const __m128i infNaNExponent = _mm_set1_epi32(255 << 23);
+		const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)); // 2^112
+
+		__m128i exponentMantissa = _mm_and_si128(value, _mm_set1_epi32(0x7fff));
+		__m128i sign = _mm_slli_epi32(_mm_xor_si128(value, exponentMantissa), 16);
+		__m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponentMantissa, 13)), magic);
+		__m128i infNaN = _mm_and_si128(_mm_cmpgt_epi32(exponentMantissa, infNaNThreshold), infNaNExponent);
+		return _mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(sign, infNaN)));
+	}
+
+	static size_t ToFloatSSE2(const uint16_t* src, float* dst, size_t count)
+	{
+		const __m128i zero = _mm_setzero_si128();
+
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i value = _mm_loadu_si128((const __m128i*)(src + i));
+			_mm_storeu_ps(dst + i, ToFloatSSE2(_mm_unpacklo_epi16(value, zero)));
+			_mm_storeu_ps(dst + i + 4, ToFloatSSE2(_mm_unpackhi_epi16(value, zero)));
+		}
+		return i;
+	}
+
+	HZ_TARGET_F16C static size_t FromFloatF16C(const float* src, uint16_t* dst, size_t count)
+	{
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 value = _mm256_loadu_ps(src + i);
+			_mm_storeu_si128((__m128i*)(dst + i), _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT));
+		}
+		return i;
+	}
+
+	HZ_TARGET_F16C static size_t ToFloatF16C(const uint16_t* src, float* dst, size_t count)
+	{
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i value = _mm_loadu_si128((const __m128i*)(src + i));
+			_mm256_storeu_ps(dst + i, _mm256_cvtph_ps(value));
+		}
+		return i;
+	}
+
+	static bool s_HasF16C = CPUFeatures::HasF16C();
+
+#endif
+
+	void HalfFloat::FromFloat(const float* src, uint16_t* dst, size_t count)
+	{
+		size_t i = 0;
+#if HZ_HALF_FLOAT_X86
+		// SSE2 is part of x64
+		i = s_HasF16C ? FromFloatF16C(src, dst, count) : FromFloatSSE2(src, dst, count);
+#endif
+		for (; i < count; i++)
+			dst[i] = FromFloat(src[i]);
+	}
+
+	void HalfFloat::ToFloat(const uint16_t* src, float* dst, size_t count)
+	{
+		size_t i = 0;
+#if HZ_HALF_FLOAT_X86
+		i = s_HasF16C ? ToFloatF16C(src, dst, count) : ToFloatSSE2(src, dst, count);
+#endif
+		for (; i < count; i++)
+			dst[i] = ToFloat(src[i]);
+	}
+
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Hazel {
+
+	// IEEE 754 binary16 conversion, rounding to nearest even. Overflow becomes infinity and
+	// NaNs stay NaNs. The array versions use F16C or SSE2 when the CPU has them.
+	class HalfFloat
+	{
+	public:
+		static uint16_t FromFloat(float value);
+		static float ToFloat(uint16_t value);
+
+		// dst may point at src for an in place conversion; otherwise the ranges must not overlap
+		static void FromFloat(const float* src, uint16_t* dst, size_t count);
+		static void ToFloat(const uint16_t* src, float* dst, size_t count);
+	};
+
+}
@@ -21,13 +21,19 @@ namespace Hazel {
             return { {0.0f, 0.0f, 0.0f},{0.0f, 0.0f, 0.0f} };
         }
 
+        glm::vec3 GetInverseDirection() const
+        {
+            return 1.0f / Direction;
+        }
+
         bool IntersectsAABB(const AABB& aabb, float& t) const
         {
-            glm::vec3 dirfrac;
-            // r.dir is unit direction vector of ray
-            dirfrac.x = 1.0f / Direction.x;
-            dirfrac.y = 1.0f / Direction.y;
-            dirfrac.z = 1.0f / Direction.z;
+            return IntersectsAABB(aabb, GetInverseDirection(), t);
+        }
+
+        // Overload for testing one ray against many boxes without recomputing the reciprocal direction
+        bool IntersectsAABB(const AABB& aabb, const glm::vec3& dirfrac, float& t) const
+        {
             // lb is the corner of AABB with minimal coordinates - left bottom, rt is maximal corner
             // r.org is origin of ray
             const glm::vec3& lb = aabb.Min;
@@ -60,7 +66,7 @@ namespace Hazel {
             return true;
         }
 
-		bool IntersectsTriangle(const glm::vec3& A, const glm::vec3& B, const glm::vec3& C, float& t)
+		bool IntersectsTriangle(const glm::vec3& A, const glm::vec3& B, const glm::vec3& C, float& t) const
         {
 			glm::vec3 E1 = B - A;
 			glm::vec3 E2 = C - A;
@@ -0,0 +1,482 @@
+#include "hzpch.h"
+#include "RayKernels.h"
+
+#include "Hazel/Core/CPUFeatures.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#define HZ_RAY_KERNELS_X86 1
+	#include <immintrin.h>
+	#ifdef _MSC_VER
+		// No per-function target needed; the AVX2 kernels are only dispatched to when the CPU has it
+		#define HZ_TARGET_AVX2
+	#else
+		#define HZ_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#else
+	#define HZ_RAY_KERNELS_X86 0
+#endif
+
+namespace Hazel {
+
+	static const float s_Infinity = std::numeric_limits<float>::infinity();
+	static const float s_DeterminantEpsilon = 1e-6f;
+
+	////////////////////////////////////////////////////////////////
+	// Batches /////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////
+
+	void TriangleBatch::Add(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+	{
+		glm::vec3 e1 = b - a;
+		glm::vec3 e2 = c - a;
+		glm::vec3 n = glm::cross(e1, e2);
+		Ax.push_back(a.x); Ay.push_back(a.y); Az.push_back(a.z);
+		E1x.push_back(e1.x); E1y.push_back(e1.y); E1z.push_back(e1.z);
+		E2x.push_back(e2.x); E2y.push_back(e2.y); E2z.push_back(e2.z);
+		Nx.push_back(n.x); Ny.push_back(n.y); Nz.push_back(n.z);
+	}
+
+	void TriangleBatch::Reserve(uint32_t count)
+	{
+		for (auto* v : { &Ax, &Ay, &Az, &E1x, &E1y, &E1z, &E2x, &E2y, &E2z, &Nx, &Ny, &Nz })
+			v->reserve(count);
+	}
+
+	void TriangleBatch::Clear()
+	{
+		for (auto* v : { &Ax, &Ay, &Az, &E1x, &E1y, &E1z, &E2x, &E2y, &E2z, &Nx, &Ny, &Nz })
+			v->clear();
+	}
+
+	void AABBBatch::Add(const AABB& aabb)
+	{
+		MinX.push_back(aabb.Min.x); MinY.push_back(aabb.Min.y); MinZ.push_back(aabb.Min.z);
+		MaxX.push_back(aabb.Max.x); MaxY.push_back(aabb.Max.y); MaxZ.push_back(aabb.Max.z);
+	}
+
+	void AABBBatch::Reserve(uint32_t count)
+	{
+		for (auto* v : { &MinX, &MinY, &MinZ, &MaxX, &MaxY, &MaxZ })
+			v->reserve(count);
+	}
+
+	void AABBBatch::Clear()
+	{
+		for (auto* v : { &MinX, &MinY, &MinZ, &MaxX, &MaxY, &MaxZ })
+			v->clear();
+	}
+
+	void RayBatch::Add(const Ray& ray)
+	{
+		glm::vec3 inverseDirection = ray.GetInverseDirection();
+		OriginX.push_back(ray.Origin.x); OriginY.push_back(ray.Origin.y); OriginZ.push_back(ray.Origin.z);
+		InverseDirectionX.push_back(inverseDirection.x); InverseDirectionY.push_back(inverseDirection.y); InverseDirectionZ.push_back(inverseDirection.z);
+	}
+
+	void RayBatch::Reserve(uint32_t count)
+	{
+		for (auto* v : { &OriginX, &OriginY, &OriginZ, &InverseDirectionX, &InverseDirectionY, &InverseDirectionZ })
+			v->reserve(count);
+	}
+
+	void RayBatch::Clear()
+	{
+		for (auto* v : { &OriginX, &OriginY, &OriginZ, &InverseDirectionX, &InverseDirectionY, &InverseDirectionZ })
+			v->clear();
+	}
+
+	////////////////////////////////////////////////////////////////
+	// Scalar //////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////
+
+	// Each kernel processes [begin, end) so the SIMD versions can hand their remainders to it
+
+	static void IntersectTrianglesScalar(const Ray& ray, const TriangleBatch& tris, uint32_t begin, uint32_t end, int32_t& bestIndex, float& bestDistance)
+	{
+		const glm::vec3& o = ray.Origin;
+		const glm::vec3& d = ray.Direction;
+		for (uint32_t i = begin; i < end; i++)
+		{
+			float det = -(d.x * tris.Nx[i] + d.y * tris.Ny[i] + d.z * tris.Nz[i]);
+			float invdet = 1.0f / det;
+			glm::vec3 ao = { o.x - tris.Ax[i], o.y - tris.Ay[i], o.z - tris.Az[i] };
+			glm::vec3 dao = glm::cross(ao, d);
+			float u = (tris.E2x[i] * dao.x + tris.E2y[i] * dao.y + tris.E2z[i] * dao.z) * invdet;
+			float v = -(tris.E1x[i] * dao.x + tris.E1y[i] * dao.y + tris.E1z[i] * dao.z) * invdet;
+			float t = (ao.x * tris.Nx[i] + ao.y * tris.Ny[i] + ao.z * tris.Nz[i]) * invdet;
+			if (det >= s_DeterminantEpsilon && t >= 0.0f && u >= 0.0f && v >= 0.0f && (u + v) <= 1.0f && t < bestDistance)
+			{
+				bestDistance = t;
+				bestIndex = (int32_t)i;
+			}
+		}
+	}
+
+	static float SlabTest(float ox, float oy, float oz, float idx, float idy, float idz,
+		float minX, float minY, float minZ, float maxX, float maxY, float maxZ, float maxDistance)
+	{
+		float t0x = (minX - ox) * idx, t1x = (maxX - ox) * idx;
+		float t0y = (minY - oy) * idy, t1y = (maxY - oy) * idy;
+		float t0z = (minZ - oz) * idz, t1z = (maxZ - oz) * idz;
+		float tnear = glm::max(glm::max(glm::min(t0x, t1x), glm::min(t0y, t1y)), glm::max(glm::min(t0z, t1z), 0.0f));
+		float tfar = glm::min(glm::min(glm::max(t0x, t1x), glm::max(t0y, t1y)), glm::min(glm::max(t0z, t1z), maxDistance));
+		return tnear <= tfar ? tnear : s_Infinity;
+	}
+
+	static uint32_t IntersectAABBsScalar(const Ray& ray, const AABBBatch& boxes, uint32_t begin, uint32_t end, float* outDistances, float maxDistance)
+	{
+		glm::vec3 inv = ray.GetInverseDirection();
+		uint32_t hits = 0;
+		for (uint32_t i = begin; i < end; i++)
+		{
+			outDistances[i] = SlabTest(ray.Origin.x, ray.Origin.y, ray.Origin.z, inv.x, inv.y, inv.z,
+				boxes.MinX[i], boxes.MinY[i], boxes.MinZ[i], boxes.MaxX[i], boxes.MaxY[i], boxes.MaxZ[i], maxDistance);
+			hits += outDistances[i] != s_Infinity;
+		}
+		return hits;
+	}
+
+	static uint32_t IntersectRaysScalar(const RayBatch& rays, const AABB& box, uint32_t begin, uint32_t end, float* outDistances, float maxDistance)
+	{
+		uint32_t hits = 0;
+		for (uint32_t i = begin; i < end; i++)
+		{
+			outDistances[i] = SlabTest(rays.OriginX[i], rays.OriginY[i], rays.OriginZ[i], rays.InverseDirectionX[i], rays.InverseDirectionY[i], rays.InverseDirectionZ[i],
+				box.Min.x, box.Min.y, box.Min.z, box.Max.x, box.Max.y, box.Max.z, maxDistance);
+			hits += outDistances[i] != s_Infinity;
+		}
+		return hits;
+	}
+
+#if HZ_RAY_KERNELS_X86
+
+	static uint32_t CountBits(uint32_t mask)
+	{
+		uint32_t count = 0;
+		for (; mask; mask &= mask - 1)
+			count++;
+		return count;
+	}
+
+	// Picks the lowest index among the lanes holding the smallest distance, which matches
+	// the scalar kernel's "first strictly closer hit wins" ordering
+	static void ReduceLanes(const float* distances, const int32_t* indices, uint32_t laneCount, int32_t& bestIndex, float& bestDistance)
+	{
+		for (uint32_t lane = 0; lane < laneCount; lane++)
+		{
+			if (indices[lane] < 0)
+				continue;
+
+			if (distances[lane] < bestDistance || (distances[lane] == bestDistance && indices[lane] < bestIndex))
+			{
+				bestDistance = distances[lane];
+				bestIndex = indices[lane];
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////////
+	// SSE (4-wide) ////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////
+
+	static void IntersectTrianglesSSE(const Ray& ray, const TriangleBatch& tris, int32_t& bestIndex, float& bestDistance)
+	{
+		const __m128 ox = _mm_set1_ps(ray.Origin.x), oy = _mm_set1_ps(ray.Origin.y), oz = _mm_set1_ps(ray.Origin.z);
+		const __m128 dx = _mm_set1_ps(ray.Direction.x), dy = _mm_set1_ps(ray.Direction.y), dz = _mm_set1_ps(ray.Direction.z);
+		const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), epsilon = _mm_set1_ps(s_DeterminantEpsilon);
+
+		__m128 best = _mm_set1_ps(bestDistance);
+		__m128i bestLaneIndex = _mm_set1_epi32(-1);
+		__m128i index = _mm_setr_epi32(0, 1, 2, 3);
+		const __m128i step = _mm_set1_epi32(4);
+
+		uint32_t count = tris.GetCount() & ~3u;
+		for (uint32_t i = 0; i < count; i += 4)
+		{
+			__m128 nx = _mm_loadu_ps(&tris.Nx[i]), ny = _mm_loadu_ps(&tris.Ny[i]), nz = _mm_loadu_ps(&tris.Nz[i]);
+			__m128 det = _mm_sub_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, nx), _mm_mul_ps(dy, ny)), _mm_mul_ps(dz, nz)));
+			__m128 invdet = _mm_div_ps(one, det);
+
+			__m128 aox = _mm_sub_ps(ox, _mm_loadu_ps(&tris.Ax[i]));
+			__m128 aoy = _mm_sub_ps(oy, _mm_loadu_ps(&tris.Ay[i]));
+			__m128 aoz = _mm_sub_ps(oz, _mm_loadu_ps(&tris.Az[i]));
+
+			__m128 daox = _mm_sub_ps(_mm_mul_ps(aoy, dz), _mm_mul_ps(aoz, dy));
+			__m128 daoy = _mm_sub_ps(_mm_mul_ps(aoz, dx), _mm_mul_ps(aox, dz));
+			__m128 daoz = _mm_sub_ps(_mm_mul_ps(aox, dy), _mm_mul_ps(aoy, dx));
+
+			__m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_loadu_ps(&tris.E2x[i]), daox), _mm_mul_ps(_mm_loadu_ps(&tris.E2y[i]), daoy)), _mm_mul_ps(_mm_loadu_ps(&tris.E2z[i]), daoz)), invdet);
+			__m128 v = _mm_sub_ps(zero, _mm_mul_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_loadu_ps(&tris.E1x[i]), daox), _mm_mul_ps(_mm_loadu_ps(&tris.E1y[i]), daoy)), _mm_mul_ps(_mm_loadu_ps(&tris.E1z[i]), daoz)), invdet));
+			__m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aox, nx), _mm_mul_ps(aoy, ny)), _mm_mul_ps(aoz, nz)), invdet);
+
+			__m128 mask = _mm_cmpge_ps(det, epsilon);
+			mask = _mm_and_ps(mask, _mm_cmpge_ps(t, zero));
+			mask = _mm_and_ps(mask, _mm_cmpge_ps(u, zero));
+			mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+			mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), one));
+			mask = _mm_and_ps(mask, _mm_cmplt_ps(t, best));
+
+			best = _mm_or_ps(_mm_and_ps(mask, t), _mm_andnot_ps(mask, best));
+			__m128i maski = _mm_castps_si128(mask);
+			bestLaneIndex = _mm_or_si128(_mm_and_si128(maski, index), _mm_andnot_si128(maski, bestLaneIndex));
+			index = _mm_add_epi32(index, step);
+		}
+
+		alignas(16) float distances[4];
+		alignas(16) int32_t indices[4];
+		_mm_store_ps(distances, best);
+		_mm_store_si128((__m128i*)indices, bestLaneIndex);
+		ReduceLanes(distances, indices, 4, bestIndex, bestDistance);
+
+		IntersectTrianglesScalar(ray, tris, count, tris.GetCount(), bestIndex, bestDistance);
+	}
+
+	static __m128 SlabTestSSE(__m128 ox, __m128 oy, __m128 oz, __m128 idx, __m128 idy, __m128 idz,
+		__m128 minX, __m128 minY, __m128 minZ, __m128 maxX, __m128 maxY, __m128 maxZ, __m128 maxDistance, __m128& outMask)
+	{
+		__m128 t0x = _mm_mul_ps(_mm_sub_ps(minX, ox), idx), t1x = _mm_mul_ps(_mm_sub_ps(maxX, ox), idx);
+		__m128 t0y = _mm_mul_ps(_mm_sub_ps(minY, oy), idy), t1y = _mm_mul_ps(_mm_sub_ps(maxY, oy), idy);
+		__m128 t0z = _mm_mul_ps(_mm_sub_ps(minZ, oz), idz), t1z = _mm_mul_ps(_mm_sub_ps(maxZ, oz), idz);
+		__m128 tnear = _mm_max_ps(_mm_max_ps(_mm_min_ps(t0x, t1x), _mm_min_ps(t0y, t1y)), _mm_max_ps(_mm_min_ps(t0z, t1z), _mm_setzero_ps()));
+		__m128 tfar = _mm_min_ps(_mm_min_ps(_mm_max_ps(t0x, t1x), _mm_max_ps(t0y, t1y)), _mm_min_ps(_mm_max_ps(t0z, t1z), maxDistance));
+		outMask = _mm_cmple_ps(tnear, tfar);
+		return _mm_or_ps(_mm_and_ps(outMask, tnear), _mm_andnot_ps(outMask, _mm_set1_ps(s_Infinity)));
+	}
+
+	static uint32_t IntersectAABBsSSE(const Ray& ray, const AABBBatch& boxes, float* outDistances, float maxDistance)
+	{
+		glm::vec3 inv = ray.GetInverseDirection();
+		const __m128 ox = _mm_set1_ps(ray.Origin.x), oy = _mm_set1_ps(ray.Origin.y), oz = _mm_set1_ps(ray.Origin.z);
+		const __m128 idx = _mm_set1_ps(inv.x), idy = _mm_set1_ps(inv.y), idz = _mm_set1_ps(inv.z);
+		const __m128 maxT = _mm_set1_ps(maxDistance);
+
+		uint32_t hits = 0;
+		uint32_t count = boxes.GetCount() & ~3u;
+		for (uint32_t i = 0; i < count; i += 4)
+		{
+			__m128 mask;
+			__m128 distance = SlabTestSSE(ox, oy, oz, idx, idy, idz,
+				_mm_loadu_ps(&boxes.MinX[i]), _mm_loadu_ps(&boxes.MinY[i]), _mm_loadu_ps(&boxes.MinZ[i]),
+				_mm_loadu_ps(&boxes.MaxX[i]), _mm_loadu_ps(&boxes.MaxY[i]), _mm_loadu_ps(&boxes.MaxZ[i]), maxT, mask);
+			_mm_storeu_ps(&outDistances[i], distance);
+			hits += CountBits(_mm_movemask_ps(mask));
+		}
+
+		return hits + IntersectAABBsScalar(ray, boxes, count, boxes.GetCount(), outDistances, maxDistance);
+	}
+
+	static uint32_t IntersectRaysSSE(const RayBatch& rays, const AABB& box, float* outDistances, float maxDistance)
+	{
+		const __m128 minX = _mm_set1_ps(box.Min.x), minY = _mm_set1_ps(box.Min.y), minZ = _mm_set1_ps(box.Min.z);
+		const __m128 maxX = _mm_set1_ps(box.Max.x), maxY = _mm_set1_ps(box.Max.y), maxZ = _mm_set1_ps(box.Max.z);
+		const __m128 maxT = _mm_set1_ps(maxDistance);
+
+		uint32_t hits = 0;
+		uint32_t count = rays.GetCount() & ~3u;
+		for (uint32_t i = 0; i < count; i += 4)
+		{
+			__m128 mask;
+			__m128 distance = SlabTestSSE(
+				_mm_loadu_ps(&rays.OriginX[i]), _mm_loadu_ps(&rays.OriginY[i]), _mm_loadu_ps(&rays.OriginZ[i]),
+				_mm_loadu_ps(&rays.InverseDirectionX[i]), _mm_loadu_ps(&rays.InverseDirectionY[i]), _mm_loadu_ps(&rays.InverseDirectionZ[i]),
+				minX, minY, minZ, maxX, maxY, maxZ, maxT, mask);
+			_mm_storeu_ps(&outDistances[i], distance);
+			hits += CountBits(_mm_movemask_ps(mask));
+		}
+
+		return hits + IntersectRaysScalar(rays, box, count, rays.GetCount(), outDistances, maxDistance);
+	}
+
+	////////////////////////////////////////////////////////////////
+	// AVX2 (8-wide) ///////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////
+
+	HZ_TARGET_AVX2 static void IntersectTrianglesAVX2(const Ray& ray, const TriangleBatch& tris, int32_t& bestIndex, float& bestDistance)
+	{
+		const __m256 ox = _mm256_set1_ps(ray.Origin.x), oy = _mm256_set1_ps(ray.Origin.y), oz = _mm256_set1_ps(ray.Origin.z);
+		const __m256 dx = _mm256_set1_ps(ray.Direction.x), dy = _mm256_set1_ps(ray.Direction.y), dz = _mm256_set1_ps(ray.Direction.z);
+		const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f), epsilon = _mm256_set1_ps(s_DeterminantEpsilon);
+
+		__m256 best = _mm256_set1_ps(bestDistance);
+		__m256i bestLaneIndex = _mm256_set1_epi32(-1);
+		__m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+		const __m256i step = _mm256_set1_epi32(8);
+
+		uint32_t count = tris.GetCount() & ~7u;
+		for (uint32_t i = 0; i < count; i += 8)
+		{
+			__m256 nx = _mm256_loadu_ps(&tris.Nx[i]), ny = _mm256_loadu_ps(&tris.Ny[i]), nz = _mm256_loadu_ps(&tris.Nz[i]);
+			__m256 det = _mm256_sub_ps(zero, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, nx), _mm256_mul_ps(dy, ny)), _mm256_mul_ps(dz, nz)));
+			__m256 invdet = _mm256_div_ps(one, det);
+
+			__m256 aox = _mm256_sub_ps(ox, _mm256_loadu_ps(&tris.Ax[i]));
+			__m256 aoy = _mm256_sub_ps(oy, _mm256_loadu_ps(&tris.Ay[i]));
+			__m256 aoz = _mm256_sub_ps(oz, _mm256_loadu_ps(&tris.Az[i]));
+
+			__m256 daox = _mm256_sub_ps(_mm256_mul_ps(aoy, dz), _mm256_mul_ps(aoz, dy));
+			__m256 daoy = _mm256_sub_ps(_mm256_mul_ps(aoz, dx), _mm256_mul_ps(aox, dz));
+			__m256 daoz = _mm256_sub_ps(_mm256_mul_ps(aox, dy), _mm256_mul_ps(aoy, dx));
+
+			__m256 u = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(
+				_mm256_mul_ps(_mm256_loadu_ps(&tris.E2x[i]), daox), _mm256_mul_ps(_mm256_loadu_ps(&tris.E2y[i]), daoy)), _mm256_mul_ps(_mm256_loadu_ps(&tris.E2z[i]), daoz)), invdet);
+			__m256 v = _mm256_sub_ps(zero, _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(
+				_mm256_mul_ps(_mm256_loadu_ps(&tris.E1x[i]), daox), _mm256_mul_ps(_mm256_loadu_ps(&tris.E1y[i]), daoy)), _mm256_mul_ps(_mm256_loadu_ps(&tris.E1z[i]), daoz)), invdet));
+			__m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(aox, nx), _mm256_mul_ps(aoy, ny)), _mm256_mul_ps(aoz, nz)), invdet);
+
+			__m256 mask = _mm256_cmp_ps(det, epsilon, _CMP_GE_OQ);
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, zero, _CMP_GE_OQ));
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+			mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, best, _CMP_LT_OQ));
+
+			best = _mm256_blendv_ps(best, t, mask);
+			bestLaneIndex = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestLaneIndex), _mm256_castsi256_ps(index), mask));
+			index = _mm256_add_epi32(index, step);
+		}
+
+		alignas(32) float distances[8];
+		alignas(32) int32_t indices[8];
+		_mm256_store_ps(distances, best);
+		_mm256_store_si256((__m256i*)indices, bestLaneIndex);
+		ReduceLanes(distances, indices, 8, bestIndex, bestDistance);
+
+		IntersectTrianglesScalar(ray, tris, count, tris.GetCount(), bestIndex, bestDistance);
+	}
+
+	HZ_TARGET_AVX2 static __m256 SlabTestAVX2(__m256 ox, __m256 oy, __m256 oz, __m256 idx, __m256 idy, __m256 idz,
+		__m256 minX, __m256 minY, __m256 minZ, __m256 maxX, __m256 maxY, __m256 maxZ, __m256 maxDistance, __m256& outMask)
+	{
+		__m256 t0x = _mm256_mul_ps(_mm256_sub_ps(minX, ox), idx), t1x = _mm256_mul_ps(_mm256_sub_ps(maxX, ox), idx);
+		__m256 t0y = _mm256_mul_ps(_mm256_sub_ps(minY, oy), idy), t1y = _mm256_mul_ps(_mm256_sub_ps(maxY, oy), idy);
+		__m256 t0z = _mm256_mul_ps(_mm256_sub_ps(minZ, oz), idz), t1z = _mm256_mul_ps(_mm256_sub_ps(maxZ, oz), idz);
+		__m256 tnear = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(t0x, t1x), _mm256_min_ps(t0y, t1y)), _mm256_max_ps(_mm256_min_ps(t0z, t1z), _mm256_setzero_ps()));
+		__m256 tfar = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(t0x, t1x), _mm256_max_ps(t0y, t1y)), _mm256_min_ps(_mm256_max_ps(t0z, t1z), maxDistance));
+		outMask = _mm256_cmp_ps(tnear, tfar, _CMP_LE_OQ);
+		return _mm256_blendv_ps(_mm256_set1_ps(s_Infinity), tnear, outMask);
+	}
+
+	HZ_TARGET_AVX2 static uint32_t IntersectAABBsAVX2(const Ray& ray, const AABBBatch& boxes, float* outDistances, float maxDistance)
+	{
+		glm::vec3 inv = ray.GetInverseDirection();
+		const __m256 ox = _mm256_set1_ps(ray.Origin.x), oy = _mm256_set1_ps(ray.Origin.y), oz = _mm256_set1_ps(ray.Origin.z);
+		const __m256 idx = _mm256_set1_ps(inv.x), idy = _mm256_set1_ps(inv.y), idz = _mm256_set1_ps(inv.z);
+		const __m256 maxT = _mm256_set1_ps(maxDistance);
+
+		uint32_t hits = 0;
+		uint32_t count = boxes.GetCount() & ~7u;
+		for (uint32_t i = 0; i < count; i += 8)
+		{
+			__m256 mask;
+			__m256 distance = SlabTestAVX2(ox, oy, oz, idx, idy, idz,
+				_mm256_loadu_ps(&boxes.MinX[i]), _mm256_loadu_ps(&boxes.MinY[i]), _mm256_loadu_ps(&boxes.MinZ[i]),
+				_mm256_loadu_ps(&boxes.MaxX[i]), _mm256_loadu_ps(&boxes.MaxY[i]), _mm256_loadu_ps(&boxes.MaxZ[i]), maxT, mask);
+			_mm256_storeu_ps(&outDistances[i], distance);
+			hits += CountBits(_mm256_movemask_ps(mask));
+		}
+
+		return hits + IntersectAABBsScalar(ray, boxes, count, boxes.GetCount(), outDistances, maxDistance);
+	}
+
+	HZ_TARGET_AVX2 static uint32_t IntersectRaysAVX2(const RayBatch& rays, const AABB& box, float* outDistances, float maxDistance)
+	{
+		const __m256 minX = _mm256_set1_ps(box.Min.x), minY = _mm256_set1_ps(box.Min.y), minZ = _mm256_set1_ps(box.Min.z);
+		const __m256 maxX = _mm256_set1_ps(box.Max.x), maxY = _mm256_set1_ps(box.Max.y), maxZ = _mm256_set1_ps(box.Max.z);
+		const __m256 maxT = _mm256_set1_ps(maxDistance);
+
+		uint32_t hits = 0;
+		uint32_t count = rays.GetCount() & ~7u;
+		for (uint32_t i = 0; i < count; i += 8)
+		{
+			__m256 mask;
+			__m256 distance = SlabTestAVX2(
+				_mm256_loadu_ps(&rays.OriginX[i]), _mm256_loadu_ps(&rays.OriginY[i]), _mm256_loadu_ps(&rays.OriginZ[i]),
+				_mm256_loadu_ps(&rays.InverseDirectionX[i]), _mm256_loadu_ps(&rays.InverseDirectionY[i]), _mm256_loadu_ps(&rays.InverseDirectionZ[i]),
+				minX, minY, minZ, maxX, maxY, maxZ, maxT, mask);
+			_mm256_storeu_ps(&outDistances[i], distance);
+			hits += CountBits(_mm256_movemask_ps(mask));
+		}
+
+		return hits + IntersectRaysScalar(rays, box, count, rays.GetCount(), outDistances, maxDistance);
+	}
+
+#endif
+
+	////////////////////////////////////////////////////////////////
+	// Dispatch ////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////
+
+	static SIMDLevel DetectSIMDLevel()
+	{
+#if HZ_RAY_KERNELS_X86
+		// SSE2 is part of x64
+		return CPUFeatures::HasAVX2() ? SIMDLevel::AVX2 : SIMDLevel::SSE;
+#else
+		return SIMDLevel::Scalar;
+#endif
+	}
+
+	static SIMDLevel s_SupportedLevel = DetectSIMDLevel();
+	static SIMDLevel s_Level = s_SupportedLevel;
+
+	int32_t RayKernels::IntersectTriangles(const Ray& ray, const TriangleBatch& triangles, float& outDistance, float maxDistance)
+	{
+		int32_t bestIndex = -1;
+		float bestDistance = maxDistance;
+		switch (s_Level)
+		{
+#if HZ_RAY_KERNELS_X86
+			case SIMDLevel::AVX2: IntersectTrianglesAVX2(ray, triangles, bestIndex, bestDistance); break;
+			case SIMDLevel::SSE:  IntersectTrianglesSSE(ray, triangles, bestIndex, bestDistance); break;
+#endif
+			default:              IntersectTrianglesScalar(ray, triangles, 0, triangles.GetCount(), bestIndex, bestDistance); break;
+		}
+
+		if (bestIndex >= 0)
+			outDistance = bestDistance;
+
+		return bestIndex;
+	}
+
+	uint32_t RayKernels::IntersectAABBs(const Ray& ray, const AABBBatch& boxes, float* outDistances, float maxDistance)
+	{
+		switch (s_Level)
+		{
+#if HZ_RAY_KERNELS_X86
+			case SIMDLevel::AVX2: return IntersectAABBsAVX2(ray, boxes, outDistances, maxDistance);
+			case SIMDLevel::SSE:  return IntersectAABBsSSE(ray, boxes, outDistances, maxDistance);
+#endif
+			default:              return IntersectAABBsScalar(ray, boxes, 0, boxes.GetCount(), outDistances, maxDistance);
+		}
+	}
+
+	uint32_t RayKernels::IntersectRays(const RayBatch& rays, const AABB& box, float* outDistances, float maxDistance)
+	{
+		switch (s_Level)
+		{
+#if HZ_RAY_KERNELS_X86
+			case SIMDLevel::AVX2: return IntersectRaysAVX2(rays, box, outDistances, maxDistance);
+			case SIMDLevel::SSE:  return IntersectRaysSSE(rays, box, outDistances, maxDistance);
+#endif
+			default:              return IntersectRaysScalar(rays, box, 0, rays.GetCount(), outDistances, maxDistance);
+		}
+	}
+
+	SIMDLevel RayKernels::GetSupportedLevel()
+	{
+		return s_SupportedLevel;
+	}
+
+	SIMDLevel RayKernels::GetLevel()
+	{
+		return s_Level;
+	}
+
+	void RayKernels::SetLevel(SIMDLevel level)
+	{
+		s_Level = (int)level <= (int)s_SupportedLevel ? level : s_SupportedLevel;
+	}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <glm/glm.hpp>
+
+#include "AABB.h"
+#include "Ray.h"
+
+namespace Hazel {
+
+	// Triangles in structure-of-arrays layout for the batch kernels. Edges and the
+	// (unnormalized) face normal are precomputed so each test is mostly dot products.
+	struct TriangleBatch
+	{
+		std::vector<float> Ax, Ay, Az;
+		std::vector<float> E1x, E1y, E1z;
+		std::vector<float> E2x, E2y, E2z;
+		std::vector<float> Nx, Ny, Nz;
+
+		void Add(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+		void Reserve(uint32_t count);
+		void Clear();
+
+		uint32_t GetCount() const { return (uint32_t)Ax.size(); }
+	};
+
+	struct AABBBatch
+	{
+		std::vector<float> MinX, MinY, MinZ;
+		std::vector<float> MaxX, MaxY, MaxZ;
+
+		void Add(const AABB& aabb);
+		void Reserve(uint32_t count);
+		void Clear();
+
+		uint32_t GetCount() const { return (uint32_t)MinX.size(); }
+	};
+
+	// Rays with their reciprocal directions precomputed, for many-rays-vs-one-box tests
+	struct RayBatch
+	{
+		std::vector<float> OriginX, OriginY, OriginZ;
+		std::vector<float> InverseDirectionX, InverseDirectionY, InverseDirectionZ;
+
+		void Add(const Ray& ray);
+		void Reserve(uint32_t count);
+		void Clear();
+
+		uint32_t GetCount() const { return (uint32_t)OriginX.size(); }
+	};
+
+	enum class SIMDLevel
+	{
+		Scalar = 0, SSE = 1, AVX2 = 2
+	};
+
+	// Batch ray intersection kernels. The widest instruction set supported by the CPU is
+	// picked at startup; results match Ray::IntersectsTriangle (front faces only) and a slab
+	// test whose near distance is clamped to the ray origin.
+	class RayKernels
+	{
+	public:
+		// Index of the closest triangle hit with t < maxDistance, or -1
+		static int32_t IntersectTriangles(const Ray& ray, const TriangleBatch& triangles, float& outDistance, float maxDistance = std::numeric_limits<float>::max());
+
+		// outDistances[i] is the entry distance for hit boxes and +infinity for misses. Returns the hit count.
+		static uint32_t IntersectAABBs(const Ray& ray, const AABBBatch& boxes, float* outDistances, float maxDistance = std::numeric_limits<float>::max());
+		static uint32_t IntersectRays(const RayBatch& rays, const AABB& box, float* outDistances, float maxDistance = std::numeric_limits<float>::max());
+
+		static SIMDLevel GetSupportedLevel();
+		static SIMDLevel GetLevel();
+		// Clamped to what the CPU supports; mainly useful for benchmarking and testing
+		static void SetLevel(SIMDLevel level);
+	};
+
+}
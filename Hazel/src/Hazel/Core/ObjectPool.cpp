@@ -0,0 +1,104 @@
+#include "hzpch.h"
+#include "ObjectPool.h"
+
+namespace Hazel {
+
+	// Pools are created on first use, which can be before main
+	static std::mutex& GetRegistryMutex()
+	{
+		static std::mutex* mutex = new std::mutex();
+		return *mutex;
+	}
+
+	static std::vector<ObjectPool*>& GetRegistry()
+	{
+		static std::vector<ObjectPool*>* pools = new std::vector<ObjectPool*>();
+		return *pools;
+	}
+
+	ObjectPool::ObjectPool(const char* name, uint64_t objectSize, uint64_t alignment)
+		: m_Name(name), m_Alignment(alignment)
+	{
+		// Free objects hold the free list link
+		m_ObjectSize = std::max<uint64_t>(objectSize, sizeof(void*));
+		m_ObjectSize = (m_ObjectSize + alignment - 1) & ~(alignment - 1);
+
+		std::scoped_lock<std::mutex> lock(GetRegistryMutex());
+		GetRegistry().push_back(this);
+	}
+
+	ObjectPool::~ObjectPool()
+	{
+		HZ_CORE_ASSERT(m_LiveCount == 0, "Object pool destroyed with objects still alive!");
+		for (void* slab : m_Slabs)
+			::operator delete(slab, std::align_val_t(m_Alignment));
+
+		std::scoped_lock<std::mutex> lock(GetRegistryMutex());
+		auto& pools = GetRegistry();
+		pools.erase(std::find(pools.begin(), pools.end(), this));
+	}
+
+	void ObjectPool::AllocateSlab()
+	{
+		uint8_t* slab = (uint8_t*)::operator new(m_ObjectSize * SlabObjectCount, std::align_val_t(m_Alignment));
+		m_Slabs.push_back(slab);
+
+		// Linked in order, so objects allocated one after the other are adjacent
+		for (int32_t i = SlabObjectCount - 1; i >= 0; i--)
+		{
+			void* object = slab + i * m_ObjectSize;
+			*(void**)object = m_FreeList;
+			m_FreeList = object;
+		}
+	}
+
+	void* ObjectPool::Allocate(uint64_t size)
+	{
+		if (size > m_ObjectSize)
+			return ::operator new(size);
+
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+		if (!m_FreeList)
+			AllocateSlab();
+
+		void* object = m_FreeList;
+		m_FreeList = *(void**)object;
+		m_LiveCount++;
+		m_PeakCount = std::max(m_PeakCount, m_LiveCount);
+		return object;
+	}
+
+	void ObjectPool::Free(void* memory, uint64_t size)
+	{
+		if (!memory)
+			return;
+
+		if (size > m_ObjectSize)
+		{
+			::operator delete(memory);
+			return;
+		}
+
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+		*(void**)memory = m_FreeList;
+		m_FreeList = memory;
+		m_LiveCount--;
+	}
+
+	ObjectPoolStats ObjectPool::GetStats() const
+	{
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+		return { m_Name, m_ObjectSize, m_LiveCount, m_PeakCount, m_Slabs.size() * SlabObjectCount };
+	}
+
+	std::vector<ObjectPoolStats> ObjectPool::GetAllStats()
+	{
+		std::scoped_lock<std::mutex> lock(GetRegistryMutex());
+		std::vector<ObjectPoolStats> stats;
+		stats.reserve(GetRegistry().size());
+		for (ObjectPool* pool : GetRegistry())
+			stats.push_back(pool->GetStats());
+		return stats;
+	}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+namespace Hazel {
+
+	struct ObjectPoolStats
+	{
+		const char* Name;
+		uint64_t ObjectSize;
+		uint64_t LiveCount;
+		uint64_t PeakCount;
+		uint64_t Capacity;
+	};
+
+	// Slab allocator for objects of a single size. Objects are carved out of slabs of
+	// SlabObjectCount at a time and freed ones go on a free list, so creating and destroying
+	// them is cheap and the ones alive at the same time tend to sit next to each other.
+	// Slabs are kept until shutdown; the peak count says how much the pool grew to.
+	// Allocate and Free are safe to call from any thread.
+	class ObjectPool
+	{
+	public:
+		static const uint32_t SlabObjectCount = 64;
+
+		ObjectPool(const char* name, uint64_t objectSize, uint64_t alignment);
+		~ObjectPool();
+
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		// Anything larger than the pool's objects (a subclass without its own pool) goes to the heap
+		void* Allocate(uint64_t size);
+		void Free(void* memory, uint64_t size);
+
+		ObjectPoolStats GetStats() const;
+
+		// The pool for T, created on first use and never destroyed, so objects can be freed
+		// during static destruction
+		template<typename T>
+		static ObjectPool& Get(const char* name)
+		{
+			static ObjectPool* pool = new ObjectPool(name, sizeof(T), alignof(T));
+			return *pool;
+		}
+
+		// Every pool created so far, for diagnostics
+		static std::vector<ObjectPoolStats> GetAllStats();
+	private:
+		void AllocateSlab();
+	private:
+		const char* m_Name;
+		uint64_t m_ObjectSize;
+		uint64_t m_Alignment;
+
+		mutable std::mutex m_Mutex;
+		std::vector<void*> m_Slabs;
+		void* m_FreeList = nullptr;
+		uint64_t m_LiveCount = 0;
+		uint64_t m_PeakCount = 0;
+	};
+
+}
+
+// Opts a RefCounted class into pooled allocation: put it in the class body. Ref<T>::Create
+// (and any other new of the class) then takes the object from the class's ObjectPool, and
+// deleting it returns it there.
+#define HZ_POOLED_OBJECT(Type) \
+	public: \
+		static void* operator new(size_t size) { return ::Hazel::ObjectPool::Get<Type>(#Type).Allocate(size); } \
+		static void operator delete(void* memory, size_t size) { ::Hazel::ObjectPool::Get<Type>(#Type).Free(memory, size); }
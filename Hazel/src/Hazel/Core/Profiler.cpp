@@ -0,0 +1,307 @@
+#include "hzpch.h"
+#include "Profiler.h"
+
+#if HZ_ENABLE_PROFILING
+
+#include <imgui/imgui.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+
+namespace Hazel {
+
+	// Written only by its thread. Count is published after the event it covers, so readers on
+	// other threads see whole events; events the thread overwrites while being read are dropped.
+	struct ProfilerThreadBuffer
+	{
+		const char* Name = nullptr;
+		uint32_t ID = 0;
+
+		ProfileEvent Events[Profiler::ThreadEventCapacity];
+		std::atomic<uint64_t> Count = 0;
+
+		// Open scopes
+		const char* ScopeNames[Profiler::MaxDepth];
+		uint64_t ScopeStarts[Profiler::MaxDepth];
+		uint32_t Depth = 0;
+		// Scopes opened past MaxDepth; they aren't recorded, so their ends are ignored too
+		uint32_t DroppedDepth = 0;
+	};
+
+	struct ProfilerData
+	{
+		std::chrono::steady_clock::time_point Epoch = std::chrono::steady_clock::now();
+
+		// Buffers are kept after their thread exits, so its events can still be read
+		std::mutex Mutex;
+		std::vector<ProfilerThreadBuffer*> Threads;
+
+		uint64_t FrameStart = 0;
+		uint64_t LastFrameStart = 0;
+
+		// Flame view
+		bool Paused = false;
+		std::vector<ProfileThreadEvents> ShownThreads;
+		uint64_t ShownStart = 0, ShownEnd = 0;
+		std::string LastTracePath;
+	};
+
+	static ProfilerData s_Data;
+
+	static thread_local ProfilerThreadBuffer* t_Buffer = nullptr;
+
+	static ProfilerThreadBuffer& GetThreadBuffer()
+	{
+		if (!t_Buffer)
+		{
+			t_Buffer = new ProfilerThreadBuffer();
+			std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+			t_Buffer->ID = (uint32_t)s_Data.Threads.size();
+			s_Data.Threads.push_back(t_Buffer);
+		}
+		return *t_Buffer;
+	}
+
+	void Profiler::BeginScope(const char* name)
+	{
+		ProfilerThreadBuffer& buffer = GetThreadBuffer();
+		HZ_CORE_ASSERT(buffer.Depth < MaxDepth, "Profile scopes nested too deeply");
+		if (buffer.Depth >= MaxDepth)
+		{
+			buffer.DroppedDepth++;
+			return;
+		}
+
+		buffer.ScopeNames[buffer.Depth] = name;
+		buffer.ScopeStarts[buffer.Depth] = GetTime();
+		buffer.Depth++;
+	}
+
+	void Profiler::EndScope()
+	{
+		uint64_t end = GetTime();
+		ProfilerThreadBuffer& buffer = GetThreadBuffer();
+		if (buffer.DroppedDepth > 0)
+		{
+			buffer.DroppedDepth--;
+			return;
+		}
+		if (buffer.Depth == 0)
+			return;
+
+		buffer.Depth--;
+		uint64_t index = buffer.Count.load(std::memory_order_relaxed);
+		ProfileEvent& event = buffer.Events[index % ThreadEventCapacity];
+		event.Name = buffer.ScopeNames[buffer.Depth];
+		event.Start = buffer.ScopeStarts[buffer.Depth];
+		event.Duration = end - event.Start;
+		event.Depth = buffer.Depth;
+		buffer.Count.store(index + 1, std::memory_order_release);
+	}
+
+	void Profiler::SetThreadName(const char* name)
+	{
+		GetThreadBuffer().Name = name;
+	}
+
+	void Profiler::BeginFrame()
+	{
+		s_Data.LastFrameStart = s_Data.FrameStart;
+		s_Data.FrameStart = GetTime();
+	}
+
+	uint64_t Profiler::GetTime()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_Data.Epoch).count();
+	}
+
+	static void CopyEvents(const ProfilerThreadBuffer& buffer, uint64_t start, uint64_t end, std::vector<ProfileEvent>& outEvents)
+	{
+		uint64_t count = buffer.Count.load(std::memory_order_acquire);
+		uint64_t first = count > Profiler::ThreadEventCapacity ? count - Profiler::ThreadEventCapacity : 0;
+
+		size_t firstCopied = outEvents.size();
+		for (uint64_t i = first; i < count; i++)
+			outEvents.push_back(buffer.Events[i % Profiler::ThreadEventCapacity]);
+
+		// Drop what the thread overwrote while we were copying, then what is outside the range.
+		// It may already be writing event newCount, over the slot of event newCount - capacity.
+		uint64_t newCount = buffer.Count.load(std::memory_order_acquire);
+		uint64_t valid = newCount + 1 > Profiler::ThreadEventCapacity ? newCount + 1 - Profiler::ThreadEventCapacity : 0;
+		if (valid > first)
+			outEvents.erase(outEvents.begin() + firstCopied, outEvents.begin() + firstCopied + (size_t)std::min(valid - first, count - first));
+
+		auto outside = [start, end](const ProfileEvent& event) { return event.Start >= end || event.Start + event.Duration < start; };
+		outEvents.erase(std::remove_if(outEvents.begin() + firstCopied, outEvents.end(), outside), outEvents.end());
+	}
+
+	void Profiler::GetEvents(uint64_t start, uint64_t end, std::vector<ProfileThreadEvents>& outThreads)
+	{
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+		outThreads.resize(s_Data.Threads.size());
+		for (size_t i = 0; i < s_Data.Threads.size(); i++)
+		{
+			const ProfilerThreadBuffer& buffer = *s_Data.Threads[i];
+			ProfileThreadEvents& thread = outThreads[i];
+			thread.Name = buffer.Name;
+			thread.ID = buffer.ID;
+			thread.Events.clear();
+			CopyEvents(buffer, start, end, thread.Events);
+		}
+	}
+
+	void Profiler::GetLastFrame(uint64_t& outStart, uint64_t& outEnd)
+	{
+		outStart = s_Data.LastFrameStart;
+		outEnd = s_Data.FrameStart;
+	}
+
+	static void WriteJsonString(std::ofstream& out, const char* string)
+	{
+		out << '"';
+		for (const char* c = string; *c; c++)
+		{
+			if (*c == '"' || *c == '\\')
+				out << '\\';
+			out << *c;
+		}
+		out << '"';
+	}
+
+	bool Profiler::WriteChromeTrace(const std::string& filepath)
+	{
+		std::ofstream out(filepath);
+		if (!out)
+		{
+			HZ_CORE_ERROR("Could not write profile to {0}", filepath);
+			return false;
+		}
+
+		std::vector<ProfileThreadEvents> threads;
+		GetEvents(0, UINT64_MAX, threads);
+
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		bool first = true;
+		for (const ProfileThreadEvents& thread : threads)
+		{
+			if (thread.Name)
+			{
+				out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread.ID << ",\"args\":{\"name\":";
+				WriteJsonString(out, thread.Name);
+				out << "}}";
+				first = false;
+			}
+
+			// Microseconds, with the nanoseconds kept as fractions
+			char timing[64];
+			for (const ProfileEvent& event : thread.Events)
+			{
+				out << (first ? "" : ",") << "\n{\"name\":";
+				WriteJsonString(out, event.Name);
+				snprintf(timing, sizeof(timing), ",\"ts\":%.3f,\"dur\":%.3f", event.Start / 1000.0, event.Duration / 1000.0);
+				out << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread.ID << timing << "}";
+				first = false;
+			}
+		}
+		out << "\n]}\n";
+
+		HZ_CORE_INFO("Wrote profile to {0}", filepath);
+		return true;
+	}
+
+	static ImU32 GetScopeColor(const char* name)
+	{
+		// Same name, same color, across frames
+		uint32_t hash = 2166136261u;
+		for (const char* c = name; *c; c++)
+			hash = (hash ^ (uint8_t)*c) * 16777619u;
+
+		float hue = (hash % 360) / 360.0f;
+		ImVec4 color;
+		ImGui::ColorConvertHSVtoRGB(hue, 0.5f, 0.75f, color.x, color.y, color.z);
+		color.w = 1.0f;
+		return ImGui::ColorConvertFloat4ToU32(color);
+	}
+
+	void Profiler::OnImGuiRender()
+	{
+		ImGui::Begin("Profiler");
+
+		ImGui::Checkbox("Pause", &s_Data.Paused);
+		ImGui::SameLine();
+		if (ImGui::Button("Save Chrome Trace"))
+		{
+			s_Data.LastTracePath = "HazelProfile.json";
+			WriteChromeTrace(s_Data.LastTracePath);
+		}
+		if (!s_Data.LastTracePath.empty())
+		{
+			ImGui::SameLine();
+			ImGui::Text("Saved %s", s_Data.LastTracePath.c_str());
+		}
+
+		if (!s_Data.Paused)
+		{
+			GetLastFrame(s_Data.ShownStart, s_Data.ShownEnd);
+			GetEvents(s_Data.ShownStart, s_Data.ShownEnd, s_Data.ShownThreads);
+		}
+
+		uint64_t frameDuration = s_Data.ShownEnd - s_Data.ShownStart;
+		ImGui::Text("Frame: %.3f ms", frameDuration / 1000000.0);
+		if (!frameDuration)
+		{
+			ImGui::End();
+			return;
+		}
+
+		const float rowHeight = ImGui::GetFontSize() + 4.0f;
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		for (const ProfileThreadEvents& thread : s_Data.ShownThreads)
+		{
+			if (thread.Events.empty())
+				continue;
+
+			if (thread.Name)
+				ImGui::Text("%s", thread.Name);
+			else
+				ImGui::Text("Thread %u", thread.ID);
+
+			uint32_t depthCount = 0;
+			for (const ProfileEvent& event : thread.Events)
+				depthCount = std::max(depthCount, event.Depth + 1);
+
+			ImVec2 origin = ImGui::GetCursorScreenPos();
+			float width = ImGui::GetContentRegionAvailWidth();
+			float scale = width / (float)frameDuration;
+			ImGui::Dummy({ width, rowHeight * depthCount });
+
+			for (const ProfileEvent& event : thread.Events)
+			{
+				// Clipped to the frame, as scopes can straddle its boundaries
+				uint64_t start = std::max(event.Start, s_Data.ShownStart);
+				uint64_t end = std::min(event.Start + event.Duration, s_Data.ShownEnd);
+				ImVec2 min = { origin.x + (start - s_Data.ShownStart) * scale, origin.y + event.Depth * rowHeight };
+				ImVec2 max = { origin.x + (end - s_Data.ShownStart) * scale, min.y + rowHeight - 1.0f };
+				if (max.x - min.x < 1.0f)
+					max.x = min.x + 1.0f;
+
+				drawList->AddRectFilled(min, max, GetScopeColor(event.Name));
+				if (max.x - min.x > 20.0f)
+				{
+					ImVec4 clip = { min.x, min.y, max.x - 2.0f, max.y };
+					drawList->AddText(ImGui::GetFont(), ImGui::GetFontSize(), { min.x + 2.0f, min.y + 2.0f }, IM_COL32(0, 0, 0, 255), event.Name, nullptr, 0.0f, &clip);
+				}
+
+				if (ImGui::IsMouseHoveringRect(min, max))
+					ImGui::SetTooltip("%s\n%.3f ms", event.Name, event.Duration / 1000000.0);
+			}
+		}
+
+		ImGui::End();
+	}
+
+}
+
+#endif
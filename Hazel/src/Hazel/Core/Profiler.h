@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Profiling scopes are compiled out of distribution builds, along with the profiler itself
+#ifndef HZ_ENABLE_PROFILING
+	#ifdef HZ_DIST
+		#define HZ_ENABLE_PROFILING 0
+	#else
+		#define HZ_ENABLE_PROFILING 1
+	#endif
+#endif
+
+namespace Hazel {
+
+	struct ProfileEvent
+	{
+		const char* Name;
+		uint64_t Start;    // Nanoseconds since the profiler started
+		uint64_t Duration; // Nanoseconds
+		uint32_t Depth;    // Of enclosing scopes on the same thread
+	};
+
+	struct ProfileThreadEvents
+	{
+		const char* Name;
+		uint32_t ID;
+		std::vector<ProfileEvent> Events;
+	};
+
+	// Records nested, named scopes on every thread. Each thread writes the scopes it closes into
+	// its own ring buffer, without locks, so recording costs two clock reads; the oldest events
+	// are overwritten once a thread has recorded ThreadEventCapacity of them. Reading them back
+	// (the flame view, trace export) copies what is in the buffers at the time.
+	// Use the HZ_PROFILE_ macros rather than calling this directly, so it compiles out.
+	class Profiler
+	{
+	public:
+		static const uint32_t ThreadEventCapacity = 32768;
+		static const uint32_t MaxDepth = 64;
+
+		// Names are stored as pointers, so they must be string literals or otherwise never freed.
+		// Begin and End can be in different functions (or render commands), as long as they pair up
+		// on the thread.
+		static void BeginScope(const char* name);
+		static void EndScope();
+
+		// Shown in the flame view and traces; the same rule about lifetime applies
+		static void SetThreadName(const char* name);
+
+		// Called by the application at the start of every frame
+		static void BeginFrame();
+
+		static uint64_t GetTime();
+
+		// Events of every thread overlapping [start, end)
+		static void GetEvents(uint64_t start, uint64_t end, std::vector<ProfileThreadEvents>& outThreads);
+		static void GetLastFrame(uint64_t& outStart, uint64_t& outEnd);
+
+		// Everything still in the buffers, in the Chrome trace event format (chrome://tracing, Perfetto)
+		static bool WriteChromeTrace(const std::string& filepath);
+
+		// Flame graph of the last frame, one row of bars per thread and depth
+		static void OnImGuiRender();
+	};
+
+	class ProfileScope
+	{
+	public:
+		ProfileScope(const char* name) { Profiler::BeginScope(name); }
+		~ProfileScope() { Profiler::EndScope(); }
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+	};
+
+}
+
+#if HZ_ENABLE_PROFILING
+	#define HZ_PROFILE_CONCAT_IMPL(a, b) a##b
+	#define HZ_PROFILE_CONCAT(a, b) HZ_PROFILE_CONCAT_IMPL(a, b)
+	#define HZ_PROFILE_SCOPE(name) ::Hazel::ProfileScope HZ_PROFILE_CONCAT(profileScope, __LINE__)(name)
+	#define HZ_PROFILE_FUNCTION() HZ_PROFILE_SCOPE(__FUNCTION__)
+	#define HZ_PROFILE_BEGIN(name) ::Hazel::Profiler::BeginScope(name)
+	#define HZ_PROFILE_END() ::Hazel::Profiler::EndScope()
+	#define HZ_PROFILE_THREAD(name) ::Hazel::Profiler::SetThreadName(name)
+#else
+	#define HZ_PROFILE_SCOPE(name)
+	#define HZ_PROFILE_FUNCTION()
+	#define HZ_PROFILE_BEGIN(name)
+	#define HZ_PROFILE_END()
+	#define HZ_PROFILE_THREAD(name)
+#endif
@@ -0,0 +1,72 @@
+#include "hzpch.h"
+#include "Ref.h"
+
+#include <thread>
+
+namespace Hazel {
+
+	// Held for a handful of instructions, so spinning beats a mutex per object
+	static void LockControl(WeakRefControl& control)
+	{
+		while (control.Locked.exchange(true, std::memory_order_acquire))
+			std::this_thread::yield();
+	}
+
+	static void UnlockControl(WeakRefControl& control)
+	{
+		control.Locked.store(false, std::memory_order_release);
+	}
+
+	bool WeakRefControl::TryAcquire()
+	{
+		bool acquired = false;
+		LockControl(*this);
+		if (const RefCounted* object = Object.load(std::memory_order_relaxed))
+		{
+			// The count may have reached zero with the object not detached yet; it can't be revived
+			uint32_t count = object->m_RefCount.load(std::memory_order_relaxed);
+			while (count != 0 && !object->m_RefCount.compare_exchange_weak(count, count + 1, std::memory_order_relaxed))
+				;
+			acquired = count != 0;
+		}
+		UnlockControl(*this);
+		return acquired;
+	}
+
+	void WeakRefControl::Release()
+	{
+		if (WeakCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete this;
+	}
+
+	WeakRefControl* RefCounted::AcquireWeakControl() const
+	{
+		WeakRefControl* control = m_WeakControl.load(std::memory_order_acquire);
+		if (!control)
+		{
+			WeakRefControl* created = new WeakRefControl();
+			created->Object.store(this, std::memory_order_relaxed);
+			if (m_WeakControl.compare_exchange_strong(control, created, std::memory_order_acq_rel, std::memory_order_acquire))
+				control = created;
+			else
+				delete created;
+		}
+
+		// The object's own share keeps the block alive while the caller holds a Ref
+		control->WeakCount.fetch_add(1, std::memory_order_relaxed);
+		return control;
+	}
+
+	void RefCounted::DetachWeakRefs() const
+	{
+		WeakRefControl* control = m_WeakControl.load(std::memory_order_acquire);
+		if (!control)
+			return;
+
+		LockControl(*control);
+		control->Object.store(nullptr, std::memory_order_relaxed);
+		UnlockControl(*control);
+		control->Release();
+	}
+
+}
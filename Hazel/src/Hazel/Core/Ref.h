@@ -1,24 +1,64 @@
 #pragma once
 
 #include <stdint.h>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 
 namespace Hazel {
 
+	class RefCounted;
+
+	// Shared by an object and the WeakRefs to it, so they can tell once it has been deleted.
+	// Created the first time a WeakRef to the object is made.
+	struct WeakRefControl
+	{
+		// One per WeakRef, plus one held by the object while it is alive
+		std::atomic<uint32_t> WeakCount = 1;
+		std::atomic<bool> Locked = false;
+		std::atomic<const RefCounted*> Object = nullptr;
+
+		// Takes a strong reference to the object if it is still alive
+		bool TryAcquire();
+		void Release();
+	};
+
+	// Intrusive reference count. Refs can be copied and dropped from any thread: increments are
+	// relaxed, and decrements acquire-release so whichever thread deletes the object sees every
+	// write made through the other references.
 	class RefCounted
 	{
 	public:
+		RefCounted() = default;
+		// A copy is a new object, with no references yet
+		RefCounted(const RefCounted&) {}
+		RefCounted& operator=(const RefCounted&) { return *this; }
+
 		void IncRefCount() const
 		{
-			m_RefCount++;
+			m_RefCount.fetch_add(1, std::memory_order_relaxed);
 		}
-		void DecRefCount() const
+		// Returns the count left
+		uint32_t DecRefCount() const
 		{
-			m_RefCount--;
+			return m_RefCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
 		}
 
-		uint32_t GetRefCount() const { return m_RefCount; }
+		uint32_t GetRefCount() const { return m_RefCount.load(std::memory_order_relaxed); }
+	private:
+		WeakRefControl* AcquireWeakControl() const;
+		// Called with the count at zero, before the object is deleted
+		void DetachWeakRefs() const;
 	private:
-		mutable uint32_t m_RefCount = 0; // TODO: atomic
+		mutable std::atomic<uint32_t> m_RefCount = 0;
+		mutable std::atomic<WeakRefControl*> m_WeakControl = nullptr;
+
+		template<class T>
+		friend class Ref;
+		template<class T>
+		friend class WeakRef;
+		friend struct WeakRefControl;
 	};
 
 	template<typename T>
@@ -29,7 +69,7 @@ namespace Hazel {
 			: m_Instance(nullptr)
 		{
 		}
-		
+
 		Ref(std::nullptr_t n)
 			: m_Instance(nullptr)
 		{
@@ -128,6 +168,13 @@ namespace Hazel {
 			return Ref<T>(new T(std::forward<Args>(args)...));
 		}
 	private:
+		// Takes over a reference the caller already holds
+		struct AdoptTag {};
+		Ref(T* instance, AdoptTag)
+			: m_Instance(instance)
+		{
+		}
+
 		void IncRef() const
 		{
 			if (m_Instance)
@@ -136,21 +183,122 @@ namespace Hazel {
 
 		void DecRef() const
 		{
-			if (m_Instance)
+			// Only the thread taking the count to zero sees zero, so only one deletes
+			if (m_Instance && m_Instance->DecRefCount() == 0)
 			{
-				m_Instance->DecRefCount();
-				if (m_Instance->GetRefCount() == 0)
-				{
-					delete m_Instance;
-				}
+				m_Instance->DetachWeakRefs();
+				delete m_Instance;
 			}
 		}
 
 		template<class T2>
 		friend class Ref;
+		template<class T2>
+		friend class RefView;
+		template<class T2>
+		friend class WeakRef;
 		T* m_Instance;
 	};
 
-	// TODO: WeakRef
+	// Non-owning pointer to a ref counted object, for hot paths where something else is known
+	// to keep the object alive for as long as the view is used (per-frame draw lists, for
+	// instance). Copying one doesn't touch the count; turn it into a Ref to keep the object.
+	template<typename T>
+	class RefView
+	{
+	public:
+		RefView() = default;
+		RefView(std::nullptr_t) {}
+		RefView(T* instance)
+			: m_Instance(instance)
+		{
+		}
+
+		template<typename T2>
+		RefView(const Ref<T2>& ref)
+			: m_Instance(ref.m_Instance)
+		{
+		}
+
+		template<typename T2>
+		RefView(const RefView<T2>& other)
+			: m_Instance(other.m_Instance)
+		{
+		}
+
+		operator bool() const { return m_Instance != nullptr; }
+
+		T* operator->() const { return m_Instance; }
+		T& operator*() const { return *m_Instance; }
+		T* Raw() const { return m_Instance; }
+
+		Ref<T> ToRef() const { return Ref<T>(m_Instance); }
+
+		bool operator==(const RefView<T>& other) const { return m_Instance == other.m_Instance; }
+		bool operator!=(const RefView<T>& other) const { return m_Instance != other.m_Instance; }
+	private:
+		template<class T2>
+		friend class RefView;
+		T* m_Instance = nullptr;
+	};
+
+	// Refers to an object without keeping it alive. Lock returns a Ref to it, or null once it
+	// has been deleted; that check and taking the reference happen atomically, so a locked
+	// Ref is always safe to use, on any thread.
+	template<typename T>
+	class WeakRef
+	{
+	public:
+		WeakRef() = default;
+		WeakRef(std::nullptr_t) {}
+
+		WeakRef(const Ref<T>& ref)
+			: m_Instance(ref.m_Instance)
+		{
+			if (m_Instance)
+				m_Control = m_Instance->AcquireWeakControl();
+		}
+
+		WeakRef(const WeakRef<T>& other)
+			: m_Instance(other.m_Instance), m_Control(other.m_Control)
+		{
+			if (m_Control)
+				m_Control->WeakCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		WeakRef(WeakRef<T>&& other) noexcept
+			: m_Instance(other.m_Instance), m_Control(other.m_Control)
+		{
+			other.m_Instance = nullptr;
+			other.m_Control = nullptr;
+		}
+
+		~WeakRef()
+		{
+			if (m_Control)
+				m_Control->Release();
+		}
+
+		WeakRef& operator=(WeakRef<T> other)
+		{
+			std::swap(m_Instance, other.m_Instance);
+			std::swap(m_Control, other.m_Control);
+			return *this;
+		}
+
+		Ref<T> Lock() const
+		{
+			if (m_Control && m_Control->TryAcquire())
+				return Ref<T>(m_Instance, typename Ref<T>::AdoptTag());
+
+			return nullptr;
+		}
+
+		// Only a hint on its own; another thread may drop the last Ref right after
+		bool IsValid() const { return m_Control && m_Control->Object.load(std::memory_order_relaxed) != nullptr; }
+	private:
+		T* m_Instance = nullptr;
+		WeakRefControl* m_Control = nullptr;
+	};
 
-}
\ No newline at end of file
+}
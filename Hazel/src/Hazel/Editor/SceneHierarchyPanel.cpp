@@ -10,6 +10,7 @@
 #include "Hazel/Physics/PhysicsLayer.h"
 #include "Hazel/Physics/PXPhysicsWrappers.h"
 #include "Hazel/Renderer/MeshFactory.h"
+#include "Hazel/Asset/AssetManager.h"
 
 #include <assimp/scene.h>
 
@@ -175,9 +176,10 @@ namespace Hazel {
 		sprintf(imguiName, "Mesh##%d", imguiMeshID++);
 
 		// Mesh Hierarchy
-		if (ImGui::TreeNode(imguiName))
+		const aiScene* scene = mesh->GetSource().m_Scene;
+		if (scene && ImGui::TreeNode(imguiName))
 		{
-			auto rootNode = mesh->m_Scene->mRootNode;
+			auto rootNode = scene->mRootNode;
 			MeshNodeHierarchy(mesh, rootNode);
 			ImGui::TreePop();
 		}
@@ -533,9 +535,29 @@ namespace Hazel {
 			{
 				std::string file = Application::Get().OpenFile();
 				if (!file.empty())
-					mc.Mesh = Ref<Mesh>::Create(file);
+					mc.Mesh = AssetManager::LoadMesh(file);
 			}
 			ImGui::Columns(1);
+
+			if (mc.Mesh)
+			{
+				const char* residencyStrings[] = { "Keep All", "Keep Collision", "GPU Only" };
+				int residency = (int)mc.Mesh->GetResidency();
+				if (ImGui::Combo("CPU Residency", &residency, residencyStrings, 3))
+				{
+					// Residency is part of the asset key, so this switches to another (possibly shared) source mesh
+					mc.Mesh = AssetManager::LoadMesh(mc.Mesh->GetFilePath(), (MeshResidency)residency);
+				}
+
+				MeshMemoryStats stats = mc.Mesh->GetMemoryStats();
+				auto toKB = [](uint64_t bytes) { return (float)bytes / 1024.0f; };
+				ImGui::Text("CPU Memory: %.1f KB", toKB(stats.GetCPUTotal()));
+				ImGui::Text("  Vertices: %.1f KB", toKB(stats.VertexData + stats.PositionData));
+				ImGui::Text("  Indices: %.1f KB", toKB(stats.IndexData));
+				ImGui::Text("  BVH: %.1f KB", toKB(stats.BVHData));
+				ImGui::Text("  Importer: %.1f KB", toKB(stats.ImporterData));
+				ImGui::Text("GPU Memory: %.1f KB", toKB(stats.GetGPUTotal()));
+			}
 		});
 
 		DrawComponent<CameraComponent>("Camera", entity, [](CameraComponent& cc)
@@ -629,7 +651,7 @@ namespace Hazel {
 			{
 				std::string file = Application::Get().OpenFile("*.hdr");
 				if (!file.empty())
-					slc.SceneEnvironment = Environment::Load(file);
+					slc.SceneEnvironment = AssetManager::LoadEnvironment(file);
 			}
 			ImGui::Columns(1);
 			
@@ -940,7 +962,7 @@ namespace Hazel {
 				std::string file = Application::Get().OpenFile();
 				if (!file.empty())
 				{
-					mcc.CollisionMesh = Ref<Mesh>::Create(file);
+					mcc.CollisionMesh = AssetManager::LoadMesh(file);
 					if (mcc.IsConvex)
 						PXPhysicsWrappers::CreateConvexMesh(mcc, true);
 					else
@@ -0,0 +1,297 @@
+#include "hzpch.h"
+#include "AssetPack.h"
+
+#include "Hazel/FileSystem/LZ4.h"
+
+namespace Hazel {
+
+	static const uint32_t s_RawBlockFlag = 0x80000000u;
+
+	// Written so that a corrupt offset can't wrap around and pass
+	static bool IsRangeInside(uint64_t offset, uint64_t length, uint64_t size)
+	{
+		return offset <= size && length <= size - offset;
+	}
+
+	uint64_t AssetPack::HashPath(const std::string& path)
+	{
+		// FNV-1a
+		uint64_t hash = 14695981039346656037ull;
+		for (char c : path)
+		{
+			hash ^= (uint8_t)c;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	bool AssetPack::Open(const std::string& filepath)
+	{
+		m_FilePath = filepath;
+		if (!m_File.Open(filepath))
+		{
+			HZ_CORE_ERROR("AssetPack: could not open {0}", filepath);
+			return false;
+		}
+
+		const uint8_t* data = m_File.GetData();
+		uint64_t size = m_File.GetSize();
+
+		const AssetPackHeader* header = (const AssetPackHeader*)data;
+		if (size < sizeof(AssetPackHeader) || memcmp(header->Magic, Magic, sizeof(Magic)) != 0)
+		{
+			HZ_CORE_ERROR("AssetPack: {0} is not an asset pack", filepath);
+			m_File.Close();
+			return false;
+		}
+
+		if (header->Version != Version)
+		{
+			HZ_CORE_ERROR("AssetPack: {0} has version {1}, expected {2}", filepath, header->Version, Version);
+			m_File.Close();
+			return false;
+		}
+
+		if (header->BlockSize == 0)
+		{
+			HZ_CORE_ERROR("AssetPack: {0} has no block size", filepath);
+			m_File.Close();
+			return false;
+		}
+
+		uint64_t tableSize = (uint64_t)header->EntryCount * sizeof(AssetPackEntry);
+		if (!IsRangeInside(header->TableOffset, tableSize, size) || !IsRangeInside(header->StringsOffset, header->StringsSize, size))
+		{
+			HZ_CORE_ERROR("AssetPack: {0} is truncated", filepath);
+			m_File.Close();
+			return false;
+		}
+
+		m_Header = header;
+		m_Entries = (const AssetPackEntry*)(data + header->TableOffset);
+		m_Strings = (const char*)(data + header->StringsOffset);
+
+		for (uint32_t i = 0; i < header->EntryCount; i++)
+		{
+			const AssetPackEntry& entry = m_Entries[i];
+			bool valid = IsRangeInside(entry.DataOffset, entry.StoredSize, size) && IsRangeInside(entry.PathOffset, entry.PathLength, header->StringsSize);
+			switch (entry.Compression)
+			{
+				// Read straight from the mapping, so the stored bytes must be the whole entry
+				case AssetPackCompression::None: valid = valid && entry.Size == entry.StoredSize; break;
+				case AssetPackCompression::LZ4:  break;
+				default:                         valid = false; break;
+			}
+
+			if (!valid)
+			{
+				HZ_CORE_ERROR("AssetPack: {0} has a corrupt entry table", filepath);
+				m_Header = nullptr;
+				m_Entries = nullptr;
+				m_Strings = nullptr;
+				m_File.Close();
+				return false;
+			}
+		}
+
+		HZ_CORE_INFO("AssetPack: mounted {0} ({1} entries)", filepath, header->EntryCount);
+		return true;
+	}
+
+	std::string AssetPack::GetEntryPath(const AssetPackEntry& entry) const
+	{
+		return std::string(m_Strings + entry.PathOffset, entry.PathLength);
+	}
+
+	const AssetPackEntry* AssetPack::FindEntry(const std::string& path) const
+	{
+		if (!m_Header)
+			return nullptr;
+
+		uint64_t hash = HashPath(path);
+		const AssetPackEntry* end = m_Entries + m_Header->EntryCount;
+		const AssetPackEntry* it = std::lower_bound(m_Entries, end, hash, [](const AssetPackEntry& entry, uint64_t value) { return entry.PathHash < value; });
+		for (; it != end && it->PathHash == hash; it++)
+		{
+			if (it->PathLength == path.size() && memcmp(m_Strings + it->PathOffset, path.data(), path.size()) == 0)
+				return it;
+		}
+		return nullptr;
+	}
+
+	bool AssetPack::ReadEntry(const AssetPackEntry& entry, uint8_t* destination) const
+	{
+		const uint8_t* source = GetEntryData(entry);
+		if (entry.Compression == AssetPackCompression::None)
+		{
+			memcpy(destination, source, entry.Size);
+			return true;
+		}
+
+		const uint8_t* sourceEnd = source + entry.StoredSize;
+		uint64_t remaining = entry.Size;
+		while (remaining > 0)
+		{
+			// Each block, prefix included, has to fit in what's left of the entry
+			uint64_t available = (uint64_t)(sourceEnd - source);
+			if (available < sizeof(uint32_t))
+				return false;
+
+			uint32_t prefix;
+			memcpy(&prefix, source, sizeof(prefix));
+			source += sizeof(prefix);
+			available -= sizeof(prefix);
+
+			uint32_t storedSize = prefix & ~s_RawBlockFlag;
+			uint32_t blockSize = (uint32_t)std::min<uint64_t>(remaining, m_Header->BlockSize);
+			if (storedSize > available)
+				return false;
+
+			if (prefix & s_RawBlockFlag)
+			{
+				if (storedSize != blockSize)
+					return false;
+				memcpy(destination, source, blockSize);
+			}
+			else if (LZ4::Decompress(source, storedSize, destination, blockSize) != blockSize)
+			{
+				return false;
+			}
+
+			source += storedSize;
+			destination += blockSize;
+			remaining -= blockSize;
+		}
+		return true;
+	}
+
+	AssetPackWriter::AssetPackWriter(uint32_t alignment, uint32_t blockSize)
+		: m_Alignment(alignment), m_BlockSize(blockSize)
+	{
+		HZ_CORE_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+	}
+
+	AssetPackWriter::~AssetPackWriter()
+	{
+		if (m_File)
+			fclose(m_File);
+	}
+
+	bool AssetPackWriter::Open(const std::string& filepath)
+	{
+		m_File = fopen(filepath.c_str(), "wb");
+		if (!m_File)
+			return false;
+
+		// Filled in by Finalize
+		AssetPackHeader header = {};
+		m_Offset = fwrite(&header, 1, sizeof(header), m_File);
+		return m_Offset == sizeof(header);
+	}
+
+	bool AssetPackWriter::WritePadding()
+	{
+		static const uint8_t zeros[256] = {};
+		uint64_t padding = (m_Alignment - (m_Offset % m_Alignment)) % m_Alignment;
+		while (padding > 0)
+		{
+			size_t count = (size_t)std::min<uint64_t>(padding, sizeof(zeros));
+			if (fwrite(zeros, 1, count, m_File) != count)
+				return false;
+			m_Offset += count;
+			padding -= count;
+		}
+		return true;
+	}
+
+	bool AssetPackWriter::AddFile(const std::string& path, const void* data, uint64_t size, bool compress)
+	{
+		HZ_CORE_ASSERT(m_File, "AssetPackWriter isn't open");
+		if (!WritePadding())
+			return false;
+
+		AssetPackEntry& entry = m_Entries.emplace_back();
+		entry = {};
+		entry.PathHash = AssetPack::HashPath(path);
+		entry.DataOffset = m_Offset;
+		entry.Size = size;
+		entry.PathOffset = (uint32_t)m_Strings.size();
+		entry.PathLength = (uint32_t)path.size();
+		m_Strings += path;
+
+		std::vector<uint8_t> compressed;
+		if (compress && size > 0)
+		{
+			const uint8_t* source = (const uint8_t*)data;
+			std::vector<uint8_t> block(LZ4::GetCompressBound(m_BlockSize));
+			for (uint64_t offset = 0; offset < size; offset += m_BlockSize)
+			{
+				uint32_t blockSize = (uint32_t)std::min<uint64_t>(size - offset, m_BlockSize);
+				uint32_t storedSize = LZ4::Compress(source + offset, blockSize, block.data(), (uint32_t)block.size());
+
+				const uint8_t* blockData = block.data();
+				uint32_t prefix = storedSize;
+				if (storedSize == 0 || storedSize >= blockSize)
+				{
+					blockData = source + offset;
+					storedSize = blockSize;
+					prefix = blockSize | s_RawBlockFlag;
+				}
+
+				compressed.insert(compressed.end(), (const uint8_t*)&prefix, (const uint8_t*)&prefix + sizeof(prefix));
+				compressed.insert(compressed.end(), blockData, blockData + storedSize);
+			}
+
+			// Not worth paying for decompression unless it saves at least ~5%
+			if (compressed.size() >= size - size / 20)
+				compressed.clear();
+		}
+
+		const void* stored = data;
+		entry.StoredSize = size;
+		entry.Compression = AssetPackCompression::None;
+		if (!compressed.empty())
+		{
+			stored = compressed.data();
+			entry.StoredSize = compressed.size();
+			entry.Compression = AssetPackCompression::LZ4;
+		}
+
+		if (fwrite(stored, 1, (size_t)entry.StoredSize, m_File) != entry.StoredSize)
+			return false;
+
+		m_Offset += entry.StoredSize;
+		m_TotalSize += size;
+		m_StoredSize += entry.StoredSize;
+		return true;
+	}
+
+	bool AssetPackWriter::Finalize()
+	{
+		HZ_CORE_ASSERT(m_File, "AssetPackWriter isn't open");
+		std::sort(m_Entries.begin(), m_Entries.end(), [](const AssetPackEntry& a, const AssetPackEntry& b) { return a.PathHash < b.PathHash; });
+
+		if (!WritePadding())
+			return false;
+
+		AssetPackHeader header = {};
+		memcpy(header.Magic, AssetPack::Magic, sizeof(header.Magic));
+		header.Version = AssetPack::Version;
+		header.EntryCount = (uint32_t)m_Entries.size();
+		header.Alignment = m_Alignment;
+		header.BlockSize = m_BlockSize;
+		header.TableOffset = m_Offset;
+		header.StringsOffset = m_Offset + m_Entries.size() * sizeof(AssetPackEntry);
+		header.StringsSize = m_Strings.size();
+
+		bool success = fwrite(m_Entries.data(), sizeof(AssetPackEntry), m_Entries.size(), m_File) == m_Entries.size();
+		success = success && fwrite(m_Strings.data(), 1, m_Strings.size(), m_File) == m_Strings.size();
+		success = success && fseek(m_File, 0, SEEK_SET) == 0;
+		success = success && fwrite(&header, sizeof(header), 1, m_File) == 1;
+
+		success = fclose(m_File) == 0 && success;
+		m_File = nullptr;
+		return success;
+	}
+
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Hazel/FileSystem/MappedFile.h"
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace Hazel {
+
+	// Pack layout, little endian:
+	//   AssetPackHeader
+	//   Entry data, each entry starting on a multiple of the header's alignment so
+	//   uncompressed entries can be used straight from the mapping
+	//   AssetPackEntry table, sorted by path hash
+	//   Path strings
+	//
+	// LZ4 entries are split into independently compressed blocks of BlockSize bytes (before
+	// compression), each prefixed by its stored size. Blocks that don't shrink are stored raw,
+	// flagged by the top bit of the prefix.
+
+	enum class AssetPackCompression : uint32_t
+	{
+		None = 0, LZ4 = 1
+	};
+
+	struct AssetPackHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint32_t EntryCount;
+		uint32_t Alignment;
+		uint32_t BlockSize;
+		uint32_t Reserved;
+		uint64_t TableOffset;
+		uint64_t StringsOffset;
+		uint64_t StringsSize;
+	};
+
+	struct AssetPackEntry
+	{
+		uint64_t PathHash;
+		uint64_t DataOffset;
+		uint64_t StoredSize; // Bytes in the pack
+		uint64_t Size;       // Bytes once decompressed
+		uint32_t PathOffset; // Into the string table
+		uint32_t PathLength;
+		AssetPackCompression Compression;
+		uint32_t Reserved;
+	};
+
+	static_assert(sizeof(AssetPackHeader) == 48, "AssetPackHeader layout changed");
+	static_assert(sizeof(AssetPackEntry) == 48, "AssetPackEntry layout changed");
+
+	// Read-only view of a memory-mapped pack. Lookups and reads don't modify any state,
+	// so they're safe from any number of threads.
+	class AssetPack
+	{
+	public:
+		static constexpr char Magic[4] = { 'H', 'Z', 'P', 'K' };
+		static constexpr uint32_t Version = 1;
+
+		bool Open(const std::string& filepath);
+
+		const std::string& GetFilePath() const { return m_FilePath; }
+		uint32_t GetEntryCount() const { return m_Header ? m_Header->EntryCount : 0; }
+		const AssetPackEntry& GetEntry(uint32_t index) const { return m_Entries[index]; }
+		std::string GetEntryPath(const AssetPackEntry& entry) const;
+
+		// Paths are expected in FileSystem::NormalizePath form
+		const AssetPackEntry* FindEntry(const std::string& path) const;
+
+		// Points into the mapping; only usable as-is if the entry is uncompressed
+		const uint8_t* GetEntryData(const AssetPackEntry& entry) const { return m_File.GetData() + entry.DataOffset; }
+		// Decompresses if needed; destination must hold entry.Size bytes
+		bool ReadEntry(const AssetPackEntry& entry, uint8_t* destination) const;
+
+		static uint64_t HashPath(const std::string& path);
+	private:
+		MappedFile m_File;
+		std::string m_FilePath;
+		const AssetPackHeader* m_Header = nullptr;
+		const AssetPackEntry* m_Entries = nullptr;
+		const char* m_Strings = nullptr;
+	};
+
+	// Streams entries straight to disk; the table is written by Finalize
+	class AssetPackWriter
+	{
+	public:
+		AssetPackWriter(uint32_t alignment = 64, uint32_t blockSize = 256 * 1024);
+		~AssetPackWriter();
+
+		bool Open(const std::string& filepath);
+		// Compressed data is only kept if it's noticeably smaller than the original
+		bool AddFile(const std::string& path, const void* data, uint64_t size, bool compress = true);
+		bool Finalize();
+
+		uint64_t GetTotalSize() const { return m_TotalSize; }
+		uint64_t GetStoredSize() const { return m_StoredSize; }
+	private:
+		bool WritePadding();
+	private:
+		FILE* m_File = nullptr;
+		uint32_t m_Alignment;
+		uint32_t m_BlockSize;
+		uint64_t m_Offset = 0;
+
+		std::vector<AssetPackEntry> m_Entries;
+		std::string m_Strings;
+
+		uint64_t m_TotalSize = 0;
+		uint64_t m_StoredSize = 0;
+	};
+
+}
@@ -0,0 +1,176 @@
+#include "hzpch.h"
+#include "FileSystem.h"
+
+#include "Hazel/FileSystem/AssetPack.h"
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+namespace Hazel {
+
+	struct FileSystemData
+	{
+		std::vector<Scope<AssetPack>> Packs;
+	};
+
+	static FileSystemData s_Data;
+
+	// Most recently mounted packs take priority
+	static const AssetPackEntry* FindPackEntry(const std::string& normalizedPath, const AssetPack*& outPack)
+	{
+		for (auto it = s_Data.Packs.rbegin(); it != s_Data.Packs.rend(); it++)
+		{
+			if (const AssetPackEntry* entry = (*it)->FindEntry(normalizedPath))
+			{
+				outPack = it->get();
+				return entry;
+			}
+		}
+		return nullptr;
+	}
+
+	void FileSystem::Init()
+	{
+		std::vector<std::string> packs;
+		for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::current_path()))
+		{
+			if (entry.is_regular_file() && entry.path().extension() == ".hpk")
+				packs.push_back(entry.path().filename().string());
+		}
+
+		// Deterministic priority: later names override earlier ones
+		std::sort(packs.begin(), packs.end());
+		for (const auto& pack : packs)
+			Mount(pack);
+	}
+
+	void FileSystem::Shutdown()
+	{
+		UnmountAll();
+	}
+
+	bool FileSystem::Mount(const std::string& packPath)
+	{
+		Scope<AssetPack> pack = CreateScope<AssetPack>();
+		if (!pack->Open(packPath))
+			return false;
+
+		s_Data.Packs.push_back(std::move(pack));
+		return true;
+	}
+
+	void FileSystem::UnmountAll()
+	{
+		s_Data.Packs.clear();
+	}
+
+	bool FileSystem::Exists(const std::string& path)
+	{
+		const AssetPack* pack;
+		if (FindPackEntry(NormalizePath(path), pack))
+			return true;
+
+		return std::filesystem::is_regular_file(path);
+	}
+
+	bool FileSystem::IsDirectory(const std::string& path)
+	{
+		if (std::filesystem::is_directory(path))
+			return true;
+
+		std::string prefix = NormalizePath(path) + "/";
+		for (const auto& pack : s_Data.Packs)
+		{
+			for (uint32_t i = 0; i < pack->GetEntryCount(); i++)
+			{
+				if (pack->GetEntryPath(pack->GetEntry(i)).compare(0, prefix.size(), prefix) == 0)
+					return true;
+			}
+		}
+		return false;
+	}
+
+	FileData FileSystem::ReadFile(const std::string& path)
+	{
+		const AssetPack* pack;
+		std::string normalizedPath = NormalizePath(path);
+		if (const AssetPackEntry* entry = FindPackEntry(normalizedPath, pack))
+		{
+			if (entry->Compression == AssetPackCompression::None)
+				return FileData(pack->GetEntryData(*entry), entry->Size);
+
+			std::vector<uint8_t> data(entry->Size);
+			if (!pack->ReadEntry(*entry, data.data()))
+			{
+				HZ_CORE_ERROR("FileSystem: {0} is corrupt in {1}", normalizedPath, pack->GetFilePath());
+				return FileData();
+			}
+			return FileData(std::move(data));
+		}
+
+		std::ifstream stream(path, std::ios::in | std::ios::binary);
+		if (!stream)
+			return FileData();
+
+		stream.seekg(0, std::ios::end);
+		std::vector<uint8_t> data((size_t)stream.tellg());
+		stream.seekg(0, std::ios::beg);
+		stream.read((char*)data.data(), data.size());
+		return FileData(std::move(data));
+	}
+
+	std::string FileSystem::ReadTextFile(const std::string& path)
+	{
+		FileData file = ReadFile(path);
+		return file.ToString();
+	}
+
+	std::vector<std::string> FileSystem::GetFiles(const std::string& directory)
+	{
+		std::set<std::string> files;
+
+		std::string prefix = NormalizePath(directory) + "/";
+		for (const auto& pack : s_Data.Packs)
+		{
+			for (uint32_t i = 0; i < pack->GetEntryCount(); i++)
+			{
+				std::string path = pack->GetEntryPath(pack->GetEntry(i));
+				if (path.compare(0, prefix.size(), prefix) == 0 && path.find('/', prefix.size()) == std::string::npos)
+					files.insert(path);
+			}
+		}
+
+		if (std::filesystem::is_directory(directory))
+		{
+			for (const auto& entry : std::filesystem::directory_iterator(directory))
+			{
+				if (entry.is_regular_file())
+					files.insert(NormalizePath(entry.path().string()));
+			}
+		}
+
+		return std::vector<std::string>(files.begin(), files.end());
+	}
+
+	std::string FileSystem::NormalizePath(const std::string& path)
+	{
+		std::filesystem::path result = std::filesystem::path(path).lexically_normal();
+		if (result.is_absolute())
+		{
+			std::filesystem::path relative = result.lexically_relative(std::filesystem::current_path());
+			if (!relative.empty() && *relative.begin() != "..")
+				result = relative;
+		}
+
+		std::string normalized = result.generic_string();
+		if (!normalized.empty() && normalized.back() == '/')
+			normalized.pop_back();
+#ifdef HZ_PLATFORM_WINDOWS
+		// Paths are case insensitive on Windows
+		std::transform(normalized.begin(), normalized.end(), normalized.begin(), [](char c) { return (char)::tolower(c); });
+#endif
+		return normalized;
+	}
+
+}
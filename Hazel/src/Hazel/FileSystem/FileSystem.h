@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace Hazel {
+
+	// Contents of a file read through the FileSystem. Uncompressed pack entries point straight
+	// into the mapped pack; everything else is an owned copy.
+	class FileData
+	{
+	public:
+		FileData() = default;
+		FileData(const uint8_t* mapped, uint64_t size)
+			: m_Data(mapped), m_Size(size) {}
+		FileData(std::vector<uint8_t>&& storage)
+			: m_Storage(std::move(storage)), m_Data(m_Storage.data()), m_Size(m_Storage.size()), m_Valid(true) {}
+
+		FileData(FileData&& other) noexcept { *this = std::move(other); }
+		FileData& operator=(FileData&& other) noexcept
+		{
+			bool owned = !other.m_Storage.empty();
+			m_Storage = std::move(other.m_Storage);
+			m_Data = owned ? m_Storage.data() : other.m_Data;
+			m_Size = other.m_Size;
+			m_Valid = other.m_Valid || other.m_Data;
+			other.m_Data = nullptr;
+			other.m_Size = 0;
+			other.m_Valid = false;
+			return *this;
+		}
+
+		const uint8_t* GetData() const { return m_Data; }
+		uint64_t GetSize() const { return m_Size; }
+		std::string ToString() const { return std::string((const char*)m_Data, (size_t)m_Size); }
+
+		// Empty files are valid too
+		bool IsValid() const { return m_Valid || m_Data; }
+		operator bool() const { return IsValid(); }
+	private:
+		std::vector<uint8_t> m_Storage;
+		const uint8_t* m_Data = nullptr;
+		uint64_t m_Size = 0;
+		bool m_Valid = false;
+	};
+
+	// Resolves asset paths against mounted packs first (most recently mounted wins), then loose
+	// files on disk. Packs should be mounted before loading starts: reads are thread-safe,
+	// mounting and unmounting are not, and unmounting invalidates FileData views into the pack.
+	class FileSystem
+	{
+	public:
+		// Mounts every .hpk pack in the working directory
+		static void Init();
+		static void Shutdown();
+
+		static bool Mount(const std::string& packPath);
+		static void UnmountAll();
+
+		static bool Exists(const std::string& path);
+		static bool IsDirectory(const std::string& path);
+		static FileData ReadFile(const std::string& path);
+		static std::string ReadTextFile(const std::string& path);
+
+		// Full paths of the files directly inside a directory, from packs and disk
+		static std::vector<std::string> GetFiles(const std::string& directory);
+
+		// Relative to the working directory when possible, '/' separated, lowercase on Windows
+		static std::string NormalizePath(const std::string& path);
+	};
+
+}
@@ -0,0 +1,190 @@
+#include "hzpch.h"
+#include "LZ4.h"
+
+namespace Hazel {
+
+	static const uint32_t s_MinMatch = 4;
+	static const uint32_t s_LastLiterals = 5;  // The last five bytes are always literals
+	static const uint32_t s_MatchFindLimit = 12; // No match may start in the last twelve bytes
+	static const uint32_t s_MaxOffset = 65535;
+	static const uint32_t s_HashLog = 16;
+
+	static inline uint32_t Read32(const uint8_t* p)
+	{
+		uint32_t value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	static inline uint32_t Hash(uint32_t sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - s_HashLog);
+	}
+
+	static inline uint8_t* WriteLength(uint8_t* op, uint32_t length)
+	{
+		while (length >= 255)
+		{
+			*op++ = 255;
+			length -= 255;
+		}
+		*op++ = (uint8_t)length;
+		return op;
+	}
+
+	uint32_t LZ4::Compress(const void* src, uint32_t srcSize, void* dst, uint32_t dstCapacity)
+	{
+		const uint8_t* source = (const uint8_t*)src;
+		uint8_t* op = (uint8_t*)dst;
+		uint8_t* const opEnd = op + dstCapacity;
+
+		uint32_t anchor = 0;
+		if (srcSize > s_MatchFindLimit)
+		{
+			// Positions are stored +1 so zero means empty
+			std::vector<uint32_t> table((size_t)1 << s_HashLog, 0);
+
+			const uint32_t matchLimit = srcSize - s_LastLiterals;
+			const uint32_t inputLimit = srcSize - s_MatchFindLimit;
+
+			uint32_t ip = 0;
+			uint32_t misses = 0;
+			while (ip < inputLimit)
+			{
+				uint32_t sequence = Read32(source + ip);
+				uint32_t& slot = table[Hash(sequence)];
+				uint32_t candidate = slot;
+				slot = ip + 1;
+
+				if (candidate == 0 || ip - (candidate - 1) > s_MaxOffset || Read32(source + candidate - 1) != sequence)
+				{
+					// Skip ahead faster through data that doesn't compress
+					ip += 1 + (misses++ >> 6);
+					continue;
+				}
+				misses = 0;
+
+				uint32_t match = candidate - 1;
+				uint32_t matchLength = s_MinMatch;
+				while (ip + matchLength < matchLimit && source[match + matchLength] == source[ip + matchLength])
+					matchLength++;
+
+				uint32_t literalLength = ip - anchor;
+				uint64_t worstCase = 1 + (literalLength / 255 + 1) + literalLength + 2 + (matchLength / 255 + 1);
+				if (op + worstCase > opEnd)
+					return 0;
+
+				uint8_t* token = op++;
+				*token = (uint8_t)(std::min(literalLength, 15u) << 4);
+				if (literalLength >= 15)
+					op = WriteLength(op, literalLength - 15);
+				memcpy(op, source + anchor, literalLength);
+				op += literalLength;
+
+				uint16_t offset = (uint16_t)(ip - match);
+				*op++ = (uint8_t)(offset & 0xff);
+				*op++ = (uint8_t)(offset >> 8);
+
+				uint32_t extraLength = matchLength - s_MinMatch;
+				*token |= (uint8_t)std::min(extraLength, 15u);
+				if (extraLength >= 15)
+					op = WriteLength(op, extraLength - 15);
+
+				ip += matchLength;
+				anchor = ip;
+			}
+		}
+
+		// Trailing literals
+		uint32_t literalLength = srcSize - anchor;
+		uint64_t worstCase = 1 + (literalLength / 255 + 1) + literalLength;
+		if (op + worstCase > opEnd)
+			return 0;
+
+		*op++ = (uint8_t)(std::min(literalLength, 15u) << 4);
+		if (literalLength >= 15)
+			op = WriteLength(op, literalLength - 15);
+		if (literalLength > 0)
+			memcpy(op, source + anchor, literalLength);
+		op += literalLength;
+
+		return (uint32_t)(op - (uint8_t*)dst);
+	}
+
+	int64_t LZ4::Decompress(const void* src, uint32_t srcSize, void* dst, uint32_t dstCapacity)
+	{
+		const uint8_t* ip = (const uint8_t*)src;
+		const uint8_t* const ipEnd = ip + srcSize;
+		uint8_t* op = (uint8_t*)dst;
+		uint8_t* const opStart = op;
+		uint8_t* const opEnd = op + dstCapacity;
+
+		while (ip < ipEnd)
+		{
+			uint8_t token = *ip++;
+
+			size_t literalLength = token >> 4;
+			if (literalLength == 15)
+			{
+				uint8_t byte;
+				do
+				{
+					if (ip >= ipEnd)
+						return -1;
+					byte = *ip++;
+					literalLength += byte;
+				} while (byte == 255);
+			}
+
+			if (literalLength > (size_t)(ipEnd - ip) || literalLength > (size_t)(opEnd - op))
+				return -1;
+			memcpy(op, ip, literalLength);
+			ip += literalLength;
+			op += literalLength;
+
+			// The last sequence has literals only
+			if (ip == ipEnd)
+				break;
+
+			if (ipEnd - ip < 2)
+				return -1;
+			size_t offset = ip[0] | (ip[1] << 8);
+			ip += 2;
+			if (offset == 0 || offset > (size_t)(op - opStart))
+				return -1;
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15)
+			{
+				uint8_t byte;
+				do
+				{
+					if (ip >= ipEnd)
+						return -1;
+					byte = *ip++;
+					matchLength += byte;
+				} while (byte == 255);
+			}
+			matchLength += s_MinMatch;
+
+			if (matchLength > (size_t)(opEnd - op))
+				return -1;
+
+			const uint8_t* match = op - offset;
+			if (offset >= matchLength)
+			{
+				memcpy(op, match, matchLength);
+				op += matchLength;
+			}
+			else
+			{
+				// Overlapping copy repeats the last offset bytes
+				for (size_t i = 0; i < matchLength; i++)
+					*op++ = *match++;
+			}
+		}
+
+		return op - opStart;
+	}
+
+}
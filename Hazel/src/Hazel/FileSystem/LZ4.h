@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace Hazel {
+
+	// LZ4 block format (no frame header), compatible with LZ4_compress_default/LZ4_decompress_safe.
+	// The compressor is the plain greedy single-pass variant: fast, not the tightest.
+	class LZ4
+	{
+	public:
+		static uint32_t GetCompressBound(uint32_t size) { return size + size / 255 + 16; }
+
+		// Returns the compressed size, or 0 if it doesn't fit in dstCapacity
+		static uint32_t Compress(const void* src, uint32_t srcSize, void* dst, uint32_t dstCapacity);
+		// Returns the decompressed size, or -1 if the data is malformed or doesn't fit in dstCapacity
+		static int64_t Decompress(const void* src, uint32_t srcSize, void* dst, uint32_t dstCapacity);
+	};
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <stdint.h>
+
+namespace Hazel {
+
+	// Read-only memory mapping of a whole file
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool Open(const std::string& filepath);
+		void Close();
+
+		bool IsOpen() const { return m_Data != nullptr; }
+		const uint8_t* GetData() const { return m_Data; }
+		uint64_t GetSize() const { return m_Size; }
+	private:
+		const uint8_t* m_Data = nullptr;
+		uint64_t m_Size = 0;
+
+		// Platform handles
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+	};
+
+}
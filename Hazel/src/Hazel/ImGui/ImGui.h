@@ -2,6 +2,8 @@
 
 #include "imgui/imgui.h"
 
+#include "Hazel/Core/FrameAllocator.h"
+
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -253,7 +255,8 @@ namespace Hazel::UI {
 
 		bool changed = false;
 
-		std::string id = "##" + std::string(label);
+		FrameString id = "##";
+		id += label;
 		if (ImGui::BeginCombo(id.c_str(), current))
 		{
 			for (int i = 0; i < optionCount; i++)
@@ -306,12 +306,13 @@ namespace Hazel {
 
 		if (!PhysicsMeshSerializer::IsSerialized(collider.CollisionMesh->GetFilePath()))
 		{
-			const std::vector<Vertex>& vertices = collider.CollisionMesh->GetStaticVertices();
 			const std::vector<Index>& indices = collider.CollisionMesh->GetIndices();
-
-			std::vector<glm::vec3> vertexPositions;
-			for (const auto& vertex : vertices)
-				vertexPositions.push_back(vertex.Position);
+			std::vector<glm::vec3> vertexPositions = collider.CollisionMesh->GetVertexPositions();
+			if (vertexPositions.empty() || indices.empty())
+			{
+				HZ_CORE_ERROR("Cannot cook collision mesh {0}: its CPU geometry has been released", collider.CollisionMesh->GetFilePath());
+				return meshes;
+			}
 
 			for (const auto& submesh : collider.CollisionMesh->GetSubmeshes())
 			{
@@ -374,7 +375,7 @@ namespace Hazel {
 					indices.push_back(index);
 				}
 
-				collider.ProcessedMeshes.push_back(Ref<Mesh>::Create(vertices, indices));
+				collider.ProcessedMeshes.push_back(Ref<Mesh>::Create(vertices, indices, MeshResidency::GPUOnly));
 			}
 		}
 
@@ -397,11 +398,13 @@ namespace Hazel {
 
 		if (!PhysicsMeshSerializer::IsSerialized(collider.CollisionMesh->GetFilePath()))
 		{
-			const std::vector<Vertex>& vertices = collider.CollisionMesh->GetStaticVertices();
-			const std::vector<Index>& indices = collider.CollisionMesh->GetIndices();
-			std::vector<glm::vec3> vertexPositions;
-			for (const auto& vertex : vertices)
-				vertexPositions.push_back(vertex.Position);
+			std::vector<glm::vec3> vertexPositions = collider.CollisionMesh->GetVertexPositions();
+			if (vertexPositions.empty())
+			{
+				HZ_CORE_ERROR("Cannot cook collision mesh {0}: its CPU geometry has been released", collider.CollisionMesh->GetFilePath());
+				s_CookingFactory->setParams(currentParams);
+				return meshes;
+			}
 
 			for (const auto& submesh : collider.CollisionMesh->GetSubmeshes())
 			{
@@ -478,7 +481,7 @@ namespace Hazel {
 						indexCounter++;
 					}
 
-					collider.ProcessedMeshes.push_back(Ref<Mesh>::Create(collisionVertices, collisionIndices));
+					collider.ProcessedMeshes.push_back(Ref<Mesh>::Create(collisionVertices, collisionIndices, MeshResidency::GPUOnly));
 				}
 			}
 		}
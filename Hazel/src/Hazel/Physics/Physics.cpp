@@ -152,6 +152,8 @@ namespace Hazel {
 
 	void Physics::Simulate(Timestep ts)
 	{
+		HZ_PROFILE_FUNCTION();
+
 		s_SimulationTime += ts.GetMilliseconds();
 
 		if (s_SimulationTime < s_Settings.FixedTimestep)
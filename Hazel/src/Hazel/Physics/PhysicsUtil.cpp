@@ -1,6 +1,8 @@
 #include "hzpch.h"
 #include "PhysicsUtil.h"
 
+#include "Hazel/FileSystem/FileSystem.h"
+
 #include <filesystem>
 
 namespace Hazel {
@@ -136,7 +138,7 @@ namespace Hazel {
 		lastDot = lastDot == std::string::npos ? p.filename().string().length() - 1 : lastDot;
 		std::string dirName = p.filename().string().substr(0, lastDot);
 		auto path = p.parent_path() / dirName;
-		return std::filesystem::is_directory(path);
+		return FileSystem::IsDirectory(path.string());
 	}
 
 	static std::vector<physx::PxU8*> s_MeshDataBuffers;
@@ -151,22 +153,16 @@ namespace Hazel {
 		std::string dirName = p.filename().string().substr(0, lastDot);
 		auto path = p.parent_path() / dirName;
 
-		for (const auto& file : std::filesystem::directory_iterator(path))
+		for (const auto& file : FileSystem::GetFiles(path.string()))
 		{
-			HZ_CORE_INFO("De-Serializing {0}", file.path().string());
-
-			FILE* f = fopen(file.path().string().c_str(), "rb");
-			uint32_t size;
+			HZ_CORE_INFO("De-Serializing {0}", file);
 
-			if (f)
+			FileData data = FileSystem::ReadFile(file);
+			if (data)
 			{
-				fseek(f, 0, SEEK_END);
-				size = ftell(f);
-				fseek(f, 0, SEEK_SET);
-
+				uint32_t size = (uint32_t)data.GetSize();
 				physx::PxU8* buffer = new physx::PxU8[size / sizeof(physx::PxU8)];
-				fread(buffer, sizeof(physx::PxU8), size / sizeof(physx::PxU8), f);
-				fclose(f);
+				memcpy(buffer, data.GetData(), size);
 				s_MeshDataBuffers.push_back(buffer);
 				result.push_back(physx::PxDefaultMemoryInputData(buffer, size));
 			}
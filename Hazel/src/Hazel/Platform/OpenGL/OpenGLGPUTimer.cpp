@@ -0,0 +1,113 @@
+#include "hzpch.h"
+#include "OpenGLGPUTimer.h"
+
+#include "Hazel/Renderer/Renderer.h"
+
+#include <glad/glad.h>
+
+namespace Hazel {
+
+	OpenGLGPUTimer::~OpenGLGPUTimer()
+	{
+		std::vector<RendererID> queries;
+		for (const QueryPair& pair : m_FreeQueries)
+			queries.insert(queries.end(), { pair.Begin, pair.End });
+		for (const QueryPair& pair : m_PendingQueries)
+			queries.insert(queries.end(), { pair.Begin, pair.End });
+		if (m_ActiveQuery.Begin)
+			queries.insert(queries.end(), { m_ActiveQuery.Begin, m_ActiveQuery.End });
+
+		if (queries.empty())
+			return;
+
+		Renderer::Submit([queries]()
+		{
+			glDeleteQueries((GLsizei)queries.size(), queries.data());
+		});
+	}
+
+	void OpenGLGPUTimer::Begin()
+	{
+		Ref<OpenGLGPUTimer> instance = this;
+		Renderer::Submit([instance]()
+		{
+			instance->ReadResults();
+
+			QueryPair& query = instance->m_ActiveQuery;
+			if (instance->m_FreeQueries.empty())
+			{
+				RendererID ids[2];
+				glCreateQueries(GL_TIMESTAMP, 2, ids);
+				query.Begin = ids[0];
+				query.End = ids[1];
+			}
+			else
+			{
+				query = instance->m_FreeQueries.back();
+				instance->m_FreeQueries.pop_back();
+			}
+
+			query.Frame = Renderer::GetFrameIndex();
+			glQueryCounter(query.Begin, GL_TIMESTAMP);
+		});
+	}
+
+	void OpenGLGPUTimer::End()
+	{
+		Ref<OpenGLGPUTimer> instance = this;
+		Renderer::Submit([instance]()
+		{
+			QueryPair& query = instance->m_ActiveQuery;
+			HZ_CORE_ASSERT(query.Begin, "GPUTimer::End without Begin");
+			glQueryCounter(query.End, GL_TIMESTAMP);
+			instance->m_PendingQueries.push_back(query);
+			query = {};
+		});
+	}
+
+	void OpenGLGPUTimer::ReadResults()
+	{
+		while (!m_PendingQueries.empty())
+		{
+			QueryPair query = m_PendingQueries.front();
+
+			// Queries complete in order, so once one isn't ready, the later ones aren't either
+			GLint available = 0;
+			glGetQueryObjectiv(query.End, GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				break;
+
+			GLuint64 begin = 0, end = 0;
+			glGetQueryObjectui64v(query.Begin, GL_QUERY_RESULT, &begin);
+			glGetQueryObjectui64v(query.End, GL_QUERY_RESULT, &end);
+
+			m_PendingQueries.pop_front();
+			m_FreeQueries.push_back(query);
+
+			// The first result of a new frame completes the previous one
+			if (query.Frame != m_ResultFrame)
+			{
+				if (m_ResultFrame != UINT64_MAX)
+					AddFrameTime(m_ResultTime / 1000000.0f);
+				m_ResultFrame = query.Frame;
+				m_ResultTime = 0;
+			}
+			m_ResultTime += end - begin;
+		}
+	}
+
+	void OpenGLGPUTimer::AddFrameTime(float time)
+	{
+		m_LastTime = time;
+
+		m_FrameTimes[m_FrameTimeIndex] = time;
+		m_FrameTimeIndex = (m_FrameTimeIndex + 1) % AverageFrameCount;
+		m_FrameTimeCount = std::min(m_FrameTimeCount + 1, AverageFrameCount);
+
+		float total = 0.0f;
+		for (uint32_t i = 0; i < m_FrameTimeCount; i++)
+			total += m_FrameTimes[i];
+		m_AverageTime = total / (float)m_FrameTimeCount;
+	}
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Hazel/Renderer/GPUTimer.h"
+#include "Hazel/Renderer/RendererAPI.h"
+
+#include <deque>
+
+namespace Hazel {
+
+	// GL_TIMESTAMP queries in pairs. Pairs waiting for their results are kept in submission order
+	// and checked, oldest first, every time the timer begins; a pair is only reused once read, so
+	// the pool grows to however many the GPU lags behind by.
+	class OpenGLGPUTimer : public GPUTimer
+	{
+	public:
+		virtual ~OpenGLGPUTimer();
+
+		virtual void Begin() override;
+		virtual void End() override;
+
+		virtual float GetAverageTime() const override { return m_AverageTime; }
+		virtual float GetLastTime() const override { return m_LastTime; }
+	private:
+		struct QueryPair
+		{
+			RendererID Begin = 0;
+			RendererID End = 0;
+			uint64_t Frame = 0;
+		};
+
+		// Render thread
+		void ReadResults();
+		void AddFrameTime(float time);
+	private:
+		std::vector<QueryPair> m_FreeQueries;
+		std::deque<QueryPair> m_PendingQueries;
+		QueryPair m_ActiveQuery;
+
+		// Results of the frame being added up
+		uint64_t m_ResultFrame = UINT64_MAX;
+		uint64_t m_ResultTime = 0;
+
+		float m_FrameTimes[AverageFrameCount] = {};
+		uint32_t m_FrameTimeCount = 0;
+		uint32_t m_FrameTimeIndex = 0;
+
+		float m_AverageTime = 0.0f;
+		float m_LastTime = 0.0f;
+	};
+
+}
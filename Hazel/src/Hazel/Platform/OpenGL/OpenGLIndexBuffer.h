@@ -3,17 +3,19 @@
 #include "Hazel/Renderer/IndexBuffer.h"
 
 #include "Hazel/Core/Buffer.h"
+#include "Hazel/Core/ObjectPool.h"
 
 namespace Hazel {
 
 	class OpenGLIndexBuffer : public IndexBuffer
 	{
+		HZ_POOLED_OBJECT(OpenGLIndexBuffer)
 	public:
 		OpenGLIndexBuffer(uint32_t size);
 		OpenGLIndexBuffer(void* data, uint32_t size);
 		virtual ~OpenGLIndexBuffer();
 
-		virtual void SetData(void* data, uint32_t size, uint32_t offset = 0);
+		virtual void SetData(BufferView data, uint32_t offset = 0) override;
 		virtual void Bind() const;
 
 		virtual uint32_t GetCount() const { return m_Size / sizeof(uint32_t); }
@@ -23,8 +25,6 @@ namespace Hazel {
 	private:
 		RendererID m_RendererID = 0;
 		uint32_t m_Size;
-
-		Buffer m_LocalData;
 	};
 
 }
\ No newline at end of file
@@ -91,6 +91,8 @@ namespace Hazel {
 
 	void OpenGLPipeline::Bind()
 	{
+		Renderer::GetCurrentFrameStats().PipelineBinds++;
+
 		Ref<OpenGLPipeline> instance = this;
 		Renderer::Submit([instance]()
 		{
@@ -4,9 +4,8 @@
 namespace Hazel {
 
 	OpenGLRenderPass::OpenGLRenderPass(const RenderPassSpecification& spec)
-		: m_Specification(spec)
+		: m_Specification(spec), m_GPUTimer(GPUTimer::Create())
 	{
-
 	}
 
 	OpenGLRenderPass::~OpenGLRenderPass()
@@ -12,8 +12,11 @@ namespace Hazel {
 
 		virtual RenderPassSpecification& GetSpecification() override { return m_Specification; }
 		virtual const RenderPassSpecification& GetSpecification() const override { return m_Specification; }
+
+		virtual const Ref<GPUTimer>& GetGPUTimer() const override { return m_GPUTimer; }
 	private:
 		RenderPassSpecification m_Specification;
+		Ref<GPUTimer> m_GPUTimer;
 	};
 
 }
@@ -88,7 +88,7 @@ namespace Hazel {
 		glClearColor(r, g, b, a);
 	}
 
-	void RendererAPI::DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest)
+	void RendererAPI::DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest, uint32_t baseVertex)
 	{
 		if (!depthTest)
 			glDisable(GL_DEPTH_TEST);
@@ -104,7 +104,7 @@ namespace Hazel {
 				break;
 		}
 
-		glDrawElements(glPrimitiveType, count, GL_UNSIGNED_INT, nullptr);
+		glDrawElementsBaseVertex(glPrimitiveType, count, GL_UNSIGNED_INT, nullptr, baseVertex);
 
 		if (!depthTest)
 			glEnable(GL_DEPTH_TEST);
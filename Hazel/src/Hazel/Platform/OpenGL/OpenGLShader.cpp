@@ -7,7 +7,9 @@
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include "Hazel/Core/FrameAllocator.h"
 #include "Hazel/Renderer/Renderer.h"
+#include "Hazel/FileSystem/FileSystem.h"
 
 namespace Hazel {
 
@@ -84,21 +86,9 @@ namespace Hazel {
 
 	std::string OpenGLShader::ReadShaderFromFile(const std::string& filepath) const
 	{
-		std::string result;
-		std::ifstream in(filepath, std::ios::in | std::ios::binary);
-		if (in)
-		{
-			in.seekg(0, std::ios::end);
-			result.resize(in.tellg());
-			in.seekg(0, std::ios::beg);
-			in.read(&result[0], result.size());
-		}
-		else
-		{
-			HZ_CORE_ASSERT(false, "Could not load shader!");
-		}
-		in.close();
-		return result;
+		FileData file = FileSystem::ReadFile(filepath);
+		HZ_CORE_ASSERT(file, "Could not load shader!");
+		return file.ToString();
 	}
 
 	std::unordered_map<GLenum, std::string> OpenGLShader::PreProcess(const std::string& source)
@@ -402,12 +392,12 @@ namespace Hazel {
 					for (size_t k = 0; k < fields.size(); k++)
 					{
 						OpenGLShaderUniformDeclaration* field = (OpenGLShaderUniformDeclaration*)fields[k];
-						field->m_Location = GetUniformLocation(uniform->m_Name + "." + field->m_Name);
+						field->m_Location = GetUniformLocation((uniform->m_Name + "." + field->m_Name).c_str());
 					}
 				}
 				else
 				{
-					uniform->m_Location = GetUniformLocation(uniform->m_Name);
+					uniform->m_Location = GetUniformLocation(uniform->m_Name.c_str());
 				}
 			}
 		}
@@ -426,12 +416,12 @@ namespace Hazel {
 					for (size_t k = 0; k < fields.size(); k++)
 					{
 						OpenGLShaderUniformDeclaration* field = (OpenGLShaderUniformDeclaration*)fields[k];
-						field->m_Location = GetUniformLocation(uniform->m_Name + "." + field->m_Name);
+						field->m_Location = GetUniformLocation((uniform->m_Name + "." + field->m_Name).c_str());
 					}
 				}
 				else
 				{
-					uniform->m_Location = GetUniformLocation(uniform->m_Name);
+					uniform->m_Location = GetUniformLocation(uniform->m_Name.c_str());
 				}
 			}
 		}
@@ -451,12 +441,12 @@ namespace Hazel {
 						for (size_t k = 0; k < fields.size(); k++)
 						{
 							OpenGLShaderUniformDeclaration* field = (OpenGLShaderUniformDeclaration*)fields[k];
-							field->m_Location = GetUniformLocation(uniform->m_Name + "." + field->m_Name);
+							field->m_Location = GetUniformLocation((uniform->m_Name + "." + field->m_Name).c_str());
 						}
 					}
 					else
 					{
-						uniform->m_Location = GetUniformLocation(uniform->m_Name);
+						uniform->m_Location = GetUniformLocation(uniform->m_Name.c_str());
 					}
 				}
 			}
@@ -477,12 +467,12 @@ namespace Hazel {
 						for (size_t k = 0; k < fields.size(); k++)
 						{
 							OpenGLShaderUniformDeclaration* field = (OpenGLShaderUniformDeclaration*)fields[k];
-							field->m_Location = GetUniformLocation(uniform->m_Name + "." + field->m_Name);
+							field->m_Location = GetUniformLocation((uniform->m_Name + "." + field->m_Name).c_str());
 						}
 					}
 					else
 					{
-						uniform->m_Location = GetUniformLocation(uniform->m_Name);
+						uniform->m_Location = GetUniformLocation(uniform->m_Name.c_str());
 					}
 				}
 			}
@@ -492,7 +482,7 @@ namespace Hazel {
 		for (size_t i = 0; i < m_Resources.size(); i++)
 		{
 			OpenGLShaderResourceDeclaration* resource = (OpenGLShaderResourceDeclaration*)m_Resources[i];
-			int32_t location = GetUniformLocation(resource->m_Name);
+			int32_t location = GetUniformLocation(resource->m_Name.c_str());
 
 			if (resource->GetCount() == 1)
 			{
@@ -509,7 +499,7 @@ namespace Hazel {
 				int* samplers = new int[count];
 				for (uint32_t s = 0; s < count; s++)
 					samplers[s] = sampler++;
-				UploadUniformIntArray(resource->GetName(), samplers, count);
+				UploadUniformIntArray(resource->GetName().c_str(), samplers, count);
 				delete[] samplers;
 			}
 		}
@@ -520,9 +510,9 @@ namespace Hazel {
 
 	}
 
-	int32_t OpenGLShader::GetUniformLocation(const std::string& name) const
+	int32_t OpenGLShader::GetUniformLocation(const char* name) const
 	{
-		int32_t result = glGetUniformLocation(m_RendererID, name.c_str());
+		int32_t result = glGetUniformLocation(m_RendererID, name);
 		if (result == -1)
 			HZ_CORE_WARN("Could not find uniform '{0}' in shader", name);
 
@@ -610,23 +600,37 @@ namespace Hazel {
 		m_RendererID = program;
 	}
 
-	void OpenGLShader::SetVSMaterialUniformBuffer(Buffer buffer)
+	static void CountUniformUpload(uint64_t size)
+	{
+		RendererFrameStats& stats = Renderer::GetCurrentFrameStats();
+		stats.UniformUploads++;
+		stats.UniformBytes += size;
+	}
+
+	void OpenGLShader::SetVSMaterialUniformBuffer(BufferView buffer)
 	{
-		Renderer::Submit([this, buffer]() {
+		CountUniformUpload(buffer.Size);
+
+		// Captured by value, so every draw gets the values the material had when it was bound
+		BufferView values(FrameAllocator::Stage(buffer.Data, buffer.Size), buffer.Size);
+		Renderer::Submit([this, values]() {
 			glUseProgram(m_RendererID);
-			ResolveAndSetUniforms(m_VSMaterialUniformBuffer, buffer);
+			ResolveAndSetUniforms(m_VSMaterialUniformBuffer, values);
 		});
 	}
 
-	void OpenGLShader::SetPSMaterialUniformBuffer(Buffer buffer)
+	void OpenGLShader::SetPSMaterialUniformBuffer(BufferView buffer)
 	{
-		Renderer::Submit([this, buffer]() {
+		CountUniformUpload(buffer.Size);
+
+		BufferView values(FrameAllocator::Stage(buffer.Data, buffer.Size), buffer.Size);
+		Renderer::Submit([this, values]() {
 			glUseProgram(m_RendererID);
-			ResolveAndSetUniforms(m_PSMaterialUniformBuffer, buffer);
+			ResolveAndSetUniforms(m_PSMaterialUniformBuffer, values);
 		});
 	}
 
-	void OpenGLShader::ResolveAndSetUniforms(const Ref<OpenGLShaderUniformBufferDeclaration>& decl, Buffer buffer)
+	void OpenGLShader::ResolveAndSetUniforms(const Ref<OpenGLShaderUniformBufferDeclaration>& decl, BufferView buffer)
 	{
 		const ShaderUniformList& uniforms = decl->GetUniformDeclarations();
 		for (size_t i = 0; i < uniforms.size(); i++)
@@ -639,7 +643,7 @@ namespace Hazel {
 		}
 	}
 
-	void OpenGLShader::ResolveAndSetUniform(OpenGLShaderUniformDeclaration* uniform, Buffer buffer)
+	void OpenGLShader::ResolveAndSetUniform(OpenGLShaderUniformDeclaration* uniform, BufferView buffer)
 	{
 		if (uniform->GetLocation() == -1)
 			return;
@@ -681,7 +685,7 @@ namespace Hazel {
 		}
 	}
 
-	void OpenGLShader::ResolveAndSetUniformArray(OpenGLShaderUniformDeclaration* uniform, Buffer buffer)
+	void OpenGLShader::ResolveAndSetUniformArray(OpenGLShaderUniformDeclaration* uniform, BufferView buffer)
 	{
 		//HZ_CORE_ASSERT(uniform->GetLocation() != -1, "Uniform has invalid location!");
 
@@ -701,7 +705,7 @@ namespace Hazel {
 			UploadUniformFloat2(uniform->GetLocation(), *(glm::vec2*)&buffer.Data[offset]);
 			break;
 		case OpenGLShaderUniformDeclaration::Type::VEC3:
-			UploadUniformFloat3(uniform->GetLocation(), *(glm::vec3*)&buffer.Data[offset]);
+			UploadUniformFloat3Array(uniform->GetLocation(), *(glm::vec3*)&buffer.Data[offset], uniform->GetCount());
 			break;
 		case OpenGLShaderUniformDeclaration::Type::VEC4:
 			UploadUniformFloat4(uniform->GetLocation(), *(glm::vec4*)&buffer.Data[offset]);
@@ -720,7 +724,7 @@ namespace Hazel {
 		}
 	}
 
-	void OpenGLShader::ResolveAndSetUniformField(const OpenGLShaderUniformDeclaration& field, byte* data, int32_t offset)
+	void OpenGLShader::ResolveAndSetUniformField(const OpenGLShaderUniformDeclaration& field, const byte* data, int32_t offset)
 	{
 		switch (field.GetType())
 		{
@@ -762,7 +766,7 @@ namespace Hazel {
 			{
 				case UniformType::Float:
 				{
-					const std::string& name = decl.Name;
+					const char* name = FrameAllocator::CopyString(decl.Name);
 					float value = *(float*)(uniformBuffer.GetBuffer() + decl.Offset);
 					Renderer::Submit([=]() {
 						UploadUniformFloat(name, value);
@@ -770,7 +774,7 @@ namespace Hazel {
 				}
 				case UniformType::Float3:
 				{
-					const std::string& name = decl.Name;
+					const char* name = FrameAllocator::CopyString(decl.Name);
 					glm::vec3& values = *(glm::vec3*)(uniformBuffer.GetBuffer() + decl.Offset);
 					Renderer::Submit([=]() {
 						UploadUniformFloat3(name, values);
@@ -778,7 +782,7 @@ namespace Hazel {
 				}
 				case UniformType::Float4:
 				{
-					const std::string& name = decl.Name;
+					const char* name = FrameAllocator::CopyString(decl.Name);
 					glm::vec4& values = *(glm::vec4*)(uniformBuffer.GetBuffer() + decl.Offset);
 					Renderer::Submit([=]() {
 						UploadUniformFloat4(name, values);
@@ -786,7 +790,7 @@ namespace Hazel {
 				}
 				case UniformType::Matrix4x4:
 				{
-					const std::string& name = decl.Name;
+					const char* name = FrameAllocator::CopyString(decl.Name);
 					glm::mat4& values = *(glm::mat4*)(uniformBuffer.GetBuffer() + decl.Offset);
 					Renderer::Submit([=]() {
 						UploadUniformMat4(name, values);
@@ -796,45 +800,68 @@ namespace Hazel {
 		}
 	}
 
-	void OpenGLShader::SetFloat(const std::string& name, float value)
+	void OpenGLShader::SetFloat(std::string_view name, float value)
 	{
+		CountUniformUpload(sizeof(float));
+		const char* uniformName = FrameAllocator::CopyString(name);
 		Renderer::Submit([=]() {
-			UploadUniformFloat(name, value);
+			UploadUniformFloat(uniformName, value);
 		});
 	}
 
-	void OpenGLShader::SetInt(const std::string& name, int value)
+	void OpenGLShader::SetInt(std::string_view name, int value)
 	{
+		CountUniformUpload(sizeof(int));
+		const char* uniformName = FrameAllocator::CopyString(name);
 		Renderer::Submit([=]() {
-			UploadUniformInt(name, value);
+			UploadUniformInt(uniformName, value);
 		});
 	}
 
-	void OpenGLShader::SetBool(const std::string& name, bool value)
+	void OpenGLShader::SetBool(std::string_view name, bool value)
 	{
+		CountUniformUpload(sizeof(int));
+		const char* uniformName = FrameAllocator::CopyString(name);
 		Renderer::Submit([=]() {
-			UploadUniformInt(name, value);
+			UploadUniformInt(uniformName, value);
 		});
 	}
 
-	void OpenGLShader::SetFloat2(const std::string& name, const glm::vec2& value)
+	void OpenGLShader::SetFloat2(std::string_view name, const glm::vec2& value)
 	{
+		CountUniformUpload(sizeof(glm::vec2));
+		const char* uniformName = FrameAllocator::CopyString(name);
 		Renderer::Submit([=]() {
-			UploadUniformFloat2(name, value);
+			UploadUniformFloat2(uniformName, value);
 		});
 	}
 
-	void OpenGLShader::SetFloat3(const std::string& name, const glm::vec3& value)
+	void OpenGLShader::SetFloat3(std::string_view name, const glm::vec3& value)
 	{
+		CountUniformUpload(sizeof(glm::vec3));
+		const char* uniformName = FrameAllocator::CopyString(name);
 		Renderer::Submit([=]() {
-			UploadUniformFloat3(name, value);
+			UploadUniformFloat3(uniformName, value);
 		});
 	}
 
-	void OpenGLShader::SetMat4(const std::string& name, const glm::mat4& value)
+	void OpenGLShader::SetMat4(std::string_view name, const glm::mat4& value)
 	{
+		CountUniformUpload(sizeof(glm::mat4));
+		const char* uniformName = FrameAllocator::CopyString(name);
 		Renderer::Submit([=]() {
-			UploadUniformMat4(name, value);
+			UploadUniformMat4(uniformName, value);
+		});
+	}
+
+	void OpenGLShader::SetMat4Array(std::string_view name, const glm::mat4* values, uint32_t count)
+	{
+		CountUniformUpload(sizeof(glm::mat4) * count);
+		const char* uniformName = FrameAllocator::CopyString(name);
+		glm::mat4* frameValues = FrameAllocator::Allocate<glm::mat4>(count);
+		memcpy(frameValues, values, sizeof(glm::mat4) * count);
+		Renderer::Submit([=]() {
+			UploadUniformMat4Array(uniformName, frameValues, count);
 		});
 	}
 
@@ -842,7 +869,7 @@ namespace Hazel {
 	{
 		if (bind)
 		{
-			UploadUniformMat4(name, value);
+			UploadUniformMat4(name.c_str(), value);
 		}
 		else
 		{
@@ -852,10 +879,14 @@ namespace Hazel {
 		}
 	}
 
-	void OpenGLShader::SetIntArray(const std::string& name, int* values, uint32_t size)
+	void OpenGLShader::SetIntArray(std::string_view name, const int* values, uint32_t size)
 	{
+		CountUniformUpload(sizeof(int) * size);
+		const char* uniformName = FrameAllocator::CopyString(name);
+		int* frameValues = FrameAllocator::Allocate<int>(size);
+		memcpy(frameValues, values, sizeof(int) * size);
 		Renderer::Submit([=]() {
-			UploadUniformIntArray(name, values, size);
+			UploadUniformIntArray(uniformName, frameValues, size);
 		});
 	}
 
@@ -884,6 +915,11 @@ namespace Hazel {
 		glUniform3f(location, value.x, value.y, value.z);
 	}
 
+	void OpenGLShader::UploadUniformFloat3Array(uint32_t location, const glm::vec3& values, uint32_t count)
+	{
+		glUniform3fv(location, count, glm::value_ptr(values));
+	}
+
 	void OpenGLShader::UploadUniformFloat4(uint32_t location, const glm::vec4& value)
 	{
 		glUniform4f(location, value.x, value.y, value.z, value.w);
@@ -904,7 +940,7 @@ namespace Hazel {
 		glUniformMatrix4fv(location, count, GL_FALSE, glm::value_ptr(values));
 	}
 
-	void OpenGLShader::UploadUniformStruct(OpenGLShaderUniformDeclaration* uniform, byte* buffer, uint32_t offset)
+	void OpenGLShader::UploadUniformStruct(OpenGLShaderUniformDeclaration* uniform, const byte* buffer, uint32_t offset)
 	{
 		const ShaderStruct& s = uniform->GetShaderUniformStruct();
 		const auto& fields = s.GetFields();
@@ -916,32 +952,32 @@ namespace Hazel {
 		}
 	}
 
-	void OpenGLShader::UploadUniformInt(const std::string& name, int32_t value)
+	void OpenGLShader::UploadUniformInt(const char* name, int32_t value)
 	{
 		int32_t location = GetUniformLocation(name);
 		glUniform1i(location, value);
 	}
 
-	void OpenGLShader::UploadUniformIntArray(const std::string& name, int32_t* values, uint32_t count)
+	void OpenGLShader::UploadUniformIntArray(const char* name, const int32_t* values, uint32_t count)
 	{
 		int32_t location = GetUniformLocation(name);
 		glUniform1iv(location, count, values);
 	}
 
-	void OpenGLShader::UploadUniformFloat(const std::string& name, float value)
+	void OpenGLShader::UploadUniformFloat(const char* name, float value)
 	{
 		glUseProgram(m_RendererID);
-		auto location = glGetUniformLocation(m_RendererID, name.c_str());
+		auto location = glGetUniformLocation(m_RendererID, name);
 		if (location != -1)
 			glUniform1f(location, value);
 		else
 			HZ_LOG_UNIFORM("Uniform '{0}' not found!", name);
 	}
 
-	void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& values)
+	void OpenGLShader::UploadUniformFloat2(const char* name, const glm::vec2& values)
 	{
 		glUseProgram(m_RendererID);
-		auto location = glGetUniformLocation(m_RendererID, name.c_str());
+		auto location = glGetUniformLocation(m_RendererID, name);
 		if (location != -1)
 			glUniform2f(location, values.x, values.y);
 		else
@@ -949,34 +985,44 @@ namespace Hazel {
 	}
 
 
-	void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& values)
+	void OpenGLShader::UploadUniformFloat3(const char* name, const glm::vec3& values)
 	{
 		glUseProgram(m_RendererID);
-		auto location = glGetUniformLocation(m_RendererID, name.c_str());
+		auto location = glGetUniformLocation(m_RendererID, name);
 		if (location != -1)
 			glUniform3f(location, values.x, values.y, values.z);
 		else
 			HZ_LOG_UNIFORM("Uniform '{0}' not found!", name);
 	}
 
-	void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& values)
+	void OpenGLShader::UploadUniformFloat4(const char* name, const glm::vec4& values)
 	{
 		glUseProgram(m_RendererID);
-		auto location = glGetUniformLocation(m_RendererID, name.c_str());
+		auto location = glGetUniformLocation(m_RendererID, name);
 		if (location != -1)
 			glUniform4f(location, values.x, values.y, values.z, values.w);
 		else
 			HZ_LOG_UNIFORM("Uniform '{0}' not found!", name);
 	}
 
-	void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& values)
+	void OpenGLShader::UploadUniformMat4(const char* name, const glm::mat4& values)
 	{
 		glUseProgram(m_RendererID);
-		auto location = glGetUniformLocation(m_RendererID, name.c_str());
+		auto location = glGetUniformLocation(m_RendererID, name);
 		if (location != -1)
 			glUniformMatrix4fv(location, 1, GL_FALSE, (const float*)&values);
 		else
 			HZ_LOG_UNIFORM("Uniform '{0}' not found!", name);
 	}
 
+	void OpenGLShader::UploadUniformMat4Array(const char* name, const glm::mat4* values, uint32_t count)
+	{
+		glUseProgram(m_RendererID);
+		auto location = glGetUniformLocation(m_RendererID, name);
+		if (location != -1)
+			glUniformMatrix4fv(location, count, GL_FALSE, (const float*)values);
+		else
+			HZ_LOG_UNIFORM("Uniform '{0}' not found!", name);
+	}
+
 }
\ No newline at end of file
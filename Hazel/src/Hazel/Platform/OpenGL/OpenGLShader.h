@@ -22,18 +22,19 @@ namespace Hazel {
 
 		virtual void UploadUniformBuffer(const UniformBufferBase& uniformBuffer) override;
 
-		virtual void SetVSMaterialUniformBuffer(Buffer buffer) override;
-		virtual void SetPSMaterialUniformBuffer(Buffer buffer) override;
-
-		virtual void SetInt(const std::string& name, int value) override;
-		virtual void SetBool(const std::string& name, bool value) override;
-		virtual void SetFloat(const std::string& name, float value) override;
-		virtual void SetFloat2(const std::string& name, const glm::vec2& value) override;
-		virtual void SetFloat3(const std::string& name, const glm::vec3& value) override;
-		virtual void SetMat4(const std::string& name, const glm::mat4& value) override;
+		virtual void SetVSMaterialUniformBuffer(BufferView buffer) override;
+		virtual void SetPSMaterialUniformBuffer(BufferView buffer) override;
+
+		virtual void SetInt(std::string_view name, int value) override;
+		virtual void SetBool(std::string_view name, bool value) override;
+		virtual void SetFloat(std::string_view name, float value) override;
+		virtual void SetFloat2(std::string_view name, const glm::vec2& value) override;
+		virtual void SetFloat3(std::string_view name, const glm::vec3& value) override;
+		virtual void SetMat4(std::string_view name, const glm::mat4& value) override;
+		virtual void SetMat4Array(std::string_view name, const glm::mat4* values, uint32_t count) override;
 		virtual void SetMat4FromRenderThread(const std::string& name, const glm::mat4& value, bool bind = true) override;
 
-		virtual void SetIntArray(const std::string& name, int* values, uint32_t size) override;
+		virtual void SetIntArray(std::string_view name, const int* values, uint32_t size) override;
 
 		virtual const std::string& GetName() const override { return m_Name; }
 	private:
@@ -46,39 +47,41 @@ namespace Hazel {
 		void ParseUniformStruct(const std::string& block, ShaderDomain domain);
 		ShaderStruct* FindStruct(const std::string& name);
 
-		int32_t GetUniformLocation(const std::string& name) const;
+		int32_t GetUniformLocation(const char* name) const;
 
 		void ResolveUniforms();
 		void ValidateUniforms();
 		void CompileAndUploadShader();
 		static GLenum ShaderTypeFromString(const std::string& type);
 
-		void ResolveAndSetUniforms(const Ref<OpenGLShaderUniformBufferDeclaration>& decl, Buffer buffer);
-		void ResolveAndSetUniform(OpenGLShaderUniformDeclaration* uniform, Buffer buffer);
-		void ResolveAndSetUniformArray(OpenGLShaderUniformDeclaration* uniform, Buffer buffer);
-		void ResolveAndSetUniformField(const OpenGLShaderUniformDeclaration& field, byte* data, int32_t offset);
+		void ResolveAndSetUniforms(const Ref<OpenGLShaderUniformBufferDeclaration>& decl, BufferView buffer);
+		void ResolveAndSetUniform(OpenGLShaderUniformDeclaration* uniform, BufferView buffer);
+		void ResolveAndSetUniformArray(OpenGLShaderUniformDeclaration* uniform, BufferView buffer);
+		void ResolveAndSetUniformField(const OpenGLShaderUniformDeclaration& field, const byte* data, int32_t offset);
 
 		void UploadUniformInt(uint32_t location, int32_t value);
 		void UploadUniformIntArray(uint32_t location, int32_t* values, int32_t count);
 		void UploadUniformFloat(uint32_t location, float value);
 		void UploadUniformFloat2(uint32_t location, const glm::vec2& value);
 		void UploadUniformFloat3(uint32_t location, const glm::vec3& value);
+		void UploadUniformFloat3Array(uint32_t location, const glm::vec3& values, uint32_t count);
 		void UploadUniformFloat4(uint32_t location, const glm::vec4& value);
 		void UploadUniformMat3(uint32_t location, const glm::mat3& values);
 		void UploadUniformMat4(uint32_t location, const glm::mat4& values);
 		void UploadUniformMat4Array(uint32_t location, const glm::mat4& values, uint32_t count);
 
-		void UploadUniformStruct(OpenGLShaderUniformDeclaration* uniform, byte* buffer, uint32_t offset);
+		void UploadUniformStruct(OpenGLShaderUniformDeclaration* uniform, const byte* buffer, uint32_t offset);
 
-		void UploadUniformInt(const std::string& name, int32_t value);
-		void UploadUniformIntArray(const std::string& name, int32_t* values, uint32_t count);
+		void UploadUniformInt(const char* name, int32_t value);
+		void UploadUniformIntArray(const char* name, const int32_t* values, uint32_t count);
 
-		void UploadUniformFloat(const std::string& name, float value);
-		void UploadUniformFloat2(const std::string& name, const glm::vec2& value);
-		void UploadUniformFloat3(const std::string& name, const glm::vec3& value);
-		void UploadUniformFloat4(const std::string& name, const glm::vec4& value);
+		void UploadUniformFloat(const char* name, float value);
+		void UploadUniformFloat2(const char* name, const glm::vec2& value);
+		void UploadUniformFloat3(const char* name, const glm::vec3& value);
+		void UploadUniformFloat4(const char* name, const glm::vec4& value);
 
-		void UploadUniformMat4(const std::string& name, const glm::mat4& value);
+		void UploadUniformMat4(const char* name, const glm::mat4& value);
+		void UploadUniformMat4Array(const char* name, const glm::mat4* values, uint32_t count);
 
 		virtual const ShaderUniformBufferList& GetVSRendererUniforms() const override { return m_VSRendererUniformBuffers; }
 		virtual const ShaderUniformBufferList& GetPSRendererUniforms() const override { return m_PSRendererUniformBuffers; }
@@ -0,0 +1,158 @@
+#include "hzpch.h"
+#include "Hazel/Renderer/StreamingBuffer.h"
+
+#include "Hazel/Renderer/Renderer.h"
+
+#include <glad/glad.h>
+
+#include <atomic>
+
+namespace Hazel {
+
+	struct StreamingBufferData
+	{
+		RendererID BufferID = 0;
+		uint8_t* Mapped = nullptr;
+		uint64_t FrameSize = 0;
+
+		// The region being written is FrameIndex; Offset is how much of it is allocated
+		uint32_t FrameIndex = 0;
+		std::atomic<uint64_t> Offset = 0;
+		GLsync Fences[StreamingBuffer::FrameCount] = {};
+	};
+
+	static StreamingBufferData s_Data;
+
+	void StreamingBuffer::Init(uint64_t frameSize)
+	{
+		Renderer::Submit([frameSize]()
+		{
+			uint64_t size = frameSize * FrameCount;
+
+			RendererID bufferID;
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glCreateBuffers(1, &bufferID);
+			glNamedBufferStorage(bufferID, size, nullptr, flags);
+			uint8_t* mapped = (uint8_t*)glMapNamedBufferRange(bufferID, 0, size, flags);
+			if (!mapped)
+			{
+				HZ_CORE_WARN("Could not map streaming buffer; uploading dynamic data through buffer updates");
+				glDeleteBuffers(1, &bufferID);
+				return;
+			}
+
+			s_Data.BufferID = bufferID;
+			s_Data.Mapped = mapped;
+			s_Data.FrameSize = frameSize;
+			s_Data.FrameIndex = 0;
+			s_Data.Offset = 0;
+		});
+	}
+
+	void StreamingBuffer::Shutdown()
+	{
+		if (!s_Data.Mapped)
+			return;
+
+		std::vector<GLsync> fences;
+		for (GLsync& fence : s_Data.Fences)
+		{
+			if (fence)
+				fences.push_back(fence);
+			fence = nullptr;
+		}
+
+		RendererID bufferID = s_Data.BufferID;
+		Renderer::Submit([bufferID, fences]()
+		{
+			for (GLsync fence : fences)
+				glDeleteSync(fence);
+			glUnmapNamedBuffer(bufferID);
+			glDeleteBuffers(1, &bufferID);
+		});
+
+		s_Data.BufferID = 0;
+		s_Data.Mapped = nullptr;
+		s_Data.FrameSize = 0;
+		s_Data.Offset = 0;
+	}
+
+	StreamingAllocation StreamingBuffer::Allocate(uint64_t size, uint64_t alignment)
+	{
+		if (!s_Data.Mapped || size == 0)
+			return {};
+
+		// Aligned relative to the start of the buffer, which is what draws and copies see
+		uint64_t base = (uint64_t)s_Data.FrameIndex * s_Data.FrameSize;
+		uint64_t offset = s_Data.Offset.load(std::memory_order_relaxed);
+		uint64_t alignedOffset;
+		do
+		{
+			alignedOffset = (base + offset + alignment - 1) / alignment * alignment - base;
+			if (alignedOffset + size > s_Data.FrameSize)
+				return {};
+		} while (!s_Data.Offset.compare_exchange_weak(offset, alignedOffset + size, std::memory_order_relaxed));
+
+		StreamingAllocation allocation;
+		allocation.Data = s_Data.Mapped + base + alignedOffset;
+		allocation.Offset = base + alignedOffset;
+		allocation.Size = size;
+		return allocation;
+	}
+
+	void StreamingBuffer::BindAsVertexBuffer()
+	{
+		Renderer::Submit([]()
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, s_Data.BufferID);
+		});
+	}
+
+	void StreamingBuffer::BindAsIndexBuffer()
+	{
+		Renderer::Submit([]()
+		{
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_Data.BufferID);
+		});
+	}
+
+	RendererID StreamingBuffer::GetRendererID()
+	{
+		return s_Data.BufferID;
+	}
+
+	void StreamingBuffer::EndFrame()
+	{
+		if (!s_Data.Mapped)
+			return;
+
+		s_Data.Fences[s_Data.FrameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		s_Data.FrameIndex = (s_Data.FrameIndex + 1) % FrameCount;
+		s_Data.Offset.store(0, std::memory_order_relaxed);
+
+		// Only blocks when the GPU has fallen FrameCount frames behind
+		GLsync& fence = s_Data.Fences[s_Data.FrameIndex];
+		if (!fence)
+			return;
+
+		while (true)
+		{
+			GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+			if (status != GL_TIMEOUT_EXPIRED)
+				break;
+		}
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	uint64_t StreamingBuffer::GetFrameSize()
+	{
+		return s_Data.FrameSize;
+	}
+
+	uint64_t StreamingBuffer::GetUsedSize()
+	{
+		return s_Data.Offset.load(std::memory_order_relaxed);
+	}
+
+}
@@ -3,10 +3,20 @@
 
 #include "Hazel/Renderer/RendererAPI.h"
 #include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/TextureStreamer.h"
+#include "Hazel/FileSystem/FileSystem.h"
 
 #include <glad/glad.h>
 #include "stb_image.h"
 
+// EXT_texture_compression_s3tc / EXT_texture_sRGB, not part of the core profile glad is generated for
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+	#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+	#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+	#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
 namespace Hazel {
 
 	static GLenum HazelToOpenGLTextureFormat(TextureFormat format)
@@ -21,6 +31,30 @@ namespace Hazel {
 		return 0;
 	}
 
+	static GLenum HazelToOpenGLCompressedFormat(TextureFormat format, bool srgb)
+	{
+		switch (format)
+		{
+			case Hazel::TextureFormat::BC1: return srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+			case Hazel::TextureFormat::BC3: return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+			case Hazel::TextureFormat::BC4: return GL_COMPRESSED_RED_RGTC1;
+			case Hazel::TextureFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+			case Hazel::TextureFormat::BC7: return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+		}
+		HZ_CORE_ASSERT(false, "Unknown compressed texture format!");
+		return 0;
+	}
+
+	// BC4 holds one channel, which would sample as (r, 0, 0, 1); spread it so masks read as the grey images they were cooked from
+	static void SetCompressedSwizzle(RendererID rendererID, TextureFormat format)
+	{
+		if (format != TextureFormat::BC4)
+			return;
+
+		GLint swizzle[] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+		glTextureParameteriv(rendererID, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+	}
+
 	//////////////////////////////////////////////////////////////////////////////////
 	// Texture2D
 	//////////////////////////////////////////////////////////////////////////////////
@@ -52,33 +86,52 @@ namespace Hazel {
 	OpenGLTexture2D::OpenGLTexture2D(const std::string& path, bool srgb)
 		: m_FilePath(path)
 	{
-		int width, height, channels;
-		if (stbi_is_hdr(path.c_str()))
-		{
-			HZ_CORE_INFO("Loading HDR texture {0}, srgb={1}", path, srgb);
-			m_ImageData.Data = (byte*)stbi_loadf(path.c_str(), &width, &height, &channels, 0);
-			m_IsHDR = true;
-			m_Format = TextureFormat::Float16;
-		}
-		else
-		{
-			HZ_CORE_INFO("Loading texture {0}, srgb={1}", path, srgb);
-			m_ImageData.Data = stbi_load(path.c_str(), &width, &height, &channels, srgb ? STBI_rgb : STBI_rgb_alpha);
-			HZ_CORE_ASSERT(m_ImageData.Data, "Could not read image!");
-			m_Format = TextureFormat::RGBA;
-		}
+		TextureData data;
+		if (Texture2D::Decode(path, srgb, data))
+			Upload(data);
+	}
 
-		if (!m_ImageData.Data)
-			return;
+	OpenGLTexture2D::OpenGLTexture2D(TextureData& data)
+		: m_FilePath(data.Path)
+	{
+		if (data.Data)
+			Upload(data);
+	}
 
+	void OpenGLTexture2D::Upload(TextureData& data)
+	{
+		// Staged pixels are in write only mapped memory and are uploaded from their offset, so
+		// they're never kept as image data where GetWriteableBuffer could hand them out
+		m_ImageData = data.Staging ? Buffer() : data.Data;
+		m_IsHDR = data.HDR;
+		m_Format = data.Format;
+		m_Width = data.Width;
+		m_Height = data.Height;
 		m_Loaded = true;
 
-		m_Width = width;
-		m_Height = height;
+		// The pixels now belong to this texture and are freed once uploaded
+		data.Data = Buffer();
 
+		if (Texture::IsCompressed(m_Format))
+		{
+			UploadCompressed(data);
+			return;
+		}
+
+		bool srgb = data.SRGB;
+		StagingAllocation staging = data.Staging;
+		data.Staging = StagingAllocation();
 		Ref<OpenGLTexture2D> instance = this;
-		Renderer::Submit([instance, srgb]() mutable
+		Renderer::Submit([instance, srgb, staging]() mutable
 		{
+			// Staged pixels are read from the pixel unpack buffer, at their offset into it
+			const byte* pixels = instance->m_ImageData.Data;
+			if (staging)
+			{
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, TextureUploader::GetRendererID());
+				pixels = (const byte*)(uintptr_t)staging.Offset;
+			}
+
 			// TODO: Consolidate properly
 			if (srgb)
 			{
@@ -88,7 +141,7 @@ namespace Hazel {
 				glTextureParameteri(instance->m_RendererID, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
 				glTextureParameteri(instance->m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-				glTextureSubImage2D(instance->m_RendererID, 0, 0, 0, instance->m_Width, instance->m_Height, GL_RGB, GL_UNSIGNED_BYTE, instance->m_ImageData.Data);
+				glTextureSubImage2D(instance->m_RendererID, 0, 0, 0, instance->m_Width, instance->m_Height, GL_RGB, GL_UNSIGNED_BYTE, pixels);
 				glGenerateTextureMipmap(instance->m_RendererID);
 			}
 			else
@@ -104,18 +157,141 @@ namespace Hazel {
 
 				GLenum internalFormat = HazelToOpenGLTextureFormat(instance->m_Format);
 				GLenum format = srgb ? GL_SRGB8 : (instance->m_IsHDR ? GL_RGB : HazelToOpenGLTextureFormat(instance->m_Format)); // HDR = GL_RGB for now
-				GLenum type = internalFormat == GL_RGBA16F ? GL_FLOAT : GL_UNSIGNED_BYTE;
-				glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, instance->m_Width, instance->m_Height, 0, format, type, instance->m_ImageData.Data);
+				GLenum type = internalFormat == GL_RGBA16F ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE;
+				// Rows of RGB half float images aren't necessarily 4 byte aligned
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+				glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, instance->m_Width, instance->m_Height, 0, format, type, pixels);
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 				glGenerateMipmap(GL_TEXTURE_2D);
 
 				glBindTexture(GL_TEXTURE_2D, 0);
 			}
-			stbi_image_free(instance->m_ImageData.Data);
+
+			if (staging)
+			{
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+				TextureUploader::Retire(staging);
+			}
+			else
+			{
+				stbi_image_free(instance->m_ImageData.Data);
+			}
+			instance->m_ImageData = Buffer();
+		});
+	}
+
+	// Cooked mips are uploaded as they are; nothing is decoded or generated at load time.
+	// Streamed textures start out with only the tail of the chain, so the GL texture is
+	// created at the size of the first mip present.
+	void OpenGLTexture2D::UploadCompressed(TextureData& data)
+	{
+		m_MipCount = data.MipCount ? data.MipCount : (uint32_t)data.Mips.size();
+		m_FirstResidentMip = data.FirstMip;
+		m_SRGB = data.SRGB;
+
+		std::vector<TextureMip> mips = std::move(data.Mips);
+		StagingAllocation staging = data.Staging;
+		data.Staging = StagingAllocation();
+		Ref<OpenGLTexture2D> instance = this;
+		Renderer::Submit([instance, mips, staging]() mutable
+		{
+			const byte* pixels = instance->m_ImageData.Data;
+			if (staging)
+			{
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, TextureUploader::GetRendererID());
+				pixels = (const byte*)(uintptr_t)staging.Offset;
+			}
+
+			GLenum internalFormat = HazelToOpenGLCompressedFormat(instance->m_Format, instance->m_SRGB);
+			uint32_t levels = (uint32_t)mips.size();
+
+			glCreateTextures(GL_TEXTURE_2D, 1, &instance->m_RendererID);
+			glTextureStorage2D(instance->m_RendererID, levels, internalFormat, mips[0].Width, mips[0].Height);
+			glTextureParameteri(instance->m_RendererID, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+			glTextureParameteri(instance->m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTextureParameterf(instance->m_RendererID, GL_TEXTURE_MAX_ANISOTROPY, RendererAPI::GetCapabilities().MaxAnisotropy);
+			SetCompressedSwizzle(instance->m_RendererID, instance->m_Format);
+
+			for (uint32_t level = 0; level < levels; level++)
+			{
+				const TextureMip& mip = mips[level];
+				glCompressedTextureSubImage2D(instance->m_RendererID, level, 0, 0, mip.Width, mip.Height, internalFormat, mip.Size, pixels + mip.Offset);
+			}
+
+			if (staging)
+			{
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+				TextureUploader::Retire(staging);
+			}
+			else
+			{
+				instance->m_ImageData.Release();
+			}
+		});
+
+		if (m_FirstResidentMip > 0)
+		{
+			m_Streamed = true;
+			TextureStreamer::Register(this);
+		}
+	}
+
+	// GL textures can't grow or shrink their mip chain in place, so a new texture is created at the
+	// new size. Mips both have in common are copied over on the GPU; only new ones are uploaded.
+	void OpenGLTexture2D::SetResidentMips(uint32_t firstMip, TextureData& data)
+	{
+		HZ_CORE_ASSERT(m_Streamed && firstMip < m_MipCount, "Texture isn't streamed or mip is out of range!");
+		if (firstMip == m_FirstResidentMip)
+			return;
+
+		uint32_t oldFirstMip = m_FirstResidentMip;
+		HZ_CORE_ASSERT(firstMip > oldFirstMip || (data.FirstMip == firstMip && data.Mips.size() == oldFirstMip - firstMip), "Missing mips!");
+		m_FirstResidentMip = firstMip;
+
+		Buffer pixels = data.Data;
+		data.Data = Buffer();
+		std::vector<TextureMip> mips = std::move(data.Mips);
+
+		Ref<OpenGLTexture2D> instance = this;
+		Renderer::Submit([instance, firstMip, oldFirstMip, mips, pixels]() mutable
+		{
+			GLenum internalFormat = HazelToOpenGLCompressedFormat(instance->m_Format, instance->m_SRGB);
+			uint32_t levels = instance->m_MipCount - firstMip;
+
+			GLuint rendererID;
+			glCreateTextures(GL_TEXTURE_2D, 1, &rendererID);
+			glTextureStorage2D(rendererID, levels, internalFormat, std::max(instance->m_Width >> firstMip, 1u), std::max(instance->m_Height >> firstMip, 1u));
+			glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+			glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTextureParameterf(rendererID, GL_TEXTURE_MAX_ANISOTROPY, RendererAPI::GetCapabilities().MaxAnisotropy);
+			SetCompressedSwizzle(rendererID, instance->m_Format);
+
+			for (uint32_t mip = firstMip; mip < instance->m_MipCount; mip++)
+			{
+				if (mip < oldFirstMip)
+				{
+					const TextureMip& newMip = mips[mip - firstMip];
+					glCompressedTextureSubImage2D(rendererID, mip - firstMip, 0, 0, newMip.Width, newMip.Height, internalFormat, newMip.Size, pixels.Data + newMip.Offset);
+				}
+				else
+				{
+					uint32_t width = std::max(instance->m_Width >> mip, 1u);
+					uint32_t height = std::max(instance->m_Height >> mip, 1u);
+					glCopyImageSubData(instance->m_RendererID, GL_TEXTURE_2D, mip - oldFirstMip, 0, 0, 0, rendererID, GL_TEXTURE_2D, mip - firstMip, 0, 0, 0, width, height, 1);
+				}
+			}
+
+			glDeleteTextures(1, &instance->m_RendererID);
+			instance->m_RendererID = rendererID;
+			pixels.Release();
 		});
 	}
 
 	OpenGLTexture2D::~OpenGLTexture2D()
 	{
+		if (m_Streamed)
+			TextureStreamer::Unregister(this);
+
 		GLuint rendererID = m_RendererID;
 		Renderer::Submit([rendererID]() {
 			glDeleteTextures(1, &rendererID);
@@ -124,6 +300,8 @@ namespace Hazel {
 
 	void OpenGLTexture2D::Bind(uint32_t slot) const
 	{
+		Renderer::GetCurrentFrameStats().TextureBinds++;
+
 		Ref<const OpenGLTexture2D> instance = this;
 		Renderer::Submit([instance, slot]() {
 			glBindTextureUnit(slot, instance->m_RendererID);
@@ -162,7 +340,7 @@ namespace Hazel {
 
 	uint32_t OpenGLTexture2D::GetMipLevelCount() const
 	{
-		return Texture::CalculateMipMapCount(m_Width, m_Height);
+		return m_MipCount ? m_MipCount : Texture::CalculateMipMapCount(m_Width, m_Height);
 	}
 
 	//////////////////////////////////////////////////////////////////////////////////
@@ -191,6 +369,28 @@ namespace Hazel {
 		});
 	}
 
+	OpenGLTextureCube::OpenGLTextureCube(TextureFormat format, uint32_t width, uint32_t height, Buffer data)
+		: OpenGLTextureCube(format, width, height)
+	{
+		HZ_CORE_ASSERT(format == TextureFormat::Float16 && width == height, "Only square Float16 cube maps can be created from data!");
+		HZ_CORE_ASSERT(data.Size == TextureCube::GetPixelDataSize(width), "Cube map data is the wrong size!");
+
+		Ref<OpenGLTextureCube> instance = this;
+		Renderer::Submit([instance, data]() mutable
+		{
+			const byte* pixels = data.Data;
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+			for (uint32_t level = 0; level < instance->GetMipLevelCount(); level++)
+			{
+				uint32_t size = std::max(instance->m_Width >> level, 1u);
+				glTextureSubImage3D(instance->m_RendererID, level, 0, 0, 0, size, size, 6, GL_RGB, GL_HALF_FLOAT, pixels);
+				pixels += (size_t)size * size * 6 * 3 * sizeof(uint16_t);
+			}
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+			data.Release();
+		});
+	}
+
 	// TODO: Revisit this, as currently env maps are being loaded as equirectangular 2D images
 	//       so this is an old path
 	OpenGLTextureCube::OpenGLTextureCube(const std::string& path)
@@ -198,7 +398,8 @@ namespace Hazel {
 	{
 		int width, height, channels;
 		stbi_set_flip_vertically_on_load(false);
-		m_ImageData = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb);
+		FileData file = FileSystem::ReadFile(path);
+		m_ImageData = stbi_load_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &channels, STBI_rgb);
 
 		m_Width = width;
 		m_Height = height;
@@ -294,6 +495,8 @@ namespace Hazel {
 
 	void OpenGLTextureCube::Bind(uint32_t slot) const
 	{
+		Renderer::GetCurrentFrameStats().TextureBinds++;
+
 		Ref<const OpenGLTextureCube> instance = this;
 		Renderer::Submit([instance, slot]() {
 			glBindTextureUnit(slot, instance->m_RendererID);
@@ -305,4 +508,25 @@ namespace Hazel {
 		return Texture::CalculateMipMapCount(m_Width, m_Height);
 	}
 
+	Buffer OpenGLTextureCube::ReadPixels() const
+	{
+		HZ_CORE_ASSERT(m_Format == TextureFormat::Float16 && m_Width == m_Height, "Only square Float16 cube maps can be read back!");
+
+		Buffer data;
+		data.Allocate((uint32_t)TextureCube::GetPixelDataSize(m_Width));
+
+		byte* pixels = data.Data;
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		for (uint32_t level = 0; level < GetMipLevelCount(); level++)
+		{
+			uint32_t size = std::max(m_Width >> level, 1u);
+			GLsizei levelSize = size * size * 6 * 3 * sizeof(uint16_t);
+			// Cube maps come back with all six faces, like a single layer cube map array
+			glGetTextureImage(m_RendererID, level, GL_RGB, GL_HALF_FLOAT, levelSize, pixels);
+			pixels += levelSize;
+		}
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		return data;
+	}
+
 }
\ No newline at end of file
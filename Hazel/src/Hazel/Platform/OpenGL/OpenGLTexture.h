@@ -3,13 +3,17 @@
 #include "Hazel/Renderer/RendererAPI.h"
 #include "Hazel/Renderer/Texture.h"
 
+#include "Hazel/Core/ObjectPool.h"
+
 namespace Hazel {
 
 	class OpenGLTexture2D : public Texture2D
 	{
+		HZ_POOLED_OBJECT(OpenGLTexture2D)
 	public:
 		OpenGLTexture2D(TextureFormat format, uint32_t width, uint32_t height, TextureWrap wrap);
 		OpenGLTexture2D(const std::string& path, bool srgb);
+		OpenGLTexture2D(TextureData& data);
 		virtual ~OpenGLTexture2D();
 
 		virtual void Bind(uint32_t slot = 0) const;
@@ -18,8 +22,10 @@ namespace Hazel {
 		virtual uint32_t GetWidth() const override { return m_Width; }
 		virtual uint32_t GetHeight() const override { return m_Height; }
 		// This function currently returns the expected number of mips based on image size,
-		// not present mips in data
+		// not present mips in data, unless the texture was cooked
 		virtual uint32_t GetMipLevelCount() const override;
+		virtual uint32_t GetFirstResidentMip() const override { return m_FirstResidentMip; }
+		virtual void SetResidentMips(uint32_t firstMip, TextureData& data) override;
 
 		virtual void Lock() override;
 		virtual void Unlock() override;
@@ -37,11 +43,18 @@ namespace Hazel {
 		{
 			return m_RendererID == ((OpenGLTexture2D&)other).m_RendererID;
 		}
+	private:
+		void Upload(TextureData& data);
+		void UploadCompressed(TextureData& data);
 	private:
 		RendererID m_RendererID;
 		TextureFormat m_Format;
 		TextureWrap m_Wrap = TextureWrap::Clamp;
 		uint32_t m_Width, m_Height;
+		uint32_t m_MipCount = 0; // Cooked textures only
+		uint32_t m_FirstResidentMip = 0;
+		bool m_SRGB = false;
+		bool m_Streamed = false;
 
 		Buffer m_ImageData;
 		bool m_IsHDR = false;
@@ -57,6 +70,7 @@ namespace Hazel {
 	public:
 		OpenGLTextureCube(TextureFormat format, uint32_t width, uint32_t height);
 		OpenGLTextureCube(const std::string& path);
+		OpenGLTextureCube(TextureFormat format, uint32_t width, uint32_t height, Buffer data);
 		virtual ~OpenGLTextureCube();
 
 		virtual void Bind(uint32_t slot = 0) const;
@@ -68,6 +82,8 @@ namespace Hazel {
 		// not present mips in data
 		virtual uint32_t GetMipLevelCount() const override;
 
+		virtual Buffer ReadPixels() const override;
+
 		virtual const std::string& GetPath() const override { return m_FilePath; }
 
 		virtual RendererID GetRendererID() const override { return m_RendererID; }
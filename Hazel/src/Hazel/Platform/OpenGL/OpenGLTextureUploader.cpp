@@ -0,0 +1,246 @@
+#include "hzpch.h"
+#include "Hazel/Renderer/TextureUploader.h"
+
+#include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/Texture.h"
+
+#include <glad/glad.h>
+#include "stb_image.h"
+
+#include <deque>
+#include <mutex>
+
+namespace Hazel {
+
+	struct StagingRegion
+	{
+		uint64_t Offset = 0;
+		uint64_t Size = 0;      // Including any space skipped at the end of the buffer to get here
+		GLsync Fence = nullptr; // Set once the upload commands have been issued
+		bool Done = false;      // Discarded, or uploaded and the fence signalled
+	};
+
+	struct TextureUploaderData
+	{
+		std::mutex Mutex;
+		RendererID BufferID = 0;
+		uint8_t* Mapped = nullptr;
+		uint64_t Size = 0;
+
+		// Ranges in flight in allocation order, so free space is always the stretch from the
+		// end of the last one (Head) round to the start of the first. With ranges in flight,
+		// Head meeting the first one means the buffer is full.
+		std::deque<StagingRegion> Regions;
+		uint64_t Head = 0;
+		uint64_t UsedSize = 0;
+	};
+
+	static TextureUploaderData s_Data;
+
+	// Satisfies the offset alignment of every pixel and block format
+	static const uint64_t s_Alignment = 256;
+
+	static StagingAllocation Allocate(uint64_t size)
+	{
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+		if (!s_Data.Mapped)
+			return {};
+
+		uint64_t alignedSize = (size + s_Alignment - 1) & ~(s_Alignment - 1);
+		if (alignedSize > s_Data.Size)
+			return {};
+
+		uint64_t offset, skipped = 0;
+		if (s_Data.Regions.empty())
+		{
+			s_Data.Head = 0;
+			offset = 0;
+		}
+		else
+		{
+			uint64_t tail = s_Data.Regions.front().Offset;
+			if (s_Data.Head > tail)
+			{
+				// Free space wraps around the end of the buffer
+				if (s_Data.Head + alignedSize <= s_Data.Size)
+					offset = s_Data.Head;
+				else if (alignedSize <= tail)
+				{
+					offset = 0;
+					skipped = s_Data.Size - s_Data.Head;
+				}
+				else
+					return {};
+			}
+			else if (s_Data.Head < tail && s_Data.Head + alignedSize <= tail)
+				offset = s_Data.Head;
+			else
+				return {};
+		}
+
+		StagingRegion region;
+		region.Offset = offset;
+		region.Size = alignedSize + skipped;
+		s_Data.Regions.push_back(region);
+		s_Data.Head = offset + alignedSize;
+		s_Data.UsedSize += region.Size;
+		if (s_Data.Head == s_Data.Size)
+			s_Data.Head = 0;
+
+		StagingAllocation allocation;
+		allocation.Data = s_Data.Mapped + offset;
+		allocation.Offset = offset;
+		allocation.Size = size;
+		return allocation;
+	}
+
+	// Frees finished ranges from the front; ones finishing out of order wait their turn
+	static void FreeDoneRegions()
+	{
+		while (!s_Data.Regions.empty() && s_Data.Regions.front().Done)
+		{
+			s_Data.UsedSize -= s_Data.Regions.front().Size;
+			s_Data.Regions.pop_front();
+		}
+	}
+
+	static StagingRegion* FindRegion(uint64_t offset)
+	{
+		for (auto& region : s_Data.Regions)
+		{
+			if (region.Offset == offset && !region.Done && !region.Fence)
+				return &region;
+		}
+		return nullptr;
+	}
+
+	void TextureUploader::Init(uint64_t size)
+	{
+		Renderer::Submit([size]()
+		{
+			RendererID bufferID;
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glCreateBuffers(1, &bufferID);
+			glNamedBufferStorage(bufferID, size, nullptr, flags);
+			uint8_t* mapped = (uint8_t*)glMapNamedBufferRange(bufferID, 0, size, flags);
+			if (!mapped)
+			{
+				HZ_CORE_WARN("Could not map texture staging buffer; uploading from client memory");
+				glDeleteBuffers(1, &bufferID);
+				return;
+			}
+
+			std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+			s_Data.BufferID = bufferID;
+			s_Data.Mapped = mapped;
+			s_Data.Size = size;
+		});
+	}
+
+	void TextureUploader::Shutdown()
+	{
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+		if (!s_Data.Mapped)
+			return;
+
+		std::vector<GLsync> fences;
+		for (auto& region : s_Data.Regions)
+		{
+			if (region.Fence)
+				fences.push_back(region.Fence);
+		}
+
+		RendererID bufferID = s_Data.BufferID;
+		Renderer::Submit([bufferID, fences]()
+		{
+			for (GLsync fence : fences)
+				glDeleteSync(fence);
+			glUnmapNamedBuffer(bufferID);
+			glDeleteBuffers(1, &bufferID);
+		});
+
+		s_Data.BufferID = 0;
+		s_Data.Mapped = nullptr;
+		s_Data.Size = 0;
+		s_Data.Regions.clear();
+		s_Data.Head = 0;
+		s_Data.UsedSize = 0;
+	}
+
+	bool TextureUploader::Stage(TextureData& data)
+	{
+		if (!data.Data || data.Staging)
+			return false;
+
+		StagingAllocation allocation = Allocate(data.Data.Size);
+		if (!allocation)
+			return false;
+
+		memcpy(allocation.Data, data.Data.Data, data.Data.Size);
+
+		// Compressed data is read into new[] memory; everything else comes from stb_image
+		if (Texture::IsCompressed(data.Format))
+			data.Data.Release();
+		else
+			stbi_image_free(data.Data.Data);
+
+		data.Data = Buffer(allocation.Data, (uint32_t)allocation.Size);
+		data.Staging = allocation;
+		return true;
+	}
+
+	RendererID TextureUploader::GetRendererID()
+	{
+		return s_Data.BufferID;
+	}
+
+	void TextureUploader::Retire(const StagingAllocation& allocation)
+	{
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+		if (StagingRegion* region = FindRegion(allocation.Offset))
+			region->Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	void TextureUploader::Discard(const StagingAllocation& allocation)
+	{
+		if (!allocation)
+			return;
+
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+		if (StagingRegion* region = FindRegion(allocation.Offset))
+			region->Done = true;
+		FreeDoneRegions();
+	}
+
+	void TextureUploader::Update()
+	{
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+		for (auto& region : s_Data.Regions)
+		{
+			if (!region.Fence)
+				continue;
+
+			GLenum status = glClientWaitSync(region.Fence, 0, 0);
+			if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+			{
+				glDeleteSync(region.Fence);
+				region.Fence = nullptr;
+				region.Done = true;
+			}
+		}
+		FreeDoneRegions();
+	}
+
+	uint64_t TextureUploader::GetSize()
+	{
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+		return s_Data.Size;
+	}
+
+	uint64_t TextureUploader::GetUsedSize()
+	{
+		std::scoped_lock<std::mutex> lock(s_Data.Mutex);
+		return s_Data.UsedSize;
+	}
+
+}
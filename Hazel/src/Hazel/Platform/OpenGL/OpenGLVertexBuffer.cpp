@@ -4,6 +4,8 @@
 #include <glad/glad.h>
 
 #include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/StreamingBuffer.h"
+#include "Hazel/Core/FrameAllocator.h"
 
 namespace Hazel {
 
@@ -21,13 +23,16 @@ namespace Hazel {
 	OpenGLVertexBuffer::OpenGLVertexBuffer(void* data, uint32_t size, VertexBufferUsage usage)
 		: m_Size(size), m_Usage(usage)
 	{
-		m_LocalData = Buffer::Copy(data, size);
-		 
+		// The initial data is only needed until the render thread has uploaded it
+		ScopedBuffer localData = ScopedBuffer::Copy(BufferView(data, size));
+		Renderer::GetCurrentFrameStats().BufferBytesUploaded += size;
+
 		Ref<OpenGLVertexBuffer> instance = this;
-		Renderer::Submit([instance]() mutable
+		Renderer::Submit([instance, localData = std::move(localData)]() mutable
 		{
 			glCreateBuffers(1, &instance->m_RendererID);
-			glNamedBufferData(instance->m_RendererID, instance->m_Size, instance->m_LocalData.Data, OpenGLUsage(instance->m_Usage));
+			glNamedBufferData(instance->m_RendererID, instance->m_Size, localData.GetData(), OpenGLUsage(instance->m_Usage));
+			localData.Release();
 		});
 	}
 
@@ -50,13 +55,27 @@ namespace Hazel {
 		});
 	}
 
-	void OpenGLVertexBuffer::SetData(void* data, uint32_t size, uint32_t offset)
+	void OpenGLVertexBuffer::SetData(BufferView data, uint32_t offset)
 	{
-		m_LocalData = Buffer::Copy(data, size);
-		m_Size = size;
+		HZ_CORE_ASSERT(offset + data.Size <= m_Size, "Vertex buffer overflow!");
+		uint32_t size = data.Size;
 		Ref<OpenGLVertexBuffer> instance = this;
-		Renderer::Submit([instance, offset]() {
-			glNamedBufferSubData(instance->m_RendererID, offset, instance->m_Size, instance->m_LocalData.Data);
+		Renderer::GetCurrentFrameStats().BufferBytesUploaded += size;
+
+		// Copied on the GPU, so the driver neither copies the data nor waits for draws still reading the buffer
+		if (StreamingAllocation staging = StreamingBuffer::Allocate(size))
+		{
+			memcpy(staging.Data, data.Data, size);
+			uint64_t stagingOffset = staging.Offset;
+			Renderer::Submit([instance, offset, stagingOffset, size]() {
+				glCopyNamedBufferSubData(StreamingBuffer::GetRendererID(), instance->m_RendererID, stagingOffset, offset, size);
+			});
+			return;
+		}
+
+		const void* frameData = FrameAllocator::Stage(data.Data, data.Size);
+		Renderer::Submit([instance, offset, frameData, size]() {
+			glNamedBufferSubData(instance->m_RendererID, offset, size, frameData);
 		});
 	}
 
@@ -3,17 +3,19 @@
 #include "Hazel/Renderer/VertexBuffer.h"
 
 #include "Hazel/Core/Buffer.h"
+#include "Hazel/Core/ObjectPool.h"
 
 namespace Hazel {
 
 	class OpenGLVertexBuffer : public VertexBuffer
 	{
+		HZ_POOLED_OBJECT(OpenGLVertexBuffer)
 	public:
 		OpenGLVertexBuffer(void* data, uint32_t size, VertexBufferUsage usage = VertexBufferUsage::Static);
 		OpenGLVertexBuffer(uint32_t size, VertexBufferUsage usage = VertexBufferUsage::Dynamic);
 		virtual ~OpenGLVertexBuffer();
 
-		virtual void SetData(void* data, uint32_t size, uint32_t offset = 0);
+		virtual void SetData(BufferView data, uint32_t offset = 0) override;
 		virtual void Bind() const;
 
 		virtual const VertexBufferLayout& GetLayout() const override { return m_Layout; }
@@ -26,8 +28,6 @@ namespace Hazel {
 		uint32_t m_Size;
 		VertexBufferUsage m_Usage;
 		VertexBufferLayout m_Layout;
-
-		Buffer m_LocalData;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "hzpch.h"
+#include "Hazel/FileSystem/MappedFile.h"
+
+#include <Windows.h>
+
+namespace Hazel {
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const std::string& filepath)
+	{
+		Close();
+
+		HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (!mapping)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!data)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_FileHandle = file;
+		m_MappingHandle = mapping;
+		m_Data = (const uint8_t*)data;
+		m_Size = (uint64_t)size.QuadPart;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+		if (m_MappingHandle)
+			CloseHandle((HANDLE)m_MappingHandle);
+		if (m_FileHandle)
+			CloseHandle((HANDLE)m_FileHandle);
+
+		m_Data = nullptr;
+		m_Size = 0;
+		m_MappingHandle = nullptr;
+		m_FileHandle = nullptr;
+	}
+
+}
@@ -0,0 +1,149 @@
+#include "hzpch.h"
+#include "EnvironmentCache.h"
+
+#include "Renderer.h"
+#include "SceneRenderer.h"
+
+#include "Hazel/Asset/AssetManager.h"
+#include "Hazel/FileSystem/FileSystem.h"
+
+#include <filesystem>
+
+namespace Hazel {
+
+	struct EnvironmentCacheHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint64_t Key;
+		uint32_t RadianceSize, Reserved;
+		uint64_t RadianceDataSize;
+		SphericalHarmonicsL2 IrradianceSH;
+	};
+
+	static const char s_Magic[4] = { 'H', 'Z', 'E', 'C' };
+	// Bump whenever the file layout or the way the maps are generated changes
+	static const uint32_t s_Version = 2;
+
+	// Set before anything is loaded; loader threads read it
+	static std::string s_Directory = "cache/environments";
+
+	// A word at a time, as this runs over tens of megabytes of HDR image per load
+	static uint64_t HashData(const uint8_t* data, uint64_t size, uint64_t hash = 14695981039346656037ull)
+	{
+		hash ^= size;
+		uint64_t i = 0;
+		for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+		{
+			uint64_t word;
+			memcpy(&word, data + i, sizeof(word));
+			hash = (hash ^ word) * 1099511628211ull;
+			hash ^= hash >> 29;
+		}
+		for (; i < size; i++)
+			hash = (hash ^ data[i]) * 1099511628211ull;
+		return hash;
+	}
+
+	static bool Write(uint64_t key, const Buffer& radiance, const SphericalHarmonicsL2& irradiance)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(s_Directory, error);
+
+		EnvironmentCacheHeader header;
+		memcpy(header.Magic, s_Magic, sizeof(s_Magic));
+		header.Version = s_Version;
+		header.Key = key;
+		header.RadianceSize = SceneRenderer::RadianceMapSize;
+		header.Reserved = 0;
+		header.RadianceDataSize = radiance.Size;
+		header.IrradianceSH = irradiance;
+
+		// Written next to the final file and renamed, so a concurrent load never sees half a file
+		std::string path = EnvironmentCache::GetPath(key);
+		std::string tempPath = path + ".tmp";
+		FILE* f = fopen(tempPath.c_str(), "wb");
+		if (!f)
+			return false;
+
+		bool written = fwrite(&header, sizeof(header), 1, f) == 1
+			&& fwrite(radiance.Data, 1, radiance.Size, f) == radiance.Size;
+		written = fclose(f) == 0 && written;
+
+		if (written)
+			std::filesystem::rename(tempPath, path, error);
+		if (!written || error)
+		{
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+		return true;
+	}
+
+	void EnvironmentCache::SetDirectory(const std::string& directory)
+	{
+		s_Directory = directory;
+	}
+
+	const std::string& EnvironmentCache::GetDirectory()
+	{
+		return s_Directory;
+	}
+
+	uint64_t EnvironmentCache::GetKey(const uint8_t* source, uint64_t size)
+	{
+		uint32_t settings[] = { s_Version, SceneRenderer::RadianceMapSize };
+		return HashData((const uint8_t*)settings, sizeof(settings), HashData(source, size));
+	}
+
+	std::string EnvironmentCache::GetPath(uint64_t key)
+	{
+		char filename[32];
+		snprintf(filename, sizeof(filename), "%016llx.hzenv", (unsigned long long)key);
+		return (std::filesystem::path(s_Directory) / filename).string();
+	}
+
+	bool EnvironmentCache::Read(uint64_t key, EnvironmentData& outData)
+	{
+		std::string path = GetPath(key);
+		if (!FileSystem::Exists(path))
+			return false;
+
+		FileData file = FileSystem::ReadFile(path);
+		EnvironmentCacheHeader header;
+		if (file.GetSize() < sizeof(header))
+			return false;
+		memcpy(&header, file.GetData(), sizeof(header));
+
+		uint64_t radianceSize = TextureCube::GetPixelDataSize(SceneRenderer::RadianceMapSize);
+		if (memcmp(header.Magic, s_Magic, sizeof(s_Magic)) != 0 || header.Version != s_Version || header.Key != key
+			|| header.RadianceSize != SceneRenderer::RadianceMapSize || header.RadianceDataSize != radianceSize
+			|| file.GetSize() != sizeof(header) + radianceSize)
+		{
+			HZ_CORE_WARN("Ignoring stale or corrupt environment cache {0}", path);
+			return false;
+		}
+
+		uint8_t* data = (uint8_t*)file.GetData() + sizeof(header);
+		outData.RadianceData = Buffer::Copy(data, (uint32_t)radianceSize);
+		outData.IrradianceSH = header.IrradianceSH;
+		return true;
+	}
+
+	void EnvironmentCache::Store(uint64_t key, const Ref<TextureCube>& radiance, const SphericalHarmonicsL2& irradiance)
+	{
+		Renderer::Submit([key, radiance, irradiance]()
+		{
+			Buffer radianceData = radiance->ReadPixels();
+
+			AssetManager::SubmitBackgroundJob([key, radianceData, irradiance]() mutable
+			{
+				if (!Write(key, radianceData, irradiance))
+					HZ_CORE_WARN("Could not write environment cache {0}", EnvironmentCache::GetPath(key));
+
+				radianceData.Release();
+			});
+		});
+	}
+
+}
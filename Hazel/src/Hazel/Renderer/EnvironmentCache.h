@@ -0,0 +1,25 @@
+#pragma once
+
+#include "SceneEnvironment.h"
+
+namespace Hazel {
+
+	// Disk cache of the radiance cube map and irradiance SH generated for an environment, so
+	// loading one again is a file read and an upload instead of several compute passes.
+	// Files are named after a hash of the source image and the generation settings.
+	class EnvironmentCache
+	{
+	public:
+		static void SetDirectory(const std::string& directory);
+		static const std::string& GetDirectory();
+
+		static uint64_t GetKey(const uint8_t* source, uint64_t size);
+		static std::string GetPath(uint64_t key);
+
+		// Any thread. Fills in the radiance data and irradiance of outData; false if nothing usable is cached.
+		static bool Read(uint64_t key, EnvironmentData& outData);
+		// Main thread. Reads the radiance map back on the render thread and writes it out on a loader thread.
+		static void Store(uint64_t key, const Ref<TextureCube>& radiance, const SphericalHarmonicsL2& irradiance);
+	};
+
+}
@@ -0,0 +1,22 @@
+#include "hzpch.h"
+#include "GPUTimer.h"
+
+#include "Renderer.h"
+
+#include "Hazel/Platform/OpenGL/OpenGLGPUTimer.h"
+
+namespace Hazel {
+
+	Ref<GPUTimer> GPUTimer::Create()
+	{
+		switch (RendererAPI::Current())
+		{
+			case RendererAPIType::None:    return Ref<GPUTimer>::Create();
+			case RendererAPIType::OpenGL:  return Ref<OpenGLGPUTimer>::Create();
+		}
+
+		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
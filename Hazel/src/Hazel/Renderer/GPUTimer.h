@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Hazel/Core/Base.h"
+
+namespace Hazel {
+
+	// Measures how long the GPU spends on the commands between Begin and End. Results are read back
+	// once the GPU has got to them, a few frames later, without waiting; everything measured in a
+	// frame is added up (a pass can run more than once a frame) and averaged over AverageFrameCount frames.
+	// The base class measures nothing and reports 0, which is what runs without a GPU
+	// (RendererAPIType::None).
+	class GPUTimer : public RefCounted
+	{
+	public:
+		static const uint32_t AverageFrameCount = 32;
+
+		virtual ~GPUTimer() = default;
+
+		// Main thread; they submit the queries
+		virtual void Begin() {}
+		virtual void End() {}
+
+		// Milliseconds
+		virtual float GetAverageTime() const { return 0.0f; }
+		virtual float GetLastTime() const { return 0.0f; }
+
+		static Ref<GPUTimer> Create();
+	};
+
+}
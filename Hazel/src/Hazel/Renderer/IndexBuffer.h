@@ -4,6 +4,8 @@
 
 #include "RendererAPI.h"
 
+#include "Hazel/Core/Buffer.h"
+
 namespace Hazel {
 
 	class IndexBuffer : public RefCounted
@@ -11,7 +13,9 @@ namespace Hazel {
 	public:
 		virtual ~IndexBuffer() {}
 
-		virtual void SetData(void* buffer, uint32_t size, uint32_t offset = 0) = 0;
+		// The data is staged in the streaming buffer (or frame memory when that is full), so it
+		// can be reused as soon as this returns
+		virtual void SetData(BufferView data, uint32_t offset = 0) = 0;
 		virtual void Bind() const = 0;
 
 		virtual uint32_t GetCount() const = 0;
@@ -0,0 +1,263 @@
+#include "hzpch.h"
+#include "KTX2.h"
+
+namespace Hazel {
+
+	static const uint8_t s_Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+	struct KTX2Header
+	{
+		uint8_t Identifier[12];
+		uint32_t VkFormat;
+		uint32_t TypeSize;
+		uint32_t PixelWidth, PixelHeight, PixelDepth;
+		uint32_t LayerCount, FaceCount, LevelCount;
+		uint32_t SupercompressionScheme;
+
+		uint32_t DFDByteOffset, DFDByteLength;
+		uint32_t KVDByteOffset, KVDByteLength;
+		uint64_t SGDByteOffset, SGDByteLength;
+	};
+
+	struct KTX2Level
+	{
+		uint64_t ByteOffset;
+		uint64_t ByteLength;
+		uint64_t UncompressedByteLength;
+	};
+
+	static_assert(sizeof(KTX2Header) == 80, "KTX2Header must match the file layout");
+	static_assert(sizeof(KTX2Level) == 24, "KTX2Level must match the file layout");
+
+	// VkFormat values
+	enum : uint32_t
+	{
+		VK_FORMAT_BC1_RGB_UNORM_BLOCK = 131,
+		VK_FORMAT_BC1_RGB_SRGB_BLOCK = 132,
+		VK_FORMAT_BC3_UNORM_BLOCK = 137,
+		VK_FORMAT_BC3_SRGB_BLOCK = 138,
+		VK_FORMAT_BC4_UNORM_BLOCK = 139,
+		VK_FORMAT_BC5_UNORM_BLOCK = 141,
+		VK_FORMAT_BC7_UNORM_BLOCK = 145,
+		VK_FORMAT_BC7_SRGB_BLOCK = 146
+	};
+
+	static uint32_t GetVkFormat(TextureFormat format, bool srgb)
+	{
+		switch (format)
+		{
+			case TextureFormat::BC1: return srgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+			case TextureFormat::BC3: return srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+			case TextureFormat::BC4: return VK_FORMAT_BC4_UNORM_BLOCK;
+			case TextureFormat::BC5: return VK_FORMAT_BC5_UNORM_BLOCK;
+			case TextureFormat::BC7: return srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+		}
+		return 0;
+	}
+
+	static bool GetTextureFormat(uint32_t vkFormat, TextureFormat& outFormat, bool& outSRGB)
+	{
+		outSRGB = vkFormat == VK_FORMAT_BC1_RGB_SRGB_BLOCK || vkFormat == VK_FORMAT_BC3_SRGB_BLOCK || vkFormat == VK_FORMAT_BC7_SRGB_BLOCK;
+		switch (vkFormat)
+		{
+			case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+			case VK_FORMAT_BC1_RGB_SRGB_BLOCK:  outFormat = TextureFormat::BC1; return true;
+			case VK_FORMAT_BC3_UNORM_BLOCK:
+			case VK_FORMAT_BC3_SRGB_BLOCK:      outFormat = TextureFormat::BC3; return true;
+			case VK_FORMAT_BC4_UNORM_BLOCK:     outFormat = TextureFormat::BC4; return true;
+			case VK_FORMAT_BC5_UNORM_BLOCK:     outFormat = TextureFormat::BC5; return true;
+			case VK_FORMAT_BC7_UNORM_BLOCK:
+			case VK_FORMAT_BC7_SRGB_BLOCK:      outFormat = TextureFormat::BC7; return true;
+		}
+		return false;
+	}
+
+	// Khronos Data Format basic descriptor block for a BCn format
+	static std::vector<uint32_t> CreateDataFormatDescriptor(TextureFormat format, bool srgb)
+	{
+		enum { ModelBC1A = 128, ModelBC3 = 130, ModelBC4 = 131, ModelBC5 = 132, ModelBC7 = 134 };
+		enum { ChannelColor = 0, ChannelRed = 0, ChannelGreen = 1, ChannelAlpha = 15 };
+
+		uint32_t model = 0;
+		std::vector<std::pair<uint32_t, uint32_t>> samples; // Channel, bit offset; all 64 bits long
+		switch (format)
+		{
+			case TextureFormat::BC1: model = ModelBC1A; samples = { { ChannelColor, 0 } }; break;
+			case TextureFormat::BC3: model = ModelBC3;  samples = { { ChannelAlpha, 0 }, { ChannelColor, 64 } }; break;
+			case TextureFormat::BC4: model = ModelBC4;  samples = { { ChannelRed, 0 } }; break;
+			case TextureFormat::BC5: model = ModelBC5;  samples = { { ChannelRed, 0 }, { ChannelGreen, 64 } }; break;
+			case TextureFormat::BC7: model = ModelBC7;  samples = { { ChannelColor, 0 } }; break;
+		}
+		// BC7 describes its whole 128 bit block with one sample
+		uint32_t sampleBits = format == TextureFormat::BC7 ? 128 : 64;
+
+		uint32_t blockSize = 24 + 16 * (uint32_t)samples.size();
+		std::vector<uint32_t> dfd;
+		dfd.push_back(4 + blockSize);                       // Total size
+		dfd.push_back(0);                                   // Vendor 0 (Khronos), descriptor type 0 (basic)
+		dfd.push_back(2 | (blockSize << 16));               // Version 2, block size
+		dfd.push_back(model | (1 << 8) | ((srgb ? 2 : 1) << 16)); // Model, BT.709 primaries, transfer, straight alpha
+		dfd.push_back(3 | (3 << 8));                        // 4x4x1x1 texel blocks, stored minus one
+		dfd.push_back(Texture::GetBlockSize(format));       // Bytes in plane 0
+		dfd.push_back(0);
+		for (auto [channel, offset] : samples)
+		{
+			dfd.push_back(offset | ((sampleBits - 1) << 16) | (channel << 24));
+			dfd.push_back(0);          // Sample position
+			dfd.push_back(0);          // Lower
+			dfd.push_back(0xffffffff); // Upper
+		}
+		return dfd;
+	}
+
+	static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	bool KTX2::IsKTX2(const uint8_t* data, uint64_t size)
+	{
+		return size >= sizeof(s_Identifier) && memcmp(data, s_Identifier, sizeof(s_Identifier)) == 0;
+	}
+
+	static bool ReadHeader(const uint8_t* data, uint64_t size, KTX2Header& outHeader, TextureFormat& outFormat, const std::string& path)
+	{
+		if (size < sizeof(KTX2Header) || !KTX2::IsKTX2(data, size))
+			return false;
+
+		memcpy(&outHeader, data, sizeof(outHeader));
+
+		bool srgb; // Unused, see KTX2::Read
+		if (!GetTextureFormat(outHeader.VkFormat, outFormat, srgb))
+		{
+			HZ_CORE_ERROR("KTX2 format {0} is not supported ({1})", outHeader.VkFormat, path);
+			return false;
+		}
+
+		// Level count 0 asks the loader to generate mips, which compressed formats can't do
+		if (outHeader.PixelWidth == 0 || outHeader.PixelHeight == 0 || outHeader.PixelDepth > 1 || outHeader.LayerCount > 1
+			|| outHeader.FaceCount != 1 || outHeader.LevelCount == 0 || outHeader.LevelCount > Texture::CalculateMipMapCount(outHeader.PixelWidth, outHeader.PixelHeight)
+			|| outHeader.SupercompressionScheme != 0)
+		{
+			HZ_CORE_ERROR("KTX2 file only supports single 2D images without supercompression ({0})", path);
+			return false;
+		}
+
+		return sizeof(KTX2Header) + (uint64_t)outHeader.LevelCount * sizeof(KTX2Level) <= size;
+	}
+
+	bool KTX2::ReadInfo(const uint8_t* data, uint64_t size, uint32_t& outWidth, uint32_t& outHeight, uint32_t& outMipCount)
+	{
+		KTX2Header header;
+		TextureFormat format;
+		if (!ReadHeader(data, size, header, format, ""))
+			return false;
+
+		outWidth = header.PixelWidth;
+		outHeight = header.PixelHeight;
+		outMipCount = header.LevelCount;
+		return true;
+	}
+
+	bool KTX2::Read(const uint8_t* data, uint64_t size, TextureData& outData, uint32_t firstMip, uint32_t lastMip)
+	{
+		KTX2Header header;
+		TextureFormat format;
+		if (!ReadHeader(data, size, header, format, outData.Path))
+			return false;
+
+		lastMip = std::min(lastMip, header.LevelCount);
+		if (firstMip >= lastMip)
+			return false;
+
+		const KTX2Level* levels = (const KTX2Level*)(data + sizeof(KTX2Header));
+		uint64_t totalSize = 0;
+		for (uint32_t i = firstMip; i < lastMip; i++)
+		{
+			KTX2Level level;
+			memcpy(&level, &levels[i], sizeof(level));
+
+			uint32_t width = std::max(header.PixelWidth >> i, 1u);
+			uint32_t height = std::max(header.PixelHeight >> i, 1u);
+			if (level.ByteLength != Texture::GetCompressedSize(format, width, height) || level.ByteOffset > size || level.ByteLength > size - level.ByteOffset)
+			{
+				HZ_CORE_ERROR("KTX2 file is truncated or corrupt ({0})", outData.Path);
+				return false;
+			}
+			totalSize += level.ByteLength;
+		}
+
+		if (totalSize > std::numeric_limits<uint32_t>::max())
+			return false;
+
+		outData.Format = format;
+		outData.Width = header.PixelWidth;
+		outData.Height = header.PixelHeight;
+		outData.HDR = false;
+		// Whoever loads the texture knows best whether it holds colors; the file's
+		// transfer function only records what the cooker guessed
+		outData.Data.Allocate((uint32_t)totalSize);
+		outData.Mips.resize(lastMip - firstMip);
+		outData.FirstMip = firstMip;
+		outData.MipCount = header.LevelCount;
+
+		uint32_t offset = 0;
+		for (uint32_t i = firstMip; i < lastMip; i++)
+		{
+			KTX2Level level;
+			memcpy(&level, &levels[i], sizeof(level));
+
+			TextureMip& mip = outData.Mips[i - firstMip];
+			mip.Width = std::max(header.PixelWidth >> i, 1u);
+			mip.Height = std::max(header.PixelHeight >> i, 1u);
+			mip.Offset = offset;
+			mip.Size = (uint32_t)level.ByteLength;
+			memcpy(outData.Data.Data + offset, data + level.ByteOffset, mip.Size);
+			offset += mip.Size;
+		}
+		return true;
+	}
+
+	bool KTX2::Write(const TextureData& data, std::vector<uint8_t>& outFile)
+	{
+		uint32_t blockSize = Texture::GetBlockSize(data.Format);
+		if (!blockSize || data.Mips.empty() || data.FirstMip != 0)
+			return false;
+
+		std::vector<uint32_t> dfd = CreateDataFormatDescriptor(data.Format, data.SRGB);
+
+		KTX2Header header = {};
+		memcpy(header.Identifier, s_Identifier, sizeof(s_Identifier));
+		header.VkFormat = GetVkFormat(data.Format, data.SRGB);
+		header.TypeSize = 1;
+		header.PixelWidth = data.Width;
+		header.PixelHeight = data.Height;
+		header.FaceCount = 1;
+		header.LevelCount = (uint32_t)data.Mips.size();
+
+		uint64_t levelIndexSize = (uint64_t)header.LevelCount * sizeof(KTX2Level);
+		header.DFDByteOffset = (uint32_t)(sizeof(KTX2Header) + levelIndexSize);
+		header.DFDByteLength = (uint32_t)(dfd.size() * sizeof(uint32_t));
+
+		// Level data is aligned to the block size and stored smallest mip first
+		std::vector<KTX2Level> levels(header.LevelCount);
+		uint64_t offset = header.DFDByteOffset + header.DFDByteLength;
+		for (int32_t i = (int32_t)header.LevelCount - 1; i >= 0; i--)
+		{
+			offset = AlignUp(offset, blockSize);
+			levels[i].ByteOffset = offset;
+			levels[i].ByteLength = data.Mips[i].Size;
+			levels[i].UncompressedByteLength = data.Mips[i].Size;
+			offset += data.Mips[i].Size;
+		}
+
+		outFile.assign((size_t)offset, 0);
+		memcpy(outFile.data(), &header, sizeof(header));
+		memcpy(outFile.data() + sizeof(header), levels.data(), (size_t)levelIndexSize);
+		memcpy(outFile.data() + header.DFDByteOffset, dfd.data(), header.DFDByteLength);
+		for (uint32_t i = 0; i < header.LevelCount; i++)
+			memcpy(outFile.data() + levels[i].ByteOffset, data.Data.Data + data.Mips[i].Offset, data.Mips[i].Size);
+		return true;
+	}
+
+}
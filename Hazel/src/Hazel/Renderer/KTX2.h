@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Hazel/Renderer/Texture.h"
+
+namespace Hazel {
+
+	// Minimal KTX 2.0 support for the block compressed 2D textures TextureCooker produces: a single
+	// layer and face, no supercompression, every mip level present. The writer emits a basic data
+	// format descriptor so the files open in standard tools; the reader only needs the header.
+	class KTX2
+	{
+	public:
+		static bool IsKTX2(const uint8_t* data, uint64_t size);
+
+		// outData.Data is allocated with new[] and holds mips [firstMip, lastMip) of the file,
+		// in TextureData::Mips order
+		static bool Read(const uint8_t* data, uint64_t size, TextureData& outData, uint32_t firstMip = 0, uint32_t lastMip = UINT32_MAX);
+		// Header only, without reading or validating the mips
+		static bool ReadInfo(const uint8_t* data, uint64_t size, uint32_t& outWidth, uint32_t& outHeight, uint32_t& outMipCount);
+		static bool Write(const TextureData& data, std::vector<uint8_t>& outFile);
+	};
+
+}
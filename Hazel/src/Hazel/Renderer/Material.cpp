@@ -1,6 +1,8 @@
 #include "hzpch.h"
 #include "Material.h"
 
+#include "Renderer.h"
+
 namespace Hazel {
 
 	//////////////////////////////////////////////////////////////////////////////////
@@ -52,7 +54,7 @@ namespace Hazel {
 			mi->OnShaderReloaded();
 	}
 
-	ShaderUniformDeclaration* Material::FindUniformDeclaration(const std::string& name)
+	ShaderUniformDeclaration* Material::FindUniformDeclaration(std::string_view name)
 	{
 		if (m_VSUniformStorageBuffer)
 		{
@@ -76,7 +78,7 @@ namespace Hazel {
 		return nullptr;
 	}
 
-	ShaderResourceDeclaration* Material::FindResourceDeclaration(const std::string& name)
+	ShaderResourceDeclaration* Material::FindResourceDeclaration(std::string_view name)
 	{
 		auto& resources = m_Shader->GetResources();
 		for (ShaderResourceDeclaration* resource : resources)
@@ -87,7 +89,7 @@ namespace Hazel {
 		return nullptr;
 	}
 
-	Buffer& Material::GetUniformBufferTarget(ShaderUniformDeclaration* uniformDeclaration)
+	ScopedBuffer& Material::GetUniformBufferTarget(ShaderUniformDeclaration* uniformDeclaration)
 	{
 		switch (uniformDeclaration->GetDomain())
 		{
@@ -101,6 +103,8 @@ namespace Hazel {
 
 	void Material::Bind()
 	{
+		Renderer::GetCurrentFrameStats().MaterialBinds++;
+
 		m_Shader->Bind();
 
 		if (m_VSUniformStorageBuffer)
@@ -131,6 +135,16 @@ namespace Hazel {
 		return Ref<MaterialInstance>::Create(material);
 	}
 
+	Ref<MaterialInstance> MaterialInstance::Copy(const Ref<MaterialInstance>& other)
+	{
+		Ref<MaterialInstance> instance = Ref<MaterialInstance>::Create(other->m_Material, other->m_Name);
+		instance->m_VSUniformStorageBuffer = ScopedBuffer::Copy(other->m_VSUniformStorageBuffer);
+		instance->m_PSUniformStorageBuffer = ScopedBuffer::Copy(other->m_PSUniformStorageBuffer);
+		instance->m_Textures = other->m_Textures;
+		instance->m_OverriddenValues = other->m_OverriddenValues;
+		return instance;
+	}
+
 	MaterialInstance::MaterialInstance(const Ref<Material>& material, const std::string& name)
 		: m_Material(material), m_Name(name)
 	{
@@ -155,14 +169,14 @@ namespace Hazel {
 		{
 			const auto& vsBuffer = m_Material->m_Shader->GetVSMaterialUniformBuffer();
 			m_VSUniformStorageBuffer.Allocate(vsBuffer.GetSize());
-			memcpy(m_VSUniformStorageBuffer.Data, m_Material->m_VSUniformStorageBuffer.Data, vsBuffer.GetSize());
+			memcpy(m_VSUniformStorageBuffer.GetData(), m_Material->m_VSUniformStorageBuffer.GetData(), vsBuffer.GetSize());
 		}
 
 		if (m_Material->m_Shader->HasPSMaterialUniformBuffer())
 		{
 			const auto& psBuffer = m_Material->m_Shader->GetPSMaterialUniformBuffer();
 			m_PSUniformStorageBuffer.Allocate(psBuffer.GetSize());
-			memcpy(m_PSUniformStorageBuffer.Data, m_Material->m_PSUniformStorageBuffer.Data, psBuffer.GetSize());
+			memcpy(m_PSUniformStorageBuffer.GetData(), m_Material->m_PSUniformStorageBuffer.GetData(), psBuffer.GetSize());
 		}
 	}
 
@@ -184,11 +198,11 @@ namespace Hazel {
 		{
 			auto& buffer = GetUniformBufferTarget(decl);
 			auto& materialBuffer = m_Material->GetUniformBufferTarget(decl);
-			buffer.Write(materialBuffer.Data + decl->GetOffset(), decl->GetSize(), decl->GetOffset());
+			buffer.Write(materialBuffer.GetData() + decl->GetOffset(), decl->GetSize(), decl->GetOffset());
 		}
 	}
 
-	Buffer& MaterialInstance::GetUniformBufferTarget(ShaderUniformDeclaration* uniformDeclaration)
+	ScopedBuffer& MaterialInstance::GetUniformBufferTarget(ShaderUniformDeclaration* uniformDeclaration)
 	{
 		switch (uniformDeclaration->GetDomain())
 		{
@@ -202,6 +216,8 @@ namespace Hazel {
 
 	void MaterialInstance::Bind()
 	{
+		Renderer::GetCurrentFrameStats().MaterialBinds++;
+
 		m_Material->m_Shader->Bind();
 
 		if (m_VSUniformStorageBuffer)
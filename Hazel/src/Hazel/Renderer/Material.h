@@ -1,10 +1,12 @@
 #pragma once
 
 #include "Hazel/Core/Base.h"
+#include "Hazel/Core/ObjectPool.h"
 
 #include "Hazel/Renderer/Shader.h"
 #include "Hazel/Renderer/Texture.h"
 
+#include <string_view>
 #include <unordered_set>
 
 namespace Hazel {
@@ -32,7 +34,7 @@ namespace Hazel {
 		Ref<Shader> GetShader() { return m_Shader; }
 
 		template <typename T>
-		void Set(const std::string& name, const T& value)
+		void Set(std::string_view name, const T& value)
 		{
 			auto decl = FindUniformDeclaration(name);
 			HZ_CORE_ASSERT(decl, "Could not find uniform with name 'x'");
@@ -43,7 +45,7 @@ namespace Hazel {
 				mi->OnMaterialValueUpdated(decl);
 		}
 
-		void Set(const std::string& name, const Ref<Texture>& texture)
+		void Set(std::string_view name, const Ref<Texture>& texture)
 		{
 			auto decl = FindResourceDeclaration(name);
 			uint32_t slot = decl->GetRegister();
@@ -52,18 +54,18 @@ namespace Hazel {
 			m_Textures[slot] = texture;
 		}
 
-		void Set(const std::string& name, const Ref<Texture2D>& texture)
+		void Set(std::string_view name, const Ref<Texture2D>& texture)
 		{
 			Set(name, (const Ref<Texture>&)texture);
 		}
 
-		void Set(const std::string& name, const Ref<TextureCube>& texture)
+		void Set(std::string_view name, const Ref<TextureCube>& texture)
 		{
 			Set(name, (const Ref<Texture>&)texture);
 		}
 
 		template<typename T>
-		T& Get(const std::string& name)
+		T& Get(std::string_view name)
 		{
 			auto decl = FindUniformDeclaration(name);
 			HZ_CORE_ASSERT(decl, "Could not find uniform with name 'x'");
@@ -72,7 +74,7 @@ namespace Hazel {
 		}
 
 		template<typename T>
-		Ref<T> GetResource(const std::string& name)
+		Ref<T> GetResource(std::string_view name)
 		{
 			auto decl = FindResourceDeclaration(name);
 			uint32_t slot = decl->GetRegister();
@@ -80,7 +82,7 @@ namespace Hazel {
 			return m_Textures[slot];
 		}
 		
-		ShaderResourceDeclaration* FindResourceDeclaration(const std::string& name);
+		ShaderResourceDeclaration* FindResourceDeclaration(std::string_view name);
 	public:
 		static Ref<Material> Create(const Ref<Shader>& shader);
 	private:
@@ -88,14 +90,14 @@ namespace Hazel {
 		void OnShaderReloaded();
 		void BindTextures();
 
-		ShaderUniformDeclaration* FindUniformDeclaration(const std::string& name);
-		Buffer& GetUniformBufferTarget(ShaderUniformDeclaration* uniformDeclaration);
+		ShaderUniformDeclaration* FindUniformDeclaration(std::string_view name);
+		ScopedBuffer& GetUniformBufferTarget(ShaderUniformDeclaration* uniformDeclaration);
 	private:
 		Ref<Shader> m_Shader;
 		std::unordered_set<MaterialInstance*> m_MaterialInstances;
 
-		Buffer m_VSUniformStorageBuffer;
-		Buffer m_PSUniformStorageBuffer;
+		ScopedBuffer m_VSUniformStorageBuffer;
+		ScopedBuffer m_PSUniformStorageBuffer;
 		std::vector<Ref<Texture>> m_Textures;
 
 		uint32_t m_MaterialFlags;
@@ -104,12 +106,13 @@ namespace Hazel {
 	class MaterialInstance : public RefCounted
 	{
 		friend class Material;
+		HZ_POOLED_OBJECT(MaterialInstance)
 	public:
 		MaterialInstance(const Ref<Material>& material, const std::string& name = "");
 		virtual ~MaterialInstance();
 
 		template <typename T>
-		void Set(const std::string& name, const T& value)
+		void Set(std::string_view name, const T& value)
 		{
 			auto decl = m_Material->FindUniformDeclaration(name);
 			if (!decl)
@@ -119,10 +122,12 @@ namespace Hazel {
 			auto& buffer = GetUniformBufferTarget(decl);
 			buffer.Write((byte*)& value, decl->GetSize(), decl->GetOffset());
 
-			m_OverriddenValues.insert(name);
+			// Checked first, as inserting builds a string even when it's already there
+			if (m_OverriddenValues.find(decl->GetName()) == m_OverriddenValues.end())
+				m_OverriddenValues.insert(decl->GetName());
 		}
 
-		void Set(const std::string& name, const Ref<Texture>& texture)
+		void Set(std::string_view name, const Ref<Texture>& texture)
 		{
 			auto decl = m_Material->FindResourceDeclaration(name);
 			if (!decl)
@@ -136,18 +141,18 @@ namespace Hazel {
 			m_Textures[slot] = texture;
 		}
 
-		void Set(const std::string& name, const Ref<Texture2D>& texture)
+		void Set(std::string_view name, const Ref<Texture2D>& texture)
 		{
 			Set(name, (const Ref<Texture>&)texture);
 		}
 
-		void Set(const std::string& name, const Ref<TextureCube>& texture)
+		void Set(std::string_view name, const Ref<TextureCube>& texture)
 		{
 			Set(name, (const Ref<Texture>&)texture);
 		}
 
 		template<typename T>
-		T& Get(const std::string& name)
+		T& Get(std::string_view name)
 		{
 			auto decl = m_Material->FindUniformDeclaration(name);
 			HZ_CORE_ASSERT(decl, "Could not find uniform with name 'x'");
@@ -156,7 +161,7 @@ namespace Hazel {
 		}
 
 		template<typename T>
-		Ref<T> GetResource(const std::string& name)
+		Ref<T> GetResource(std::string_view name)
 		{
 			auto decl = m_Material->FindResourceDeclaration(name);
 			HZ_CORE_ASSERT(decl, "Could not find uniform with name 'x'");
@@ -166,7 +171,7 @@ namespace Hazel {
 		}
 
 		template<typename T>
-		Ref<T> TryGetResource(const std::string& name)
+		Ref<T> TryGetResource(std::string_view name)
 		{
 			auto decl = m_Material->FindResourceDeclaration(name);
 			if (!decl)
@@ -189,19 +194,22 @@ namespace Hazel {
 		Ref<Shader> GetShader() { return m_Material->m_Shader; }
 
 		const std::string& GetName() const { return m_Name; }
+		const std::vector<Ref<Texture>>& GetTextures() const { return m_Textures; }
 	public:
 		static Ref<MaterialInstance> Create(const Ref<Material>& material);
+		// A separate instance of the same material, starting out with other's values, textures and overrides
+		static Ref<MaterialInstance> Copy(const Ref<MaterialInstance>& other);
 	private:
 		void AllocateStorage();
 		void OnShaderReloaded();
-		Buffer& GetUniformBufferTarget(ShaderUniformDeclaration* uniformDeclaration);
+		ScopedBuffer& GetUniformBufferTarget(ShaderUniformDeclaration* uniformDeclaration);
 		void OnMaterialValueUpdated(ShaderUniformDeclaration* decl);
 	private:
 		Ref<Material> m_Material;
 		std::string m_Name;
 
-		Buffer m_VSUniformStorageBuffer;
-		Buffer m_PSUniformStorageBuffer;
+		ScopedBuffer m_VSUniformStorageBuffer;
+		ScopedBuffer m_PSUniformStorageBuffer;
 		std::vector<Ref<Texture>> m_Textures;
 
 		// TODO: This is temporary; come up with a proper system to track overrides
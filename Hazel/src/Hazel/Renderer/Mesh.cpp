@@ -15,6 +15,8 @@
 #include <assimp/Importer.hpp>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/LogStream.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
 
 #include "imgui/imgui.h"
 
@@ -22,8 +24,11 @@
 #include "Hazel/Renderer/VertexBuffer.h"
 
 #include "Hazel/Physics/PhysicsUtil.h"
+#include "Hazel/Asset/AssetManager.h"
+#include "Hazel/FileSystem/FileSystem.h"
 
 #include <filesystem>
+#include <mutex>
 
 namespace Hazel {
 
@@ -58,11 +63,16 @@ namespace Hazel {
 	{
 		static void Initialize()
 		{
-			if (Assimp::DefaultLogger::isNullLogger())
+			// Meshes can be imported from several asset loader threads at once
+			static std::once_flag s_InitFlag;
+			std::call_once(s_InitFlag, []()
 			{
-				Assimp::DefaultLogger::create("", Assimp::Logger::VERBOSE);
-				Assimp::DefaultLogger::get()->attachStream(new LogStream, Assimp::Logger::Err | Assimp::Logger::Warn);
-			}
+				if (Assimp::DefaultLogger::isNullLogger())
+				{
+					Assimp::DefaultLogger::create("", Assimp::Logger::VERBOSE);
+					Assimp::DefaultLogger::get()->attachStream(new LogStream, Assimp::Logger::Err | Assimp::Logger::Warn);
+				}
+			});
 		}
 
 		virtual void write(const char* message) override
@@ -71,25 +81,122 @@ namespace Hazel {
 		}
 	};
 
-	Mesh::Mesh(const std::string& filename)
-		: m_FilePath(filename)
+	struct FileSystemStream : public Assimp::IOStream
+	{
+		FileSystemStream(FileData&& data)
+			: Data(std::move(data)) {}
+
+		virtual size_t Read(void* buffer, size_t size, size_t count) override
+		{
+			if (size == 0)
+				return 0;
+
+			count = std::min(count, (size_t)(Data.GetSize() - Position) / size);
+			memcpy(buffer, Data.GetData() + Position, size * count);
+			Position += size * count;
+			return count;
+		}
+
+		virtual size_t Write(const void* buffer, size_t size, size_t count) override { return 0; }
+
+		// Assimp passes offsets from the current position or the end as negative values cast to size_t
+		virtual aiReturn Seek(size_t offset, aiOrigin origin) override
+		{
+			int64_t size = (int64_t)Data.GetSize();
+			int64_t base = origin == aiOrigin_SET ? 0 : (origin == aiOrigin_CUR ? (int64_t)Position : size);
+			int64_t position = base + (int64_t)offset;
+			if (position < 0 || position > size)
+				return aiReturn_FAILURE;
+
+			Position = (size_t)position;
+			return aiReturn_SUCCESS;
+		}
+
+		virtual size_t Tell() const override { return Position; }
+		virtual size_t FileSize() const override { return (size_t)Data.GetSize(); }
+		virtual void Flush() override {}
+
+		FileData Data;
+		size_t Position = 0;
+	};
+
+	// Routes Assimp's reads (the mesh and any files it references) through Hazel's FileSystem
+	struct FileSystemIO : public Assimp::IOSystem
+	{
+		virtual bool Exists(const char* path) const override { return FileSystem::Exists(path); }
+		virtual char getOsSeparator() const override { return '/'; }
+
+		virtual Assimp::IOStream* Open(const char* path, const char* mode) override
+		{
+			if (strchr(mode, 'w') || strchr(mode, 'a'))
+				return nullptr;
+
+			FileData data = FileSystem::ReadFile(path);
+			if (!data)
+				return nullptr;
+
+			return new FileSystemStream(std::move(data));
+		}
+
+		virtual void Close(Assimp::IOStream* stream) override { delete stream; }
+	};
+
+	// TODO: Temp - this should be handled by Hazel's filesystem
+	static std::string GetTexturePath(const std::string& meshPath, const std::string& texturePath)
+	{
+		std::filesystem::path path = meshPath;
+		auto parentPath = path.parent_path();
+		parentPath /= texturePath;
+		return parentPath.string();
+	}
+
+	template<typename VertexType>
+	static float CalculateUVDensity(const VertexType* vertices, const Index* indices, uint32_t triangleCount)
+	{
+		float uvArea = 0.0f, area = 0.0f;
+		for (uint32_t i = 0; i < triangleCount; i++)
+		{
+			const VertexType& v0 = vertices[indices[i].V1];
+			const VertexType& v1 = vertices[indices[i].V2];
+			const VertexType& v2 = vertices[indices[i].V3];
+
+			area += glm::length(glm::cross(v1.Position - v0.Position, v2.Position - v0.Position));
+			glm::vec2 e0 = v1.Texcoord - v0.Texcoord;
+			glm::vec2 e1 = v2.Texcoord - v0.Texcoord;
+			uvArea += glm::abs(e0.x * e1.y - e0.y * e1.x);
+		}
+		return area > 0.0f ? glm::sqrt(uvArea / area) : 0.0f;
+	}
+
+	Mesh::Mesh(const std::string& filename, MeshResidency residency)
 	{
+		// A failed import leaves nothing to upload; the mesh stays empty and reports it through Loaded
+		if (Import(filename))
+			CreateGPUResources(residency, false);
+	}
+
+	bool Mesh::Import(const std::string& filename)
+	{
+		m_FilePath = filename;
+
 		LogStream::Initialize();
 
 		HZ_CORE_INFO("Loading mesh: {0}", filename.c_str());
 		
 		m_Importer = std::make_unique<Assimp::Importer>();
+		m_Importer->SetIOHandler(new FileSystemIO());
 
 		const aiScene* scene = m_Importer->ReadFile(filename, s_MeshImportFlags);
 		if (!scene || !scene->HasMeshes())
+		{
 			HZ_CORE_ERROR("Failed to load mesh file: {0}", filename);
+			m_Importer.reset();
+			return false;
+		}
 
 		m_Scene = scene;
 
 		m_IsAnimated = scene->mAnimations != nullptr;
-		m_MeshShader = m_IsAnimated ? Renderer::GetShaderLibrary()->Get("HazelPBR_Anim") : Renderer::GetShaderLibrary()->Get("HazelPBR_Static");
-		m_BaseMaterial = Ref<Material>::Create(m_MeshShader);
-		// m_MaterialInstance = Ref<MaterialInstance>::Create(m_BaseMaterial);
 		m_InverseTransform = glm::inverse(Mat4FromAssimpMat4(scene->mRootNode->mTransformation));
 
 		uint32_t vertexCount = 0;
@@ -171,15 +278,20 @@ namespace Hazel {
 				HZ_CORE_ASSERT(mesh->mFaces[i].mNumIndices == 3, "Must have 3 indices.");
 				Index index = { mesh->mFaces[i].mIndices[0], mesh->mFaces[i].mIndices[1], mesh->mFaces[i].mIndices[2] };
 				m_Indices.push_back(index);
-
-				if (!m_IsAnimated)
-					m_TriangleCache[m].emplace_back(m_StaticVertices[index.V1 + submesh.BaseVertex], m_StaticVertices[index.V2 + submesh.BaseVertex], m_StaticVertices[index.V3 + submesh.BaseVertex]);
 			}
 
-			
+			if (mesh->HasTextureCoords(0))
+			{
+				const Index* indices = &m_Indices[submesh.BaseIndex / 3];
+				if (m_IsAnimated)
+					submesh.UVDensity = CalculateUVDensity(&m_AnimatedVertices[submesh.BaseVertex], indices, mesh->mNumFaces);
+				else
+					submesh.UVDensity = CalculateUVDensity(&m_StaticVertices[submesh.BaseVertex], indices, mesh->mNumFaces);
+			}
 		}
 
 		TraverseNodes(scene->mRootNode);
+		BuildSubmeshBVHs();
 
 		// Bones
 		if (m_IsAnimated)
@@ -195,7 +307,8 @@ namespace Hazel {
 					std::string boneName(bone->mName.data);
 					int boneIndex = 0;
 
-					if (m_BoneMapping.find(boneName) == m_BoneMapping.end())
+					auto boneIt = m_BoneMapping.find(boneName);
+					if (boneIt == m_BoneMapping.end())
 					{
 						// Allocate an index for a new bone
 						boneIndex = m_BoneCount;
@@ -208,7 +321,7 @@ namespace Hazel {
 					else
 					{
 						HZ_MESH_LOG("Found existing bone in map");
-						boneIndex = m_BoneMapping[boneName];
+						boneIndex = boneIt->second;
 					}
 
 					for (size_t j = 0; j < bone->mNumWeights; j++)
@@ -222,19 +335,19 @@ namespace Hazel {
 		}
 
 		// Materials
+		// Only the description is read here; material instances and textures need the renderer
 		if (scene->HasMaterials())
 		{
 			HZ_MESH_LOG("---- Materials - {0} ----", filename);
 
-			m_Textures.resize(scene->mNumMaterials);
-			m_Materials.resize(scene->mNumMaterials);
+			m_ImportedMaterials.resize(scene->mNumMaterials);
 			for (uint32_t i = 0; i < scene->mNumMaterials; i++)
 			{
 				auto aiMaterial = scene->mMaterials[i];
 				auto aiMaterialName = aiMaterial->GetName();
 
-				auto mi = Ref<MaterialInstance>::Create(m_BaseMaterial, aiMaterialName.data);
-				m_Materials[i] = mi;
+				ImportedMaterial& material = m_ImportedMaterials[i];
+				material.Name = aiMaterialName.data;
 
 				HZ_MESH_LOG("  {0} (Index = {1})", aiMaterialName.data, i);
 				aiString aiTexPath;
@@ -243,6 +356,7 @@ namespace Hazel {
 
 				aiColor3D aiColor;
 				aiMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, aiColor);
+				material.AlbedoColor = { aiColor.r, aiColor.g, aiColor.b };
 
 				float shininess, metalness;
 				if (aiMaterial->Get(AI_MATKEY_SHININESS, shininess) != aiReturn_SUCCESS)
@@ -251,58 +365,26 @@ namespace Hazel {
 				if (aiMaterial->Get(AI_MATKEY_REFLECTIVITY, metalness) != aiReturn_SUCCESS)
 					metalness = 0.0f;
 
-				float roughness = 1.0f - glm::sqrt(shininess / 100.0f);
+				material.Roughness = 1.0f - glm::sqrt(shininess / 100.0f);
+				material.Metalness = metalness;
 				HZ_MESH_LOG("    COLOR = {0}, {1}, {2}", aiColor.r, aiColor.g, aiColor.b);
-				HZ_MESH_LOG("    ROUGHNESS = {0}", roughness);
-				bool hasAlbedoMap = aiMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &aiTexPath) == AI_SUCCESS;
-				if (hasAlbedoMap)
+				HZ_MESH_LOG("    ROUGHNESS = {0}", material.Roughness);
+
+				if (aiMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &aiTexPath) == AI_SUCCESS)
 				{
-					// TODO: Temp - this should be handled by Hazel's filesystem
-					std::filesystem::path path = filename;
-					auto parentPath = path.parent_path();
-					parentPath /= std::string(aiTexPath.data);
-					std::string texturePath = parentPath.string();
-					HZ_MESH_LOG("    Albedo map path = {0}", texturePath);
-					auto texture = Texture2D::Create(texturePath, true);
-					if (texture->Loaded())
-					{
-						m_Textures[i] = texture;
-						mi->Set("u_AlbedoTexture", m_Textures[i]);
-						mi->Set("u_AlbedoTexToggle", 1.0f);
-					}
-					else
-					{
-						HZ_CORE_ERROR("Could not load texture: {0}", texturePath);
-						// Fallback to albedo color
-						mi->Set("u_AlbedoColor", glm::vec3{ aiColor.r, aiColor.g, aiColor.b });
-					}
+					material.AlbedoMapPath = GetTexturePath(filename, aiTexPath.data);
+					HZ_MESH_LOG("    Albedo map path = {0}", material.AlbedoMapPath);
 				}
 				else
 				{
-					mi->Set("u_AlbedoColor", glm::vec3 { aiColor.r, aiColor.g, aiColor.b });
 					HZ_MESH_LOG("    No albedo map");
 				}
 
 				// Normal maps
-				mi->Set("u_NormalTexToggle", 0.0f);
 				if (aiMaterial->GetTexture(aiTextureType_NORMALS, 0, &aiTexPath) == AI_SUCCESS)
 				{
-					// TODO: Temp - this should be handled by Hazel's filesystem
-					std::filesystem::path path = filename;
-					auto parentPath = path.parent_path();
-					parentPath /= std::string(aiTexPath.data);
-					std::string texturePath = parentPath.string();
-					HZ_MESH_LOG("    Normal map path = {0}", texturePath);
-					auto texture = Texture2D::Create(texturePath);
-					if (texture->Loaded())
-					{
-						mi->Set("u_NormalTexture", texture);
-						mi->Set("u_NormalTexToggle", 1.0f);
-					}
-					else
-					{
-						HZ_CORE_ERROR("    Could not load texture: {0}", texturePath);
-					}
+					material.NormalMapPath = GetTexturePath(filename, aiTexPath.data);
+					HZ_MESH_LOG("    Normal map path = {0}", material.NormalMapPath);
 				}
 				else
 				{
@@ -310,63 +392,17 @@ namespace Hazel {
 				}
 
 				// Roughness map
-				// mi->Set("u_Roughness", 1.0f);
-				// mi->Set("u_RoughnessTexToggle", 0.0f);
 				if (aiMaterial->GetTexture(aiTextureType_SHININESS, 0, &aiTexPath) == AI_SUCCESS)
 				{
-					// TODO: Temp - this should be handled by Hazel's filesystem
-					std::filesystem::path path = filename;
-					auto parentPath = path.parent_path();
-					parentPath /= std::string(aiTexPath.data);
-					std::string texturePath = parentPath.string();
-					HZ_MESH_LOG("    Roughness map path = {0}", texturePath);
-					auto texture = Texture2D::Create(texturePath);
-					if (texture->Loaded())
-					{
-						mi->Set("u_RoughnessTexture", texture);
-						mi->Set("u_RoughnessTexToggle", 1.0f);
-					}
-					else
-					{
-						HZ_CORE_ERROR("    Could not load texture: {0}", texturePath);
-					}
+					material.RoughnessMapPath = GetTexturePath(filename, aiTexPath.data);
+					HZ_MESH_LOG("    Roughness map path = {0}", material.RoughnessMapPath);
 				}
 				else
 				{
 					HZ_MESH_LOG("    No roughness map");
-					mi->Set("u_Roughness", roughness);
 				}
 
-#if 0
 				// Metalness map (or is it??)
-				if (aiMaterial->Get("$raw.ReflectionFactor|file", aiPTI_String, 0, aiTexPath) == AI_SUCCESS)
-				{
-					// TODO: Temp - this should be handled by Hazel's filesystem
-					std::filesystem::path path = filename;
-					auto parentPath = path.parent_path();
-					parentPath /= std::string(aiTexPath.data);
-					std::string texturePath = parentPath.string();
-
-					auto texture = Texture2D::Create(texturePath);
-					if (texture->Loaded())
-					{
-						HZ_MESH_LOG("    Metalness map path = {0}", texturePath);
-						mi->Set("u_MetalnessTexture", texture);
-						mi->Set("u_MetalnessTexToggle", 1.0f);
-					}
-					else
-					{
-						HZ_CORE_ERROR("Could not load texture: {0}", texturePath);
-					}
-				}
-				else
-				{
-					HZ_MESH_LOG("    No metalness texture");
-					mi->Set("u_Metalness", metalness);
-				}
-#endif
-
-				bool metalnessTextureFound = false;
 				for (uint32_t i = 0; i < aiMaterial->mNumProperties; i++)
 				{
 					auto prop = aiMaterial->mProperties[i];
@@ -431,40 +467,143 @@ namespace Hazel {
 						std::string key = prop->mKey.data;
 						if (key == "$raw.ReflectionFactor|file")
 						{
-							metalnessTextureFound = true;
-
-							// TODO: Temp - this should be handled by Hazel's filesystem
-							std::filesystem::path path = filename;
-							auto parentPath = path.parent_path();
-							parentPath /= str;
-							std::string texturePath = parentPath.string();
-							HZ_MESH_LOG("    Metalness map path = {0}", texturePath);
-							auto texture = Texture2D::Create(texturePath);
-							if (texture->Loaded())
-							{
-								mi->Set("u_MetalnessTexture", texture);
-								mi->Set("u_MetalnessTexToggle", 1.0f);
-							}
-							else
-							{
-								HZ_CORE_ERROR("    Could not load texture: {0}", texturePath);
-								mi->Set("u_Metalness", metalness);
-								mi->Set("u_MetalnessTexToggle", 0.0f);
-							}
+							material.MetalnessMapPath = GetTexturePath(filename, str);
+							HZ_MESH_LOG("    Metalness map path = {0}", material.MetalnessMapPath);
 							break;
 						}
 					}
 				}
 
-				if (!metalnessTextureFound)
-				{
+				if (material.MetalnessMapPath.empty())
 					HZ_MESH_LOG("    No metalness map");
+			}
+			HZ_MESH_LOG("------------------------");
+		}
+
+		return true;
+	}
+
+	static void SetMaterialTexture(Ref<MaterialInstance> material, const Ref<Texture2D>& texture, const std::string& path, const std::string& textureUniform, const std::string& toggleUniform)
+	{
+		if (texture && texture->Loaded())
+		{
+			material->Set(textureUniform, texture);
+			material->Set(toggleUniform, 1.0f);
+		}
+		else
+		{
+			HZ_CORE_ERROR("    Could not load texture: {0}", path);
+		}
+	}
+
+	void Mesh::CreateGPUResources(MeshResidency residency, bool asyncTextures)
+	{
+		HZ_CORE_ASSERT(!m_Submeshes.empty(), "Creating GPU resources for a mesh that failed to import!");
+
+		m_MeshShader = m_IsAnimated ? Renderer::GetShaderLibrary()->Get("HazelPBR_Anim") : Renderer::GetShaderLibrary()->Get("HazelPBR_Static");
+		m_BaseMaterial = Ref<Material>::Create(m_MeshShader);
+		// m_MaterialInstance = Ref<MaterialInstance>::Create(m_BaseMaterial);
+
+		// Blocking loads gather every material's maps first so they decode in parallel
+		struct PendingTexture
+		{
+			uint32_t MaterialIndex;
+			bool IsAlbedo;
+			std::string Path;
+			std::string TextureUniform;
+			std::string ToggleUniform;
+		};
+		std::vector<PendingTexture> pendingTextures;
+		std::vector<std::pair<std::string, bool>> pendingTextureRequests;
+
+		m_Textures.resize(m_ImportedMaterials.size());
+		m_Materials.resize(m_ImportedMaterials.size());
+		for (uint32_t i = 0; i < m_ImportedMaterials.size(); i++)
+		{
+			const ImportedMaterial& material = m_ImportedMaterials[i];
+
+			auto mi = Ref<MaterialInstance>::Create(m_BaseMaterial, material.Name);
+			m_Materials[i] = mi;
+
+			// Fallback values are set up front so the material renders sensibly until (or unless) its maps arrive
+			mi->Set("u_AlbedoColor", material.AlbedoColor);
+			mi->Set("u_AlbedoTexToggle", 0.0f);
+			mi->Set("u_NormalTexToggle", 0.0f);
+			mi->Set("u_Roughness", material.Roughness);
+			mi->Set("u_RoughnessTexToggle", 0.0f);
+			mi->Set("u_Metalness", material.Metalness);
+			mi->Set("u_MetalnessTexToggle", 0.0f);
+
+			struct TextureSlot
+			{
+				const std::string& Path;
+				bool SRGB;
+				const char* TextureUniform;
+				const char* ToggleUniform;
+			};
 
-					mi->Set("u_Metalness", metalness);
-					mi->Set("u_MetalnessTexToggle", 0.0f);
+			TextureSlot slots[] = {
+				{ material.AlbedoMapPath,    true,  "u_AlbedoTexture",    "u_AlbedoTexToggle" },
+				{ material.NormalMapPath,    false, "u_NormalTexture",    "u_NormalTexToggle" },
+				{ material.RoughnessMapPath, false, "u_RoughnessTexture", "u_RoughnessTexToggle" },
+				{ material.MetalnessMapPath, false, "u_MetalnessTexture", "u_MetalnessTexToggle" },
+			};
+
+			for (const auto& slot : slots)
+			{
+				if (slot.Path.empty())
+					continue;
+
+				bool isAlbedo = &slot == &slots[0];
+				std::string path = slot.Path;
+				std::string textureUniform = slot.TextureUniform;
+				std::string toggleUniform = slot.ToggleUniform;
+				if (asyncTextures)
+				{
+					// The mesh is already owned by the asset manager at this point, so keeping it alive here is safe
+					Ref<Mesh> mesh = this;
+					AssetImportSettings settings;
+					settings.SRGB = slot.SRGB;
+					AssetManager::LoadAsync<Texture2D>(path, settings, [mesh, mi, i, isAlbedo, path, textureUniform, toggleUniform](const Ref<Texture2D>& texture) mutable
+					{
+						SetMaterialTexture(mi, texture, path, textureUniform, toggleUniform);
+						if (!texture || !texture->Loaded())
+							return;
+
+						if (isAlbedo)
+							mesh->m_Textures[i] = texture;
+
+						// Instances copied the material before the texture arrived; leave any they've set themselves
+						for (Mesh* instance : mesh->m_Instances)
+						{
+							const Ref<MaterialInstance>& material = instance->m_Materials[i];
+							if (!material->TryGetResource<Texture2D>(textureUniform))
+								SetMaterialTexture(material, texture, path, textureUniform, toggleUniform);
+							if (isAlbedo && !instance->m_Textures[i])
+								instance->m_Textures[i] = texture;
+						}
+					});
+				}
+				else
+				{
+					pendingTextures.push_back({ i, isAlbedo, path, textureUniform, toggleUniform });
+					pendingTextureRequests.push_back({ path, slot.SRGB });
 				}
 			}
-			HZ_MESH_LOG("------------------------");
+		}
+		std::vector<ImportedMaterial>().swap(m_ImportedMaterials);
+
+		if (!pendingTextures.empty())
+		{
+			std::vector<Ref<Texture2D>> textures = AssetManager::LoadTextures2D(pendingTextureRequests);
+			for (size_t t = 0; t < pendingTextures.size(); t++)
+			{
+				const PendingTexture& pending = pendingTextures[t];
+				const Ref<Texture2D>& texture = textures[t];
+				SetMaterialTexture(m_Materials[pending.MaterialIndex], texture, pending.Path, pending.TextureUniform, pending.ToggleUniform);
+				if (pending.IsAlbedo && texture->Loaded())
+					m_Textures[pending.MaterialIndex] = texture;
+			}
 		}
 
 		VertexBufferLayout vertexLayout;
@@ -498,18 +637,41 @@ namespace Hazel {
 		PipelineSpecification pipelineSpecification;
 		pipelineSpecification.Layout = vertexLayout;
 		m_Pipeline = Pipeline::Create(pipelineSpecification);
+		m_Loaded = true;
+
+		SetResidency(residency);
 	}
 
-	Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<Index>& indices)
+	Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<Index>& indices, MeshResidency residency)
 		: m_StaticVertices(vertices), m_Indices(indices), m_IsAnimated(false)
 	{
 		Submesh submesh;
 		submesh.BaseVertex = 0;
 		submesh.BaseIndex = 0;
+		submesh.MaterialIndex = 0;
 		submesh.IndexCount = indices.size() * 3;
+		submesh.VertexCount = vertices.size();
 		submesh.Transform = glm::mat4(1.0F);
+		if (!indices.empty())
+			submesh.UVDensity = CalculateUVDensity(vertices.data(), indices.data(), (uint32_t)indices.size());
 		m_Submeshes.push_back(submesh);
 
+		BuildSubmeshBVHs();
+
+		// A single default material so generated meshes can be rendered like imported ones
+		m_MeshShader = Renderer::GetShaderLibrary()->Get("HazelPBR_Static");
+		m_BaseMaterial = Ref<Material>::Create(m_MeshShader);
+		auto mi = Ref<MaterialInstance>::Create(m_BaseMaterial, "Default");
+		mi->Set("u_AlbedoColor", glm::vec3(0.8f));
+		mi->Set("u_AlbedoTexToggle", 0.0f);
+		mi->Set("u_NormalTexToggle", 0.0f);
+		mi->Set("u_Roughness", 0.8f);
+		mi->Set("u_RoughnessTexToggle", 0.0f);
+		mi->Set("u_Metalness", 0.0f);
+		mi->Set("u_MetalnessTexToggle", 0.0f);
+		m_Materials.push_back(mi);
+		m_Textures.resize(1);
+
 		m_VertexBuffer = VertexBuffer::Create(m_StaticVertices.data(), m_StaticVertices.size() * sizeof(Vertex));
 		m_IndexBuffer = IndexBuffer::Create(m_Indices.data(), m_Indices.size() * sizeof(Index));
 
@@ -522,10 +684,41 @@ namespace Hazel {
 			{ ShaderDataType::Float2, "a_TexCoord" },
 		};
 		m_Pipeline = Pipeline::Create(pipelineSpecification);
+		m_Loaded = true;
+
+		SetResidency(residency);
+	}
+
+	Mesh::Mesh(const Ref<Mesh>& source)
+		: m_Source(source->m_Source ? source->m_Source : source)
+	{
+		m_Source->m_Instances.insert(this);
+
+		m_FilePath = m_Source->m_FilePath;
+		m_Submeshes = m_Source->m_Submeshes;
+		m_VertexBuffer = m_Source->m_VertexBuffer;
+		m_IndexBuffer = m_Source->m_IndexBuffer;
+		m_Pipeline = m_Source->m_Pipeline;
+		m_MeshShader = m_Source->m_MeshShader;
+		m_BaseMaterial = m_Source->m_BaseMaterial;
+		m_Textures = m_Source->m_Textures;
+		m_Loaded = m_Source->m_Loaded;
+
+		m_Materials.reserve(m_Source->m_Materials.size());
+		for (const auto& material : m_Source->m_Materials)
+			m_Materials.push_back(MaterialInstance::Copy(material));
+
+		// Bone offsets are shared data too, but each instance poses its own final transforms
+		m_IsAnimated = m_Source->m_IsAnimated;
+		m_InverseTransform = m_Source->m_InverseTransform;
+		m_BoneCount = m_Source->m_BoneCount;
+		m_BoneInfo = m_Source->m_BoneInfo;
 	}
 
 	Mesh::~Mesh()
 	{
+		if (m_Source)
+			m_Source->m_Instances.erase(this);
 	}
 
 	void Mesh::OnUpdate(Timestep ts)
@@ -536,9 +729,10 @@ namespace Hazel {
 			{
 				m_WorldTime += ts;
 
-				float ticksPerSecond = (float)(m_Scene->mAnimations[0]->mTicksPerSecond != 0 ? m_Scene->mAnimations[0]->mTicksPerSecond : 25.0f) * m_TimeMultiplier;
+				const aiAnimation* animation = GetSource().m_Scene->mAnimations[0];
+				float ticksPerSecond = (float)(animation->mTicksPerSecond != 0 ? animation->mTicksPerSecond : 25.0f) * m_TimeMultiplier;
 				m_AnimationTime += ts * ticksPerSecond;
-				m_AnimationTime = fmod(m_AnimationTime, (float)m_Scene->mAnimations[0]->mDuration);
+				m_AnimationTime = fmod(m_AnimationTime, (float)animation->mDuration);
 			}
 
 			// TODO: We only need to recalc bones if rendering has been requested at the current animation frame
@@ -546,6 +740,153 @@ namespace Hazel {
 		}
 	}
 
+	void Mesh::SetResidency(MeshResidency residency)
+	{
+		if (m_Source)
+		{
+			m_Source->SetResidency(residency);
+			return;
+		}
+
+		if (residency < m_Residency)
+		{
+			HZ_CORE_WARN("Mesh {0}: CPU data has already been released, reload the mesh to raise its residency", m_FilePath);
+			return;
+		}
+
+		m_Residency = residency;
+		if (residency == MeshResidency::KeepAll)
+			return;
+
+		// Vertex and index buffers take their own copy of the data on creation,
+		// so nothing here is needed for the GPU upload anymore
+		if (residency == MeshResidency::KeepCollision && !m_StaticVertices.empty())
+			m_Positions = GetVertexPositions();
+
+		std::vector<Vertex>().swap(m_StaticVertices);
+		std::vector<AnimatedVertex>().swap(m_AnimatedVertices);
+
+		if (residency == MeshResidency::GPUOnly)
+		{
+			std::vector<glm::vec3>().swap(m_Positions);
+			std::vector<Index>().swap(m_Indices);
+			std::vector<MeshBVH>().swap(m_SubmeshBVHs);
+		}
+
+		// Animation samples the imported scene every frame, static meshes are done with it
+		if (!m_IsAnimated)
+		{
+			m_Importer.reset();
+			m_Scene = nullptr;
+		}
+	}
+
+	std::vector<glm::vec3> Mesh::GetVertexPositions() const
+	{
+		const Mesh& source = GetSource();
+		if (source.m_StaticVertices.empty())
+			return source.m_Positions;
+
+		std::vector<glm::vec3> positions;
+		positions.reserve(source.m_StaticVertices.size());
+		for (const auto& vertex : source.m_StaticVertices)
+			positions.push_back(vertex.Position);
+		return positions;
+	}
+
+	// Instances report the source's data, which they share
+	MeshMemoryStats Mesh::GetMemoryStats() const
+	{
+		const Mesh& source = GetSource();
+		MeshMemoryStats stats;
+		stats.VertexData = source.m_StaticVertices.capacity() * sizeof(Vertex) + source.m_AnimatedVertices.capacity() * sizeof(AnimatedVertex);
+		stats.PositionData = source.m_Positions.capacity() * sizeof(glm::vec3);
+		stats.IndexData = source.m_Indices.capacity() * sizeof(Index);
+
+		for (const auto& bvh : source.m_SubmeshBVHs)
+			stats.BVHData += bvh.GetMemoryUsage();
+
+		if (source.m_Importer)
+		{
+			aiMemoryInfo info;
+			source.m_Importer->GetMemoryRequirements(info);
+			stats.ImporterData = info.total;
+		}
+
+		stats.GPUVertexData = m_VertexBuffer ? m_VertexBuffer->GetSize() : 0;
+		stats.GPUIndexData = m_IndexBuffer ? m_IndexBuffer->GetSize() : 0;
+		return stats;
+	}
+
+	MeshBVHGeometry Mesh::GetSubmeshGeometry(const Submesh& submesh) const
+	{
+		const Mesh& source = GetSource();
+		MeshBVHGeometry geometry;
+		if (source.m_StaticVertices.empty())
+		{
+			geometry.Positions = &source.m_Positions[submesh.BaseVertex];
+			geometry.PositionStride = sizeof(glm::vec3);
+		}
+		else
+		{
+			geometry.Positions = &source.m_StaticVertices[submesh.BaseVertex].Position;
+			geometry.PositionStride = sizeof(Vertex);
+		}
+		geometry.Indices = &source.m_Indices[submesh.BaseIndex / 3].V1;
+		geometry.TriangleCount = submesh.IndexCount / 3;
+		return geometry;
+	}
+
+	void Mesh::BuildSubmeshBVHs()
+	{
+		// Picking only works against static geometry for now
+		if (m_IsAnimated)
+			return;
+
+		m_SubmeshBVHs.resize(m_Submeshes.size());
+		for (size_t i = 0; i < m_Submeshes.size(); i++)
+		{
+			const Submesh& submesh = m_Submeshes[i];
+			if (submesh.IndexCount > 0)
+				m_SubmeshBVHs[i].Build(GetSubmeshGeometry(submesh));
+		}
+	}
+
+	bool Mesh::Raycast(const Ray& ray, const glm::mat4& transform, MeshRaycastHit& outHit) const
+	{
+		bool hit = false;
+		float closest = std::numeric_limits<float>::max();
+
+		const std::vector<MeshBVH>& submeshBVHs = GetSource().m_SubmeshBVHs;
+		for (uint32_t i = 0; i < submeshBVHs.size(); i++)
+		{
+			const MeshBVH& bvh = submeshBVHs[i];
+			if (bvh.IsEmpty())
+				continue;
+
+			// Direction is deliberately left unnormalized so t stays comparable across submeshes
+			const Submesh& submesh = m_Submeshes[i];
+			glm::mat4 submeshTransform = transform * submesh.Transform;
+			Ray localRay = {
+				glm::inverse(submeshTransform) * glm::vec4(ray.Origin, 1.0f),
+				glm::inverse(glm::mat3(submeshTransform)) * ray.Direction
+			};
+
+			uint32_t triangle;
+			float distance;
+			if (bvh.Raycast(localRay, GetSubmeshGeometry(submesh), triangle, distance, closest))
+			{
+				closest = distance;
+				outHit.Submesh = i;
+				outHit.Triangle = triangle;
+				outHit.Distance = distance;
+				hit = true;
+			}
+		}
+
+		return hit;
+	}
+
 	static std::string LevelToSpaces(uint32_t level)
 	{
 		std::string result = "";
@@ -685,8 +1026,8 @@ namespace Hazel {
 
 	void Mesh::ReadNodeHierarchy(float AnimationTime, const aiNode* pNode, const glm::mat4& parentTransform)
 	{
-		std::string name(pNode->mName.data);
-		const aiAnimation* animation = m_Scene->mAnimations[0];
+		std::string_view name(pNode->mName.data, pNode->mName.length);
+		const aiAnimation* animation = GetSource().m_Scene->mAnimations[0];
 		glm::mat4 nodeTransform(Mat4FromAssimpMat4(pNode->mTransformation));
 		const aiNodeAnim* nodeAnim = FindNodeAnim(animation, name);
 
@@ -706,9 +1047,11 @@ namespace Hazel {
 
 		glm::mat4 transform = parentTransform * nodeTransform;
 
-		if (m_BoneMapping.find(name) != m_BoneMapping.end())
+		const auto& boneMapping = GetSource().m_BoneMapping;
+		auto boneIt = boneMapping.find(name);
+		if (boneIt != boneMapping.end())
 		{
-			uint32_t BoneIndex = m_BoneMapping[name];
+			uint32_t BoneIndex = boneIt->second;
 			m_BoneInfo[BoneIndex].FinalTransformation = m_InverseTransform * transform * m_BoneInfo[BoneIndex].BoneOffset;
 		}
 
@@ -716,12 +1059,12 @@ namespace Hazel {
 			ReadNodeHierarchy(AnimationTime, pNode->mChildren[i], transform);
 	}
 
-	const aiNodeAnim* Mesh::FindNodeAnim(const aiAnimation* animation, const std::string& nodeName)
+	const aiNodeAnim* Mesh::FindNodeAnim(const aiAnimation* animation, std::string_view nodeName)
 	{
 		for (uint32_t i = 0; i < animation->mNumChannels; i++)
 		{
 			const aiNodeAnim* nodeAnim = animation->mChannels[i];
-			if (std::string(nodeAnim->mNodeName.data) == nodeName)
+			if (std::string_view(nodeAnim->mNodeName.data, nodeAnim->mNodeName.length) == nodeName)
 				return nodeAnim;
 		}
 		return nullptr;
@@ -729,7 +1072,7 @@ namespace Hazel {
 
 	void Mesh::BoneTransform(float time)
 	{
-		ReadNodeHierarchy(time, m_Scene->mRootNode, glm::mat4(1.0f));
+		ReadNodeHierarchy(time, GetSource().m_Scene->mRootNode, glm::mat4(1.0f));
 		m_BoneTransforms.resize(m_BoneCount);
 		for (size_t i = 0; i < m_BoneCount; i++)
 			m_BoneTransforms[i] = m_BoneInfo[i].FinalTransformation;
@@ -738,14 +1081,15 @@ namespace Hazel {
 	void Mesh::DumpVertexBuffer()
 	{
 		// TODO: Convert to ImGui
+		const Mesh& source = GetSource();
 		HZ_MESH_LOG("------------------------------------------------------");
 		HZ_MESH_LOG("Vertex Buffer Dump");
 		HZ_MESH_LOG("Mesh: {0}", m_FilePath);
 		if (m_IsAnimated)
 		{
-			for (size_t i = 0; i < m_AnimatedVertices.size(); i++)
+			for (size_t i = 0; i < source.m_AnimatedVertices.size(); i++)
 			{
-				auto& vertex = m_AnimatedVertices[i];
+				auto& vertex = source.m_AnimatedVertices[i];
 				HZ_MESH_LOG("Vertex: {0}", i);
 				HZ_MESH_LOG("Position: {0}, {1}, {2}", vertex.Position.x, vertex.Position.y, vertex.Position.z);
 				HZ_MESH_LOG("Normal: {0}, {1}, {2}", vertex.Normal.x, vertex.Normal.y, vertex.Normal.z);
@@ -757,9 +1101,9 @@ namespace Hazel {
 		}
 		else
 		{
-			for (size_t i = 0; i < m_StaticVertices.size(); i++)
+			for (size_t i = 0; i < source.m_StaticVertices.size(); i++)
 			{
-				auto& vertex = m_StaticVertices[i];
+				auto& vertex = source.m_StaticVertices[i];
 				HZ_MESH_LOG("Vertex: {0}", i);
 				HZ_MESH_LOG("Position: {0}, {1}, {2}", vertex.Position.x, vertex.Position.y, vertex.Position.z);
 				HZ_MESH_LOG("Normal: {0}, {1}, {2}", vertex.Normal.x, vertex.Normal.y, vertex.Normal.z);
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <vector>
+#include <unordered_set>
 #include <glm/glm.hpp>
 
 #include "Hazel/Core/Timestep.h"
+#include "Hazel/Core/ObjectPool.h"
+#include "Hazel/Core/HashMap.h"
 
 #include "Hazel/Renderer/Pipeline.h"
 #include "Hazel/Renderer/IndexBuffer.h"
@@ -12,6 +15,9 @@
 #include "Hazel/Renderer/Material.h"
 
 #include "Hazel/Core/Math/AABB.h"
+#include "Hazel/Core/Math/Ray.h"
+
+#include "Hazel/Renderer/MeshBVH.h"
 
 struct aiNode;
 struct aiAnimation;
@@ -104,14 +110,6 @@ namespace Hazel {
 		}
 	};
 
-	struct Triangle
-	{
-		Vertex V0, V1, V2;
-
-		Triangle(const Vertex& v0, const Vertex& v1, const Vertex& v2)
-			: V0(v0), V1(v1), V2(v2) {}
-	};
-
 	class Submesh
 	{
 	public:
@@ -123,15 +121,52 @@ namespace Hazel {
 
 		glm::mat4 Transform;
 		AABB BoundingBox;
+		// Texels per local unit of a 1x1 texture: sqrt(UV area / surface area), 0 without UVs.
+		// Used to estimate which texture mips are visible.
+		float UVDensity = 0.0f;
 
 		std::string NodeName, MeshName;
 	};
 
+	// How much of a mesh's CPU-side data is kept once its vertex and index buffers have been created
+	enum class MeshResidency
+	{
+		KeepAll = 0,   // Full vertices, indices and the imported scene
+		KeepCollision, // Positions and indices only, enough for picking and physics cooking
+		GPUOnly        // Nothing but submesh info; picking and collider cooking are unavailable
+	};
+
+	struct MeshMemoryStats
+	{
+		uint64_t VertexData = 0;
+		uint64_t PositionData = 0;
+		uint64_t IndexData = 0;
+		uint64_t BVHData = 0;
+		uint64_t ImporterData = 0;
+
+		uint64_t GPUVertexData = 0;
+		uint64_t GPUIndexData = 0;
+
+		uint64_t GetCPUTotal() const { return VertexData + PositionData + IndexData + BVHData + ImporterData; }
+		uint64_t GetGPUTotal() const { return GPUVertexData + GPUIndexData; }
+	};
+
+	struct MeshRaycastHit
+	{
+		uint32_t Submesh = 0;
+		uint32_t Triangle = 0; // Relative to the submesh's first index
+		float Distance = 0.0f; // In units of the (world space) ray direction
+	};
+
 	class Mesh : public RefCounted
 	{
+		HZ_POOLED_OBJECT(Mesh)
 	public:
-		Mesh(const std::string& filename);
-		Mesh(const std::vector<Vertex>& vertices, const std::vector<Index>& indices);
+		Mesh(const std::string& filename, MeshResidency residency = MeshResidency::KeepAll);
+		Mesh(const std::vector<Vertex>& vertices, const std::vector<Index>& indices, MeshResidency residency = MeshResidency::KeepAll);
+		// An instance of source for one entity: the geometry, GPU buffers and bone hierarchy are shared,
+		// while materials and animation state are its own, so instances can be edited and animated separately
+		Mesh(const Ref<Mesh>& source);
 		~Mesh();
 
 		void OnUpdate(Timestep ts);
@@ -140,24 +175,49 @@ namespace Hazel {
 		std::vector<Submesh>& GetSubmeshes() { return m_Submeshes; }
 		const std::vector<Submesh>& GetSubmeshes() const { return m_Submeshes; }
 
-		const std::vector<Vertex>& GetStaticVertices() const { return m_StaticVertices; }
-		const std::vector<Index>& GetIndices() const { return m_Indices; }
+		// Empty unless the residency is KeepAll
+		const std::vector<Vertex>& GetStaticVertices() const { return GetSource().m_StaticVertices; }
+		// Empty if the residency is GPUOnly
+		const std::vector<Index>& GetIndices() const { return GetSource().m_Indices; }
+		std::vector<glm::vec3> GetVertexPositions() const;
+
+		// Residency can only be lowered; released data requires reloading the mesh. On an instance
+		// this applies to the shared source, so every other instance of it loses the data too.
+		void SetResidency(MeshResidency residency);
+		MeshResidency GetResidency() const { return GetSource().m_Residency; }
+		MeshMemoryStats GetMemoryStats() const;
 
 		Ref<Shader> GetMeshShader() { return m_MeshShader; }
 		Ref<Material> GetMaterial() { return m_BaseMaterial; }
 		std::vector<Ref<MaterialInstance>> GetMaterials() { return m_Materials; }
+		const std::vector<Ref<MaterialInstance>>& GetMaterials() const { return m_Materials; }
 		const std::vector<Ref<Texture2D>>& GetTextures() const { return m_Textures; }
 		const std::string& GetFilePath() const { return m_FilePath; }
 
 		bool IsAnimated() const { return m_IsAnimated; }
+		// False if the file couldn't be imported: such a mesh has no submeshes or GPU resources and draws nothing
+		bool Loaded() const { return m_Loaded; }
 
-		const std::vector<Triangle> GetTriangleCache(uint32_t index) const { return m_TriangleCache.at(index); }
+		// Closest hit against the mesh's static geometry; transform is the mesh's world transform
+		bool Raycast(const Ray& ray, const glm::mat4& transform, MeshRaycastHit& outHit) const;
+		const MeshBVH& GetSubmeshBVH(uint32_t index) const { return GetSource().m_SubmeshBVHs[index]; }
 	private:
+		// The asset manager imports on a loader thread and creates GPU resources once back on the main thread
+		Mesh() = default;
+		bool Import(const std::string& filename);
+		void CreateGPUResources(MeshResidency residency, bool asyncTextures);
+
+		// The mesh owning the CPU-side geometry and the imported scene: the source for instances
+		const Mesh& GetSource() const { return m_Source ? *m_Source : *this; }
+
+		void BuildSubmeshBVHs();
+		MeshBVHGeometry GetSubmeshGeometry(const Submesh& submesh) const;
+
 		void BoneTransform(float time);
 		void ReadNodeHierarchy(float AnimationTime, const aiNode* pNode, const glm::mat4& ParentTransform);
 		void TraverseNodes(aiNode* node, const glm::mat4& parentTransform = glm::mat4(1.0f), uint32_t level = 0);
 
-		const aiNodeAnim* FindNodeAnim(const aiAnimation* animation, const std::string& nodeName);
+		const aiNodeAnim* FindNodeAnim(const aiAnimation* animation, std::string_view nodeName);
 		uint32_t FindPosition(float AnimationTime, const aiNodeAnim* pNodeAnim);
 		uint32_t FindRotation(float AnimationTime, const aiNodeAnim* pNodeAnim);
 		uint32_t FindScaling(float AnimationTime, const aiNodeAnim* pNodeAnim);
@@ -166,6 +226,11 @@ namespace Hazel {
 		glm::vec3 InterpolateScale(float animationTime, const aiNodeAnim* nodeAnim);
 	private:
 		std::vector<Submesh> m_Submeshes;
+
+		// Only set on instances; everything not copied from it is read through GetSource
+		Ref<Mesh> m_Source;
+		// Instances created from this mesh, so textures that finish loading later reach them as well
+		std::unordered_set<Mesh*> m_Instances;
 		
 		std::unique_ptr<Assimp::Importer> m_Importer;
 
@@ -180,10 +245,11 @@ namespace Hazel {
 
 		std::vector<Vertex> m_StaticVertices;
 		std::vector<AnimatedVertex> m_AnimatedVertices;
+		std::vector<glm::vec3> m_Positions; // Only used once static vertices have been released
 		std::vector<Index> m_Indices;
-		std::unordered_map<std::string, uint32_t> m_BoneMapping;
+		HashMap<std::string, uint32_t> m_BoneMapping;
 		std::vector<glm::mat4> m_BoneTransforms;
-		const aiScene* m_Scene;
+		const aiScene* m_Scene = nullptr;
 
 		// Materials
 		Ref<Shader> m_MeshShader;
@@ -192,7 +258,23 @@ namespace Hazel {
 		std::vector<Ref<Texture2D>> m_NormalMaps;
 		std::vector<Ref<MaterialInstance>> m_Materials;
 
-		std::unordered_map<uint32_t, std::vector<Triangle>> m_TriangleCache;
+		// Read by Import, consumed by CreateGPUResources
+		struct ImportedMaterial
+		{
+			std::string Name;
+			glm::vec3 AlbedoColor{ 1.0f };
+			float Roughness = 1.0f;
+			float Metalness = 0.0f;
+
+			// Empty if the material has no such map
+			std::string AlbedoMapPath, NormalMapPath, RoughnessMapPath, MetalnessMapPath;
+		};
+		std::vector<ImportedMaterial> m_ImportedMaterials;
+
+		std::vector<MeshBVH> m_SubmeshBVHs;
+
+		MeshResidency m_Residency = MeshResidency::KeepAll;
+		bool m_Loaded = false;
 
 		// Animation
 		bool m_IsAnimated = false;
@@ -205,5 +287,6 @@ namespace Hazel {
 
 		friend class Renderer;
 		friend class SceneHierarchyPanel;
+		friend class AssetManager;
 	};
 }
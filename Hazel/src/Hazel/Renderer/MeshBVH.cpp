@@ -0,0 +1,321 @@
+#include "hzpch.h"
+#include "MeshBVH.h"
+
+namespace Hazel {
+
+	static const uint32_t s_BinCount = 16;
+	static const uint32_t s_MaxLeafTriangles = 4;
+	static const uint32_t s_TraversalStackSize = 64;
+	// Traversal keeps at most one deferred sibling per level, plus the two children it just pushed,
+	// so a tree this deep never overflows the stack
+	static const uint32_t s_MaxDepth = s_TraversalStackSize - 1;
+
+	// SAH costs relative to a single ray-triangle test
+	static const float s_TraversalCost = 1.0f;
+	static const float s_IntersectionCost = 1.0f;
+
+	struct Bounds
+	{
+		glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 Max = glm::vec3(-std::numeric_limits<float>::max());
+
+		void Grow(const glm::vec3& point)
+		{
+			Min = glm::min(Min, point);
+			Max = glm::max(Max, point);
+		}
+
+		void Grow(const Bounds& other)
+		{
+			Min = glm::min(Min, other.Min);
+			Max = glm::max(Max, other.Max);
+		}
+
+		float SurfaceArea() const
+		{
+			glm::vec3 extent = Max - Min;
+			if (extent.x < 0.0f)
+				return 0.0f;
+			return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+		}
+	};
+
+	struct MeshBVH::BuildContext
+	{
+		std::vector<Bounds> TriangleBounds;
+		std::vector<glm::vec3> Centroids;
+	};
+
+	void MeshBVH::Build(const MeshBVHGeometry& geometry)
+	{
+		Clear();
+
+		if (geometry.TriangleCount == 0)
+			return;
+
+		BuildContext context;
+		context.TriangleBounds.resize(geometry.TriangleCount);
+		context.Centroids.resize(geometry.TriangleCount);
+		m_TriangleIndices.resize(geometry.TriangleCount);
+		for (uint32_t i = 0; i < geometry.TriangleCount; i++)
+		{
+			Bounds& bounds = context.TriangleBounds[i];
+			bounds.Grow(geometry.GetPosition(geometry.Indices[i * 3 + 0]));
+			bounds.Grow(geometry.GetPosition(geometry.Indices[i * 3 + 1]));
+			bounds.Grow(geometry.GetPosition(geometry.Indices[i * 3 + 2]));
+			context.Centroids[i] = (bounds.Min + bounds.Max) * 0.5f;
+			m_TriangleIndices[i] = i;
+		}
+
+		m_Nodes.reserve(geometry.TriangleCount * 2 - 1);
+		BuildNode(context, 0, geometry.TriangleCount, 0);
+		m_Nodes.shrink_to_fit();
+	}
+
+	void MeshBVH::Clear()
+	{
+		m_Nodes.clear();
+		m_Nodes.shrink_to_fit();
+		m_TriangleIndices.clear();
+		m_TriangleIndices.shrink_to_fit();
+	}
+
+	// Levels a tree over count triangles needs when every node is split in half
+	static uint32_t GetMedianSplitDepth(uint32_t count)
+	{
+		uint32_t depth = 0;
+		for (; count > s_MaxLeafTriangles; count = (count + 1) / 2)
+			depth++;
+		return depth;
+	}
+
+	uint32_t MeshBVH::BuildNode(BuildContext& context, uint32_t first, uint32_t count, uint32_t depth)
+	{
+		uint32_t nodeIndex = (uint32_t)m_Nodes.size();
+		m_Nodes.emplace_back();
+
+		Bounds bounds, centroidBounds;
+		for (uint32_t i = first; i < first + count; i++)
+		{
+			uint32_t triangle = m_TriangleIndices[i];
+			bounds.Grow(context.TriangleBounds[triangle]);
+			centroidBounds.Grow(context.Centroids[triangle]);
+		}
+
+		auto makeLeaf = [&]()
+		{
+			MeshBVHNode& node = m_Nodes[nodeIndex];
+			node.Min = bounds.Min;
+			node.Max = bounds.Max;
+			node.Offset = first;
+			node.TriangleCount = count;
+			return nodeIndex;
+		};
+
+		if (count <= s_MaxLeafTriangles || depth >= s_MaxDepth)
+			return makeLeaf();
+
+		// SAH splits can be arbitrarily lopsided on degenerate meshes. Once only balanced splits
+		// would still fit under the depth limit, split at the median from here on.
+		bool forceMedianSplit = depth + GetMedianSplitDepth(count) >= s_MaxDepth;
+
+		// Binned SAH: bucket triangle centroids along each axis and evaluate every bin boundary
+		int bestAxis = -1;
+		uint32_t bestSplit = 0;
+		float bestCost = s_IntersectionCost * count;
+		glm::vec3 centroidExtent = centroidBounds.Max - centroidBounds.Min;
+		float parentArea = bounds.SurfaceArea();
+
+		for (int axis = 0; axis < 3 && !forceMedianSplit; axis++)
+		{
+			if (centroidExtent[axis] <= 0.0f)
+				continue;
+
+			Bounds binBounds[s_BinCount];
+			uint32_t binCounts[s_BinCount] = {};
+			float scale = s_BinCount / centroidExtent[axis];
+			for (uint32_t i = first; i < first + count; i++)
+			{
+				uint32_t triangle = m_TriangleIndices[i];
+				uint32_t bin = glm::min(s_BinCount - 1, (uint32_t)((context.Centroids[triangle][axis] - centroidBounds.Min[axis]) * scale));
+				binBounds[bin].Grow(context.TriangleBounds[triangle]);
+				binCounts[bin]++;
+			}
+
+			// Sweep from the right to get the cost of everything right of each split plane
+			float rightAreas[s_BinCount - 1];
+			uint32_t rightCounts[s_BinCount - 1];
+			Bounds rightBounds;
+			uint32_t rightCount = 0;
+			for (uint32_t i = s_BinCount - 1; i > 0; i--)
+			{
+				rightBounds.Grow(binBounds[i]);
+				rightCount += binCounts[i];
+				rightAreas[i - 1] = rightBounds.SurfaceArea();
+				rightCounts[i - 1] = rightCount;
+			}
+
+			Bounds leftBounds;
+			uint32_t leftCount = 0;
+			for (uint32_t i = 0; i < s_BinCount - 1; i++)
+			{
+				leftBounds.Grow(binBounds[i]);
+				leftCount += binCounts[i];
+				if (leftCount == 0 || rightCounts[i] == 0)
+					continue;
+
+				float cost = s_TraversalCost + s_IntersectionCost * (leftBounds.SurfaceArea() * leftCount + rightAreas[i] * rightCounts[i]) / parentArea;
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = i + 1;
+				}
+			}
+		}
+
+		uint32_t leftCount;
+		if (bestAxis != -1)
+		{
+			float scale = s_BinCount / centroidExtent[bestAxis];
+			float minimum = centroidBounds.Min[bestAxis];
+			auto begin = m_TriangleIndices.begin() + first;
+			auto middle = std::partition(begin, begin + count, [&](uint32_t triangle)
+			{
+				uint32_t bin = glm::min(s_BinCount - 1, (uint32_t)((context.Centroids[triangle][bestAxis] - minimum) * scale));
+				return bin < bestSplit;
+			});
+			leftCount = (uint32_t)(middle - begin);
+		}
+		else
+		{
+			// SAH prefers a leaf. Accept that unless the leaf would be unreasonably large
+			// (e.g. many triangles sharing a centroid), in which case split down the middle.
+			if (!forceMedianSplit && count <= s_MaxLeafTriangles * 4)
+				return makeLeaf();
+
+			int axis = 0;
+			if (centroidExtent.y > centroidExtent[axis])
+				axis = 1;
+			if (centroidExtent.z > centroidExtent[axis])
+				axis = 2;
+
+			leftCount = count / 2;
+			auto begin = m_TriangleIndices.begin() + first;
+			std::nth_element(begin, begin + leftCount, begin + count, [&](uint32_t a, uint32_t b)
+			{
+				return context.Centroids[a][axis] < context.Centroids[b][axis];
+			});
+		}
+
+		{
+			MeshBVHNode& node = m_Nodes[nodeIndex];
+			node.Min = bounds.Min;
+			node.Max = bounds.Max;
+			node.TriangleCount = 0;
+		}
+
+		BuildNode(context, first, leftCount, depth + 1);
+		uint32_t rightChild = BuildNode(context, first + leftCount, count - leftCount, depth + 1);
+		m_Nodes[nodeIndex].Offset = rightChild;
+		return nodeIndex;
+	}
+
+	static bool IntersectNode(const MeshBVHNode& node, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance, float& outDistance)
+	{
+		glm::vec3 t0 = (node.Min - origin) * inverseDirection;
+		glm::vec3 t1 = (node.Max - origin) * inverseDirection;
+		glm::vec3 tmin = glm::min(t0, t1);
+		glm::vec3 tmax = glm::max(t0, t1);
+
+		float tnear = glm::max(glm::max(tmin.x, tmin.y), glm::max(tmin.z, 0.0f));
+		float tfar = glm::min(glm::min(tmax.x, tmax.y), glm::min(tmax.z, maxDistance));
+
+		outDistance = tnear;
+		return tnear <= tfar;
+	}
+
+	bool MeshBVH::Raycast(const Ray& ray, const MeshBVHGeometry& geometry, uint32_t& outTriangle, float& outDistance, float maxDistance) const
+	{
+		if (m_Nodes.empty())
+			return false;
+
+		glm::vec3 inverseDirection = 1.0f / ray.Direction;
+		float closest = maxDistance;
+		bool hit = false;
+
+		float t;
+		if (!IntersectNode(m_Nodes[0], ray.Origin, inverseDirection, closest, t))
+			return false;
+
+		uint32_t stack[s_TraversalStackSize];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const MeshBVHNode& node = m_Nodes[stack[--stackSize]];
+
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = node.Offset; i < node.Offset + node.TriangleCount; i++)
+				{
+					uint32_t triangle = m_TriangleIndices[i];
+					const uint32_t* indices = &geometry.Indices[triangle * 3];
+					if (ray.IntersectsTriangle(geometry.GetPosition(indices[0]), geometry.GetPosition(indices[1]), geometry.GetPosition(indices[2]), t) && t < closest)
+					{
+						closest = t;
+						outTriangle = triangle;
+						hit = true;
+					}
+				}
+				continue;
+			}
+
+			// Visit the nearer child first so its hits can cull the farther one
+			uint32_t left = (uint32_t)(&node - m_Nodes.data()) + 1;
+			uint32_t right = node.Offset;
+			float leftDistance, rightDistance;
+			bool hitLeft = IntersectNode(m_Nodes[left], ray.Origin, inverseDirection, closest, leftDistance);
+			bool hitRight = IntersectNode(m_Nodes[right], ray.Origin, inverseDirection, closest, rightDistance);
+
+			if (hitLeft && hitRight)
+			{
+				// Guaranteed by s_MaxDepth
+				HZ_CORE_ASSERT(stackSize + 2 <= s_TraversalStackSize, "MeshBVH traversal stack overflow!");
+				if (leftDistance <= rightDistance)
+				{
+					stack[stackSize++] = right;
+					stack[stackSize++] = left;
+				}
+				else
+				{
+					stack[stackSize++] = left;
+					stack[stackSize++] = right;
+				}
+			}
+			else if (hitLeft)
+			{
+				stack[stackSize++] = left;
+			}
+			else if (hitRight)
+			{
+				stack[stackSize++] = right;
+			}
+		}
+
+		if (hit)
+			outDistance = closest;
+
+		return hit;
+	}
+
+	AABB MeshBVH::GetBounds() const
+	{
+		if (m_Nodes.empty())
+			return AABB();
+
+		return AABB(m_Nodes[0].Min, m_Nodes[0].Max);
+	}
+
+}
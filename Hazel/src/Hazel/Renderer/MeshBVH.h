@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <glm/glm.hpp>
+
+#include "Hazel/Core/Math/AABB.h"
+#include "Hazel/Core/Math/Ray.h"
+
+namespace Hazel {
+
+	// Triangle soup a MeshBVH is built over. Positions are read with a stride so the
+	// BVH can sit directly on top of the mesh's vertex array without copying it.
+	struct MeshBVHGeometry
+	{
+		const void* Positions = nullptr;
+		uint32_t PositionStride = sizeof(glm::vec3);
+		const uint32_t* Indices = nullptr; // Three per triangle, relative to Positions
+		uint32_t TriangleCount = 0;
+
+		const glm::vec3& GetPosition(uint32_t index) const
+		{
+			return *(const glm::vec3*)((const uint8_t*)Positions + (size_t)index * PositionStride);
+		}
+	};
+
+	// Nodes are stored depth-first: an interior node's left child is always the next
+	// node in the array, so only the right child index needs to be stored.
+	struct MeshBVHNode
+	{
+		glm::vec3 Min;
+		uint32_t Offset; // Leaf: first entry in the triangle list, interior: right child index
+		glm::vec3 Max;
+		uint32_t TriangleCount; // 0 for interior nodes
+
+		bool IsLeaf() const { return TriangleCount > 0; }
+	};
+
+	static_assert(sizeof(MeshBVHNode) == 32, "MeshBVHNode should fit in half a cache line");
+
+	class MeshBVH
+	{
+	public:
+		void Build(const MeshBVHGeometry& geometry);
+		void Clear();
+
+		// Returns the closest front-facing triangle hit with t < maxDistance
+		bool Raycast(const Ray& ray, const MeshBVHGeometry& geometry, uint32_t& outTriangle, float& outDistance, float maxDistance = std::numeric_limits<float>::max()) const;
+
+		AABB GetBounds() const;
+		bool IsEmpty() const { return m_Nodes.empty(); }
+		uint32_t GetNodeCount() const { return (uint32_t)m_Nodes.size(); }
+		size_t GetMemoryUsage() const { return m_Nodes.capacity() * sizeof(MeshBVHNode) + m_TriangleIndices.capacity() * sizeof(uint32_t); }
+	private:
+		struct BuildContext;
+		uint32_t BuildNode(BuildContext& context, uint32_t first, uint32_t count, uint32_t depth);
+	private:
+		std::vector<MeshBVHNode> m_Nodes;
+		std::vector<uint32_t> m_TriangleIndices;
+	};
+
+}
@@ -37,6 +37,16 @@ namespace Hazel {
 	{
 		//HZ_RENDER_TRACE("RenderCommandQueue::Execute -- {0} commands, {1} bytes", m_CommandCount, (m_CommandBufferPtr - m_CommandBuffer));
 
+		Flush(true);
+	}
+
+	void RenderCommandQueue::Discard()
+	{
+		Flush(false);
+	}
+
+	void RenderCommandQueue::Flush(bool execute)
+	{
 		byte* buffer = m_CommandBuffer;
 
 		for (uint32_t i = 0; i < m_CommandCount; i++)
@@ -46,7 +56,7 @@ namespace Hazel {
 
 			uint32_t size = *(uint32_t*)buffer;
 			buffer += sizeof(uint32_t);
-			function(buffer);
+			function(buffer, execute);
 			buffer += size;
 		}
 
@@ -7,14 +7,41 @@ namespace Hazel {
 	class RenderCommandQueue
 	{
 	public:
-		typedef void(*RenderCommandFn)(void*);
+		// Runs the command if execute is set, then destroys it
+		typedef void(*RenderCommandFn)(void* command, bool execute);
 
 		RenderCommandQueue();
 		~RenderCommandQueue();
 
 		void* Allocate(RenderCommandFn func, uint32_t size);
 
+		// Records func to be run by Execute
+		template<typename FuncT>
+		void Submit(FuncT&& func)
+		{
+			auto renderCmd = [](void* ptr, bool execute) {
+				auto pFunc = (FuncT*)ptr;
+				if (execute)
+					(*pFunc)();
+
+				// NOTE: Instead of destroying we could try and enforce all items to be trivally destructible
+				// however some items like uniforms which contain std::strings still exist for now
+				// static_assert(std::is_trivially_destructible_v<FuncT>, "FuncT must be trivially destructible");
+				pFunc->~FuncT();
+			};
+			auto storageBuffer = Allocate(renderCmd, sizeof(func));
+			new (storageBuffer) FuncT(std::forward<FuncT>(func));
+		}
+
 		void Execute();
+		// Destroys the commands without running them
+		void Discard();
+
+		// What's been recorded since the last Execute
+		uint32_t GetCommandCount() const { return m_CommandCount; }
+		uint32_t GetSize() const { return (uint32_t)(m_CommandBufferPtr - m_CommandBuffer); }
+	private:
+		void Flush(bool execute);
 	private:
 		uint8_t* m_CommandBuffer;
 		uint8_t* m_CommandBufferPtr;
@@ -3,12 +3,14 @@
 #include "Hazel/Core/Base.h"
 
 #include "Framebuffer.h"
+#include "GPUTimer.h"
 
 namespace Hazel {
 
 	struct RenderPassSpecification
 	{
 		Ref<Framebuffer> TargetFramebuffer;
+		std::string DebugName = "Unnamed";
 	};
 
 	class RenderPass : public RefCounted
@@ -19,6 +21,9 @@ namespace Hazel {
 		virtual RenderPassSpecification& GetSpecification() = 0;
 		virtual const RenderPassSpecification& GetSpecification() const = 0;
 
+		// Measures the pass on the GPU, from Renderer::BeginRenderPass to EndRenderPass
+		virtual const Ref<GPUTimer>& GetGPUTimer() const = 0;
+
 		static Ref<RenderPass> Create(const RenderPassSpecification& spec);
 	};
 
@@ -8,6 +8,10 @@
 #include "RendererAPI.h"
 #include "SceneRenderer.h"
 #include "Renderer2D.h"
+#include "TextureUploader.h"
+#include "StreamingBuffer.h"
+
+#include <fstream>
 
 namespace Hazel {
 
@@ -22,6 +26,17 @@ namespace Hazel {
 		Ref<VertexBuffer> m_FullscreenQuadVertexBuffer;
 		Ref<IndexBuffer> m_FullscreenQuadIndexBuffer;
 		Ref<Pipeline> m_FullscreenQuadPipeline;
+
+		uint64_t m_FrameIndex = 0;
+		bool m_NullDevice = false;
+
+		RendererFrameStats m_FrameStats;
+		RendererFrameStats m_LastFrameStats;
+		RenderPassStats* m_ActivePassStats = nullptr;
+
+		std::ofstream m_StatsCapture;
+		std::vector<std::string> m_StatsCapturePasses; // The file's pass columns, taken from the first frame captured
+		bool m_StatsCaptureHeaderWritten = false;
 	};
 
 	static RendererData s_Data;
@@ -30,6 +45,8 @@ namespace Hazel {
 	{
 		s_Data.m_ShaderLibrary = Ref<ShaderLibrary>::Create();
 		Renderer::Submit([](){ RendererAPI::Init(); });
+		TextureUploader::Init();
+		StreamingBuffer::Init();
 
 		Renderer::GetShaderLibrary()->Load("assets/shaders/HazelPBR_Static.glsl");
 		Renderer::GetShaderLibrary()->Load("assets/shaders/HazelPBR_Anim.glsl");
@@ -74,6 +91,16 @@ namespace Hazel {
 		Renderer2D::Init();
 	}
 
+	void Renderer::SetNullDevice(bool nullDevice)
+	{
+		s_Data.m_NullDevice = nullDevice;
+	}
+
+	bool Renderer::IsNullDevice()
+	{
+		return s_Data.m_NullDevice;
+	}
+
 	Ref<ShaderLibrary> Renderer::GetShaderLibrary()
 	{
 		return s_Data.m_ShaderLibrary;
@@ -102,10 +129,28 @@ namespace Hazel {
 	{
 	}
 
-	void Renderer::DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest)
+	static void CountDraw(uint32_t count, PrimitiveType type)
+	{
+		RendererFrameStats& stats = s_Data.m_FrameStats;
+		stats.DrawCalls++;
+		if (type == PrimitiveType::Lines)
+			stats.Lines += count / 2;
+		else
+			stats.Triangles += count / 3;
+
+		if (RenderPassStats* pass = s_Data.m_ActivePassStats)
+		{
+			pass->DrawCalls++;
+			if (type == PrimitiveType::Triangles)
+				pass->Triangles += count / 3;
+		}
+	}
+
+	void Renderer::DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest, uint32_t baseVertex)
 	{
+		CountDraw(count, type);
 		Renderer::Submit([=]() {
-			RendererAPI::DrawIndexed(count, type, depthTest);
+			RendererAPI::DrawIndexed(count, type, depthTest, baseVertex);
 		});
 	}
 
@@ -118,7 +163,92 @@ namespace Hazel {
 
 	void Renderer::WaitAndRender()
 	{
-		s_Data.m_CommandQueue.Execute();
+		HZ_PROFILE_FUNCTION();
+
+		RendererFrameStats& stats = s_Data.m_FrameStats;
+		stats.Frame = s_Data.m_FrameIndex;
+		stats.Commands = s_Data.m_CommandQueue.GetCommandCount();
+		stats.CommandBytes = s_Data.m_CommandQueue.GetSize();
+
+		if (s_Data.m_NullDevice)
+			s_Data.m_CommandQueue.Discard();
+		else
+			s_Data.m_CommandQueue.Execute();
+		TextureUploader::Update();
+		StreamingBuffer::EndFrame();
+
+		// After executing, so the work the commands record themselves is counted as well
+		if (s_Data.m_StatsCapture.is_open())
+		{
+			if (!s_Data.m_StatsCaptureHeaderWritten)
+			{
+				for (uint32_t i = 0; i < stats.PassCount; i++)
+					s_Data.m_StatsCapturePasses.push_back(stats.Passes[i].Name);
+				RendererFrameStats::WriteCSVHeader(s_Data.m_StatsCapture, s_Data.m_StatsCapturePasses);
+				s_Data.m_StatsCaptureHeaderWritten = true;
+			}
+			stats.WriteCSVRow(s_Data.m_StatsCapture, s_Data.m_StatsCapturePasses);
+		}
+
+		s_Data.m_LastFrameStats = stats;
+		stats = {};
+		s_Data.m_ActivePassStats = nullptr;
+
+		s_Data.m_FrameIndex++;
+	}
+
+	uint64_t Renderer::GetFrameIndex()
+	{
+		return s_Data.m_FrameIndex;
+	}
+
+	const RendererFrameStats& Renderer::GetFrameStats()
+	{
+		return s_Data.m_LastFrameStats;
+	}
+
+	RendererFrameStats& Renderer::GetCurrentFrameStats()
+	{
+		return s_Data.m_FrameStats;
+	}
+
+	void Renderer::CountCulled(uint32_t count)
+	{
+		if (RenderPassStats* pass = s_Data.m_ActivePassStats)
+		{
+			pass->Submitted += count;
+			pass->Culled += count;
+		}
+	}
+
+	bool Renderer::StartStatsCapture(const std::string& filepath)
+	{
+		StopStatsCapture();
+
+		s_Data.m_StatsCapture.open(filepath);
+		if (!s_Data.m_StatsCapture)
+		{
+			HZ_CORE_ERROR("Could not open '{0}' to capture renderer stats", filepath);
+			return false;
+		}
+
+		HZ_CORE_INFO("Capturing renderer stats to '{0}'", filepath);
+		return true;
+	}
+
+	void Renderer::StopStatsCapture()
+	{
+		if (!s_Data.m_StatsCapture.is_open())
+			return;
+
+		s_Data.m_StatsCapture.close();
+		s_Data.m_StatsCapturePasses.clear();
+		s_Data.m_StatsCaptureHeaderWritten = false;
+	}
+
+	bool Renderer::IsCapturingStats()
+	{
+		return s_Data.m_StatsCapture.is_open();
 	}
 
 	void Renderer::BeginRenderPass(Ref<RenderPass> renderPass, bool clear)
@@ -127,7 +257,17 @@ namespace Hazel {
 
 		// TODO: Convert all of this into a render command buffer
 		s_Data.m_ActiveRenderPass = renderPass;
-		
+
+		RendererFrameStats& stats = s_Data.m_FrameStats;
+		const std::string& name = renderPass->GetSpecification().DebugName;
+		s_Data.m_ActivePassStats = stats.FindPass(name);
+		if (!s_Data.m_ActivePassStats && stats.PassCount < RendererFrameStats::MaxPasses)
+		{
+			s_Data.m_ActivePassStats = &stats.Passes[stats.PassCount++];
+			s_Data.m_ActivePassStats->Name = name;
+		}
+
+		renderPass->GetGPUTimer()->Begin();
 		renderPass->GetSpecification().TargetFramebuffer->Bind();
 		if (clear)
 		{
@@ -142,7 +282,9 @@ namespace Hazel {
 	{
 		HZ_CORE_ASSERT(s_Data.m_ActiveRenderPass, "No active render pass! Have you called Renderer::EndRenderPass twice?");
 		s_Data.m_ActiveRenderPass->GetSpecification().TargetFramebuffer->Unbind();
+		s_Data.m_ActiveRenderPass->GetGPUTimer()->End();
 		s_Data.m_ActiveRenderPass = nullptr;
+		s_Data.m_ActivePassStats = nullptr;
 	}
 
 	void Renderer::SubmitQuad(Ref<MaterialInstance> material, const glm::mat4& transform)
@@ -193,7 +335,14 @@ namespace Hazel {
 		Renderer::DrawIndexed(6, PrimitiveType::Triangles, depthTest);
 	}
 
-	void Renderer::SubmitMesh(Ref<Mesh> mesh, const glm::mat4& transform, Ref<MaterialInstance> overrideMaterial)
+	static void CountMesh()
+	{
+		s_Data.m_FrameStats.Instances++;
+		if (RenderPassStats* pass = s_Data.m_ActivePassStats)
+			pass->Submitted++;
+	}
+
+	void Renderer::SubmitMesh(RefView<Mesh> mesh, const glm::mat4& transform, RefView<MaterialInstance> overrideMaterial)
 	{
 		// auto material = overrideMaterial ? overrideMaterial : mesh->GetMaterialInstance();
 		// auto shader = material->GetShader();
@@ -201,66 +350,62 @@ namespace Hazel {
 		mesh->m_VertexBuffer->Bind();
 		mesh->m_Pipeline->Bind();
 		mesh->m_IndexBuffer->Bind();
+		CountMesh();
 
 		auto& materials = mesh->GetMaterials();
 		for (Submesh& submesh : mesh->m_Submeshes)
 		{
 			// Material
-			auto material = overrideMaterial ? overrideMaterial : materials[submesh.MaterialIndex];
+			RefView<MaterialInstance> material = overrideMaterial ? overrideMaterial : RefView<MaterialInstance>(materials[submesh.MaterialIndex]);
 			auto shader = material->GetShader();
 			material->Bind();
 
 			if (mesh->m_IsAnimated)
-			{
-				for (size_t i = 0; i < mesh->m_BoneTransforms.size(); i++)
-				{
-					std::string uniformName = std::string("u_BoneTransforms[") + std::to_string(i) + std::string("]");
-					shader->SetMat4(uniformName, mesh->m_BoneTransforms[i]);
-				}
-			}
+				shader->SetMat4Array("u_BoneTransforms", mesh->m_BoneTransforms.data(), (uint32_t)mesh->m_BoneTransforms.size());
 			shader->SetMat4("u_Transform", transform * submesh.Transform);
 
-			Renderer::Submit([submesh, material]() {
-				if (material->GetFlag(MaterialFlag::DepthTest))	
+			// Only what the draw needs; a copy of the submesh would copy its names
+			uint32_t indexCount = submesh.IndexCount, baseIndex = submesh.BaseIndex, baseVertex = submesh.BaseVertex;
+			uint32_t flags = material->GetFlags();
+			CountDraw(indexCount, PrimitiveType::Triangles);
+			Renderer::Submit([indexCount, baseIndex, baseVertex, flags]() {
+				if (flags & (uint32_t)MaterialFlag::DepthTest)
 					glEnable(GL_DEPTH_TEST);
 				else
 					glDisable(GL_DEPTH_TEST);
 
-				if (!material->GetFlag(MaterialFlag::TwoSided))
+				if (!(flags & (uint32_t)MaterialFlag::TwoSided))
 					Renderer::Submit([]() { glEnable(GL_CULL_FACE); });
 				else
 					Renderer::Submit([]() { glDisable(GL_CULL_FACE); });
 
-				glDrawElementsBaseVertex(GL_TRIANGLES, submesh.IndexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * submesh.BaseIndex), submesh.BaseVertex);
+				glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * baseIndex), baseVertex);
 			});
 		}
 	}
 
-	void Renderer::SubmitMeshWithShader(Ref<Mesh> mesh, const glm::mat4& transform, Ref<Shader> shader)
+	void Renderer::SubmitMeshWithShader(RefView<Mesh> mesh, const glm::mat4& transform, RefView<Shader> shader)
 	{
 		mesh->m_VertexBuffer->Bind();
 		mesh->m_Pipeline->Bind();
 		mesh->m_IndexBuffer->Bind();
+		CountMesh();
 
 		for (Submesh& submesh : mesh->m_Submeshes)
 		{
 			if (mesh->m_IsAnimated)
-			{
-				for (size_t i = 0; i < mesh->m_BoneTransforms.size(); i++)
-				{
-					std::string uniformName = std::string("u_BoneTransforms[") + std::to_string(i) + std::string("]");
-					shader->SetMat4(uniformName, mesh->m_BoneTransforms[i]);
-				}
-			}
+				shader->SetMat4Array("u_BoneTransforms", mesh->m_BoneTransforms.data(), (uint32_t)mesh->m_BoneTransforms.size());
 			shader->SetMat4("u_Transform", transform * submesh.Transform);
 
-			Renderer::Submit([submesh]() {
-				glDrawElementsBaseVertex(GL_TRIANGLES, submesh.IndexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * submesh.BaseIndex), submesh.BaseVertex);
+			uint32_t indexCount = submesh.IndexCount, baseIndex = submesh.BaseIndex, baseVertex = submesh.BaseVertex;
+			CountDraw(indexCount, PrimitiveType::Triangles);
+			Renderer::Submit([indexCount, baseIndex, baseVertex]() {
+				glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * baseIndex), baseVertex);
 			});
 		}
 	}
 
-	void Renderer::DrawAABB(Ref<Mesh> mesh, const glm::mat4& transform, const glm::vec4& color)
+	void Renderer::DrawAABB(RefView<Mesh> mesh, const glm::mat4& transform, const glm::vec4& color)
 	{
 		for (Submesh& submesh : mesh->m_Submeshes)
 		{
@@ -2,6 +2,7 @@
 
 #include "RenderCommandQueue.h"
 #include "RenderPass.h"
+#include "RendererStats.h"
 
 #include "Mesh.h"
 
@@ -13,14 +14,14 @@ namespace Hazel {
 	class Renderer
 	{
 	public:
-		typedef void(*RenderCommandFn)(void*);
+		typedef void(*RenderCommandFn)(void*, bool);
 
 		// Commands
 		static void Clear();
 		static void Clear(float r, float g, float b, float a = 1.0f);
 		static void SetClearColor(float r, float g, float b, float a);
 
-		static void DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest = true);
+		static void DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest = true, uint32_t baseVertex = 0);
 		
 		// For OpenGL
 		static void SetLineThickness(float thickness);
@@ -29,22 +30,18 @@ namespace Hazel {
 
 		static void Init();
 
+		// Drops recorded commands instead of executing them, so the renderer runs without a GPU
+		// context (benchmarks, tools). Everything up to the command queue still runs: resources
+		// are created and materials bound, only nothing reaches the driver. Set before Init.
+		static void SetNullDevice(bool nullDevice);
+		static bool IsNullDevice();
+
 		static Ref<ShaderLibrary> GetShaderLibrary();
 
 		template<typename FuncT>
 		static void Submit(FuncT&& func)
 		{
-			auto renderCmd = [](void* ptr) {
-				auto pFunc = (FuncT*)ptr;
-				(*pFunc)();
-
-				// NOTE: Instead of destroying we could try and enforce all items to be trivally destructible
-				// however some items like uniforms which contain std::strings still exist for now
-				// static_assert(std::is_trivially_destructible_v<FuncT>, "FuncT must be trivially destructible");
-				pFunc->~FuncT();
-			};
-			auto storageBuffer = GetRenderCommandQueue().Allocate(renderCmd, sizeof(func));
-			new (storageBuffer) FuncT(std::forward<FuncT>(func));
+			GetRenderCommandQueue().Submit(std::forward<FuncT>(func));
 		}
 
 		/*static void* Submit(RenderCommandFn fn, unsigned int size)
@@ -54,17 +51,33 @@ namespace Hazel {
 
 		static void WaitAndRender();
 
+		// Frames rendered so far; render thread
+		static uint64_t GetFrameIndex();
+
+		// The last frame WaitAndRender finished
+		static const RendererFrameStats& GetFrameStats();
+		// The frame being recorded, for whatever records it to count into
+		static RendererFrameStats& GetCurrentFrameStats();
+		// Meshes a pass was given but didn't draw; counts towards the active pass
+		static void CountCulled(uint32_t count);
+
+		// Writes the stats of every frame from now on to a CSV file, one row per frame
+		static bool StartStatsCapture(const std::string& filepath);
+		static void StopStatsCapture();
+		static bool IsCapturingStats();
+
 		// ~Actual~ Renderer here... TODO: remove confusion later
 		static void BeginRenderPass(Ref<RenderPass> renderPass, bool clear = true);
 		static void EndRenderPass();
 
 		static void SubmitQuad(Ref<MaterialInstance> material, const glm::mat4& transform = glm::mat4(1.0f));
 		static void SubmitFullscreenQuad(Ref<MaterialInstance> material);
-		static void SubmitMesh(Ref<Mesh> mesh, const glm::mat4& transform, Ref<MaterialInstance> overrideMaterial = nullptr);
-		static void SubmitMeshWithShader(Ref<Mesh> mesh, const glm::mat4& transform, Ref<Shader> shader);
+		// Views, as the draw lists passing them in keep the meshes and materials alive
+		static void SubmitMesh(RefView<Mesh> mesh, const glm::mat4& transform, RefView<MaterialInstance> overrideMaterial = nullptr);
+		static void SubmitMeshWithShader(RefView<Mesh> mesh, const glm::mat4& transform, RefView<Shader> shader);
 
 		static void DrawAABB(const AABB& aabb, const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f));
-		static void DrawAABB(Ref<Mesh> mesh, const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f));
+		static void DrawAABB(RefView<Mesh> mesh, const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f));
 	private:
 		static RenderCommandQueue& GetRenderCommandQueue();
 	};
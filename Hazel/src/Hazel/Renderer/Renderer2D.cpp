@@ -4,6 +4,7 @@
 #include "Hazel/Renderer/Pipeline.h"
 #include "Hazel/Renderer/Shader.h"
 #include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/StreamingBuffer.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -42,6 +43,9 @@ namespace Hazel {
 		Ref<Shader> TextureShader;
 		Ref<Texture2D> WhiteTexture;
 
+		// Batches are built in the storage arrays and copied into the streaming buffer when they're
+		// flushed, taking only what they used; when it has no room left this frame, they're
+		// uploaded to the vertex buffers instead
 		uint32_t QuadIndexCount = 0;
 		QuadVertex* QuadVertexBufferBase = nullptr;
 		QuadVertex* QuadVertexBufferPtr = nullptr;
@@ -149,56 +153,101 @@ namespace Hazel {
 	{
 	}
 
-	void Renderer2D::BeginScene(const glm::mat4& viewProj, bool depthTest)
+	static void StartQuadBatch()
 	{
-		s_Data.CameraViewProj = viewProj;
-		s_Data.DepthTest = depthTest;
-
-		s_Data.TextureShader->Bind();
-		s_Data.TextureShader->SetMat4("u_ViewProjection", viewProj);
-
-		s_Data.QuadIndexCount = 0;
 		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
-
-		s_Data.LineIndexCount = 0;
-		s_Data.LineVertexBufferPtr = s_Data.LineVertexBufferBase;
+		s_Data.QuadIndexCount = 0;
 
 		s_Data.TextureSlotIndex = 1;
 	}
 
-	void Renderer2D::EndScene()
+	static void StartLineBatch()
 	{
-		uint32_t dataSize = (uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase;
-		if (dataSize)
+		s_Data.LineVertexBufferPtr = s_Data.LineVertexBufferBase;
+		s_Data.LineIndexCount = 0;
+	}
+
+	static void FlushQuads()
+	{
+		uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase);
+		if (!dataSize)
+			return;
+
+		// Aligned to the vertex size, so the batch can be drawn with a base vertex
+		uint32_t baseVertex = 0;
+		StreamingAllocation streaming = StreamingBuffer::Allocate(dataSize, sizeof(QuadVertex));
+		if (streaming)
 		{
-			s_Data.QuadVertexBuffer->SetData(s_Data.QuadVertexBufferBase, dataSize);
+			memcpy(streaming.Data, s_Data.QuadVertexBufferBase, dataSize);
+			StreamingBuffer::BindAsVertexBuffer();
+			baseVertex = (uint32_t)(streaming.Offset / sizeof(QuadVertex));
+			Renderer::GetCurrentFrameStats().BufferBytesUploaded += dataSize;
+		}
+		else
+		{
+			s_Data.QuadVertexBuffer->SetData(BufferView(s_Data.QuadVertexBufferBase, dataSize));
+			s_Data.QuadVertexBuffer->Bind();
+		}
 
-			s_Data.TextureShader->Bind();
-			s_Data.TextureShader->SetMat4("u_ViewProjection", s_Data.CameraViewProj);
+		s_Data.TextureShader->Bind();
+		s_Data.TextureShader->SetMat4("u_ViewProjection", s_Data.CameraViewProj);
 
-			for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
-				s_Data.TextureSlots[i]->Bind(i);
+		for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
+			s_Data.TextureSlots[i]->Bind(i);
 
-			s_Data.QuadPipeline->Bind();
-			s_Data.QuadIndexBuffer->Bind();
-			Renderer::DrawIndexed(s_Data.QuadIndexCount, PrimitiveType::Triangles, s_Data.DepthTest);
-			s_Data.Stats.DrawCalls++;
-		}
+		s_Data.QuadPipeline->Bind();
+		s_Data.QuadIndexBuffer->Bind();
+		Renderer::DrawIndexed(s_Data.QuadIndexCount, PrimitiveType::Triangles, s_Data.DepthTest, baseVertex);
+		s_Data.Stats.DrawCalls++;
+	}
 
-		dataSize = (uint8_t*)s_Data.LineVertexBufferPtr - (uint8_t*)s_Data.LineVertexBufferBase;
-		if (dataSize)
+	static void FlushLines()
+	{
+		uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.LineVertexBufferPtr - (uint8_t*)s_Data.LineVertexBufferBase);
+		if (!dataSize)
+			return;
+
+		uint32_t baseVertex = 0;
+		StreamingAllocation streaming = StreamingBuffer::Allocate(dataSize, sizeof(LineVertex));
+		if (streaming)
+		{
+			memcpy(streaming.Data, s_Data.LineVertexBufferBase, dataSize);
+			StreamingBuffer::BindAsVertexBuffer();
+			baseVertex = (uint32_t)(streaming.Offset / sizeof(LineVertex));
+			Renderer::GetCurrentFrameStats().BufferBytesUploaded += dataSize;
+		}
+		else
 		{
-			s_Data.LineVertexBuffer->SetData(s_Data.LineVertexBufferBase, dataSize);
+			s_Data.LineVertexBuffer->SetData(BufferView(s_Data.LineVertexBufferBase, dataSize));
+			s_Data.LineVertexBuffer->Bind();
+		}
 
-			s_Data.LineShader->Bind();
-			s_Data.LineShader->SetMat4("u_ViewProjection", s_Data.CameraViewProj);
+		s_Data.LineShader->Bind();
+		s_Data.LineShader->SetMat4("u_ViewProjection", s_Data.CameraViewProj);
 
-			s_Data.LinePipeline->Bind();
-			s_Data.LineIndexBuffer->Bind();
-			Renderer::SetLineThickness(2.0f);
-			Renderer::DrawIndexed(s_Data.LineIndexCount, PrimitiveType::Lines, false);
-			s_Data.Stats.DrawCalls++;
-		}
+		s_Data.LinePipeline->Bind();
+		s_Data.LineIndexBuffer->Bind();
+		Renderer::SetLineThickness(2.0f);
+		Renderer::DrawIndexed(s_Data.LineIndexCount, PrimitiveType::Lines, false, baseVertex);
+		s_Data.Stats.DrawCalls++;
+	}
+
+	void Renderer2D::BeginScene(const glm::mat4& viewProj, bool depthTest)
+	{
+		s_Data.CameraViewProj = viewProj;
+		s_Data.DepthTest = depthTest;
+
+		s_Data.TextureShader->Bind();
+		s_Data.TextureShader->SetMat4("u_ViewProjection", viewProj);
+
+		StartQuadBatch();
+		StartLineBatch();
+	}
+
+	void Renderer2D::EndScene()
+	{
+		FlushQuads();
+		FlushLines();
 
 #if OLD
 		Flush();
@@ -220,17 +269,14 @@ namespace Hazel {
 
 	void Renderer2D::FlushAndReset()
 	{
-		EndScene();
-
-		s_Data.QuadIndexCount = 0;
-		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
-
-		s_Data.TextureSlotIndex = 1;
+		FlushQuads();
+		StartQuadBatch();
 	}
 
 	void Renderer2D::FlushAndResetLines()
 	{
-
+		FlushLines();
+		StartLineBatch();
 	}
 
 	void Renderer2D::DrawQuad(const glm::mat4& transform, const glm::vec4& color)
@@ -38,7 +38,7 @@ namespace Hazel {
 		static void Clear(float r, float g, float b, float a);
 		static void SetClearColor(float r, float g, float b, float a);
 
-		static void DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest = true);
+		static void DrawIndexed(uint32_t count, PrimitiveType type, bool depthTest = true, uint32_t baseVertex = 0);
 		static void SetLineThickness(float thickness);
 
 		static RenderAPICapabilities& GetCapabilities()
@@ -0,0 +1,45 @@
+#include "hzpch.h"
+#include "RendererStats.h"
+
+namespace Hazel {
+
+	RenderPassStats* RendererFrameStats::FindPass(const std::string& name)
+	{
+		for (uint32_t i = 0; i < PassCount; i++)
+		{
+			if (Passes[i].Name == name)
+				return &Passes[i];
+		}
+		return nullptr;
+	}
+
+	const RenderPassStats* RendererFrameStats::FindPass(const std::string& name) const
+	{
+		return const_cast<RendererFrameStats*>(this)->FindPass(name);
+	}
+
+	void RendererFrameStats::WriteCSVHeader(std::ostream& out, const std::vector<std::string>& passNames)
+	{
+		out << "Frame,DrawCalls,Triangles,Lines,Instances,PipelineBinds,MaterialBinds,TextureBinds,UniformUploads,UniformBytes,Commands,CommandBytes,BufferBytesUploaded";
+		for (const std::string& name : passNames)
+			out << ',' << name << " DrawCalls," << name << " Triangles," << name << " Submitted," << name << " Culled";
+		out << '\n';
+	}
+
+	void RendererFrameStats::WriteCSVRow(std::ostream& out, const std::vector<std::string>& passNames) const
+	{
+		out << Frame << ',' << DrawCalls << ',' << Triangles << ',' << Lines << ',' << Instances << ','
+			<< PipelineBinds << ',' << MaterialBinds << ',' << TextureBinds << ',' << UniformUploads << ',' << UniformBytes << ','
+			<< Commands << ',' << CommandBytes << ',' << BufferBytesUploaded;
+
+		for (const std::string& name : passNames)
+		{
+			RenderPassStats pass;
+			if (const RenderPassStats* found = FindPass(name))
+				pass = *found;
+			out << ',' << pass.DrawCalls << ',' << pass.Triangles << ',' << pass.Submitted << ',' << pass.Culled;
+		}
+		out << '\n';
+	}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Hazel {
+
+	struct RenderPassStats
+	{
+		std::string Name; // RenderPassSpecification::DebugName; passes sharing a name are counted together
+		uint32_t DrawCalls = 0;
+		uint64_t Triangles = 0;
+		uint32_t Submitted = 0; // Meshes the pass was given, drawn or culled
+		uint32_t Culled = 0;
+	};
+
+	// What the renderer was asked to do in a frame, counted as the commands are recorded
+	struct RendererFrameStats
+	{
+		static const uint32_t MaxPasses = 16;
+
+		uint64_t Frame = 0;
+
+		uint32_t DrawCalls = 0;
+		uint64_t Triangles = 0;
+		uint64_t Lines = 0;
+		uint32_t Instances = 0; // Meshes submitted
+
+		uint32_t PipelineBinds = 0;
+		uint32_t MaterialBinds = 0;
+		uint32_t TextureBinds = 0;
+		uint32_t UniformUploads = 0;
+		uint64_t UniformBytes = 0;
+
+		uint32_t Commands = 0;
+		uint64_t CommandBytes = 0;
+		uint64_t BufferBytesUploaded = 0;
+
+		// In the order they first began in the frame; passes beyond MaxPasses go uncounted
+		RenderPassStats Passes[MaxPasses];
+		uint32_t PassCount = 0;
+
+		RenderPassStats* FindPass(const std::string& name);
+		const RenderPassStats* FindPass(const std::string& name) const;
+
+		// One row per frame. The pass columns are those of passNames, so every row of a file has
+		// the same columns; passes that didn't run in a frame are written as zeros.
+		static void WriteCSVHeader(std::ostream& out, const std::vector<std::string>& passNames);
+		void WriteCSVRow(std::ostream& out, const std::vector<std::string>& passNames) const;
+	};
+
+}
@@ -2,12 +2,58 @@
 #include "SceneEnvironment.h"
 
 #include "SceneRenderer.h"
+#include "EnvironmentCache.h"
+
+#include "Hazel/FileSystem/FileSystem.h"
 
 namespace Hazel {
 
 	Environment Environment::Load(const std::string& filepath)
 	{
-		auto [radiance, irradiance] = SceneRenderer::CreateEnvironmentMap(filepath);
-		return { filepath, radiance, irradiance };
+		EnvironmentData data;
+		if (!Decode(filepath, data))
+			return {};
+
+		return Create(data);
+	}
+
+	bool Environment::Decode(const std::string& filepath, EnvironmentData& outData)
+	{
+		outData.FilePath = filepath;
+
+		FileData file = FileSystem::ReadFile(filepath);
+		if (!file)
+		{
+			HZ_CORE_ERROR("Could not read environment {0}", filepath);
+			return false;
+		}
+
+		outData.CacheKey = EnvironmentCache::GetKey(file.GetData(), file.GetSize());
+		if (EnvironmentCache::Read(outData.CacheKey, outData))
+		{
+			HZ_CORE_INFO("Loading cached environment for {0}", filepath);
+			return true;
+		}
+
+		if (!Texture2D::Decode(filepath, file, false, outData.Source))
+			return false;
+
+		const TextureData& source = outData.Source;
+		outData.IrradianceSH = SphericalHarmonicsL2::ProjectIrradiance((const uint16_t*)source.Data.Data, source.Width, source.Height);
+		return true;
+	}
+
+	Environment Environment::Create(EnvironmentData& data)
+	{
+		if (data.RadianceData)
+		{
+			auto radiance = TextureCube::Create(TextureFormat::Float16, SceneRenderer::RadianceMapSize, SceneRenderer::RadianceMapSize, data.RadianceData);
+			data.RadianceData = Buffer();
+			return { data.FilePath, radiance, data.IrradianceSH };
+		}
+
+		auto radiance = SceneRenderer::CreateEnvironmentMap(Texture2D::Create(data.Source));
+		EnvironmentCache::Store(data.CacheKey, radiance, data.IrradianceSH);
+		return { data.FilePath, radiance, data.IrradianceSH };
 	}
-}
\ No newline at end of file
+}
@@ -1,16 +1,40 @@
 #pragma once
 
 #include "Texture.h"
+#include "SphericalHarmonics.h"
 
 namespace Hazel {
 
+	// CPU side of an environment, produced by Environment::Decode on any thread
+	struct EnvironmentData
+	{
+		std::string FilePath;
+		uint64_t CacheKey = 0;
+
+		// Radiance cube map read from the environment cache, in the layout TextureCube::Create takes...
+		Buffer RadianceData;
+		// ...or, when it isn't cached yet, the equirectangular HDR image to generate it from
+		TextureData Source;
+		// Cached, or projected from the source image
+		SphericalHarmonicsL2 IrradianceSH;
+
+		uint64_t GetSize() const { return RadianceData.Size + Source.Data.Size; }
+	};
+
 	struct Environment
 	{
 		std::string FilePath;
 		Ref<TextureCube> RadianceMap;
-		Ref<TextureCube> IrradianceMap;
+		SphericalHarmonicsL2 IrradianceSH;
 
 		static Environment Load(const std::string& filepath);
+
+		// Any thread. Prefers the maps cached for the source image over decoding it; otherwise
+		// decodes it and projects its irradiance.
+		static bool Decode(const std::string& filepath, EnvironmentData& outData);
+		// Main thread; takes ownership of the data. Radiance maps generated from the source image are
+		// written to the cache so the next load can skip generating them.
+		static Environment Create(EnvironmentData& data);
 	};
 
 
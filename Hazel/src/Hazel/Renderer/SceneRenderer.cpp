@@ -3,6 +3,7 @@
 
 #include "Renderer.h"
 #include "SceneEnvironment.h"
+#include "TextureStreamer.h"
 
 #include <glad/glad.h>
 
@@ -12,7 +13,9 @@
 
 #include "Hazel/ImGui/ImGui.h"
 
+#include "Hazel/Core/FrameAllocator.h"
 #include "Hazel/Core/Timer.h"
+#include "Hazel/Core/Profiler.h"
 
 #include <limits>
 
@@ -67,16 +70,24 @@ namespace Hazel {
 
 		RendererID ShadowMapSampler;
 
+		// Views rather than Refs: the scene owns everything for as long as it is being drawn,
+		// so recording and sorting the lists doesn't touch reference counts
 		struct DrawCommand
 		{
-			Ref<Mesh> Mesh;
-			Ref<MaterialInstance> Material;
+			RefView<Mesh> Mesh;
+			RefView<MaterialInstance> Material;
 			glm::mat4 Transform;
 		};
-		std::vector<DrawCommand> DrawList;
-		std::vector<DrawCommand> SelectedMeshDrawList;
-		std::vector<DrawCommand> ColliderDrawList;
-		std::vector<DrawCommand> ShadowPassDrawList;
+		// Frame allocated, so their storage is dropped after every flush rather than kept
+		// around. Each scene reserves what the last one needed.
+		FrameVector<DrawCommand> DrawList;
+		FrameVector<DrawCommand> SelectedMeshDrawList;
+		FrameVector<DrawCommand> ColliderDrawList;
+		FrameVector<DrawCommand> ShadowPassDrawList;
+		struct DrawListSizes
+		{
+			size_t Draw = 0, SelectedMesh = 0, Collider = 0, ShadowPass = 0;
+		} LastDrawListSizes;
 
 		// Grid
 		Ref<MaterialInstance> GridMaterial;
@@ -86,6 +97,8 @@ namespace Hazel {
 		SceneRendererOptions Options;
 	};
 
+	// How long the render thread took to issue each pass's commands; the time the GPU took is
+	// measured by the render passes' GPU timers
 	struct SceneRendererStats
 	{
 		float ShadowPass = 0.0f;
@@ -109,6 +122,7 @@ namespace Hazel {
 
 		RenderPassSpecification geoRenderPassSpec;
 		geoRenderPassSpec.TargetFramebuffer = Framebuffer::Create(geoFramebufferSpec);
+		geoRenderPassSpec.DebugName = "Geometry";
 		s_Data.GeoPass = RenderPass::Create(geoRenderPassSpec);
 
 		FramebufferSpecification compFramebufferSpec;
@@ -117,6 +131,7 @@ namespace Hazel {
 
 		RenderPassSpecification compRenderPassSpec;
 		compRenderPassSpec.TargetFramebuffer = Framebuffer::Create(compFramebufferSpec);
+		compRenderPassSpec.DebugName = "Composite";
 		s_Data.CompositePass = RenderPass::Create(compRenderPassSpec);
 
 		FramebufferSpecification bloomBlurFramebufferSpec;
@@ -125,6 +140,7 @@ namespace Hazel {
 
 		RenderPassSpecification bloomBlurRenderPassSpec;
 		bloomBlurRenderPassSpec.TargetFramebuffer = Framebuffer::Create(bloomBlurFramebufferSpec);
+		bloomBlurRenderPassSpec.DebugName = "BloomBlur";
 		s_Data.BloomBlurPass[0] = RenderPass::Create(bloomBlurRenderPassSpec);
 		bloomBlurRenderPassSpec.TargetFramebuffer = Framebuffer::Create(bloomBlurFramebufferSpec);
 		s_Data.BloomBlurPass[1] = RenderPass::Create(bloomBlurRenderPassSpec);
@@ -135,6 +151,7 @@ namespace Hazel {
 
 		RenderPassSpecification bloomBlendRenderPassSpec;
 		bloomBlendRenderPassSpec.TargetFramebuffer = Framebuffer::Create(bloomBlendFramebufferSpec);
+		bloomBlendRenderPassSpec.DebugName = "BloomBlend";
 		s_Data.BloomBlendPass = RenderPass::Create(bloomBlendRenderPassSpec);
 
 		s_Data.CompositeShader = Shader::Create("assets/shaders/SceneComposite.glsl");
@@ -179,6 +196,7 @@ namespace Hazel {
 		{
 			RenderPassSpecification shadowMapRenderPassSpec;
 			shadowMapRenderPassSpec.TargetFramebuffer = Framebuffer::Create(shadowMapFramebufferSpec);
+			shadowMapRenderPassSpec.DebugName = "Shadow";
 			s_Data.ShadowMapRenderPass[i] = RenderPass::Create(shadowMapRenderPassSpec);
 		}
 
@@ -203,6 +221,8 @@ namespace Hazel {
 
 	void SceneRenderer::BeginScene(const Scene* scene, const SceneRendererCamera& camera)
 	{
+		HZ_PROFILE_FUNCTION();
+
 		HZ_CORE_ASSERT(!s_Data.ActiveScene, "");
 
 		s_Data.ActiveScene = scene;
@@ -213,10 +233,18 @@ namespace Hazel {
 		s_Data.SceneData.SceneEnvironmentIntensity = scene->m_EnvironmentIntensity;
 		s_Data.SceneData.ActiveLight = scene->m_Light;
 		s_Data.SceneData.SceneLightEnvironment = scene->m_LightEnvironment;
+
+		const auto& sizes = s_Data.LastDrawListSizes;
+		s_Data.DrawList.reserve(sizes.Draw);
+		s_Data.SelectedMeshDrawList.reserve(sizes.SelectedMesh);
+		s_Data.ColliderDrawList.reserve(sizes.Collider);
+		s_Data.ShadowPassDrawList.reserve(sizes.ShadowPass);
 	}
 
 	void SceneRenderer::EndScene()
 	{
+		HZ_PROFILE_FUNCTION();
+
 		HZ_CORE_ASSERT(s_Data.ActiveScene, "");
 
 		s_Data.ActiveScene = nullptr;
@@ -224,15 +252,22 @@ namespace Hazel {
 		FlushDrawList();
 	}
 
-	void SceneRenderer::SubmitMesh(Ref<Mesh> mesh, const glm::mat4& transform, Ref<MaterialInstance> overrideMaterial)
+	void SceneRenderer::SubmitMesh(RefView<Mesh> mesh, const glm::mat4& transform, RefView<MaterialInstance> overrideMaterial)
 	{
-		// TODO: Culling, sorting, etc.
+		// A mesh whose import failed has nothing to draw
+		if (!mesh->Loaded())
+			return;
+
+		// TODO: Culling, sorting, etc. (report culled meshes with Renderer::CountCulled)
 		s_Data.DrawList.push_back({ mesh, overrideMaterial, transform });
 		s_Data.ShadowPassDrawList.push_back({ mesh, overrideMaterial, transform });
 	}
 
-	void SceneRenderer::SubmitSelectedMesh(Ref<Mesh> mesh, const glm::mat4& transform)
+	void SceneRenderer::SubmitSelectedMesh(RefView<Mesh> mesh, const glm::mat4& transform)
 	{
+		if (!mesh->Loaded())
+			return;
+
 		s_Data.SelectedMeshDrawList.push_back({ mesh, nullptr, transform });
 		s_Data.ShadowPassDrawList.push_back({ mesh, nullptr, transform });
 	}
@@ -258,17 +293,20 @@ namespace Hazel {
 			s_Data.ColliderDrawList.push_back({ debugMesh, nullptr, parentTransform });
 	}
 
-	static Ref<Shader> equirectangularConversionShader, envFilteringShader, envIrradianceShader;
+	static Ref<Shader> equirectangularConversionShader, envFilteringShader;
+
+	Ref<TextureCube> SceneRenderer::CreateEnvironmentMap(const std::string& filepath)
+	{
+		return CreateEnvironmentMap(Texture2D::Create(filepath));
+	}
 
-	std::pair<Ref<TextureCube>, Ref<TextureCube>> SceneRenderer::CreateEnvironmentMap(const std::string& filepath)
+	Ref<TextureCube> SceneRenderer::CreateEnvironmentMap(const Ref<Texture2D>& envEquirect)
 	{
-		const uint32_t cubemapSize = 2048;
-		const uint32_t irradianceMapSize = 32;
+		const uint32_t cubemapSize = RadianceMapSize;
 
 		Ref<TextureCube> envUnfiltered = TextureCube::Create(TextureFormat::Float16, cubemapSize, cubemapSize);
 		if (!equirectangularConversionShader)
 			equirectangularConversionShader = Shader::Create("assets/shaders/EquirectangularToCubeMap.glsl");
-		Ref<Texture2D> envEquirect = Texture2D::Create(filepath);
 		HZ_CORE_ASSERT(envEquirect->GetFormat() == TextureFormat::Float16, "Texture is not HDR!");
 
 		equirectangularConversionShader->Bind();
@@ -307,24 +345,13 @@ namespace Hazel {
 			}
 		});
 
-		if (!envIrradianceShader)
-			envIrradianceShader = Shader::Create("assets/shaders/EnvironmentIrradiance.glsl");
-
-		Ref<TextureCube> irradianceMap = TextureCube::Create(TextureFormat::Float16, irradianceMapSize, irradianceMapSize);
-		envIrradianceShader->Bind();
-		envFiltered->Bind();
-		Renderer::Submit([irradianceMap]()
-		{
-				glBindImageTexture(0, irradianceMap->GetRendererID(), 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
-				glDispatchCompute(irradianceMap->GetWidth() / 32, irradianceMap->GetHeight() / 32, 6);
-				glGenerateTextureMipmap(irradianceMap->GetRendererID());
-		});
-
-		return { envFiltered, irradianceMap };
+		return envFiltered;
 	}
 
 	void SceneRenderer::GeometryPass()
 	{
+		HZ_PROFILE_FUNCTION();
+
 		bool outline = s_Data.SelectedMeshDrawList.size() > 0;
 		bool collider = s_Data.ColliderDrawList.size() > 0;
 
@@ -384,7 +411,7 @@ namespace Hazel {
 
 			// Environment (TODO: don't do this per mesh)
 			baseMaterial->Set("u_EnvRadianceTex", s_Data.SceneData.SceneEnvironment.RadianceMap);
-			baseMaterial->Set("u_EnvIrradianceTex", s_Data.SceneData.SceneEnvironment.IrradianceMap);
+			baseMaterial->Set("u_EnvIrradianceSH", s_Data.SceneData.SceneEnvironment.IrradianceSH);
 			baseMaterial->Set("u_BRDFLUTTexture", s_Data.BRDFLUT);
 
 			// Set lights (TODO: move to light environment and don't do per mesh)
@@ -447,7 +474,7 @@ namespace Hazel {
 
 			// Environment (TODO: don't do this per mesh)
 			baseMaterial->Set("u_EnvRadianceTex", s_Data.SceneData.SceneEnvironment.RadianceMap);
-			baseMaterial->Set("u_EnvIrradianceTex", s_Data.SceneData.SceneEnvironment.IrradianceMap);
+			baseMaterial->Set("u_EnvIrradianceSH", s_Data.SceneData.SceneEnvironment.IrradianceSH);
 			baseMaterial->Set("u_BRDFLUTTexture", s_Data.BRDFLUT);
 
 			// Set lights (TODO: move to light environment and don't do per mesh)
@@ -585,6 +612,8 @@ namespace Hazel {
 
 	void SceneRenderer::CompositePass()
 	{
+		HZ_PROFILE_FUNCTION();
+
 		auto& compositeBuffer = s_Data.CompositePass->GetSpecification().TargetFramebuffer;
 
 		Renderer::BeginRenderPass(s_Data.CompositePass);
@@ -606,6 +635,8 @@ namespace Hazel {
 
 	void SceneRenderer::BloomBlurPass()
 	{
+		HZ_PROFILE_FUNCTION();
+
 		int amount = 10;
 		int index = 0;
 
@@ -774,6 +805,8 @@ namespace Hazel {
 
 	void SceneRenderer::ShadowMapPass()
 	{
+		HZ_PROFILE_FUNCTION();
+
 		auto& directionalLights = s_Data.SceneData.SceneLightEnvironment.DirectionalLights;
 		if (directionalLights[0].Multiplier == 0.0f || !directionalLights[0].CastShadows)
 		{
@@ -811,7 +844,7 @@ namespace Hazel {
 			// Render entities
 			for (auto& dc : s_Data.ShadowPassDrawList)
 			{
-				Ref<Shader> shader = dc.Mesh->IsAnimated() ? s_Data.ShadowMapAnimShader : s_Data.ShadowMapShader;
+				RefView<Shader> shader = dc.Mesh->IsAnimated() ? s_Data.ShadowMapAnimShader : s_Data.ShadowMapShader;
 				shader->SetMat4("u_ViewProjection", shadowMapVP);
 				Renderer::SubmitMeshWithShader(dc.Mesh, dc.Transform, shader);
 			}
@@ -820,37 +853,99 @@ namespace Hazel {
 		}
 	}
 
+	static void RequestTextures(const FrameVector<SceneRendererData::DrawCommand>& drawList, const glm::vec3& cameraPosition, float pixelsPerUnit, bool perspective)
+	{
+		for (auto& dc : drawList)
+		{
+			const auto& materials = dc.Mesh->GetMaterials();
+			for (const Submesh& submesh : dc.Mesh->GetSubmeshes())
+			{
+				if (submesh.UVDensity <= 0.0f)
+					continue;
+
+				glm::mat4 transform = dc.Transform * submesh.Transform;
+				float scale = glm::max(glm::length(glm::vec3(transform[0])), glm::max(glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))));
+
+				// The closest point of the (world space) bounding box decides the finest mip needed
+				const AABB& aabb = submesh.BoundingBox;
+				glm::vec3 center = transform * glm::vec4((aabb.Min + aabb.Max) * 0.5f, 1.0f);
+				glm::vec3 extents = glm::abs(glm::mat3(transform)) * ((aabb.Max - aabb.Min) * 0.5f);
+				glm::vec3 offset = glm::max(glm::abs(cameraPosition - center) - extents, glm::vec3(0.0f));
+				float distance = perspective ? glm::max(glm::length(offset), 0.01f) : 1.0f;
+
+				float texelsPerPixel = submesh.UVDensity / scale / (pixelsPerUnit / distance);
+				RefView<MaterialInstance> material = dc.Material ? dc.Material : RefView<MaterialInstance>(materials[submesh.MaterialIndex]);
+				for (auto& texture : material->GetTextures())
+				{
+					if (texture)
+						TextureStreamer::RequestTexture(texture.Raw(), texelsPerPixel);
+				}
+			}
+		}
+	}
+
+	// Reports how large each material's textures appear on screen, so TextureStreamer
+	// can load the mips that are actually visible
+	static void RequestVisibleTextures()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (!TextureStreamer::IsEnabled())
+			return;
+
+		auto& sceneCamera = s_Data.SceneData.SceneCamera;
+		const glm::mat4& projection = sceneCamera.Camera.GetProjectionMatrix();
+		glm::vec3 cameraPosition = glm::inverse(sceneCamera.ViewMatrix)[3];
+		bool perspective = projection[3][3] == 0.0f;
+
+		// Pixels covered by one world unit at distance 1 (perspective) or anywhere (orthographic)
+		float viewportHeight = (float)s_Data.GeoPass->GetSpecification().TargetFramebuffer->GetHeight();
+		float pixelsPerUnit = glm::abs(projection[1][1]) * 0.5f * viewportHeight;
+
+		RequestTextures(s_Data.DrawList, cameraPosition, pixelsPerUnit, perspective);
+		RequestTextures(s_Data.SelectedMeshDrawList, cameraPosition, pixelsPerUnit, perspective);
+	}
+
 	void SceneRenderer::FlushDrawList()
 	{
+		HZ_PROFILE_FUNCTION();
+
 		HZ_CORE_ASSERT(!s_Data.ActiveScene, "");
 
 		memset(&s_Stats, 0, sizeof(SceneRendererStats));
 
+		RequestVisibleTextures();
+
 		{
 			Renderer::Submit([]()
 			{
+				HZ_PROFILE_BEGIN("SceneRenderer::ShadowMapPass (Execute)");
 				s_Stats.ShadowPassTimer.Reset();
 			});
 			ShadowMapPass();
 			Renderer::Submit([]
 			{
 				s_Stats.ShadowPass = s_Stats.ShadowPassTimer.ElapsedMillis();
+				HZ_PROFILE_END();
 			});
 		}
 		{
 			Renderer::Submit([]()
 			{
+				HZ_PROFILE_BEGIN("SceneRenderer::GeometryPass (Execute)");
 				s_Stats.GeometryPassTimer.Reset();
 			});
 			GeometryPass();
 			Renderer::Submit([]
 			{
 				s_Stats.GeometryPass = s_Stats.GeometryPassTimer.ElapsedMillis();
+				HZ_PROFILE_END();
 			});
 		}
 		{
 			Renderer::Submit([]()
 			{
+				HZ_PROFILE_BEGIN("SceneRenderer::CompositePass (Execute)");
 				s_Stats.CompositePassTimer.Reset();
 			});
 
@@ -858,15 +953,17 @@ namespace Hazel {
 			Renderer::Submit([]
 			{
 				s_Stats.CompositePass = s_Stats.CompositePassTimer.ElapsedMillis();
+				HZ_PROFILE_END();
 			});
 
 		//	BloomBlurPass();
 		}
 
-		s_Data.DrawList.clear();
-		s_Data.SelectedMeshDrawList.clear();
-		s_Data.ShadowPassDrawList.clear();
-		s_Data.ColliderDrawList.clear();
+		s_Data.LastDrawListSizes = { s_Data.DrawList.size(), s_Data.SelectedMeshDrawList.size(), s_Data.ColliderDrawList.size(), s_Data.ShadowPassDrawList.size() };
+		s_Data.DrawList = FrameVector<SceneRendererData::DrawCommand>();
+		s_Data.SelectedMeshDrawList = FrameVector<SceneRendererData::DrawCommand>();
+		s_Data.ShadowPassDrawList = FrameVector<SceneRendererData::DrawCommand>();
+		s_Data.ColliderDrawList = FrameVector<SceneRendererData::DrawCommand>();
 		s_Data.SceneData = {};
 	}
 
@@ -955,6 +1052,61 @@ namespace Hazel {
 			UI::EndTreeNode();
 		}
 
+		if (UI::BeginTreeNode("Timings"))
+		{
+			auto gpuTime = [](std::initializer_list<RefView<RenderPass>> passes)
+			{
+				float time = 0.0f;
+				for (RefView<RenderPass> pass : passes)
+					time += pass->GetGPUTimer()->GetAverageTime();
+				return time;
+			};
+			auto row = [](const char* pass, float cpuTime, float gpuTime)
+			{
+				ImGui::Text("%s", pass);
+				ImGui::NextColumn();
+				ImGui::Text("%.3f", cpuTime);
+				ImGui::NextColumn();
+				ImGui::Text("%.3f", gpuTime);
+				ImGui::NextColumn();
+			};
+
+			ImGui::Columns(3);
+			ImGui::Text("Pass");
+			ImGui::NextColumn();
+			ImGui::Text("CPU (ms)");
+			ImGui::NextColumn();
+			ImGui::Text("GPU (ms)");
+			ImGui::NextColumn();
+			ImGui::Separator();
+
+			const auto& shadowPasses = s_Data.ShadowMapRenderPass;
+			row("Shadow", s_Stats.ShadowPass, gpuTime({ shadowPasses[0], shadowPasses[1], shadowPasses[2], shadowPasses[3] }));
+			row("Geometry", s_Stats.GeometryPass, gpuTime({ s_Data.GeoPass }));
+			row("Composite", s_Stats.CompositePass, gpuTime({ s_Data.CompositePass }));
+			ImGui::Columns(1);
+			UI::EndTreeNode();
+		}
+
+		if (UI::BeginTreeNode("Texture Streaming", false))
+		{
+			bool enabled = TextureStreamer::IsEnabled();
+			int budget = (int)(TextureStreamer::GetBudget() / (1024 * 1024));
+			UI::BeginPropertyGrid();
+			if (UI::Property("Enabled", enabled))
+				TextureStreamer::SetEnabled(enabled);
+			if (UI::Property("Budget (MB)", budget) && budget > 0)
+				TextureStreamer::SetBudget((uint64_t)budget * 1024 * 1024);
+			UI::EndPropertyGrid();
+
+			TextureStreamingStats stats = TextureStreamer::GetStats();
+			auto toMB = [](uint64_t bytes) { return (float)bytes / (1024.0f * 1024.0f); };
+			ImGui::Text("Streamed Textures: %u (%u loading)", stats.TextureCount, stats.PendingCount);
+			ImGui::Text("Resident: %.1f MB", toMB(stats.ResidentSize));
+			ImGui::Text("Requested: %.1f MB", toMB(stats.RequestedSize));
+			UI::EndTreeNode();
+		}
+
 
 		ImGui::End();
 	}
@@ -31,14 +31,21 @@ namespace Hazel {
 		static void BeginScene(const Scene* scene, const SceneRendererCamera& camera);
 		static void EndScene();
 
-		static void SubmitMesh(Ref<Mesh> mesh, const glm::mat4& transform = glm::mat4(1.0f), Ref<MaterialInstance> overrideMaterial = nullptr);
-		static void SubmitSelectedMesh(Ref<Mesh> mesh, const glm::mat4& transform = glm::mat4(1.0f));
+		// The mesh and material must stay alive until the scene ends; the draw lists don't hold references
+		static void SubmitMesh(RefView<Mesh> mesh, const glm::mat4& transform = glm::mat4(1.0f), RefView<MaterialInstance> overrideMaterial = nullptr);
+		static void SubmitSelectedMesh(RefView<Mesh> mesh, const glm::mat4& transform = glm::mat4(1.0f));
 		static void SubmitColliderMesh(const BoxColliderComponent& component, const glm::mat4& parentTransform = glm::mat4(1.0F));
 		static void SubmitColliderMesh(const SphereColliderComponent& component, const glm::mat4& parentTransform = glm::mat4(1.0F));
 		static void SubmitColliderMesh(const CapsuleColliderComponent& component, const glm::mat4& parentTransform = glm::mat4(1.0F));
 		static void SubmitColliderMesh(const MeshColliderComponent& component, const glm::mat4& parentTransform = glm::mat4(1.0F));
 
-		static std::pair<Ref<TextureCube>, Ref<TextureCube>> CreateEnvironmentMap(const std::string& filepath);
+		// Cube map size CreateEnvironmentMap generates; part of the environment cache key
+		static const uint32_t RadianceMapSize = 2048;
+
+		// Prefiltered radiance map. Irradiance comes from the CPU, see SphericalHarmonicsL2.
+		static Ref<TextureCube> CreateEnvironmentMap(const std::string& filepath);
+		// Equirectangular HDR source, e.g. one decoded by the asset loader
+		static Ref<TextureCube> CreateEnvironmentMap(const Ref<Texture2D>& envEquirect);
 
 		static Ref<RenderPass> GetFinalRenderPass();
 		static Ref<Texture2D> GetFinalColorBuffer();
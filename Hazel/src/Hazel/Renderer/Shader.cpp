@@ -63,10 +63,11 @@ namespace Hazel {
 		m_Shaders[name] = Ref<Shader>(Shader::Create(path));
 	}
 
-	const Ref<Shader>& ShaderLibrary::Get(const std::string& name) const
+	const Ref<Shader>& ShaderLibrary::Get(std::string_view name) const
 	{
-		HZ_CORE_ASSERT(m_Shaders.find(name) != m_Shaders.end());
-		return m_Shaders.at(name);
+		auto it = m_Shaders.find(name);
+		HZ_CORE_ASSERT(it != m_Shaders.end());
+		return it->second;
 	}
 
 }
\ No newline at end of file
@@ -2,11 +2,13 @@
 
 #include "Hazel/Core/Base.h"
 #include "Hazel/Core/Buffer.h"
+#include "Hazel/Core/HashMap.h"
 
 #include "Hazel/Renderer/RendererAPI.h"
 #include "Hazel/Renderer/ShaderUniform.h"
 
 #include <string>
+#include <string_view>
 #include <glm/glm.hpp>
 
 namespace Hazel
@@ -115,16 +117,18 @@ namespace Hazel
 		virtual RendererID GetRendererID() const = 0;
 		virtual void UploadUniformBuffer(const UniformBufferBase& uniformBuffer) = 0;
 
-		// Temporary while we don't have materials
-		virtual void SetFloat(const std::string& name, float value) = 0;
-		virtual void SetInt(const std::string& name, int value) = 0;
-		virtual void SetBool(const std::string& name, bool value) = 0;
-		virtual void SetFloat2(const std::string& name, const glm::vec2& value) = 0;
-		virtual void SetFloat3(const std::string& name, const glm::vec3& value) = 0;
-		virtual void SetMat4(const std::string& name, const glm::mat4& value) = 0;
+		// Temporary while we don't have materials. Names and values are copied into frame
+		// memory for the render command, so literals don't cost a heap allocation.
+		virtual void SetFloat(std::string_view name, float value) = 0;
+		virtual void SetInt(std::string_view name, int value) = 0;
+		virtual void SetBool(std::string_view name, bool value) = 0;
+		virtual void SetFloat2(std::string_view name, const glm::vec2& value) = 0;
+		virtual void SetFloat3(std::string_view name, const glm::vec3& value) = 0;
+		virtual void SetMat4(std::string_view name, const glm::mat4& value) = 0;
+		virtual void SetMat4Array(std::string_view name, const glm::mat4* values, uint32_t count) = 0;
 		virtual void SetMat4FromRenderThread(const std::string& name, const glm::mat4& value, bool bind = true) = 0;
 
-		virtual void SetIntArray(const std::string& name, int* values, uint32_t size) = 0;
+		virtual void SetIntArray(std::string_view name, const int* values, uint32_t size) = 0;
 
 		virtual const std::string& GetName() const = 0;
 
@@ -134,8 +138,9 @@ namespace Hazel
 		static Ref<Shader> Create(const std::string& filepath);
 		static Ref<Shader> CreateFromString(const std::string& source);
 
-		virtual void SetVSMaterialUniformBuffer(Buffer buffer) = 0;
-		virtual void SetPSMaterialUniformBuffer(Buffer buffer) = 0;
+		// The values are staged in frame memory, so later changes don't affect this draw
+		virtual void SetVSMaterialUniformBuffer(BufferView buffer) = 0;
+		virtual void SetPSMaterialUniformBuffer(BufferView buffer) = 0;
 
 		virtual const ShaderUniformBufferList& GetVSRendererUniforms() const = 0;
 		virtual const ShaderUniformBufferList& GetPSRendererUniforms() const = 0;
@@ -163,9 +168,9 @@ namespace Hazel
 		void Load(const std::string& path);
 		void Load(const std::string& name, const std::string& path);
 
-		const Ref<Shader>& Get(const std::string& name) const;
+		const Ref<Shader>& Get(std::string_view name) const;
 	private:
-		std::unordered_map<std::string, Ref<Shader>> m_Shaders;
+		HashMap<std::string, Ref<Shader>> m_Shaders;
 	};
 
 }
\ No newline at end of file
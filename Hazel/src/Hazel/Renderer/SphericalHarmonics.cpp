@@ -0,0 +1,194 @@
+#include "hzpch.h"
+#include "SphericalHarmonics.h"
+
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Core/Math/HalfFloat.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#define HZ_SH_X86 1
+	#include <emmintrin.h>
+#else
+	#define HZ_SH_X86 0
+#endif
+
+namespace Hazel {
+
+	// Real SH basis constants, with y up: the zonal band-2 function is 3y^2 - 1
+	static const float s_Y00 = 0.282095f;
+	static const float s_Y1 = 0.488603f;
+	static const float s_Y2 = 1.092548f;
+	static const float s_Y20 = 0.315392f;
+	static const float s_Y22 = 0.546274f;
+
+	// Every basis function is a function of theta times one of these of phi, so each row of
+	// the image only needs its texels summed against them
+	enum AzimuthFunction { Constant = 0, CosPhi, SinPhi, Cos2Phi, Sin2Phi, AzimuthFunctionCount };
+
+	// Per texel values of the azimuth functions, repeated for each of the three channels so
+	// they line up with a row of interleaved RGB
+	struct AzimuthTables
+	{
+		std::vector<float> Values[AzimuthFunctionCount];
+	};
+
+	static AzimuthTables BuildAzimuthTables(uint32_t width)
+	{
+		AzimuthTables tables;
+		for (auto& values : tables.Values)
+			values.resize((size_t)width * 3);
+
+		for (uint32_t i = 0; i < width; i++)
+		{
+			// Matches EquirectangularToCubeMap.glsl: u = phi / 2pi + 0.5, x = cos(phi), z = sin(phi)
+			float phi = (((float)i + 0.5f) / (float)width - 0.5f) * glm::two_pi<float>();
+			float functions[AzimuthFunctionCount] = { 1.0f, std::cos(phi), std::sin(phi), std::cos(2.0f * phi), std::sin(2.0f * phi) };
+			for (int f = 0; f < AzimuthFunctionCount; f++)
+				for (int channel = 0; channel < 3; channel++)
+					tables.Values[f][(size_t)i * 3 + channel] = functions[f];
+		}
+		return tables;
+	}
+
+	// sums[f][channel] = sum over the row of texel * azimuth function f
+	static void SumRow(const float* row, uint32_t count, const AzimuthTables& tables, float sums[AzimuthFunctionCount][3])
+	{
+		for (int f = 0; f < AzimuthFunctionCount; f++)
+			sums[f][0] = sums[f][1] = sums[f][2] = 0.0f;
+
+		uint32_t i = 0;
+#if HZ_SH_X86
+		// Twelve floats (four texels) at a time, in three vectors. Lane l of vector v always
+		// holds channel (4v + l) % 3, so the channels are only separated at the end.
+		__m128 accumulators[AzimuthFunctionCount][3];
+		for (auto& accumulator : accumulators)
+			accumulator[0] = accumulator[1] = accumulator[2] = _mm_setzero_ps();
+
+		for (; i + 12 <= count; i += 12)
+		{
+			__m128 texels[3] = { _mm_loadu_ps(row + i), _mm_loadu_ps(row + i + 4), _mm_loadu_ps(row + i + 8) };
+			for (int v = 0; v < 3; v++)
+				accumulators[Constant][v] = _mm_add_ps(accumulators[Constant][v], texels[v]);
+
+			for (int f = CosPhi; f < AzimuthFunctionCount; f++)
+			{
+				const float* values = tables.Values[f].data() + i;
+				for (int v = 0; v < 3; v++)
+					accumulators[f][v] = _mm_add_ps(accumulators[f][v], _mm_mul_ps(texels[v], _mm_loadu_ps(values + v * 4)));
+			}
+		}
+
+		for (int f = 0; f < AzimuthFunctionCount; f++)
+		{
+			for (int v = 0; v < 3; v++)
+			{
+				alignas(16) float lanes[4];
+				_mm_store_ps(lanes, accumulators[f][v]);
+				for (int lane = 0; lane < 4; lane++)
+					sums[f][(v * 4 + lane) % 3] += lanes[lane];
+			}
+		}
+#endif
+		for (; i < count; i++)
+		{
+			for (int f = 0; f < AzimuthFunctionCount; f++)
+				sums[f][i % 3] += row[i] * tables.Values[f][i];
+		}
+	}
+
+	// Unconvolved radiance coefficients of rows [firstRow, lastRow), in double as a large
+	// image adds up millions of texels
+	static void ProjectRows(const uint16_t* pixels, uint32_t width, uint32_t height, uint32_t firstRow, uint32_t lastRow,
+		const AzimuthTables& tables, double coefficients[9][3])
+	{
+		const uint32_t rowSize = width * 3;
+		std::vector<float> row(rowSize);
+
+		// Solid angle of a texel is dphi * dtheta * sin(theta)
+		const float texelArea = (glm::two_pi<float>() / (float)width) * (glm::pi<float>() / (float)height);
+
+		for (uint32_t j = firstRow; j < lastRow; j++)
+		{
+			HalfFloat::ToFloat(pixels + (size_t)j * rowSize, row.data(), rowSize);
+
+			float sums[AzimuthFunctionCount][3];
+			SumRow(row.data(), rowSize, tables, sums);
+
+			// Row 0 is the top of the image, theta = 0, which is +y
+			float theta = ((float)j + 0.5f) / (float)height * glm::pi<float>();
+			float sinTheta = std::sin(theta);
+			float cosTheta = std::cos(theta);
+			float weight = texelArea * sinTheta;
+
+			for (int channel = 0; channel < 3; channel++)
+			{
+				float constant = sums[Constant][channel];
+				float cosPhi = sums[CosPhi][channel];
+				float sinPhi = sums[SinPhi][channel];
+
+				float rowCoefficients[9] = {
+					s_Y00 * constant,
+					s_Y1 * cosTheta * constant,                                  // y
+					s_Y1 * sinTheta * sinPhi,                                    // z
+					s_Y1 * sinTheta * cosPhi,                                    // x
+					s_Y2 * sinTheta * cosTheta * cosPhi,                         // xy
+					s_Y2 * sinTheta * cosTheta * sinPhi,                         // yz
+					s_Y20 * (3.0f * cosTheta * cosTheta - 1.0f) * constant,      // 3y^2 - 1
+					s_Y2 * sinTheta * sinTheta * 0.5f * sums[Sin2Phi][channel],  // xz
+					s_Y22 * sinTheta * sinTheta * sums[Cos2Phi][channel]         // x^2 - z^2
+				};
+				for (int k = 0; k < 9; k++)
+					coefficients[k][channel] += (double)(rowCoefficients[k] * weight);
+			}
+		}
+	}
+
+	glm::vec3 SphericalHarmonicsL2::Evaluate(const glm::vec3& n) const
+	{
+		const glm::vec3* c = Coefficients;
+		return s_Y00 * c[0]
+			+ s_Y1 * (n.y * c[1] + n.z * c[2] + n.x * c[3])
+			+ s_Y2 * (n.x * n.y * c[4] + n.y * n.z * c[5] + n.x * n.z * c[7])
+			+ s_Y20 * (3.0f * n.y * n.y - 1.0f) * c[6]
+			+ s_Y22 * (n.x * n.x - n.z * n.z) * c[8];
+	}
+
+	SphericalHarmonicsL2 SphericalHarmonicsL2::ProjectIrradiance(const uint16_t* pixels, uint32_t width, uint32_t height)
+	{
+		SphericalHarmonicsL2 result;
+		if (!pixels || width == 0 || height == 0)
+			return result;
+
+		AzimuthTables tables = BuildAzimuthTables(width);
+
+		// Partial sums per batch of rows, added up in a fixed order so the result doesn't
+		// depend on how the batches were scheduled
+		const uint32_t rowsPerJob = 32;
+		std::vector<std::array<std::array<double, 3>, 9>> partials((height + rowsPerJob - 1) / rowsPerJob);
+		JobSystem::ParallelFor(height, rowsPerJob, [&](uint32_t firstRow, uint32_t lastRow)
+		{
+			double coefficients[9][3] = {};
+			ProjectRows(pixels, width, height, firstRow, lastRow, tables, coefficients);
+			auto& partial = partials[firstRow / rowsPerJob];
+			for (int k = 0; k < 9; k++)
+				for (int channel = 0; channel < 3; channel++)
+					partial[k][channel] = coefficients[k][channel];
+		});
+
+		// Convolving with the clamped cosine scales band l by A_l: pi, 2pi/3 and pi/4.
+		// Dividing by pi gives irradiance in the same units as the radiance.
+		const double bandScale[9] = { 1.0, 2.0 / 3.0, 2.0 / 3.0, 2.0 / 3.0, 0.25, 0.25, 0.25, 0.25, 0.25 };
+		for (int k = 0; k < 9; k++)
+		{
+			glm::dvec3 sum(0.0);
+			for (const auto& partial : partials)
+				sum += glm::dvec3(partial[k][0], partial[k][1], partial[k][2]);
+			result.Coefficients[k] = glm::vec3(sum * bandScale[k]);
+		}
+		return result;
+	}
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	// Diffuse irradiance of an environment as the 9 RGB coefficients of an order 2 (L2)
+	// spherical harmonics expansion. The Lambertian convolution is folded into the
+	// coefficients, so Evaluate gives what the irradiance cube map used to hold: the cosine
+	// weighted integral of radiance over the hemisphere, divided by pi.
+	// The layout matches the u_EnvIrradianceSH[9] uniform of the PBR shaders.
+	struct SphericalHarmonicsL2
+	{
+		glm::vec3 Coefficients[9] = {};
+
+		glm::vec3 Evaluate(const glm::vec3& normal) const;
+
+		// Projects an equirectangular RGB half float image, laid out as Texture2D::Decode
+		// produces HDR images. Rows are split across the job system's workers.
+		static SphericalHarmonicsL2 ProjectIrradiance(const uint16_t* pixels, uint32_t width, uint32_t height);
+	};
+
+	static_assert(sizeof(SphericalHarmonicsL2) == 9 * sizeof(glm::vec3), "SphericalHarmonicsL2 must match the shader's vec3[9]");
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "RendererAPI.h"
+
+namespace Hazel {
+
+	// A range of the streaming buffer, valid for the frame it was allocated in
+	struct StreamingAllocation
+	{
+		uint8_t* Data = nullptr; // Mapped memory; write only, reading it back is very slow
+		uint64_t Offset = 0;     // Into the streaming buffer, for binding or copying from it
+		uint64_t Size = 0;
+
+		operator bool() const { return Data != nullptr; }
+	};
+
+	// A persistently mapped buffer for data the GPU reads once: batched vertices, dynamic buffer
+	// updates. It is split into one region per frame in flight, so the main thread writes this
+	// frame's data straight into memory the GPU reads, with no copy on either side and nothing
+	// for the driver to synchronize. At the end of every frame its region is fenced, and the
+	// next region is waited on before it is handed out again.
+	class StreamingBuffer
+	{
+	public:
+		static const uint32_t FrameCount = 3;
+		static const uint64_t DefaultFrameSize = 8ull * 1024 * 1024;
+
+		// Called by the renderer; the buffer is created on the render thread
+		static void Init(uint64_t frameSize = DefaultFrameSize);
+		static void Shutdown();
+
+		// Any thread. Alignment need not be a power of two, so vertices can be aligned to their
+		// stride and drawn with a base vertex. Returns an empty allocation once this frame's
+		// region is full, or if the buffer could not be mapped; callers fall back to uploading.
+		static StreamingAllocation Allocate(uint64_t size, uint64_t alignment = 16);
+
+		// Main thread; submit binds for the draws reading allocations
+		static void BindAsVertexBuffer();
+		static void BindAsIndexBuffer();
+
+		// Render thread
+		static RendererID GetRendererID();
+		// Render thread, after the frame's commands: fences this frame's region and waits until
+		// the GPU is done with the next one
+		static void EndFrame();
+
+		// Of the current frame's region
+		static uint64_t GetFrameSize();
+		static uint64_t GetUsedSize();
+	};
+
+}
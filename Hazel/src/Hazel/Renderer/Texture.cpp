@@ -2,7 +2,15 @@
 #include "Texture.h"
 
 #include "Hazel/Renderer/RendererAPI.h"
+#include "Hazel/Renderer/KTX2.h"
+#include "Hazel/Renderer/TextureStreamer.h"
 #include "Hazel/Platform/OpenGL/OpenGLTexture.h"
+#include "Hazel/FileSystem/FileSystem.h"
+#include "Hazel/Core/Math/HalfFloat.h"
+
+#include "stb_image.h"
+
+#include <filesystem>
 
 namespace Hazel {
 
@@ -26,6 +34,124 @@ namespace Hazel {
 		return nullptr;
 	}
 
+	Ref<Texture2D> Texture2D::Create(TextureData& data)
+	{
+		switch (RendererAPI::Current())
+		{
+			case RendererAPIType::None:
+				// Nothing will upload from the staging range, so give it back
+				TextureUploader::Discard(data.Staging);
+				data.Staging = StagingAllocation();
+				return nullptr;
+			case RendererAPIType::OpenGL: return Ref<OpenGLTexture2D>::Create(data);
+		}
+		return nullptr;
+	}
+
+	static bool ReadCooked(const FileData& file, TextureData& outData)
+	{
+		uint32_t width, height, mipCount;
+		if (!KTX2::ReadInfo(file.GetData(), file.GetSize(), width, height, mipCount))
+			return false;
+
+		// Streamed textures start out with only their small mips
+		return KTX2::Read(file.GetData(), file.GetSize(), outData, TextureStreamer::GetInitialMip(width, height, mipCount));
+	}
+
+	bool Texture2D::Decode(const std::string& path, bool srgb, TextureData& outData)
+	{
+		outData.Path = path;
+		outData.SRGB = srgb;
+
+		std::string cookedPath = FindCookedPath(path);
+		if (!cookedPath.empty())
+		{
+			FileData cooked = FileSystem::ReadFile(cookedPath);
+			if (ReadCooked(cooked, outData))
+			{
+				HZ_CORE_INFO("Loading cooked texture {0}, srgb={1}", cookedPath, srgb);
+				return true;
+			}
+			HZ_CORE_WARN("Could not read cooked texture {0}, falling back to {1}", cookedPath, path);
+		}
+
+		FileData file = FileSystem::ReadFile(path);
+		return Decode(path, file, srgb, outData);
+	}
+
+	bool Texture2D::Decode(const std::string& path, const FileData& file, bool srgb, TextureData& outData)
+	{
+		outData.Path = path;
+		outData.SRGB = srgb;
+
+		const stbi_uc* fileData = file.GetData();
+		int fileSize = (int)file.GetSize();
+		if (KTX2::IsKTX2(fileData, fileSize))
+			return ReadCooked(file, outData);
+
+		int width, height, channels;
+		if (stbi_is_hdr_from_memory(fileData, fileSize))
+		{
+			HZ_CORE_INFO("Loading HDR texture {0}, srgb={1}", path, srgb);
+			float* pixels = stbi_loadf_from_memory(fileData, fileSize, &width, &height, &channels, STBI_rgb);
+			channels = 3;
+			if (pixels)
+			{
+				// Halves the size before upload; converted in place so stb_image still owns the memory
+				HalfFloat::FromFloat(pixels, (uint16_t*)pixels, (size_t)width * height * channels);
+			}
+			outData.Data.Data = (byte*)pixels;
+			outData.HDR = true;
+			outData.Format = TextureFormat::Float16;
+		}
+		else
+		{
+			HZ_CORE_INFO("Loading texture {0}, srgb={1}", path, srgb);
+			outData.Data.Data = stbi_load_from_memory(fileData, fileSize, &width, &height, &channels, srgb ? STBI_rgb : STBI_rgb_alpha);
+			HZ_CORE_ASSERT(outData.Data.Data, "Could not read image!");
+			outData.Format = TextureFormat::RGBA;
+			channels = srgb ? 3 : 4;
+		}
+
+		if (!outData.Data.Data)
+			return false;
+
+		outData.Width = width;
+		outData.Height = height;
+		outData.Data.Size = width * height * channels * (outData.HDR ? (int)sizeof(uint16_t) : 1);
+		return true;
+	}
+
+	std::string Texture2D::GetCookedPath(const std::string& path)
+	{
+		return std::filesystem::path(path).replace_extension(".ktx2").string();
+	}
+
+	std::string Texture2D::FindCookedPath(const std::string& path)
+	{
+		std::string cookedPath = GetCookedPath(path);
+		if (cookedPath == path || !FileSystem::Exists(cookedPath))
+			return {};
+
+		// Only loose files have modification times. Without both (a build that ships only the
+		// cooked file, or either one in a pack) the cooked file is trusted.
+		std::error_code error;
+		std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(path, error);
+		if (error)
+			return cookedPath;
+
+		std::filesystem::file_time_type cookedTime = std::filesystem::last_write_time(cookedPath, error);
+		if (error)
+			return cookedPath;
+
+		if (cookedTime < sourceTime)
+		{
+			HZ_CORE_WARN("Cooked texture {0} is older than {1}, loading the source instead; recook to update it", cookedPath, path);
+			return {};
+		}
+		return cookedPath;
+	}
+
 	Ref<TextureCube> TextureCube::Create(TextureFormat format, uint32_t width, uint32_t height)
 	{
 		switch (RendererAPI::Current())
@@ -46,6 +172,27 @@ namespace Hazel {
 		return nullptr;
 	}
 
+	Ref<TextureCube> TextureCube::Create(TextureFormat format, uint32_t width, uint32_t height, Buffer data)
+	{
+		switch (RendererAPI::Current())
+		{
+			case RendererAPIType::None: return nullptr;
+			case RendererAPIType::OpenGL: return Ref<OpenGLTextureCube>::Create(format, width, height, data);
+		}
+		return nullptr;
+	}
+
+	uint64_t TextureCube::GetPixelDataSize(uint32_t size)
+	{
+		uint64_t bytes = 0;
+		for (uint32_t mip = 0; mip < Texture::CalculateMipMapCount(size, size); mip++)
+		{
+			uint64_t mipSize = std::max(size >> mip, 1u);
+			bytes += mipSize * mipSize * 6 * 3 * sizeof(uint16_t);
+		}
+		return bytes;
+	}
+
 	uint32_t Texture::GetBPP(TextureFormat format)
 	{
 		switch (format)
@@ -56,6 +203,29 @@ namespace Hazel {
 		return 0;
 	}
 
+	bool Texture::IsCompressed(TextureFormat format)
+	{
+		return GetBlockSize(format) != 0;
+	}
+
+	uint32_t Texture::GetBlockSize(TextureFormat format)
+	{
+		switch (format)
+		{
+			case TextureFormat::BC1: return 8;
+			case TextureFormat::BC3: return 16;
+			case TextureFormat::BC4: return 8;
+			case TextureFormat::BC5: return 16;
+			case TextureFormat::BC7: return 16;
+		}
+		return 0;
+	}
+
+	uint32_t Texture::GetCompressedSize(TextureFormat format, uint32_t width, uint32_t height)
+	{
+		return ((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+	}
+
 	uint32_t Texture::CalculateMipMapCount(uint32_t width, uint32_t height)
 	{
 		uint32_t levels = 1;
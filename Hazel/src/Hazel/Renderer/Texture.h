@@ -3,15 +3,25 @@
 #include "Hazel/Core/Base.h"
 #include "Hazel/Core/Buffer.h"
 #include "RendererAPI.h"
+#include "TextureUploader.h"
 
 namespace Hazel {
 
+	class FileData;
+
 	enum class TextureFormat
 	{
 		None = 0,
 		RGB = 1,
 		RGBA = 2,
-		Float16 = 3
+		Float16 = 3,
+
+		// Block compressed, 4x4 texels per block. Always cooked offline, see TextureCooker
+		BC1 = 4, // RGB, 8 bytes per block
+		BC3 = 5, // RGBA, 16 bytes per block
+		BC4 = 6, // R, 8 bytes per block
+		BC5 = 7, // RG, 16 bytes per block; normal maps, Z is reconstructed in the shader
+		BC7 = 8  // RGBA, 16 bytes per block
 	};
 
 	enum class TextureWrap
@@ -21,6 +31,37 @@ namespace Hazel {
 		Repeat = 2
 	};
 
+	// Where one mip level lives within TextureData::Data
+	struct TextureMip
+	{
+		uint32_t Width = 0, Height = 0;
+		uint32_t Offset = 0, Size = 0;
+	};
+
+	// Decoded image pixels, ready for upload. Decoding touches no renderer state,
+	// so it can happen on any thread
+	struct TextureData
+	{
+		std::string Path;
+		TextureFormat Format = TextureFormat::None;
+		uint32_t Width = 0, Height = 0;
+		bool HDR = false;
+		bool SRGB = false;
+		// Allocated by stb_image, or with new[] for compressed formats. HDR images are RGB half floats.
+		// Once staged it points into mapped memory instead, which is write only: never read it back.
+		Buffer Data;
+
+		// Compressed formats only. Streamed textures start out with only the small mips,
+		// so Mips can be a tail of the full chain: Mips[0] is level FirstMip of MipCount
+		std::vector<TextureMip> Mips;
+		uint32_t FirstMip = 0;
+		uint32_t MipCount = 0;
+
+		// Set when TextureUploader::Stage moved Data into the staging buffer. Anything dropping
+		// the data without creating a texture from it must hand the range to TextureUploader::Discard.
+		StagingAllocation Staging;
+	};
+
 	class Texture : public RefCounted
 	{
 	public:
@@ -33,12 +74,19 @@ namespace Hazel {
 		virtual uint32_t GetWidth() const = 0;
 		virtual uint32_t GetHeight() const = 0;
 		virtual uint32_t GetMipLevelCount() const = 0;
+		// Streamed textures (see TextureStreamer) only have mips [GetFirstResidentMip(), GetMipLevelCount()) in VRAM
+		virtual uint32_t GetFirstResidentMip() const { return 0; }
 
 		virtual RendererID GetRendererID() const = 0;
 
 		static uint32_t GetBPP(TextureFormat format);
 		static uint32_t CalculateMipMapCount(uint32_t width, uint32_t height);
 
+		static bool IsCompressed(TextureFormat format);
+		// Bytes per 4x4 block, 0 for uncompressed formats
+		static uint32_t GetBlockSize(TextureFormat format);
+		static uint32_t GetCompressedSize(TextureFormat format, uint32_t width, uint32_t height);
+
 		virtual bool operator==(const Texture& other) const = 0;
 	};
 
@@ -47,6 +95,19 @@ namespace Hazel {
 	public:
 		static Ref<Texture2D> Create(TextureFormat format, uint32_t width, uint32_t height, TextureWrap wrap = TextureWrap::Clamp);
 		static Ref<Texture2D> Create(const std::string& path, bool srgb = false);
+		// Takes ownership of the decoded pixels
+		static Ref<Texture2D> Create(TextureData& data);
+
+		// Prefers a cooked .ktx2 next to the source image, which skips decoding altogether,
+		// as long as it's up to date (see FindCookedPath)
+		static bool Decode(const std::string& path, bool srgb, TextureData& outData);
+		// For callers that have already read the file; never looks for a cooked version
+		static bool Decode(const std::string& path, const FileData& file, bool srgb, TextureData& outData);
+		// Same path with a .ktx2 extension
+		static std::string GetCookedPath(const std::string& path);
+		// The cooked file to load in place of the source image, or empty if there isn't one or the
+		// source has been modified since it was cooked
+		static std::string FindCookedPath(const std::string& path);
 
 		virtual void Lock() = 0;
 		virtual void Unlock() = 0;
@@ -57,6 +118,10 @@ namespace Hazel {
 		virtual bool Loaded() const = 0;
 
 		virtual const std::string& GetPath() const = 0;
+
+		// Called by TextureStreamer. data holds the mips being added, [firstMip, GetFirstResidentMip()),
+		// and is empty when mips are being dropped.
+		virtual void SetResidentMips(uint32_t firstMip, TextureData& data) {}
 	};
 
 	class TextureCube : public Texture
@@ -64,6 +129,15 @@ namespace Hazel {
 	public:
 		static Ref<TextureCube> Create(TextureFormat format, uint32_t width, uint32_t height);
 		static Ref<TextureCube> Create(const std::string& path);
+		// Float16 only. Takes ownership of data, which holds every mip level, largest first,
+		// each as the six faces in order in RGB half floats
+		static Ref<TextureCube> Create(TextureFormat format, uint32_t width, uint32_t height, Buffer data);
+
+		// Every mip level in the layout Create takes, allocated with new[]. Float16 only, and
+		// as it reads back from the GPU, only callable from the render thread
+		virtual Buffer ReadPixels() const = 0;
+		// Bytes of the layout above for a size x size cube map
+		static uint64_t GetPixelDataSize(uint32_t size);
 
 		virtual const std::string& GetPath() const = 0;
 	};
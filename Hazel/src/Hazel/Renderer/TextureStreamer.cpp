@@ -0,0 +1,290 @@
+#include "hzpch.h"
+#include "TextureStreamer.h"
+
+#include "Hazel/Renderer/KTX2.h"
+#include "Hazel/Asset/AssetManager.h"
+#include "Hazel/FileSystem/FileSystem.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace Hazel {
+
+	struct StreamedTexture
+	{
+		Texture2D* Texture = nullptr; // Not owned; textures unregister themselves when destroyed
+		std::string FilePath;         // The KTX2 file the texture was loaded from
+		uint32_t MinResidentMip = 0;  // Mips from here on are never dropped
+		std::vector<uint64_t> TailSizes; // Bytes of mips [i, MipCount)
+
+		uint32_t RequestedMip = UINT32_MAX; // Finest mip asked for this frame
+		uint32_t TargetMip = 0;
+		uint64_t LastRequestFrame = 0;
+		uint64_t LastTargetFrame = 0;       // Last frame something needed TargetMip
+		bool Pending = false;
+		bool Failed = false;
+	};
+
+	struct TextureStreamerData
+	{
+		std::unordered_map<uint64_t, StreamedTexture> Textures;
+		std::unordered_map<const Texture*, uint64_t> TextureIDs;
+		uint64_t NextID = 1;
+
+		uint64_t Budget = 512ull * 1024 * 1024;
+		uint64_t Frame = 0;
+		uint32_t PendingCount = 0;
+		uint64_t RequestedSize = 0;
+	};
+
+	static TextureStreamerData s_Data;
+
+	// Read by loader threads through GetInitialMip
+	static std::atomic<bool> s_Enabled = true;
+	static std::atomic<uint32_t> s_MinResidentSize = 128;
+
+	// Frames a texture keeps mips nothing has asked for, so they don't thrash as the camera moves
+	static const uint64_t s_DropDelay = 60;
+	static const uint32_t s_MaxPendingCount = 4;
+
+	static uint64_t GetResidentSize(const StreamedTexture& texture)
+	{
+		return texture.TailSizes[texture.Texture->GetFirstResidentMip()];
+	}
+
+	void TextureStreamer::Shutdown()
+	{
+		// Stream-ins still in flight find their texture gone and free their mips
+		s_Data.Textures.clear();
+		s_Data.TextureIDs.clear();
+		s_Data.PendingCount = 0;
+	}
+
+	void TextureStreamer::SetEnabled(bool enabled)
+	{
+		s_Enabled = enabled;
+	}
+
+	bool TextureStreamer::IsEnabled()
+	{
+		return s_Enabled;
+	}
+
+	void TextureStreamer::SetMinResidentSize(uint32_t size)
+	{
+		s_MinResidentSize = std::max(size, 1u);
+	}
+
+	uint32_t TextureStreamer::GetMinResidentSize()
+	{
+		return s_MinResidentSize;
+	}
+
+	void TextureStreamer::SetBudget(uint64_t bytes)
+	{
+		s_Data.Budget = bytes;
+	}
+
+	uint64_t TextureStreamer::GetBudget()
+	{
+		return s_Data.Budget;
+	}
+
+	uint32_t TextureStreamer::GetInitialMip(uint32_t width, uint32_t height, uint32_t mipCount)
+	{
+		if (!s_Enabled)
+			return 0;
+
+		uint32_t mip = 0;
+		uint32_t minResidentSize = s_MinResidentSize;
+		while (mip + 1 < mipCount && std::max(width >> mip, height >> mip) > minResidentSize)
+			mip++;
+		return mip;
+	}
+
+	void TextureStreamer::Register(Texture2D* texture)
+	{
+		HZ_CORE_ASSERT(s_Data.TextureIDs.find(texture) == s_Data.TextureIDs.end(), "Texture is already registered!");
+
+		uint64_t id = s_Data.NextID++;
+		StreamedTexture& entry = s_Data.Textures[id];
+		entry.Texture = texture;
+		entry.MinResidentMip = texture->GetFirstResidentMip();
+		entry.TargetMip = entry.MinResidentMip;
+		entry.LastTargetFrame = s_Data.Frame;
+
+		const std::string& path = texture->GetPath();
+		std::string cookedPath = Texture2D::FindCookedPath(path);
+		entry.FilePath = cookedPath.empty() ? path : cookedPath;
+
+		uint32_t mipCount = texture->GetMipLevelCount();
+		entry.TailSizes.resize(mipCount + 1);
+		entry.TailSizes[mipCount] = 0;
+		for (uint32_t mip = mipCount; mip-- > 0;)
+		{
+			uint32_t width = std::max(texture->GetWidth() >> mip, 1u);
+			uint32_t height = std::max(texture->GetHeight() >> mip, 1u);
+			entry.TailSizes[mip] = entry.TailSizes[mip + 1] + Texture::GetCompressedSize(texture->GetFormat(), width, height);
+		}
+
+		s_Data.TextureIDs[texture] = id;
+	}
+
+	void TextureStreamer::Unregister(Texture2D* texture)
+	{
+		auto it = s_Data.TextureIDs.find(texture);
+		if (it == s_Data.TextureIDs.end())
+			return;
+
+		auto entry = s_Data.Textures.find(it->second);
+		if (entry->second.Pending)
+			s_Data.PendingCount--;
+		s_Data.Textures.erase(entry);
+		s_Data.TextureIDs.erase(it);
+	}
+
+	void TextureStreamer::RequestTexture(const Texture* texture, float texelsPerPixel)
+	{
+		auto it = s_Data.TextureIDs.find(texture);
+		if (it == s_Data.TextureIDs.end())
+			return;
+
+		StreamedTexture& entry = s_Data.Textures[it->second];
+		float texels = texelsPerPixel * (float)std::max(texture->GetWidth(), texture->GetHeight());
+		uint32_t mip = texels > 1.0f ? (uint32_t)std::log2(texels) : 0;
+		entry.RequestedMip = std::min({ entry.RequestedMip, mip, entry.MinResidentMip });
+		entry.LastRequestFrame = s_Data.Frame;
+	}
+
+	static void OnStreamedIn(uint64_t id, uint32_t firstMip, TextureData& data, bool loaded)
+	{
+		auto it = s_Data.Textures.find(id);
+		if (it == s_Data.Textures.end())
+		{
+			data.Data.Release();
+			return;
+		}
+
+		StreamedTexture& entry = it->second;
+		entry.Pending = false;
+		s_Data.PendingCount--;
+
+		if (!loaded)
+		{
+			// Stick with the mips that are there rather than retrying every frame
+			HZ_CORE_ERROR("Failed to stream texture mips from {0}", entry.FilePath);
+			entry.Failed = true;
+			data.Data.Release();
+			return;
+		}
+
+		entry.Texture->SetResidentMips(firstMip, data);
+	}
+
+	static void StreamIn(uint64_t id, StreamedTexture& entry, uint32_t firstMip)
+	{
+		entry.Pending = true;
+		s_Data.PendingCount++;
+
+		// Only the mips the texture doesn't have yet are read
+		uint32_t lastMip = entry.Texture->GetFirstResidentMip();
+		std::string filepath = entry.FilePath;
+		AssetManager::SubmitBackgroundJob([id, filepath, firstMip, lastMip]()
+		{
+			TextureData data;
+			FileData file = FileSystem::ReadFile(filepath);
+			bool loaded = file && KTX2::Read(file.GetData(), file.GetSize(), data, firstMip, lastMip);
+
+			AssetManager::SubmitMainThreadJob(data.Data.Size, [id, firstMip, data, loaded]() mutable
+			{
+				OnStreamedIn(id, firstMip, data, loaded);
+			});
+		});
+	}
+
+	void TextureStreamer::Update()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		uint64_t frame = ++s_Data.Frame;
+
+		// Finer mips are wanted straight away; coarser ones only once nothing has needed the
+		// current mips for a while
+		uint64_t requestedSize = 0;
+		std::vector<std::pair<uint64_t, StreamedTexture*>> textures;
+		textures.reserve(s_Data.Textures.size());
+		for (auto& [id, entry] : s_Data.Textures)
+		{
+			// With streaming disabled everything gets its full mip chain back, budget permitting
+			uint32_t requestedMip = s_Enabled ? std::min(entry.RequestedMip, entry.MinResidentMip) : 0;
+			if (requestedMip <= entry.TargetMip || frame - entry.LastTargetFrame > s_DropDelay)
+			{
+				entry.TargetMip = requestedMip;
+				entry.LastTargetFrame = frame;
+			}
+			entry.RequestedMip = UINT32_MAX;
+
+			requestedSize += entry.TailSizes[entry.TargetMip];
+			textures.push_back({ id, &entry });
+		}
+		s_Data.RequestedSize = requestedSize;
+
+		// Over budget: drop a mip at a time from the textures seen least recently, largest first
+		if (requestedSize > s_Data.Budget)
+		{
+			std::sort(textures.begin(), textures.end(), [](const auto& a, const auto& b)
+			{
+				if (a.second->LastRequestFrame != b.second->LastRequestFrame)
+					return a.second->LastRequestFrame < b.second->LastRequestFrame;
+				return a.second->TailSizes[a.second->TargetMip] > b.second->TailSizes[b.second->TargetMip];
+			});
+
+			bool dropped = true;
+			while (requestedSize > s_Data.Budget && dropped)
+			{
+				dropped = false;
+				for (auto& [id, entry] : textures)
+				{
+					if (entry->TargetMip >= entry->MinResidentMip)
+						continue;
+
+					requestedSize -= entry->TailSizes[entry->TargetMip] - entry->TailSizes[entry->TargetMip + 1];
+					entry->TargetMip++;
+					dropped = true;
+					if (requestedSize <= s_Data.Budget)
+						break;
+				}
+			}
+		}
+
+		for (auto& [id, entry] : textures)
+		{
+			if (entry->Pending)
+				continue;
+
+			uint32_t residentMip = entry->Texture->GetFirstResidentMip();
+			if (entry->TargetMip > residentMip)
+			{
+				TextureData empty;
+				entry->Texture->SetResidentMips(entry->TargetMip, empty);
+			}
+			else if (entry->TargetMip < residentMip && !entry->Failed && s_Data.PendingCount < s_MaxPendingCount)
+			{
+				StreamIn(id, *entry, entry->TargetMip);
+			}
+		}
+	}
+
+	TextureStreamingStats TextureStreamer::GetStats()
+	{
+		TextureStreamingStats stats;
+		stats.TextureCount = (uint32_t)s_Data.Textures.size();
+		stats.PendingCount = s_Data.PendingCount;
+		stats.RequestedSize = s_Data.RequestedSize;
+		stats.Budget = s_Data.Budget;
+		for (auto& [id, entry] : s_Data.Textures)
+			stats.ResidentSize += GetResidentSize(entry);
+		return stats;
+	}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Hazel/Renderer/Texture.h"
+
+namespace Hazel {
+
+	struct TextureStreamingStats
+	{
+		uint32_t TextureCount = 0;
+		uint32_t PendingCount = 0;   // Stream-ins waiting on a loader thread
+		uint64_t ResidentSize = 0;   // VRAM used by the streamed textures' resident mips
+		uint64_t RequestedSize = 0;  // VRAM the current demand would take, before applying the budget
+		uint64_t Budget = 0;
+	};
+
+	// Cooked textures load with only their small mips resident. Larger mips are read in on the
+	// asset loader threads once something on screen needs them, and dropped again when nothing
+	// has for a while or the VRAM budget is exceeded. Demand comes from SceneRenderer, which
+	// reports the projected texel density of every submesh it draws.
+	// Everything except GetInitialMip is main thread only.
+	class TextureStreamer
+	{
+	public:
+		static void Shutdown();
+
+		// When disabled, new textures load fully and streamed ones get all their mips back
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		// Mips up to this size (in texels, on the longest side) are always resident
+		static void SetMinResidentSize(uint32_t size);
+		static uint32_t GetMinResidentSize();
+
+		static void SetBudget(uint64_t bytes);
+		static uint64_t GetBudget();
+
+		// First mip to load up front for a cooked texture; safe to call from any thread
+		static uint32_t GetInitialMip(uint32_t width, uint32_t height, uint32_t mipCount);
+
+		// Called by textures with more mips than the minimum resident size
+		static void Register(Texture2D* texture);
+		static void Unregister(Texture2D* texture);
+
+		// texelsPerPixel is how many texels of a 1x1 texture would cover one screen pixel
+		// (UV density over projected size); textures not being streamed are ignored
+		static void RequestTexture(const Texture* texture, float texelsPerPixel);
+
+		// Called once per frame by the application: applies the budget to this frame's demand,
+		// starts stream-ins and drops mips nothing needs
+		static void Update();
+
+		static TextureStreamingStats GetStats();
+	};
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "RendererAPI.h"
+
+namespace Hazel {
+
+	struct TextureData;
+
+	// A range of the staging buffer holding one texture's pixels
+	struct StagingAllocation
+	{
+		uint8_t* Data = nullptr; // Mapped memory; write only, reading it back is very slow
+		uint64_t Offset = 0;     // Into the staging buffer, for uploads from it
+		uint64_t Size = 0;
+
+		operator bool() const { return Data != nullptr; }
+	};
+
+	// A persistently mapped ring buffer that loader threads copy decoded pixels into, so textures
+	// are uploaded from it on the render thread (through GL_PIXEL_UNPACK_BUFFER) instead of the
+	// driver copying client memory on the main thread. Ranges are reused once the GPU has
+	// finished the copies out of them.
+	class TextureUploader
+	{
+	public:
+		static const uint64_t DefaultStagingSize = 128ull * 1024 * 1024;
+
+		// Called by the renderer; the buffer is created on the render thread
+		static void Init(uint64_t size = DefaultStagingSize);
+		static void Shutdown();
+
+		// Any thread. Moves data's pixels into the staging buffer, freeing the decoded copy; data.Data
+		// then points into write only mapped memory. Returns false and leaves data alone if they
+		// don't fit, in which case the texture is uploaded from client memory as before.
+		static bool Stage(TextureData& data);
+
+		// Render thread. Retire follows the upload commands reading from the allocation.
+		static RendererID GetRendererID();
+		static void Retire(const StagingAllocation& allocation);
+		// Any thread. Drops an allocation that will never be uploaded; empty ones are ignored.
+		// Ranges are freed in order, so one that is never retired or discarded stalls the buffer.
+		static void Discard(const StagingAllocation& allocation);
+
+		// Render thread, once per frame: frees ranges whose uploads have completed
+		static void Update();
+
+		static uint64_t GetSize();
+		static uint64_t GetUsedSize();
+	};
+
+}
@@ -10,6 +10,7 @@
 
 #include "Hazel/Renderer/Renderer2D.h"
 #include "Hazel/Physics/Physics.h"
+#include "Hazel/Core/JobSystem.h"
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
@@ -19,6 +20,8 @@
 // Box2D
 #include <box2d/box2d.h>
 
+#include <unordered_set>
+
 // TEMP
 #include "Hazel/Core/Input.h"
 
@@ -33,6 +36,17 @@ namespace Hazel {
 		UUID SceneID;
 	};
 
+	// Tracks an entity's leaf in the scene's spatial tree, along with the inputs its
+	// world bounds were last computed from so unchanged entities can be skipped
+	struct SpatialProxyComponent
+	{
+		int32_t ProxyID = DynamicAABBTree::NullNode;
+		AABB WorldBounds;
+
+		const Mesh* SourceMesh = nullptr;
+		glm::vec3 Translation, Rotation, Scale;
+	};
+
 	// TODO: MOVE TO PHYSICS FILE!
 	class ContactListener : public b2ContactListener
 	{
@@ -128,6 +142,7 @@ namespace Hazel {
 	{
 		m_Registry.on_construct<ScriptComponent>().connect<&OnScriptComponentConstruct>();
 		m_Registry.on_destroy<ScriptComponent>().connect<&OnScriptComponentDestroy>();
+		m_Registry.on_destroy<SpatialProxyComponent>().connect<&Scene::OnSpatialProxyDestroy>(*this);
 
 		m_SceneEntity = m_Registry.create();
 		m_Registry.emplace<SceneComponent>(m_SceneEntity, m_SceneID);
@@ -138,6 +153,8 @@ namespace Hazel {
 
 		s_ActiveScenes[m_SceneID] = this;
 
+		RegisterSystems();
+
 		if (!isEditorScene)
 		{
 			Physics::CreateScene();
@@ -162,48 +179,68 @@ namespace Hazel {
 		m_SkyboxMaterial->SetFlag(MaterialFlag::DepthTest, false);
 	}
 
-	// Merge OnUpdate/Render into one function?
-	void Scene::OnUpdate(Timestep ts)
+	// Everything scripts can reach through their internal calls: the components they can get or add,
+	// meshes and materials, the spatial tree through SceneQuery and PhysX through Physics. Systems that
+	// run scripts, directly or from contact callbacks, declare this rather than being exclusive.
+	static SystemAccess ScriptAccess()
 	{
-		// Box2D physics
-		auto sceneView = m_Registry.view<Box2DWorldComponent>();
-		auto& box2DWorld = m_Registry.get<Box2DWorldComponent>(sceneView.front()).World;
-		int32_t velocityIterations = 6;
-		int32_t positionIterations = 2;
-		box2DWorld->Step(ts, velocityIterations, positionIterations);
+		return SystemAccess()
+			.Reads<IDComponent, SpatialProxyComponent>()
+			.Writes<TagComponent, TransformComponent, MeshComponent, ScriptComponent, CameraComponent, SpriteRendererComponent>()
+			.Writes<RigidBody2DComponent, BoxCollider2DComponent, RigidBodyComponent, BoxColliderComponent, SphereColliderComponent>()
+			.ReadsResource<DynamicAABBTree>()
+			.WritesResource<Mesh, ScriptEngine, Physics>();
+	}
 
-		{
-			auto view = m_Registry.view<RigidBody2DComponent>();
-			for (auto entity : view)
-			{
-				Entity e = { entity, this };
-				auto& rb2d = e.GetComponent<RigidBody2DComponent>();
-				b2Body* body = static_cast<b2Body*>(rb2d.RuntimeBody);
-
-				auto& position = body->GetPosition();
-				auto& transform = e.GetComponent<TransformComponent>();
-				transform.Translation.x = position.x;
-				transform.Translation.y = position.y;
-				transform.Rotation.z = body->GetAngle();
-			}
-		}
+	void Scene::RegisterSystems()
+	{
+		// Groups are created on first use, which changes the registry, so make them here
+		// rather than inside systems that may run at the same time
+		m_Registry.group<MeshComponent>(entt::get<TransformComponent>);
+		m_Registry.group<DirectionalLightComponent>(entt::get<TransformComponent>);
+		m_Registry.group<SkyLightComponent>(entt::get<TransformComponent>);
+
+		auto spatialTreeAccess = SystemAccess().Reads<MeshComponent, TransformComponent>().Writes<SpatialProxyComponent>().WritesResource<DynamicAABBTree>();
+
+		// Box2D and PhysX call into scripts from their contact callbacks
+		m_UpdateSystems.AddSystem("Box2D", ScriptAccess().Writes<Box2DWorldComponent>(), SystemThread::Main, [this](Timestep ts) { UpdateBox2D(ts); });
+		m_UpdateSystems.AddSystem("Spatial Tree", spatialTreeAccess, SystemThread::Any, [this](Timestep) { UpdateSpatialTree(); });
+		m_UpdateSystems.AddSystem("Scripts", ScriptAccess(), SystemThread::Main, [this](Timestep ts) { UpdateScripts(ts); });
+		m_UpdateSystems.AddSystem("PhysX", ScriptAccess(), SystemThread::Main, [](Timestep ts) { Physics::Simulate(ts); });
+
+		// Animation state lives in the Mesh objects rather than in their components. Bounds
+		// come from the static submesh data, so the spatial tree doesn't wait for animation.
+		auto animationAccess = SystemAccess().Reads<MeshComponent>().WritesResource<Mesh>();
+		auto submissionAccess = SystemAccess().Reads<MeshComponent, TransformComponent>().ReadsResource<Mesh, LightEnvironment, Environment>();
+
+		m_RuntimeRenderSystems.AddSystem("Animation", animationAccess, SystemThread::Any, [this](Timestep ts) { UpdateAnimation(ts); });
+		m_RuntimeRenderSystems.AddSystem("Mesh Submission", submissionAccess, SystemThread::Main, [this](Timestep) { SubmitMeshes(false); });
+
+		m_EditorRenderSystems.AddSystem("Spatial Tree", spatialTreeAccess, SystemThread::Any, [this](Timestep) { UpdateSpatialTree(); });
+		m_EditorRenderSystems.AddSystem("Directional Lights",
+			SystemAccess().Reads<DirectionalLightComponent, TransformComponent>().WritesResource<LightEnvironment>(),
+			SystemThread::Any, [this](Timestep) { UpdateLightEnvironment(); });
+		// Copies the environment's ref counted textures
+		m_EditorRenderSystems.AddSystem("Sky Light",
+			SystemAccess().Reads<SkyLightComponent, TransformComponent>().WritesResource<Environment>(),
+			SystemThread::Main, [this](Timestep) { UpdateSkyLight(); });
+		m_EditorRenderSystems.AddSystem("Animation", animationAccess, SystemThread::Any, [this](Timestep ts) { UpdateAnimation(ts); });
+		m_EditorRenderSystems.AddSystem("Mesh Submission",
+			submissionAccess.Reads<BoxColliderComponent, SphereColliderComponent, CapsuleColliderComponent, MeshColliderComponent>(),
+			SystemThread::Main, [this](Timestep) { SubmitMeshes(true); });
+	}
 
-		// Update all entities
-		{
-			auto view = m_Registry.view<ScriptComponent>();
-			for (auto entity : view)
-			{
-				Entity e = { entity, this };
-				if (ScriptEngine::ModuleExists(e.GetComponent<ScriptComponent>().ModuleName))
-					ScriptEngine::OnUpdateEntity(e, ts);
-			}
-		}
+	void Scene::OnUpdate(Timestep ts)
+	{
+		HZ_PROFILE_FUNCTION();
 
-		Physics::Simulate(ts);
+		m_UpdateSystems.Run(m_Registry, ts);
 	}
 
 	void Scene::OnRenderRuntime(Timestep ts)
 	{
+		HZ_PROFILE_FUNCTION();
+
 		/////////////////////////////////////////////////////////////////////
 		// RENDER 3D SCENE
 		/////////////////////////////////////////////////////////////////////
@@ -218,20 +255,9 @@ namespace Hazel {
 
 		m_SkyboxMaterial->Set("u_TextureLod", m_SkyboxLod);
 
-		auto group = m_Registry.group<MeshComponent>(entt::get<TransformComponent>);
-		SceneRenderer::BeginScene(this, { camera, cameraViewMatrix });
-		for (auto entity : group)
-		{
-			auto [transformComponent, meshComponent] = group.get<TransformComponent, MeshComponent>(entity);
-			if (meshComponent.Mesh)
-			{
-				meshComponent.Mesh->OnUpdate(ts);
-
-				// TODO: Should we render (logically)
-				SceneRenderer::SubmitMesh(meshComponent, transformComponent.GetTransform(), nullptr);
-			}
-		}
-		SceneRenderer::EndScene();
+		m_RenderCamera = camera;
+		m_RenderViewMatrix = cameraViewMatrix;
+		m_RuntimeRenderSystems.Run(m_Registry, ts);
 		/////////////////////////////////////////////////////////////////////
 
 #if 0
@@ -255,128 +281,211 @@ namespace Hazel {
 
 	void Scene::OnRenderEditor(Timestep ts, const EditorCamera& editorCamera)
 	{
+		HZ_PROFILE_FUNCTION();
+
 		/////////////////////////////////////////////////////////////////////
 		// RENDER 3D SCENE
 		/////////////////////////////////////////////////////////////////////
+		m_SkyboxMaterial->Set("u_TextureLod", m_SkyboxLod);
+
+		m_RenderCamera = editorCamera;
+		m_RenderViewMatrix = editorCamera.GetViewMatrix();
+		m_EditorRenderSystems.Run(m_Registry, ts);
+		/////////////////////////////////////////////////////////////////////
 
+#if 0
+		// Render all sprites
+		Renderer2D::BeginScene(*camera);
 		{
-			m_LightEnvironment = LightEnvironment();
-			auto lights = m_Registry.group<DirectionalLightComponent>(entt::get<TransformComponent>);
-			uint32_t directionalLightIndex = 0;
-			for (auto entity : lights)
+			auto group = m_Registry.group<TransformComponent>(entt::get<SpriteRenderer>);
+			for (auto entity : group)
 			{
-				auto [transformComponent, lightComponent] = lights.get<TransformComponent, DirectionalLightComponent>(entity);
-				glm::vec3 direction = -glm::normalize(glm::mat3(transformComponent.GetTransform()) * glm::vec3(1.0f));
-				m_LightEnvironment.DirectionalLights[directionalLightIndex++] =
-				{
-					direction,
-					lightComponent.Radiance,
-					lightComponent.Intensity,
-					lightComponent.CastShadows
-				};
+				auto [transformComponent, spriteRendererComponent] = group.get<TransformComponent, SpriteRenderer>(entity);
+				if (spriteRendererComponent.Texture)
+					Renderer2D::DrawQuad(transformComponent.Transform, spriteRendererComponent.Texture, spriteRendererComponent.TilingFactor);
+				else
+					Renderer2D::DrawQuad(transformComponent.Transform, spriteRendererComponent.Color);
 			}
 		}
 
+		Renderer2D::EndScene();
+#endif
+	}
+
+	void Scene::UpdateBox2D(Timestep ts)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		auto sceneView = m_Registry.view<Box2DWorldComponent>();
+		auto& box2DWorld = m_Registry.get<Box2DWorldComponent>(sceneView.front()).World;
+		int32_t velocityIterations = 6;
+		int32_t positionIterations = 2;
+		box2DWorld->Step(ts, velocityIterations, positionIterations);
+
+		auto view = m_Registry.view<RigidBody2DComponent>();
+		for (auto entity : view)
 		{
-			m_Environment = Environment();
-			auto lights = m_Registry.group<SkyLightComponent>(entt::get<TransformComponent>);
-			for (auto entity : lights)
+			Entity e = { entity, this };
+			auto& rb2d = e.GetComponent<RigidBody2DComponent>();
+			b2Body* body = static_cast<b2Body*>(rb2d.RuntimeBody);
+
+			auto& position = body->GetPosition();
+			auto& transform = e.GetComponent<TransformComponent>();
+			transform.Translation.x = position.x;
+			transform.Translation.y = position.y;
+			transform.Rotation.z = body->GetAngle();
+		}
+	}
+
+	void Scene::UpdateScripts(Timestep ts)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		auto view = m_Registry.view<ScriptComponent>();
+		for (auto entity : view)
+		{
+			Entity e = { entity, this };
+			if (ScriptEngine::ModuleExists(e.GetComponent<ScriptComponent>().ModuleName))
+				ScriptEngine::OnUpdateEntity(e, ts);
+		}
+	}
+
+	void Scene::UpdateLightEnvironment()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		m_LightEnvironment = LightEnvironment();
+		auto lights = m_Registry.group<DirectionalLightComponent>(entt::get<TransformComponent>);
+		uint32_t directionalLightIndex = 0;
+		for (auto entity : lights)
+		{
+			auto [transformComponent, lightComponent] = lights.get<TransformComponent, DirectionalLightComponent>(entity);
+			glm::vec3 direction = -glm::normalize(glm::mat3(transformComponent.GetTransform()) * glm::vec3(1.0f));
+			m_LightEnvironment.DirectionalLights[directionalLightIndex++] =
 			{
-				auto [transformComponent, skyLightComponent] = lights.get<TransformComponent, SkyLightComponent>(entity);
-				m_Environment = skyLightComponent.SceneEnvironment;
-				m_EnvironmentIntensity = skyLightComponent.Intensity;
-				SetSkybox(m_Environment.RadianceMap);
-			}
+				direction,
+				lightComponent.Radiance,
+				lightComponent.Intensity,
+				lightComponent.CastShadows
+			};
 		}
+	}
 
-		m_SkyboxMaterial->Set("u_TextureLod", m_SkyboxLod);
+	void Scene::UpdateSkyLight()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		m_Environment = Environment();
+		auto lights = m_Registry.group<SkyLightComponent>(entt::get<TransformComponent>);
+		for (auto entity : lights)
+		{
+			auto [transformComponent, skyLightComponent] = lights.get<TransformComponent, SkyLightComponent>(entity);
+			m_Environment = skyLightComponent.SceneEnvironment;
+			m_EnvironmentIntensity = skyLightComponent.Intensity;
+			SetSkybox(m_Environment.RadianceMap);
+		}
+	}
+
+	// Meshes from the asset manager are per-entity instances, each with its own animation state, so
+	// they're advanced in parallel. Code can still give one mesh to several entities, so each mesh
+	// is collected once and advanced once a frame.
+	void Scene::UpdateAnimation(Timestep ts)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		std::vector<Mesh*> meshes;
+		std::unordered_set<Mesh*> collected;
+		auto group = m_Registry.group<MeshComponent>(entt::get<TransformComponent>);
+		for (auto entity : group)
+		{
+			Mesh* mesh = group.get<MeshComponent>(entity).Mesh.Raw();
+			if (mesh && mesh->IsAnimated() && collected.insert(mesh).second)
+				meshes.push_back(mesh);
+		}
+
+		const uint32_t meshesPerJob = 8;
+		JobSystem::ParallelFor((uint32_t)meshes.size(), meshesPerJob, [&](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; i++)
+				meshes[i]->OnUpdate(ts);
+		});
+	}
+
+	void Scene::SubmitMeshes(bool editor)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (editor)
+			SceneRenderer::BeginScene(this, { m_RenderCamera, m_RenderViewMatrix, 0.1f, 1000.0f, 45.0f }); // TODO: real values
+		else
+			SceneRenderer::BeginScene(this, { m_RenderCamera, m_RenderViewMatrix });
 
 		auto group = m_Registry.group<MeshComponent>(entt::get<TransformComponent>);
-		SceneRenderer::BeginScene(this, { editorCamera, editorCamera.GetViewMatrix(), 0.1f, 1000.0f, 45.0f }); // TODO: real values
 		for (auto entity : group)
 		{
 			auto& [meshComponent, transformComponent] = group.get<MeshComponent, TransformComponent>(entity);
 			if (meshComponent.Mesh)
 			{
-				meshComponent.Mesh->OnUpdate(ts);
-
 				// TODO: Should we render (logically)
-				SceneRenderer::SubmitMesh(meshComponent, transformComponent.GetTransform());
+				SceneRenderer::SubmitMesh(meshComponent.Mesh, transformComponent.GetTransform());
 
 				/*if (m_SelectedEntity == entity)
 					SceneRenderer::SubmitSelectedMesh(meshComponent, transformComponent);*/
 			}
 		}
 
+		if (editor)
 		{
-			auto view = m_Registry.view<BoxColliderComponent>();
-			for (auto entity : view)
 			{
-				Entity e = { entity, this };
-				auto& collider = e.GetComponent<BoxColliderComponent>();
+				auto view = m_Registry.view<BoxColliderComponent>();
+				for (auto entity : view)
+				{
+					Entity e = { entity, this };
+					auto& collider = e.GetComponent<BoxColliderComponent>();
 
-				if (m_SelectedEntity == entity)
-					SceneRenderer::SubmitColliderMesh(collider, e.GetComponent<TransformComponent>().GetTransform());
+					if (m_SelectedEntity == entity)
+						SceneRenderer::SubmitColliderMesh(collider, e.GetComponent<TransformComponent>().GetTransform());
+				}
 			}
-		}
 
-		{
-			auto view = m_Registry.view<SphereColliderComponent>();
-			for (auto entity : view)
 			{
-				Entity e = { entity, this };
-				auto& collider = e.GetComponent<SphereColliderComponent>();
+				auto view = m_Registry.view<SphereColliderComponent>();
+				for (auto entity : view)
+				{
+					Entity e = { entity, this };
+					auto& collider = e.GetComponent<SphereColliderComponent>();
 
-				if (m_SelectedEntity == entity)
-					SceneRenderer::SubmitColliderMesh(collider, e.GetComponent<TransformComponent>().GetTransform());
+					if (m_SelectedEntity == entity)
+						SceneRenderer::SubmitColliderMesh(collider, e.GetComponent<TransformComponent>().GetTransform());
+				}
 			}
-		}
 
-		{
-			auto view = m_Registry.view<CapsuleColliderComponent>();
-			for (auto entity : view)
 			{
-				Entity e = { entity, this };
-				auto& collider = e.GetComponent<CapsuleColliderComponent>();
+				auto view = m_Registry.view<CapsuleColliderComponent>();
+				for (auto entity : view)
+				{
+					Entity e = { entity, this };
+					auto& collider = e.GetComponent<CapsuleColliderComponent>();
 
-				if (m_SelectedEntity == entity)
-					SceneRenderer::SubmitColliderMesh(collider, e.GetComponent<TransformComponent>().GetTransform());
+					if (m_SelectedEntity == entity)
+						SceneRenderer::SubmitColliderMesh(collider, e.GetComponent<TransformComponent>().GetTransform());
+				}
 			}
-		}
 
-		{
-			auto view = m_Registry.view<MeshColliderComponent>();
-			for (auto entity : view)
 			{
-				Entity e = { entity, this };
-				auto& collider = e.GetComponent<MeshColliderComponent>();
+				auto view = m_Registry.view<MeshColliderComponent>();
+				for (auto entity : view)
+				{
+					Entity e = { entity, this };
+					auto& collider = e.GetComponent<MeshColliderComponent>();
 
-				if (m_SelectedEntity == entity)
-					SceneRenderer::SubmitColliderMesh(collider, e.GetComponent<TransformComponent>().GetTransform());
+					if (m_SelectedEntity == entity)
+						SceneRenderer::SubmitColliderMesh(collider, e.GetComponent<TransformComponent>().GetTransform());
+				}
 			}
 		}
 
-
 		SceneRenderer::EndScene();
-		/////////////////////////////////////////////////////////////////////
-
-#if 0
-		// Render all sprites
-		Renderer2D::BeginScene(*camera);
-		{
-			auto group = m_Registry.group<TransformComponent>(entt::get<SpriteRenderer>);
-			for (auto entity : group)
-			{
-				auto [transformComponent, spriteRendererComponent] = group.get<TransformComponent, SpriteRenderer>(entity);
-				if (spriteRendererComponent.Texture)
-					Renderer2D::DrawQuad(transformComponent.Transform, spriteRendererComponent.Texture, spriteRendererComponent.TilingFactor);
-				else
-					Renderer2D::DrawQuad(transformComponent.Transform, spriteRendererComponent.Color);
-			}
-		}
-
-		Renderer2D::EndScene();
-#endif
 	}
 
 	void Scene::OnEvent(Event& e)
@@ -385,7 +494,10 @@ namespace Hazel {
 
 	void Scene::OnRuntimeStart()
 	{
+		HZ_PROFILE_FUNCTION();
+
 		ScriptEngine::SetSceneContext(this);
+		UpdateSpatialTree();
 
 		{
 			auto view = m_Registry.view<ScriptComponent>();
@@ -692,9 +804,149 @@ namespace Hazel {
 		m_Registry.get<Box2DWorldComponent>(m_SceneEntity).World->SetGravity({ 0.0f, gravity });
 	}
 
-	Environment Environment::Load(const std::string& filepath)
+	static AABB CalculateWorldBounds(const Mesh& mesh, const glm::mat4& transform)
+	{
+		const auto& submeshes = mesh.GetSubmeshes();
+		if (submeshes.empty())
+			return AABB(glm::vec3(transform[3]), glm::vec3(transform[3]));
+
+		AABB bounds = submeshes[0].BoundingBox.Transform(transform * submeshes[0].Transform);
+		for (size_t i = 1; i < submeshes.size(); i++)
+			bounds = AABB::Union(bounds, submeshes[i].BoundingBox.Transform(transform * submeshes[i].Transform));
+
+		return bounds;
+	}
+
+	void Scene::UpdateSpatialTree()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		std::vector<entt::entity> staleProxies;
+		{
+			auto view = m_Registry.view<SpatialProxyComponent>(entt::exclude<MeshComponent>);
+			for (auto entity : view)
+				staleProxies.push_back(entity);
+		}
+
+		auto group = m_Registry.group<MeshComponent>(entt::get<TransformComponent>);
+		for (auto entity : group)
+		{
+			auto& [meshComponent, transformComponent] = group.get<MeshComponent, TransformComponent>(entity);
+			SpatialProxyComponent* proxy = m_Registry.try_get<SpatialProxyComponent>(entity);
+			if (!meshComponent.Mesh)
+			{
+				if (proxy)
+					staleProxies.push_back(entity);
+				continue;
+			}
+
+			if (proxy && proxy->SourceMesh == meshComponent.Mesh.Raw()
+				&& proxy->Translation == transformComponent.Translation
+				&& proxy->Rotation == transformComponent.Rotation
+				&& proxy->Scale == transformComponent.Scale)
+				continue;
+
+			AABB bounds = CalculateWorldBounds(*meshComponent.Mesh, transformComponent.GetTransform());
+			if (!proxy)
+			{
+				proxy = &m_Registry.emplace<SpatialProxyComponent>(entity);
+				proxy->ProxyID = m_SpatialTree.CreateProxy(bounds, (uint32_t)entity);
+			}
+			else
+			{
+				m_SpatialTree.MoveProxy(proxy->ProxyID, bounds);
+			}
+
+			proxy->WorldBounds = bounds;
+			proxy->SourceMesh = meshComponent.Mesh.Raw();
+			proxy->Translation = transformComponent.Translation;
+			proxy->Rotation = transformComponent.Rotation;
+			proxy->Scale = transformComponent.Scale;
+		}
+
+		for (auto entity : staleProxies)
+			m_Registry.remove<SpatialProxyComponent>(entity);
+	}
+
+	void Scene::OnSpatialProxyDestroy(entt::registry& registry, entt::entity entity)
 	{
-		auto [radiance, irradiance] = SceneRenderer::CreateEnvironmentMap(filepath);
-		return { filepath, radiance, irradiance };
+		m_SpatialTree.DestroyProxy(registry.get<SpatialProxyComponent>(entity).ProxyID);
+	}
+
+	bool Scene::Raycast(const Ray& ray, SceneRaycastHit& outHit, float maxDistance) const
+	{
+		bool hit = false;
+		m_SpatialTree.Raycast(ray, maxDistance, [&](int32_t proxyID, float closest)
+		{
+			entt::entity entity = (entt::entity)m_SpatialTree.GetUserData(proxyID);
+			const MeshComponent* meshComponent = m_Registry.try_get<MeshComponent>(entity);
+			if (!meshComponent || !meshComponent->Mesh)
+				return closest;
+
+			MeshRaycastHit meshHit;
+			const auto& transformComponent = m_Registry.get<TransformComponent>(entity);
+			if (meshComponent->Mesh->Raycast(ray, transformComponent.GetTransform(), meshHit) && meshHit.Distance < closest)
+			{
+				outHit.Entity = entity;
+				outHit.Submesh = meshHit.Submesh;
+				outHit.Distance = meshHit.Distance;
+				hit = true;
+				return meshHit.Distance;
+			}
+
+			return closest;
+		});
+
+		return hit;
+	}
+
+	void Scene::QueryAABB(const AABB& aabb, std::vector<entt::entity>& outEntities) const
+	{
+		m_SpatialTree.QueryAABB(aabb, [&](int32_t proxyID)
+		{
+			entt::entity entity = (entt::entity)m_SpatialTree.GetUserData(proxyID);
+			if (m_Registry.get<SpatialProxyComponent>(entity).WorldBounds.Overlaps(aabb))
+				outEntities.push_back(entity);
+			return true;
+		});
+	}
+
+	void Scene::QuerySphere(const glm::vec3& center, float radius, std::vector<entt::entity>& outEntities) const
+	{
+		float radiusSquared = radius * radius;
+		auto nodeTest = [&](const AABB& bounds) { return bounds.DistanceSquared(center) <= radiusSquared; };
+		m_SpatialTree.Query(nodeTest, [&](int32_t proxyID)
+		{
+			entt::entity entity = (entt::entity)m_SpatialTree.GetUserData(proxyID);
+			if (nodeTest(m_Registry.get<SpatialProxyComponent>(entity).WorldBounds))
+				outEntities.push_back(entity);
+			return true;
+		});
+	}
+
+	void Scene::QueryFrustum(const Frustum& frustum, std::vector<entt::entity>& outEntities) const
+	{
+		auto nodeTest = [&](const AABB& bounds) { return frustum.Intersects(bounds); };
+		m_SpatialTree.Query(nodeTest, [&](int32_t proxyID)
+		{
+			entt::entity entity = (entt::entity)m_SpatialTree.GetUserData(proxyID);
+			if (nodeTest(m_Registry.get<SpatialProxyComponent>(entity).WorldBounds))
+				outEntities.push_back(entity);
+			return true;
+		});
+	}
+
+	void Scene::QueryNearest(const glm::vec3& point, uint32_t count, std::vector<entt::entity>& outEntities) const
+	{
+		std::vector<int32_t> proxies;
+		proxies.reserve(count);
+		m_SpatialTree.QueryNearest(point, count, [&](int32_t proxyID)
+		{
+			entt::entity entity = (entt::entity)m_SpatialTree.GetUserData(proxyID);
+			return m_Registry.get<SpatialProxyComponent>(entity).WorldBounds.DistanceSquared(point);
+		}, proxies);
+
+		for (int32_t proxyID : proxies)
+			outEntities.push_back((entt::entity)m_SpatialTree.GetUserData(proxyID));
 	}
 }
@@ -2,6 +2,9 @@
 
 #include "Hazel/Core/UUID.h"
 #include "Hazel/Core/Timestep.h"
+#include "Hazel/Core/HashMap.h"
+#include "Hazel/Core/Math/DynamicAABBTree.h"
+#include "Hazel/Core/Math/Frustum.h"
 
 #include "Hazel/Renderer/Camera.h"
 #include "Hazel/Renderer/Texture.h"
@@ -12,6 +15,7 @@
 #include "entt/entt.hpp"
 
 #include "SceneCamera.h"
+#include "SystemScheduler.h"
 #include "Hazel/Editor/EditorCamera.h"
 
 namespace Hazel {
@@ -39,8 +43,15 @@ namespace Hazel {
 		DirectionalLight DirectionalLights[4];
 	};
 
+	struct SceneRaycastHit
+	{
+		entt::entity Entity = entt::null;
+		uint32_t Submesh = 0;
+		float Distance = 0.0f;
+	};
+
 	class Entity;
-	using EntityMap = std::unordered_map<UUID, Entity>;
+	using EntityMap = HashMap<UUID, Entity>;
 
 	class Scene : public RefCounted
 	{
@@ -95,8 +106,28 @@ namespace Hazel {
 		float GetPhysics2DGravity() const;
 		void SetPhysics2DGravity(float gravity);
 
+		// Spatial queries over the world-space bounds of mesh entities. These don't need a physics
+		// scene, so they work in the editor too. Results reflect the last UpdateSpatialTree(),
+		// which runs every OnUpdate and OnRenderEditor.
+		void UpdateSpatialTree();
+		bool Raycast(const Ray& ray, SceneRaycastHit& outHit, float maxDistance = std::numeric_limits<float>::max()) const;
+		void QueryAABB(const AABB& aabb, std::vector<entt::entity>& outEntities) const;
+		void QuerySphere(const glm::vec3& center, float radius, std::vector<entt::entity>& outEntities) const;
+		void QueryFrustum(const Frustum& frustum, std::vector<entt::entity>& outEntities) const;
+		void QueryNearest(const glm::vec3& point, uint32_t count, std::vector<entt::entity>& outEntities) const;
+
 		// Editor-specific
 		void SetSelectedEntity(entt::entity entity) { m_SelectedEntity = entity; }
+	private:
+		void RegisterSystems();
+		void UpdateBox2D(Timestep ts);
+		void UpdateScripts(Timestep ts);
+		void UpdateLightEnvironment();
+		void UpdateSkyLight();
+		void UpdateAnimation(Timestep ts);
+		void SubmitMeshes(bool editor);
+
+		void OnSpatialProxyDestroy(entt::registry& registry, entt::entity entity);
 	private:
 		UUID m_SceneID;
 		entt::entity m_SceneEntity;
@@ -107,6 +138,17 @@ namespace Hazel {
 
 		EntityMap m_EntityIDMap;
 
+		DynamicAABBTree m_SpatialTree;
+
+		// The hand written loops of OnUpdate and the render functions, as systems
+		SystemScheduler m_UpdateSystems;
+		SystemScheduler m_RuntimeRenderSystems;
+		SystemScheduler m_EditorRenderSystems;
+
+		// Camera the render systems submit with, set before they run
+		Camera m_RenderCamera;
+		glm::mat4 m_RenderViewMatrix = glm::mat4(1.0f);
+
 		Light m_Light;
 		float m_LightMultiplier = 0.3f;
 
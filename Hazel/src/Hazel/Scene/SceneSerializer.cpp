@@ -7,6 +7,8 @@
 #include "Hazel/Physics/PhysicsLayer.h"
 #include "Hazel/Physics/PXPhysicsWrappers.h"
 #include "Hazel/Renderer/MeshFactory.h"
+#include "Hazel/Asset/AssetManager.h"
+#include "Hazel/FileSystem/FileSystem.h"
 
 #include "yaml-cpp/yaml.h"
 
@@ -254,6 +256,7 @@ namespace Hazel {
 
 			auto mesh = entity.GetComponent<MeshComponent>().Mesh;
 			out << YAML::Key << "AssetPath" << YAML::Value << mesh->GetFilePath();
+			out << YAML::Key << "Residency" << YAML::Value << (int)mesh->GetResidency();
 
 			out << YAML::EndMap; // MeshComponent
 		}
@@ -461,6 +464,12 @@ namespace Hazel {
 	}
 
 	void SceneSerializer::Serialize(const std::string& filepath)
+	{
+		std::ofstream fout(filepath);
+		Serialize(fout);
+	}
+
+	void SceneSerializer::Serialize(std::ostream& stream)
 	{
 		YAML::Emitter out;
 		out << YAML::BeginMap;
@@ -507,8 +516,7 @@ namespace Hazel {
 		out << YAML::EndSeq;
 		out << YAML::EndMap;
 
-		std::ofstream fout(filepath);
-		fout << out.c_str();
+		stream << out.c_str();
 	}
 
 	void SceneSerializer::SerializeRuntime(const std::string& filepath)
@@ -519,11 +527,16 @@ namespace Hazel {
 
 	bool SceneSerializer::Deserialize(const std::string& filepath)
 	{
-		std::ifstream stream(filepath);
-		std::stringstream strStream;
-		strStream << stream.rdbuf();
+		return Deserialize(YAML::Load(FileSystem::ReadTextFile(filepath)));
+	}
+
+	bool SceneSerializer::Deserialize(std::istream& in)
+	{
+		return Deserialize(YAML::Load(in));
+	}
 
-		YAML::Node data = YAML::Load(strStream.str());
+	bool SceneSerializer::Deserialize(const YAML::Node& data)
+	{
 		if (!data["Scene"])
 			return false;
 
@@ -650,9 +663,29 @@ namespace Hazel {
 				if (meshComponent)
 				{
 					std::string meshPath = meshComponent["AssetPath"].as<std::string>();
+					MeshResidency residency = meshComponent["Residency"] ? (MeshResidency)meshComponent["Residency"].as<int>() : MeshResidency::KeepAll;
 					// TEMP (because script creates mesh component...)
 					if (!deserializedEntity.HasComponent<MeshComponent>())
-						deserializedEntity.AddComponent<MeshComponent>(Ref<Mesh>::Create(meshPath));
+					{
+						// Render a placeholder until the mesh has finished loading in the background
+						Ref<Mesh> placeholder = AssetManager::CreatePlaceholderMesh(meshPath, residency);
+						deserializedEntity.AddComponent<MeshComponent>(placeholder);
+
+						AssetImportSettings settings;
+						settings.Residency = residency;
+						Ref<Scene> scene = m_Scene;
+						Entity target = deserializedEntity;
+						AssetManager::LoadAsync<Mesh>(meshPath, settings, [scene, target, placeholder](const Ref<Mesh>& mesh) mutable
+						{
+							// The entity may have been destroyed or given another mesh in the meantime
+							if (!mesh || !scene->m_Registry.valid(target.m_EntityHandle) || !target.HasComponent<MeshComponent>())
+								return;
+
+							auto& component = target.GetComponent<MeshComponent>();
+							if (component.Mesh.Raw() == placeholder.Raw())
+								component.Mesh = mesh;
+						});
+					}
 
 					HZ_CORE_INFO("  Mesh Asset Path: {0}", meshPath);
 				}
@@ -683,7 +716,21 @@ namespace Hazel {
 					auto& component = deserializedEntity.AddComponent<SkyLightComponent>();
 					std::string env = skyLightComponent["EnvironmentAssetPath"].as<std::string>();
 					if (!env.empty())
-						component.SceneEnvironment = Environment::Load(env);
+					{
+						// The sky stays empty until the environment is ready
+						Ref<Scene> scene = m_Scene;
+						Entity target = deserializedEntity;
+						AssetManager::LoadAsync<Environment>(env, {}, [scene, target](const Environment& environment) mutable
+						{
+							if (!scene->m_Registry.valid(target.m_EntityHandle) || !target.HasComponent<SkyLightComponent>())
+								return;
+
+							// Unless another environment was picked in the meantime
+							auto& component = target.GetComponent<SkyLightComponent>();
+							if (component.SceneEnvironment.FilePath.empty())
+								component.SceneEnvironment = environment;
+						});
+					}
 					component.Intensity = skyLightComponent["Intensity"].as<float>();
 					component.Angle = skyLightComponent["Angle"].as<float>();
 				}
@@ -783,7 +830,7 @@ namespace Hazel {
 				if (meshColliderComponent)
 				{
 					std::string meshPath = meshColliderComponent["AssetPath"].as<std::string>();
-					auto& component = deserializedEntity.AddComponent<MeshColliderComponent>(Ref<Mesh>::Create(meshPath));
+					auto& component = deserializedEntity.AddComponent<MeshColliderComponent>(AssetManager::LoadMesh(meshPath));
 					component.IsConvex = meshColliderComponent["IsConvex"] ? meshColliderComponent["IsConvex"].as<bool>() : false;
 					component.IsTrigger = meshColliderComponent["IsTrigger"] ? meshColliderComponent["IsTrigger"].as<bool>() : false;
 
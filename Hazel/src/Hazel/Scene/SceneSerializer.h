@@ -2,6 +2,12 @@
 
 #include "Scene.h"
 
+#include <iosfwd>
+
+namespace YAML {
+	class Node;
+}
+
 namespace Hazel {
 
 	class SceneSerializer
@@ -10,10 +16,16 @@ namespace Hazel {
 		SceneSerializer(const Ref<Scene>& scene);
 
 		void Serialize(const std::string& filepath);
+		// Writes the YAML a scene file holds
+		void Serialize(std::ostream& out);
 		void SerializeRuntime(const std::string& filepath);
 
 		bool Deserialize(const std::string& filepath);
+		// Reads scene file YAML, already in memory or from any stream
+		bool Deserialize(std::istream& in);
 		bool DeserializeRuntime(const std::string& filepath);
+	private:
+		bool Deserialize(const YAML::Node& data);
 	private:
 		Ref<Scene> m_Scene;
 	};
@@ -0,0 +1,117 @@
+#include "hzpch.h"
+#include "SystemScheduler.h"
+
+#include "Hazel/Core/JobSystem.h"
+
+namespace Hazel {
+
+	static bool Overlaps(const std::vector<entt::id_type>& a, const std::vector<entt::id_type>& b)
+	{
+		for (entt::id_type id : a)
+		{
+			if (std::find(b.begin(), b.end(), id) != b.end())
+				return true;
+		}
+		return false;
+	}
+
+	bool SystemAccess::ConflictsWith(const SystemAccess& other) const
+	{
+		if (m_Exclusive || other.m_Exclusive)
+			return true;
+
+		// Reading alongside reading is the only thing that's safe
+		return Overlaps(m_Writes, other.m_Writes) || Overlaps(m_Writes, other.m_Reads) || Overlaps(m_Reads, other.m_Writes);
+	}
+
+	void SystemScheduler::AddSystem(const std::string& name, SystemAccess access, SystemThread thread, SystemFunction function)
+	{
+		System& system = m_Systems.emplace_back();
+		system.Name = name;
+		system.Access = std::move(access);
+		system.Thread = thread;
+		system.Function = std::move(function);
+		m_GraphDirty = true;
+	}
+
+	void SystemScheduler::BuildGraph()
+	{
+		for (auto& system : m_Systems)
+		{
+			system.Dependents.clear();
+			system.DependencyCount = 0;
+		}
+
+		// Every conflicting pair is ordered as registered. Edges implied by others are kept, they
+		// only cost a decrement.
+		for (uint32_t i = 0; i < m_Systems.size(); i++)
+		{
+			for (uint32_t j = 0; j < i; j++)
+			{
+				if (m_Systems[j].Access.ConflictsWith(m_Systems[i].Access))
+				{
+					m_Systems[j].Dependents.push_back(i);
+					m_Systems[i].DependencyCount++;
+				}
+			}
+		}
+
+		uint32_t roots = 0;
+		for (auto& system : m_Systems)
+			roots += system.DependencyCount == 0 ? 1 : 0;
+		HZ_CORE_TRACE("SystemScheduler: {0} systems, {1} with no dependencies", m_Systems.size(), roots);
+
+		m_GraphDirty = false;
+	}
+
+	void SystemScheduler::Run(entt::registry& registry, Timestep ts)
+	{
+		if (m_Systems.empty())
+			return;
+
+		if (m_GraphDirty)
+			BuildGraph();
+
+		for (auto& system : m_Systems)
+		{
+			for (auto prepare : system.Access.m_PreparePools)
+				prepare(registry);
+		}
+
+		std::unique_ptr<std::atomic<uint32_t>[]> remaining(new std::atomic<uint32_t>[m_Systems.size()]);
+		for (uint32_t i = 0; i < m_Systems.size(); i++)
+			remaining[i].store(m_Systems[i].DependencyCount, std::memory_order_relaxed);
+
+		// A system submits its dependents before its own job finishes, so the counter only
+		// reaches zero once the last system is done
+		JobCounter counter;
+		std::function<void(uint32_t)> dispatch = [&](uint32_t index)
+		{
+			const System& system = m_Systems[index];
+			Job job = [&, index]()
+			{
+				const System& system = m_Systems[index];
+				system.Function(ts);
+				for (uint32_t dependent : system.Dependents)
+				{
+					if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+						dispatch(dependent);
+				}
+			};
+
+			if (system.Thread == SystemThread::Main)
+				JobSystem::SubmitMainThread(std::move(job), &counter);
+			else
+				JobSystem::Submit(std::move(job), &counter);
+		};
+
+		for (uint32_t i = 0; i < m_Systems.size(); i++)
+		{
+			if (m_Systems[i].DependencyCount == 0)
+				dispatch(i);
+		}
+
+		JobSystem::Wait(counter);
+	}
+
+}
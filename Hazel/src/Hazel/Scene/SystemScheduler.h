@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Hazel/Core/Timestep.h"
+
+#include "entt/entt.hpp"
+
+#include <functional>
+
+namespace Hazel {
+
+	using SystemFunction = std::function<void(Timestep)>;
+
+	// What a system touches, which is all the scheduler knows about it. Components name the
+	// registry's pools; resources are any other state systems share (scene members, engine
+	// services), named by a type. Anything a system touches but doesn't declare can race.
+	class SystemAccess
+	{
+	public:
+		template<typename... Components>
+		SystemAccess& Reads() { (AddComponent<Components>(m_Reads), ...); return *this; }
+		template<typename... Components>
+		SystemAccess& Writes() { (AddComponent<Components>(m_Writes), ...); return *this; }
+
+		template<typename... Resources>
+		SystemAccess& ReadsResource() { (m_Reads.push_back(entt::type_info<Resources>::id()), ...); return *this; }
+		template<typename... Resources>
+		SystemAccess& WritesResource() { (m_Writes.push_back(entt::type_info<Resources>::id()), ...); return *this; }
+
+		// For systems that can reach anything: ordered against every other system
+		SystemAccess& Exclusive() { m_Exclusive = true; return *this; }
+
+		bool ConflictsWith(const SystemAccess& other) const;
+	private:
+		template<typename Component>
+		void AddComponent(std::vector<entt::id_type>& ids)
+		{
+			ids.push_back(entt::type_info<Component>::id());
+			m_PreparePools.push_back([](entt::registry& registry) { registry.prepare<Component>(); });
+		}
+	private:
+		std::vector<entt::id_type> m_Reads, m_Writes;
+		// Creating a pool changes the registry, so it's done up front rather than by whichever system gets there first
+		std::vector<void(*)(entt::registry&)> m_PreparePools;
+		bool m_Exclusive = false;
+
+		friend class SystemScheduler;
+	};
+
+	enum class SystemThread
+	{
+		Any = 0,
+		Main // Creates GPU resources, or touches the renderer or the script engine
+	};
+
+	// Runs a fixed set of systems once per call. Two systems whose access conflicts run in the
+	// order they were added; the rest run side by side on the job system, main thread systems
+	// being picked up by the calling thread while it waits. Views and groups the systems use
+	// must already exist, as creating one changes the registry.
+	class SystemScheduler
+	{
+	public:
+		void AddSystem(const std::string& name, SystemAccess access, SystemThread thread, SystemFunction function);
+
+		// Must be called from the main thread
+		void Run(entt::registry& registry, Timestep ts);
+
+		uint32_t GetSystemCount() const { return (uint32_t)m_Systems.size(); }
+	private:
+		void BuildGraph();
+	private:
+		struct System
+		{
+			std::string Name;
+			SystemAccess Access;
+			SystemThread Thread;
+			SystemFunction Function;
+
+			// Later systems that have to wait for this one, and how many earlier ones this waits for
+			std::vector<uint32_t> Dependents;
+			uint32_t DependencyCount = 0;
+		};
+
+		std::vector<System> m_Systems;
+		bool m_GraphDirty = false;
+	};
+
+}
@@ -13,6 +13,7 @@
 #include "ScriptEngineRegistry.h"
 
 #include "Hazel/Scene/Scene.h"
+#include "Hazel/FileSystem/FileSystem.h"
 
 #include "imgui.h"
 
@@ -74,7 +75,8 @@ namespace Hazel {
 		return mono_gchandle_get_target(Handle);
 	}
 
-	static std::unordered_map<std::string, EntityScriptClass> s_EntityClassMap;
+	// Node allocated, as entity instances keep pointers to their class
+	static NodeHashMap<std::string, EntityScriptClass> s_EntityClassMap;
 
 	MonoAssembly* LoadAssemblyFromFile(const char* filepath)
 	{
@@ -83,44 +85,20 @@ namespace Hazel {
 			return NULL;
 		}
 
-		HANDLE file = CreateFileA(filepath, FILE_READ_ACCESS, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-		if (file == INVALID_HANDLE_VALUE)
+		FileData file = FileSystem::ReadFile(filepath);
+		if (!file)
 		{
 			return NULL;
 		}
 
-		DWORD file_size = GetFileSize(file, NULL);
-		if (file_size == INVALID_FILE_SIZE)
-		{
-			CloseHandle(file);
-			return NULL;
-		}
-
-		void* file_data = malloc(file_size);
-		if (file_data == NULL)
-		{
-			CloseHandle(file);
-			return NULL;
-		}
-
-		DWORD read = 0;
-		ReadFile(file, file_data, file_size, &read, NULL);
-		if (file_size != read)
-		{
-			free(file_data);
-			CloseHandle(file);
-			return NULL;
-		}
-
+		// need_copy = 1, so the image doesn't reference the file data after this returns
 		MonoImageOpenStatus status;
-		MonoImage* image = mono_image_open_from_data_full(reinterpret_cast<char*>(file_data), file_size, 1, &status, 0);
+		MonoImage* image = mono_image_open_from_data_full((char*)file.GetData(), (uint32_t)file.GetSize(), 1, &status, 0);
 		if (status != MONO_IMAGE_OK)
 		{
 			return NULL;
 		}
 		auto assemb = mono_assembly_load_from_full(image, filepath, &status, 0);
-		free(file_data);
-		CloseHandle(file);
 		mono_image_close(image);
 		return assemb;
 	}
@@ -242,6 +220,8 @@ namespace Hazel {
 
 	void ScriptEngine::LoadHazelRuntimeAssembly(const std::string& path)
 	{
+		HZ_PROFILE_FUNCTION();
+
 		MonoDomain* domain = nullptr;
 		bool cleanup = false;
 		if (s_MonoDomain)
@@ -271,6 +251,8 @@ namespace Hazel {
 
 	void ScriptEngine::ReloadAssembly(const std::string& path)
 	{
+		HZ_PROFILE_FUNCTION();
+
 		LoadHazelRuntimeAssembly(path);
 		if (s_EntityInstanceMap.size())
 		{
@@ -350,6 +332,8 @@ namespace Hazel {
 
 	void ScriptEngine::OnCreateEntity(Entity entity)
 	{
+		HZ_PROFILE_FUNCTION();
+
 		EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneUUID(), entity.GetUUID()).Instance;
 		if (entityInstance.ScriptClass->OnCreateMethod)
 			CallMethod(entityInstance.GetInstance(), entityInstance.ScriptClass->OnCreateMethod);
@@ -357,6 +341,8 @@ namespace Hazel {
 
 	void ScriptEngine::OnUpdateEntity(Entity entity, Timestep ts)
 	{
+		HZ_PROFILE_FUNCTION();
+
 		EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneUUID(), entity.GetUUID()).Instance;
 		if (entityInstance.ScriptClass->OnUpdateMethod)
 		{
@@ -367,6 +353,8 @@ namespace Hazel {
 
 	void ScriptEngine::OnPhysicsUpdateEntity(Entity entity, float fixedTimeStep)
 	{
+		HZ_PROFILE_FUNCTION();
+
 		EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneUUID(), entity.GetUUID()).Instance;
 		if (entityInstance.ScriptClass->OnPhysicsUpdateMethod)
 		{
@@ -650,6 +638,8 @@ namespace Hazel {
 
 	void ScriptEngine::InstantiateEntityClass(Entity entity)
 	{
+		HZ_PROFILE_FUNCTION();
+
 		Scene* scene = entity.m_Scene;
 		UUID id = entity.GetComponent<IDComponent>().ID;
 		auto& moduleName = entity.GetComponent<ScriptComponent>().ModuleName;
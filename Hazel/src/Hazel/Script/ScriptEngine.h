@@ -2,6 +2,7 @@
 
 #include "Hazel/Core/Base.h"
 #include "Hazel/Core/Timestep.h"
+#include "Hazel/Core/HashMap.h"
 
 #include <string>
 
@@ -99,7 +100,8 @@ namespace Hazel {
 		ScriptModuleFieldMap ModuleFieldMap;
 	};
 	
-	using EntityInstanceMap = std::unordered_map<UUID, std::unordered_map<UUID, EntityInstanceData>>;
+	// Entity instances are node allocated: public fields and script classes point into them
+	using EntityInstanceMap = HashMap<UUID, NodeHashMap<UUID, EntityInstanceData>>;
 
 	class ScriptEngine
 	{
@@ -58,6 +58,12 @@ namespace Hazel {
 		mono_add_internal_call("Hazel.Physics::OverlapCapsuleNonAlloc_Native", Hazel::Script::Hazel_Physics_OverlapCapsuleNonAlloc);
 		mono_add_internal_call("Hazel.Physics::OverlapSphereNonAlloc_Native", Hazel::Script::Hazel_Physics_OverlapSphereNonAlloc);
 
+		mono_add_internal_call("Hazel.SceneQuery::Raycast_Native", Hazel::Script::Hazel_SceneQuery_Raycast);
+		mono_add_internal_call("Hazel.SceneQuery::OverlapBox_Native", Hazel::Script::Hazel_SceneQuery_OverlapBox);
+		mono_add_internal_call("Hazel.SceneQuery::OverlapSphere_Native", Hazel::Script::Hazel_SceneQuery_OverlapSphere);
+		mono_add_internal_call("Hazel.SceneQuery::Frustum_Native", Hazel::Script::Hazel_SceneQuery_Frustum);
+		mono_add_internal_call("Hazel.SceneQuery::FindNearest_Native", Hazel::Script::Hazel_SceneQuery_FindNearest);
+
 		mono_add_internal_call("Hazel.Entity::CreateComponent_Native", Hazel::Script::Hazel_Entity_CreateComponent);
 		mono_add_internal_call("Hazel.Entity::HasComponent_Native", Hazel::Script::Hazel_Entity_HasComponent);
 		mono_add_internal_call("Hazel.Entity::FindEntityByTag_Native", Hazel::Script::Hazel_Entity_FindEntityByTag);
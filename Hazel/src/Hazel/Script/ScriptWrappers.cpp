@@ -244,6 +244,79 @@ namespace Hazel { namespace Script {
 
 	////////////////////////////////////////////////////////////////
 
+	////////////////////////////////////////////////////////////////
+	// Scene Queries ///////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////
+
+	static MonoArray* CreateEntityIDArray(Scene* scene, const std::vector<entt::entity>& entities)
+	{
+		MonoArray* result = mono_array_new(mono_domain_get(), mono_get_uint64_class(), entities.size());
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			Entity entity = { entities[i], scene };
+			mono_array_set(result, uint64_t, i, entity.GetUUID());
+		}
+		return result;
+	}
+
+	bool Hazel_SceneQuery_Raycast(glm::vec3* origin, glm::vec3* direction, float maxDistance, ScriptSceneRaycastHit* outHit)
+	{
+		Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
+		HZ_CORE_ASSERT(scene, "No active scene!");
+
+		SceneRaycastHit hit;
+		if (!scene->Raycast({ *origin, *direction }, hit, maxDistance))
+			return false;
+
+		Entity entity = { hit.Entity, scene.Raw() };
+		outHit->EntityID = entity.GetUUID();
+		outHit->Distance = hit.Distance;
+		return true;
+	}
+
+	MonoArray* Hazel_SceneQuery_OverlapBox(glm::vec3* origin, glm::vec3* halfSize)
+	{
+		Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
+		HZ_CORE_ASSERT(scene, "No active scene!");
+
+		std::vector<entt::entity> entities;
+		scene->QueryAABB({ *origin - *halfSize, *origin + *halfSize }, entities);
+		return CreateEntityIDArray(scene.Raw(), entities);
+	}
+
+	MonoArray* Hazel_SceneQuery_OverlapSphere(glm::vec3* origin, float radius)
+	{
+		Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
+		HZ_CORE_ASSERT(scene, "No active scene!");
+
+		std::vector<entt::entity> entities;
+		scene->QuerySphere(*origin, radius, entities);
+		return CreateEntityIDArray(scene.Raw(), entities);
+	}
+
+	MonoArray* Hazel_SceneQuery_Frustum(glm::mat4* viewProjection)
+	{
+		Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
+		HZ_CORE_ASSERT(scene, "No active scene!");
+
+		std::vector<entt::entity> entities;
+		scene->QueryFrustum(Frustum(*viewProjection), entities);
+		return CreateEntityIDArray(scene.Raw(), entities);
+	}
+
+	MonoArray* Hazel_SceneQuery_FindNearest(glm::vec3* point, int32_t count)
+	{
+		Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
+		HZ_CORE_ASSERT(scene, "No active scene!");
+
+		std::vector<entt::entity> entities;
+		if (count > 0)
+			scene->QueryNearest(*point, (uint32_t)count, entities);
+		return CreateEntityIDArray(scene.Raw(), entities);
+	}
+
+	////////////////////////////////////////////////////////////////
+
 	////////////////////////////////////////////////////////////////
 	// Entity //////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////
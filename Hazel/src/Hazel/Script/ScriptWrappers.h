@@ -40,6 +40,19 @@ namespace Hazel { namespace Script {
 	int32_t Hazel_Physics_OverlapCapsuleNonAlloc(glm::vec3* origin, float radius, float halfHeight, MonoArray* outColliders);
 	int32_t Hazel_Physics_OverlapSphereNonAlloc(glm::vec3* origin, float radius, MonoArray* outColliders);
 
+	// Scene queries
+	struct ScriptSceneRaycastHit
+	{
+		uint64_t EntityID;
+		float Distance;
+	};
+
+	bool Hazel_SceneQuery_Raycast(glm::vec3* origin, glm::vec3* direction, float maxDistance, ScriptSceneRaycastHit* outHit);
+	MonoArray* Hazel_SceneQuery_OverlapBox(glm::vec3* origin, glm::vec3* halfSize);
+	MonoArray* Hazel_SceneQuery_OverlapSphere(glm::vec3* origin, float radius);
+	MonoArray* Hazel_SceneQuery_Frustum(glm::mat4* viewProjection);
+	MonoArray* Hazel_SceneQuery_FindNearest(glm::vec3* point, int32_t count);
+
 	// Entity
 	void Hazel_Entity_CreateComponent(uint64_t entityID, void* type);
 	bool Hazel_Entity_HasComponent(uint64_t entityID, void* type);
@@ -16,6 +16,7 @@
 
 #include <Hazel/Core/Base.h>
 #include <Hazel/Core/Log.h>
+#include <Hazel/Core/Profiler.h>
 #include <Hazel/Core/Events/Event.h>
 
 // Math
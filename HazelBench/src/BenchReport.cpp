@@ -0,0 +1,272 @@
+#include "BenchReport.h"
+
+#include "yaml-cpp/yaml.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace Hazel {
+
+	// Nearest rank, so every percentile is a frame that actually happened
+	static float Percentile(const std::vector<float>& sorted, float percentile)
+	{
+		size_t rank = (size_t)std::ceil(percentile / 100.0f * (float)sorted.size());
+		return sorted[std::min(std::max(rank, (size_t)1), sorted.size()) - 1];
+	}
+
+	BenchStats BenchStats::Compute(std::vector<float> samples)
+	{
+		BenchStats stats;
+		if (samples.empty())
+			return stats;
+
+		std::sort(samples.begin(), samples.end());
+
+		double total = 0.0;
+		for (float sample : samples)
+			total += sample;
+
+		stats.Mean = (float)(total / (double)samples.size());
+		stats.P50 = Percentile(samples, 50.0f);
+		stats.P95 = Percentile(samples, 95.0f);
+		stats.P99 = Percentile(samples, 99.0f);
+		stats.Max = samples.back();
+		return stats;
+	}
+
+	static std::string EscapeJSON(const std::string& string)
+	{
+		std::string result;
+		result.reserve(string.size());
+		for (char c : string)
+		{
+			if (c == '"' || c == '\\')
+				result += '\\';
+			result += c;
+		}
+		return result;
+	}
+
+	static void WriteStats(FILE* file, const BenchStats& stats)
+	{
+		fprintf(file, "{ \"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f }", stats.Mean, stats.P50, stats.P95, stats.P99, stats.Max);
+	}
+
+	static void WriteStatsList(FILE* file, const char* name, const BenchStatsList& list)
+	{
+		fprintf(file, "      \"%s\": {", name);
+		for (size_t i = 0; i < list.size(); i++)
+		{
+			fprintf(file, "%s\n        \"%s\": ", i ? "," : "", EscapeJSON(list[i].first).c_str());
+			WriteStats(file, list[i].second);
+		}
+		fprintf(file, list.empty() ? "},\n" : "\n      },\n");
+	}
+
+	bool WriteBenchReport(const std::string& filepath, const BenchReport& report)
+	{
+		FILE* file = fopen(filepath.c_str(), "w");
+		if (!file)
+		{
+			printf("Could not open '%s' for writing\n", filepath.c_str());
+			return false;
+		}
+
+		fprintf(file, "{\n");
+		fprintf(file, "  \"configuration\": \"%s\",\n", EscapeJSON(report.Configuration).c_str());
+		fprintf(file, "  \"frames\": %u,\n", report.FrameCount);
+		fprintf(file, "  \"warmupFrames\": %u,\n", report.WarmupFrameCount);
+		fprintf(file, "  \"scenes\": [");
+
+		for (size_t i = 0; i < report.Scenes.size(); i++)
+		{
+			const BenchSceneResult& scene = report.Scenes[i];
+			const RendererFrameStats& renderer = scene.Renderer;
+
+			fprintf(file, "%s\n    {\n", i ? "," : "");
+			fprintf(file, "      \"name\": \"%s\",\n", EscapeJSON(scene.Name).c_str());
+			fprintf(file, "      \"entities\": %u,\n", scene.EntityCount);
+			WriteStatsList(file, "timings", scene.Timings);
+			WriteStatsList(file, "systems", scene.Systems);
+			fprintf(file, "      \"allocations\": ");
+			WriteStats(file, scene.Allocations);
+			fprintf(file, ",\n");
+			fprintf(file, "      \"renderer\": { \"drawCalls\": %u, \"triangles\": %llu, \"meshes\": %u, \"pipelineBinds\": %u, \"materialBinds\": %u, "
+				"\"textureBinds\": %u, \"uniformUploads\": %u, \"commands\": %u, \"commandBytes\": %llu, \"bufferBytesUploaded\": %llu }\n",
+				renderer.DrawCalls, (unsigned long long)renderer.Triangles, renderer.Instances, renderer.PipelineBinds, renderer.MaterialBinds,
+				renderer.TextureBinds, renderer.UniformUploads, renderer.Commands, (unsigned long long)renderer.CommandBytes, (unsigned long long)renderer.BufferBytesUploaded);
+			fprintf(file, "    }");
+		}
+
+		fprintf(file, "\n  ]\n}\n");
+		fclose(file);
+		return true;
+	}
+
+	static BenchStats ReadStats(const YAML::Node& node)
+	{
+		BenchStats stats;
+		stats.Mean = node["mean"].as<float>(0.0f);
+		stats.P50 = node["p50"].as<float>(0.0f);
+		stats.P95 = node["p95"].as<float>(0.0f);
+		stats.P99 = node["p99"].as<float>(0.0f);
+		stats.Max = node["max"].as<float>(0.0f);
+		return stats;
+	}
+
+	static BenchStatsList ReadStatsList(const YAML::Node& node)
+	{
+		BenchStatsList list;
+		for (const auto& entry : node)
+			list.emplace_back(entry.first.as<std::string>(), ReadStats(entry.second));
+		return list;
+	}
+
+	static RendererFrameStats ReadRendererStats(const YAML::Node& node)
+	{
+		RendererFrameStats stats;
+		stats.DrawCalls = node["drawCalls"].as<uint32_t>(0);
+		stats.Triangles = node["triangles"].as<uint64_t>(0);
+		stats.Instances = node["meshes"].as<uint32_t>(0);
+		stats.PipelineBinds = node["pipelineBinds"].as<uint32_t>(0);
+		stats.MaterialBinds = node["materialBinds"].as<uint32_t>(0);
+		stats.TextureBinds = node["textureBinds"].as<uint32_t>(0);
+		stats.UniformUploads = node["uniformUploads"].as<uint32_t>(0);
+		stats.Commands = node["commands"].as<uint32_t>(0);
+		stats.CommandBytes = node["commandBytes"].as<uint64_t>(0);
+		stats.BufferBytesUploaded = node["bufferBytesUploaded"].as<uint64_t>(0);
+		return stats;
+	}
+
+	// JSON is a subset of YAML, so the reports are read back with yaml-cpp
+	bool LoadBenchReport(const std::string& filepath, BenchReport& outReport)
+	{
+		std::ifstream stream(filepath);
+		if (!stream)
+		{
+			printf("Could not open '%s'\n", filepath.c_str());
+			return false;
+		}
+
+		std::stringstream source;
+		source << stream.rdbuf();
+
+		YAML::Node data = YAML::Load(source.str());
+		if (!data["scenes"])
+		{
+			printf("'%s' is not a HazelBench report\n", filepath.c_str());
+			return false;
+		}
+
+		outReport.Configuration = data["configuration"].as<std::string>("");
+		outReport.FrameCount = data["frames"].as<uint32_t>(0);
+		outReport.WarmupFrameCount = data["warmupFrames"].as<uint32_t>(0);
+		for (const auto& sceneNode : data["scenes"])
+		{
+			BenchSceneResult& scene = outReport.Scenes.emplace_back();
+			scene.Name = sceneNode["name"].as<std::string>();
+			scene.EntityCount = sceneNode["entities"].as<uint32_t>(0);
+			scene.Timings = ReadStatsList(sceneNode["timings"]);
+			scene.Systems = ReadStatsList(sceneNode["systems"]);
+			scene.Allocations = ReadStats(sceneNode["allocations"]);
+			if (const YAML::Node renderer = sceneNode["renderer"])
+				scene.Renderer = ReadRendererStats(renderer);
+		}
+		return true;
+	}
+
+	static const BenchStats* FindStats(const BenchStatsList& list, const std::string& name)
+	{
+		for (const auto& [entryName, stats] : list)
+		{
+			if (entryName == name)
+				return &stats;
+		}
+		return nullptr;
+	}
+
+	// Differences below the noise floor are never reported as regressions, however large they are relatively.
+	// Anything above it that was zero in the baseline is, as no percentage threshold applies.
+	static bool CompareValue(const std::string& label, const char* statistic, double baseline, double current, float thresholdPercent, double noiseFloor, const char* unit)
+	{
+		bool regression = current - baseline > noiseFloor;
+		char change[16] = "     new";
+		if (baseline > 0.0)
+		{
+			double percent = (current - baseline) / baseline * 100.0;
+			regression = regression && percent > thresholdPercent;
+			snprintf(change, sizeof(change), "%+7.1f%%", percent);
+		}
+		printf("  %-48s %-4s %10.3f -> %10.3f %-3s %s%s\n", label.c_str(), statistic, baseline, current, unit, change, regression ? "  REGRESSION" : "");
+		return regression;
+	}
+
+	static uint32_t CompareStats(const std::string& label, const BenchStats& baseline, const BenchStats& current, float thresholdPercent, float noiseFloor, const char* unit)
+	{
+		uint32_t regressions = 0;
+		regressions += CompareValue(label, "p50", baseline.P50, current.P50, thresholdPercent, noiseFloor, unit);
+		regressions += CompareValue(label, "p95", baseline.P95, current.P95, thresholdPercent, noiseFloor, unit);
+		regressions += CompareValue(label, "p99", baseline.P99, current.P99, thresholdPercent, noiseFloor, unit);
+		return regressions;
+	}
+
+	// Counts of what the last frame asked of the renderer; any growth past the threshold is a regression
+	static uint32_t CompareRendererStats(const RendererFrameStats& baseline, const RendererFrameStats& current, float thresholdPercent)
+	{
+		uint32_t regressions = 0;
+		regressions += CompareValue("Draw calls", "", baseline.DrawCalls, current.DrawCalls, thresholdPercent, 0.0, "");
+		regressions += CompareValue("Triangles", "", (double)baseline.Triangles, (double)current.Triangles, thresholdPercent, 0.0, "");
+		regressions += CompareValue("Meshes", "", baseline.Instances, current.Instances, thresholdPercent, 0.0, "");
+		regressions += CompareValue("Pipeline binds", "", baseline.PipelineBinds, current.PipelineBinds, thresholdPercent, 0.0, "");
+		regressions += CompareValue("Material binds", "", baseline.MaterialBinds, current.MaterialBinds, thresholdPercent, 0.0, "");
+		regressions += CompareValue("Texture binds", "", baseline.TextureBinds, current.TextureBinds, thresholdPercent, 0.0, "");
+		regressions += CompareValue("Uniform uploads", "", baseline.UniformUploads, current.UniformUploads, thresholdPercent, 0.0, "");
+		regressions += CompareValue("Commands", "", baseline.Commands, current.Commands, thresholdPercent, 0.0, "");
+		regressions += CompareValue("Command bytes", "", (double)baseline.CommandBytes, (double)current.CommandBytes, thresholdPercent, 0.0, "B");
+		regressions += CompareValue("Buffer bytes uploaded", "", (double)baseline.BufferBytesUploaded, (double)current.BufferBytesUploaded, thresholdPercent, 0.0, "B");
+		return regressions;
+	}
+
+	uint32_t CompareBenchReports(const BenchReport& baseline, const BenchReport& current, float thresholdPercent)
+	{
+		const float TimeNoiseFloor = 0.01f; // ms
+		const float AllocationNoiseFloor = 1.0f;
+
+		if (baseline.Configuration != current.Configuration)
+			printf("Warning: comparing a %s build against a %s baseline\n", current.Configuration.c_str(), baseline.Configuration.c_str());
+
+		uint32_t regressions = 0;
+		for (const BenchSceneResult& scene : current.Scenes)
+		{
+			auto it = std::find_if(baseline.Scenes.begin(), baseline.Scenes.end(), [&](const BenchSceneResult& other)
+			{
+				return other.Name == scene.Name && other.EntityCount == scene.EntityCount;
+			});
+			if (it == baseline.Scenes.end())
+			{
+				printf("\n%s (%u entities): not in the baseline\n", scene.Name.c_str(), scene.EntityCount);
+				continue;
+			}
+
+			printf("\n%s (%u entities)\n", scene.Name.c_str(), scene.EntityCount);
+			for (const auto& [name, stats] : scene.Timings)
+			{
+				if (const BenchStats* baselineStats = FindStats(it->Timings, name))
+					regressions += CompareStats(name, *baselineStats, stats, thresholdPercent, TimeNoiseFloor, "ms");
+			}
+			for (const auto& [name, stats] : scene.Systems)
+			{
+				if (const BenchStats* baselineStats = FindStats(it->Systems, name))
+					regressions += CompareStats(name, *baselineStats, stats, thresholdPercent, TimeNoiseFloor, "ms");
+			}
+			regressions += CompareStats("Allocations", it->Allocations, scene.Allocations, thresholdPercent, AllocationNoiseFloor, "");
+			regressions += CompareRendererStats(it->Renderer, scene.Renderer, thresholdPercent);
+		}
+
+		return regressions;
+	}
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Hazel/Renderer/RendererStats.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Hazel {
+
+	struct BenchStats
+	{
+		float Mean = 0.0f;
+		float P50 = 0.0f;
+		float P95 = 0.0f;
+		float P99 = 0.0f;
+		float Max = 0.0f;
+
+		static BenchStats Compute(std::vector<float> samples);
+	};
+
+	using BenchStatsList = std::vector<std::pair<std::string, BenchStats>>;
+
+	struct BenchSceneResult
+	{
+		std::string Name;
+		uint32_t EntityCount = 0;
+
+		BenchStatsList Timings; // Milliseconds: the whole frame and its phases
+		BenchStatsList Systems; // Milliseconds per profiler scope, summed over the frame; empty without profiling
+		BenchStats Allocations; // Heap allocations per frame; all zero without allocation tracking
+
+		RendererFrameStats Renderer; // Of the last frame
+	};
+
+	struct BenchReport
+	{
+		std::string Configuration;
+		uint32_t FrameCount = 0;
+		uint32_t WarmupFrameCount = 0;
+		std::vector<BenchSceneResult> Scenes;
+	};
+
+	bool WriteBenchReport(const std::string& filepath, const BenchReport& report);
+	bool LoadBenchReport(const std::string& filepath, BenchReport& outReport);
+
+	// Prints the percentiles of every timing and of the allocations, and the renderer counts, next to
+	// the baseline's, and returns how many grew by more than thresholdPercent. Scenes are matched by
+	// name and entity count.
+	uint32_t CompareBenchReports(const BenchReport& baseline, const BenchReport& current, float thresholdPercent);
+
+}
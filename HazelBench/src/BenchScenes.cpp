@@ -0,0 +1,289 @@
+#include "BenchScenes.h"
+
+#include "Hazel/Asset/AssetManager.h"
+#include "Hazel/Scene/Entity.h"
+#include "Hazel/Scene/Components.h"
+#include "Hazel/Renderer/MeshFactory.h"
+#include "Hazel/Renderer/Renderer2D.h"
+#include "Hazel/Script/ScriptEngine.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace Hazel {
+
+	static const char* ScriptModule = "Example.Sink";
+	static const char* CharacterMesh = "assets/meshes/stormtrooper/silly_dancing.fbx";
+
+	struct BenchMeshes
+	{
+		Ref<Mesh> Box;
+		Ref<Mesh> Sphere;
+		Ref<Mesh> Capsule;
+
+		BenchMeshes()
+			: Box(MeshFactory::CreateBox(glm::vec3(1.0f))), Sphere(MeshFactory::CreateSphere(0.5f)), Capsule(MeshFactory::CreateCapsule(0.5f, 1.0f))
+		{
+		}
+	};
+
+	static float GetExtent(uint32_t entityCount)
+	{
+		return std::max(std::cbrt((float)entityCount) * 2.0f, 4.0f);
+	}
+
+	static Ref<Scene> CreateBenchScene(const char* name, uint32_t entityCount, bool orthographic = false)
+	{
+		Ref<Scene> scene = Ref<Scene>::Create(name);
+		float extent = GetExtent(entityCount);
+
+		Entity cameraEntity = scene->CreateEntity("Camera");
+		TransformComponent& cameraTransform = cameraEntity.Transform();
+		cameraTransform.Scale = glm::vec3(1.0f);
+		SceneCamera& camera = cameraEntity.AddComponent<CameraComponent>().Camera;
+		if (orthographic)
+		{
+			camera.SetOrthographic(extent * 2.0f);
+		}
+		else
+		{
+			camera.SetPerspective(glm::radians(45.0f), 0.1f, 1000.0f);
+			cameraTransform.Translation = { 0.0f, extent, extent * 3.0f };
+		}
+
+		Entity lightEntity = scene->CreateEntity("Directional Light");
+		lightEntity.Transform().Scale = glm::vec3(1.0f);
+		lightEntity.AddComponent<DirectionalLightComponent>();
+
+		return scene;
+	}
+
+	static Entity CreateBenchEntity(const Ref<Scene>& scene, uint32_t entityCount, std::mt19937& rng)
+	{
+		float extent = GetExtent(entityCount);
+		std::uniform_real_distribution<float> position(-extent, extent);
+		std::uniform_real_distribution<float> angle(0.0f, glm::two_pi<float>());
+
+		Entity entity = scene->CreateEntity();
+		TransformComponent& transform = entity.Transform();
+		transform.Translation = { position(rng), position(rng) + extent, position(rng) };
+		transform.Rotation = { 0.0f, angle(rng), 0.0f };
+		transform.Scale = glm::vec3(1.0f);
+		return entity;
+	}
+
+	static void AddCollider(Entity entity, const BenchMeshes& meshes, bool sphere)
+	{
+		if (sphere)
+		{
+			entity.AddComponent<MeshComponent>(meshes.Sphere);
+			entity.AddComponent<SphereColliderComponent>().DebugMesh = meshes.Sphere;
+		}
+		else
+		{
+			entity.AddComponent<MeshComponent>(meshes.Box);
+			entity.AddComponent<BoxColliderComponent>().DebugMesh = meshes.Box;
+		}
+		entity.AddComponent<PhysicsMaterialComponent>();
+	}
+
+	static void AddRigidBody(Entity entity, RigidBodyComponent::Type type)
+	{
+		RigidBodyComponent& rigidBody = entity.AddComponent<RigidBodyComponent>();
+		rigidBody.BodyType = type;
+	}
+
+	static void AddGround(const Ref<Scene>& scene, uint32_t entityCount)
+	{
+		float extent = GetExtent(entityCount);
+
+		Entity ground = scene->CreateEntity("Ground");
+		ground.Transform().Scale = glm::vec3(1.0f);
+		AddRigidBody(ground, RigidBodyComponent::Type::Static);
+		ground.AddComponent<PhysicsMaterialComponent>();
+		ground.AddComponent<BoxColliderComponent>().Size = { extent * 4.0f, 1.0f, extent * 4.0f };
+	}
+
+	static bool ScriptsAvailable()
+	{
+		if (ScriptEngine::ModuleExists(ScriptModule))
+			return true;
+
+		printf("Warning: script module '%s' not found, scripted entities are left without scripts\n", ScriptModule);
+		return false;
+	}
+
+	static BenchScene GenerateMeshes(uint32_t entityCount, std::mt19937& rng)
+	{
+		BenchScene bench;
+		bench.SceneInstance = CreateBenchScene("Meshes", entityCount);
+
+		BenchMeshes meshes;
+		const Ref<Mesh>* variants[] = { &meshes.Box, &meshes.Sphere, &meshes.Capsule };
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			Entity entity = CreateBenchEntity(bench.SceneInstance, entityCount, rng);
+			entity.AddComponent<MeshComponent>(*variants[i % 3]);
+		}
+		return bench;
+	}
+
+	static BenchScene GeneratePhysics(uint32_t entityCount, std::mt19937& rng)
+	{
+		BenchScene bench;
+		bench.SceneInstance = CreateBenchScene("Physics", entityCount);
+		AddGround(bench.SceneInstance, entityCount);
+
+		BenchMeshes meshes;
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			Entity entity = CreateBenchEntity(bench.SceneInstance, entityCount, rng);
+			AddRigidBody(entity, RigidBodyComponent::Type::Dynamic);
+			AddCollider(entity, meshes, i % 2 == 1);
+		}
+		return bench;
+	}
+
+	static BenchScene GenerateScripts(uint32_t entityCount, std::mt19937& rng)
+	{
+		BenchScene bench;
+		bench.SceneInstance = CreateBenchScene("Scripts", entityCount);
+
+		bool scripts = ScriptsAvailable();
+		BenchMeshes meshes;
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			Entity entity = CreateBenchEntity(bench.SceneInstance, entityCount, rng);
+			entity.AddComponent<MeshComponent>(meshes.Box);
+			if (scripts)
+				entity.AddComponent<ScriptComponent>(ScriptModule);
+		}
+		return bench;
+	}
+
+	// Roughly what a game level holds: mostly static meshes, some simulated, some scripted,
+	// and static colliders that only the physics scene sees
+	static BenchScene GenerateMixed(uint32_t entityCount, std::mt19937& rng)
+	{
+		BenchScene bench;
+		bench.SceneInstance = CreateBenchScene("Mixed", entityCount);
+		AddGround(bench.SceneInstance, entityCount);
+
+		bool scripts = ScriptsAvailable();
+		BenchMeshes meshes;
+		std::uniform_int_distribution<uint32_t> roll(0, 99);
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			Entity entity = CreateBenchEntity(bench.SceneInstance, entityCount, rng);
+			uint32_t kind = roll(rng);
+			if (kind < 40)
+			{
+				entity.AddComponent<MeshComponent>(i % 2 ? meshes.Sphere : meshes.Capsule);
+			}
+			else if (kind < 65)
+			{
+				AddRigidBody(entity, RigidBodyComponent::Type::Dynamic);
+				AddCollider(entity, meshes, i % 2 == 1);
+			}
+			else if (kind < 85)
+			{
+				entity.AddComponent<MeshComponent>(meshes.Box);
+				if (scripts)
+					entity.AddComponent<ScriptComponent>(ScriptModule);
+			}
+			else
+			{
+				AddRigidBody(entity, RigidBodyComponent::Type::Static);
+				AddCollider(entity, meshes, false);
+			}
+		}
+		return bench;
+	}
+
+	static BenchScene GenerateCharacters(uint32_t entityCount, std::mt19937& rng)
+	{
+		BenchScene bench;
+		bench.SceneInstance = CreateBenchScene("Characters", entityCount);
+
+		// Imported once; every entity gets an instance that animates on its own
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			Entity entity = CreateBenchEntity(bench.SceneInstance, entityCount, rng);
+			entity.AddComponent<MeshComponent>(AssetManager::LoadMesh(CharacterMesh));
+		}
+		return bench;
+	}
+
+	static BenchScene GenerateSprites(uint32_t entityCount, std::mt19937& rng)
+	{
+		BenchScene bench;
+		bench.SceneInstance = CreateBenchScene("Sprites", entityCount, true);
+		bench.DrawSprites = true;
+
+		float extent = GetExtent(entityCount);
+		std::uniform_real_distribution<float> position(-extent, extent);
+		std::uniform_real_distribution<float> angle(0.0f, glm::two_pi<float>());
+		std::uniform_real_distribution<float> channel(0.0f, 1.0f);
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			Entity entity = bench.SceneInstance->CreateEntity();
+			TransformComponent& transform = entity.Transform();
+			transform.Translation = { position(rng), position(rng), 0.0f };
+			transform.Rotation = { 0.0f, 0.0f, angle(rng) };
+			transform.Scale = glm::vec3(1.0f);
+
+			SpriteRendererComponent& sprite = entity.AddComponent<SpriteRendererComponent>();
+			sprite.Color = { channel(rng), channel(rng), channel(rng), 1.0f };
+		}
+		return bench;
+	}
+
+	const std::vector<BenchSceneType>& GetBenchSceneTypes()
+	{
+		static std::vector<BenchSceneType> types =
+		{
+			{ "meshes",     "Static meshes of a few shared kinds",                     GenerateMeshes },
+			{ "physics",    "Dynamic PhysX bodies with box and sphere colliders",      GeneratePhysics },
+			{ "scripts",    "Meshes each running a C# script",                         GenerateScripts },
+			{ "mixed",      "Static, simulated, scripted and collider-only entities",  GenerateMixed },
+			{ "characters", "Skinned, animated characters",                            GenerateCharacters },
+			{ "sprites",    "Colored 2D sprites drawn with Renderer2D",                GenerateSprites }
+		};
+		return types;
+	}
+
+	const BenchSceneType* FindBenchSceneType(const std::string& name)
+	{
+		for (const BenchSceneType& type : GetBenchSceneTypes())
+		{
+			if (name == type.Name)
+				return &type;
+		}
+		return nullptr;
+	}
+
+	void DrawBenchSprites(Scene* scene)
+	{
+		Entity cameraEntity = scene->GetMainCameraEntity();
+		if (!cameraEntity)
+			return;
+
+		const SceneCamera& camera = cameraEntity.GetComponent<CameraComponent>().Camera;
+		glm::mat4 viewProjection = camera.GetProjectionMatrix() * glm::inverse(cameraEntity.Transform().GetTransform());
+
+		Renderer2D::BeginScene(viewProjection, false);
+		auto view = scene->GetAllEntitiesWith<SpriteRendererComponent>();
+		for (auto entityHandle : view)
+		{
+			Entity entity = { entityHandle, scene };
+			const SpriteRendererComponent& sprite = entity.GetComponent<SpriteRendererComponent>();
+			glm::mat4 transform = entity.Transform().GetTransform();
+			if (sprite.Texture)
+				Renderer2D::DrawQuad(transform, sprite.Texture, sprite.TilingFactor, sprite.Color);
+			else
+				Renderer2D::DrawQuad(transform, sprite.Color);
+		}
+		Renderer2D::EndScene();
+	}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Hazel/Scene/Scene.h"
+
+#include <random>
+#include <vector>
+
+namespace Hazel {
+
+	struct BenchScene
+	{
+		Ref<Scene> SceneInstance;
+
+		// The scene doesn't draw sprites yet, so the benchmark draws its SpriteRendererComponents itself
+		bool DrawSprites = false;
+	};
+
+	using BenchSceneGenerator = BenchScene(*)(uint32_t entityCount, std::mt19937& rng);
+
+	struct BenchSceneType
+	{
+		const char* Name;
+		const char* Description;
+		BenchSceneGenerator Generate;
+	};
+
+	// Synthetic scenes, built the same way for the same entity count and seed so that runs compare.
+	// They need the engine's assets, so run the benchmark from the directory Hazelnut runs from.
+	const std::vector<BenchSceneType>& GetBenchSceneTypes();
+	const BenchSceneType* FindBenchSceneType(const std::string& name);
+
+	// Draws the SpriteRendererComponents of a scene with Renderer2D, from its main camera
+	void DrawBenchSprites(Scene* scene);
+
+}
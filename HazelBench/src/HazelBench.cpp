@@ -0,0 +1,306 @@
+// Runs synthetic scenes for a fixed number of frames without a window or GPU, and reports frame,
+// phase and per-system timings and heap allocations as p50/p95/p99, as JSON. Rendering goes through
+// the null device: everything up to the render command queue runs, nothing reaches a driver.
+// Per-system timings come from the profiler's scopes, so they're missing from Dist builds.
+// Run it from the directory Hazelnut runs from, as the scenes use the engine's assets.
+// Usage: HazelBench [--scene <name>]... [--entities <count>] [--frames <count>] [--warmup <count>]
+//                   [--seed <seed>] [--output <report.json>] [--baseline <report.json>] [--threshold <percent>] [--list]
+
+#include "Hazel/Core/Base.h"
+#include "Hazel/Core/Timer.h"
+#include "Hazel/Core/AllocationCounter.h"
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Core/Profiler.h"
+#include "Hazel/Asset/AssetManager.h"
+#include "Hazel/FileSystem/FileSystem.h"
+#include "Hazel/Physics/Physics.h"
+#include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/SceneRenderer.h"
+#include "Hazel/Renderer/StreamingBuffer.h"
+#include "Hazel/Renderer/TextureStreamer.h"
+#include "Hazel/Renderer/TextureUploader.h"
+#include "Hazel/Script/ScriptEngine.h"
+
+#include "BenchReport.h"
+#include "BenchScenes.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+using namespace Hazel;
+
+#if defined(HZ_DEBUG)
+	static const char* Configuration = "Debug";
+#elif defined(HZ_RELEASE)
+	static const char* Configuration = "Release";
+#else
+	static const char* Configuration = "Dist";
+#endif
+
+static const uint32_t ViewportWidth = 1920;
+static const uint32_t ViewportHeight = 1080;
+static const float FrameTime = 1.0f / 60.0f;
+
+struct BenchOptions
+{
+	std::vector<std::string> Scenes;
+	uint32_t EntityCount = 1000;
+	uint32_t FrameCount = 600;
+	uint32_t WarmupFrameCount = 60;
+	uint32_t Seed = 1337;
+	std::string OutputPath = "HazelBench.json";
+	std::string BaselinePath;
+	float Threshold = 5.0f;
+};
+
+static void PrintUsage()
+{
+	printf("Usage: HazelBench [--scene <name>]... [--entities <count>] [--frames <count>] [--warmup <count>]\n");
+	printf("                  [--seed <seed>] [--output <report.json>] [--baseline <report.json>] [--threshold <percent>] [--list]\n");
+	printf("  --scene      Scene to run, repeatable; all of them by default\n");
+	printf("  --baseline   Report to compare against; exits with 1 if anything regressed\n");
+	printf("  --threshold  Growth over the baseline, in percent, that counts as a regression (default 5)\n");
+	printf("  --list       Print the scenes and exit\n");
+}
+
+static void PrintSceneTypes()
+{
+	for (const BenchSceneType& type : GetBenchSceneTypes())
+		printf("  %-12s %s\n", type.Name, type.Description);
+}
+
+#if HZ_ENABLE_PROFILING
+// Adds up the time of every scope of the frame by name, across threads. A scope nested in another
+// of the same name is left out, so recursion isn't counted twice.
+static void CollectSystemTimes(uint64_t start, uint64_t end, std::map<std::string, std::vector<float>>& systems)
+{
+	std::vector<ProfileThreadEvents> threads;
+	Profiler::GetEvents(start, end, threads);
+
+	std::map<std::string, uint64_t> frameTimes;
+	for (ProfileThreadEvents& thread : threads)
+	{
+		// Recorded as they close, so children come before their parents
+		std::sort(thread.Events.begin(), thread.Events.end(), [](const ProfileEvent& a, const ProfileEvent& b)
+		{
+			return a.Start != b.Start ? a.Start < b.Start : a.Depth < b.Depth;
+		});
+
+		std::vector<const ProfileEvent*> stack;
+		for (const ProfileEvent& event : thread.Events)
+		{
+			while (!stack.empty() && stack.back()->Depth >= event.Depth)
+				stack.pop_back();
+
+			bool nested = false;
+			for (const ProfileEvent* parent : stack)
+				nested |= strcmp(parent->Name, event.Name) == 0;
+			if (!nested)
+				frameTimes[event.Name] += event.Duration;
+
+			stack.push_back(&event);
+		}
+	}
+
+	for (const auto& [name, duration] : frameTimes)
+		systems[name].push_back(duration / 1000000.0f);
+}
+#endif
+
+static BenchSceneResult RunScene(const BenchSceneType& type, const BenchOptions& options)
+{
+	printf("%s: %u entities, %u frames\n", type.Name, options.EntityCount, options.FrameCount);
+
+	std::mt19937 rng(options.Seed);
+	BenchScene bench = type.Generate(options.EntityCount, rng);
+	Ref<Scene>& scene = bench.SceneInstance;
+
+	scene->SetViewportSize(ViewportWidth, ViewportHeight);
+	SceneRenderer::SetViewportSize(ViewportWidth, ViewportHeight);
+	scene->OnRuntimeStart();
+
+	// Loading the scene queued up resource creation; don't count it against the first frame
+	Renderer::WaitAndRender();
+
+	std::vector<float> frameTimes, updateTimes, renderTimes, executeTimes, allocations;
+	std::map<std::string, std::vector<float>> systemTimes;
+
+	for (uint32_t frame = 0; frame < options.WarmupFrameCount + options.FrameCount; frame++)
+	{
+#if HZ_ENABLE_PROFILING
+		Profiler::BeginFrame();
+		uint64_t profileStart = Profiler::GetTime();
+#endif
+		uint64_t allocationStart = AllocationCounter::GetTotalCount();
+		Timer frameTimer;
+
+		{
+			HZ_PROFILE_SCOPE("Frame");
+			FrameAllocator::BeginFrame();
+			JobSystem::Update();
+			AssetManager::Update();
+			TextureStreamer::Update();
+
+			Timer timer;
+			scene->OnUpdate(FrameTime);
+			float updateTime = timer.ElapsedMillis();
+
+			timer.Reset();
+			scene->OnRenderRuntime(FrameTime);
+			if (bench.DrawSprites)
+				DrawBenchSprites(scene.Raw());
+			float renderTime = timer.ElapsedMillis();
+
+			timer.Reset();
+			Renderer::WaitAndRender();
+			float executeTime = timer.ElapsedMillis();
+
+			AssetManager::CollectGarbage();
+
+			if (frame >= options.WarmupFrameCount)
+			{
+				updateTimes.push_back(updateTime);
+				renderTimes.push_back(renderTime);
+				executeTimes.push_back(executeTime);
+			}
+		}
+
+		if (frame < options.WarmupFrameCount)
+			continue;
+
+		frameTimes.push_back(frameTimer.ElapsedMillis());
+		allocations.push_back((float)(AllocationCounter::GetTotalCount() - allocationStart));
+#if HZ_ENABLE_PROFILING
+		CollectSystemTimes(profileStart, Profiler::GetTime(), systemTimes);
+#endif
+	}
+
+	scene->OnRuntimeStop();
+	ScriptEngine::SetSceneContext(nullptr);
+
+	BenchSceneResult result;
+	result.Name = type.Name;
+	result.EntityCount = options.EntityCount;
+	result.Timings.emplace_back("Frame", BenchStats::Compute(frameTimes));
+	result.Timings.emplace_back("Update", BenchStats::Compute(updateTimes));
+	result.Timings.emplace_back("Render", BenchStats::Compute(renderTimes));
+	result.Timings.emplace_back("Execute", BenchStats::Compute(executeTimes));
+	for (auto& [name, samples] : systemTimes)
+		result.Systems.emplace_back(name, BenchStats::Compute(std::move(samples)));
+	result.Allocations = BenchStats::Compute(allocations);
+	result.Renderer = Renderer::GetFrameStats();
+
+	const BenchStats& frameStats = result.Timings[0].second;
+	printf("  frame %.3f ms p50, %.3f ms p95, %.3f ms p99; %.0f allocations p50\n", frameStats.P50, frameStats.P95, frameStats.P99, result.Allocations.P50);
+	return result;
+}
+
+int main(int argc, char** argv)
+{
+	BenchOptions options;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--scene" && hasValue)
+			options.Scenes.push_back(argv[++i]);
+		else if (arg == "--entities" && hasValue)
+			options.EntityCount = (uint32_t)atoi(argv[++i]);
+		else if (arg == "--frames" && hasValue)
+			options.FrameCount = (uint32_t)atoi(argv[++i]);
+		else if (arg == "--warmup" && hasValue)
+			options.WarmupFrameCount = (uint32_t)atoi(argv[++i]);
+		else if (arg == "--seed" && hasValue)
+			options.Seed = (uint32_t)atoi(argv[++i]);
+		else if (arg == "--output" && hasValue)
+			options.OutputPath = argv[++i];
+		else if (arg == "--baseline" && hasValue)
+			options.BaselinePath = argv[++i];
+		else if (arg == "--threshold" && hasValue)
+			options.Threshold = (float)atof(argv[++i]);
+		else if (arg == "--list")
+		{
+			PrintSceneTypes();
+			return 0;
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if (options.FrameCount == 0)
+	{
+		printf("--frames must be at least 1\n");
+		return 1;
+	}
+
+	std::vector<const BenchSceneType*> sceneTypes;
+	if (options.Scenes.empty())
+	{
+		for (const BenchSceneType& type : GetBenchSceneTypes())
+			sceneTypes.push_back(&type);
+	}
+	for (const std::string& name : options.Scenes)
+	{
+		const BenchSceneType* type = FindBenchSceneType(name);
+		if (!type)
+		{
+			printf("Unknown scene '%s'. Scenes:\n", name.c_str());
+			PrintSceneTypes();
+			return 1;
+		}
+		sceneTypes.push_back(type);
+	}
+
+	BenchReport baseline;
+	if (!options.BaselinePath.empty() && !LoadBenchReport(options.BaselinePath, baseline))
+		return 1;
+
+	// The same start up as Application, less the window
+	InitializeCore();
+	HZ_PROFILE_THREAD("Main Thread");
+	FileSystem::Init();
+	FrameAllocator::Init();
+	ScriptEngine::Init("assets/scripts/ExampleApp.dll");
+	Physics::Init();
+	Renderer::SetNullDevice(true);
+	Renderer::Init();
+	Renderer::WaitAndRender();
+	JobSystem::Init();
+	AssetManager::Init();
+
+	BenchReport report;
+	report.Configuration = Configuration;
+	report.FrameCount = options.FrameCount;
+	report.WarmupFrameCount = options.WarmupFrameCount;
+	for (const BenchSceneType* type : sceneTypes)
+		report.Scenes.push_back(RunScene(*type, options));
+
+	AssetManager::Shutdown();
+	JobSystem::Shutdown();
+	TextureStreamer::Shutdown();
+	TextureUploader::Shutdown();
+	StreamingBuffer::Shutdown();
+	Physics::Shutdown();
+	ScriptEngine::Shutdown();
+	FileSystem::Shutdown();
+	FrameAllocator::Shutdown();
+
+	if (!WriteBenchReport(options.OutputPath, report))
+		return 1;
+	printf("\nWrote '%s'\n", options.OutputPath.c_str());
+
+	if (options.BaselinePath.empty())
+		return 0;
+
+	printf("\nCompared to '%s' (threshold %.1f%%)\n", options.BaselinePath.c_str(), options.Threshold);
+	uint32_t regressions = CompareBenchReports(baseline, report, options.Threshold);
+	printf("\n%u regression%s\n", regressions, regressions == 1 ? "" : "s");
+	return regressions ? 1 : 0;
+}
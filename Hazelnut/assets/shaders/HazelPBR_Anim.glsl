@@ -114,7 +114,8 @@ uniform sampler2D u_RoughnessTexture;
 
 // Environment maps
 uniform samplerCube u_EnvRadianceTex;
-uniform samplerCube u_EnvIrradianceTex;
+// Diffuse irradiance as L2 spherical harmonics, see SphericalHarmonicsL2
+uniform vec3 u_EnvIrradianceSH[9];
 
 // BRDF LUT
 uniform sampler2D u_BRDFLUTTexture;
@@ -318,9 +319,18 @@ vec3 Lighting(vec3 F0)
 	return result;
 }
 
+vec3 EvaluateIrradianceSH(vec3 n)
+{
+	return 0.282095 * u_EnvIrradianceSH[0]
+		+ 0.488603 * (n.y * u_EnvIrradianceSH[1] + n.z * u_EnvIrradianceSH[2] + n.x * u_EnvIrradianceSH[3])
+		+ 1.092548 * (n.x * n.y * u_EnvIrradianceSH[4] + n.y * n.z * u_EnvIrradianceSH[5] + n.x * n.z * u_EnvIrradianceSH[7])
+		+ 0.315392 * (3.0 * n.y * n.y - 1.0) * u_EnvIrradianceSH[6]
+		+ 0.546274 * (n.x * n.x - n.z * n.z) * u_EnvIrradianceSH[8];
+}
+
 vec3 IBL(vec3 F0, vec3 Lr)
 {
-	vec3 irradiance = texture(u_EnvIrradianceTex, m_Params.Normal).rgb;
+	vec3 irradiance = max(EvaluateIrradianceSH(m_Params.Normal), 0.0);
 	vec3 F = fresnelSchlickRoughness(F0, m_Params.NdotV, m_Params.Roughness);
 	vec3 kd = (1.0 - F) * (1.0 - m_Params.Metalness);
 	vec3 diffuseIBL = m_Params.Albedo * irradiance;
@@ -524,7 +534,9 @@ void main()
 	m_Params.Normal = normalize(vs_Input.Normal);
 	if (u_NormalTexToggle > 0.5)
 	{
-		m_Params.Normal = normalize(2.0 * texture(u_NormalTexture, vs_Input.TexCoord).rgb - 1.0);
+		// Z is rebuilt from XY so two channel (BC5) normal maps work too
+		vec2 normalXY = 2.0 * texture(u_NormalTexture, vs_Input.TexCoord).rg - 1.0;
+		m_Params.Normal = normalize(vec3(normalXY, sqrt(max(1.0 - dot(normalXY, normalXY), 0.0))));
 		m_Params.Normal = normalize(vs_Input.WorldNormals * m_Params.Normal);
 	}
 
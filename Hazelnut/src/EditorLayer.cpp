@@ -175,6 +175,8 @@ namespace Hazel {
 
 	void EditorLayer::OnUpdate(Timestep ts)
 	{
+		HZ_PROFILE_FUNCTION();
+
 		auto [x, y] = GetMouseViewportSpace();
 
 		SceneRenderer::SetFocusPoint({ x * 0.5f + 0.5f, y * 0.5f + 0.5f });
@@ -260,7 +262,8 @@ namespace Hazel {
 		ImGui::NextColumn();
 		ImGui::PushItemWidth(-1);
 
-		std::string id = "##" + name;
+		FrameString id = "##";
+		id += name;
 		bool result = ImGui::Checkbox(id.c_str(), &value);
 
 		ImGui::PopItemWidth();
@@ -275,7 +278,8 @@ namespace Hazel {
 		ImGui::NextColumn();
 		ImGui::PushItemWidth(-1);
 
-		std::string id = "##" + name;
+		FrameString id = "##";
+		id += name;
 		bool changed = false;
 		if (flags == PropertyFlag::SliderProperty)
 			changed = ImGui::SliderFloat(id.c_str(), &value, min, max);
@@ -299,7 +303,8 @@ namespace Hazel {
 		ImGui::NextColumn();
 		ImGui::PushItemWidth(-1);
 
-		std::string id = "##" + name;
+		FrameString id = "##";
+		id += name;
 		bool changed = false;
 		if (flags == PropertyFlag::SliderProperty)
 			changed = ImGui::SliderFloat2(id.c_str(), glm::value_ptr(value), min, max);
@@ -323,7 +328,8 @@ namespace Hazel {
 		ImGui::NextColumn();
 		ImGui::PushItemWidth(-1);
 
-		std::string id = "##" + name;
+		FrameString id = "##";
+		id += name;
 		bool changed = false;
 		if ((int)flags & (int)PropertyFlag::ColorProperty)
 			changed = ImGui::ColorEdit3(id.c_str(), glm::value_ptr(value), ImGuiColorEditFlags_NoInputs);
@@ -349,7 +355,8 @@ namespace Hazel {
 		ImGui::NextColumn();
 		ImGui::PushItemWidth(-1);
 
-		std::string id = "##" + name;
+		FrameString id = "##";
+		id += name;
 		bool changed = false;
 		if ((int)flags & (int)PropertyFlag::ColorProperty)
 			changed = ImGui::ColorEdit4(id.c_str(), glm::value_ptr(value), ImGuiColorEditFlags_NoInputs);
@@ -1072,42 +1079,14 @@ namespace Hazel {
 
 				m_SelectionContext.clear();
 				m_EditorScene->SetSelectedEntity({});
-				auto meshEntities = m_EditorScene->GetAllEntitiesWith<MeshComponent>();
-				for (auto e : meshEntities)
+				SceneRaycastHit hit;
+				if (m_EditorScene->Raycast({ origin, direction }, hit))
 				{
-					Entity entity = { e, m_EditorScene.Raw() };
-					auto mesh = entity.GetComponent<MeshComponent>().Mesh;
-					if (!mesh)
-						continue;
-
-					auto& submeshes = mesh->GetSubmeshes();
-					float lastT = std::numeric_limits<float>::max();
-					for (uint32_t i = 0; i < submeshes.size(); i++)
-					{
-						auto& submesh = submeshes[i];
-						Ray ray = {
-							glm::inverse(entity.Transform().GetTransform() * submesh.Transform) * glm::vec4(origin, 1.0f),
-							glm::inverse(glm::mat3(entity.Transform().GetTransform()) * glm::mat3(submesh.Transform)) * direction
-						};
-
-						float t;
-						bool intersects = ray.IntersectsAABB(submesh.BoundingBox, t);
-						if (intersects)
-						{
-							const auto& triangleCache = mesh->GetTriangleCache(i);
-							for (const auto& triangle : triangleCache)
-							{
-								if (ray.IntersectsTriangle(triangle.V0.Position, triangle.V1.Position, triangle.V2.Position, t))
-								{
-									HZ_WARN("INTERSECTION: {0}, t={1}", submesh.NodeName, t);
-									m_SelectionContext.push_back({ entity, &submesh, t });
-									break;
-								}
-							}
-						}
-					}
+					Entity entity = { hit.Entity, m_EditorScene.Raw() };
+					auto& submesh = entity.GetComponent<MeshComponent>().Mesh->GetSubmeshes()[hit.Submesh];
+					HZ_WARN("INTERSECTION: {0}, t={1}", submesh.NodeName, hit.Distance);
+					m_SelectionContext.push_back({ entity, &submesh, hit.Distance });
 				}
-				std::sort(m_SelectionContext.begin(), m_SelectionContext.end(), [](auto& a, auto& b) { return a.Distance < b.Distance; });
 				if (m_SelectionContext.size())
 					OnSelected(m_SelectionContext[0]);
 
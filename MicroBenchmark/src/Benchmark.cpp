@@ -0,0 +1,238 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#ifdef HZ_PLATFORM_WINDOWS
+	#include <Windows.h>
+#endif
+
+namespace Hazel {
+
+	namespace Internal {
+
+		// Out of line, so the compiler can't see that the pointer is never read
+		__declspec(noinline) void UseCharPointer(const volatile char*)
+		{
+		}
+
+	}
+
+	static const uint64_t MaxIterations = 1000000000;
+
+	std::vector<BenchmarkDefinition>& GetBenchmarks()
+	{
+		static std::vector<BenchmarkDefinition> benchmarks;
+		return benchmarks;
+	}
+
+	static bool PinToCPU(int32_t cpu)
+	{
+#ifdef HZ_PLATFORM_WINDOWS
+		if (cpu >= 64 || !SetThreadAffinityMask(GetCurrentThread(), 1ull << cpu))
+		{
+			printf("Could not pin to CPU %d\n", cpu);
+			return false;
+		}
+		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+		return true;
+#else
+		printf("Pinning to a CPU isn't supported on this platform\n");
+		return false;
+#endif
+	}
+
+	static std::string FormatTime(double nanoseconds)
+	{
+		char buffer[32];
+		if (nanoseconds < 1000.0)
+			snprintf(buffer, sizeof(buffer), "%.2f ns", nanoseconds);
+		else if (nanoseconds < 1000000.0)
+			snprintf(buffer, sizeof(buffer), "%.2f us", nanoseconds / 1000.0);
+		else
+			snprintf(buffer, sizeof(buffer), "%.2f ms", nanoseconds / 1000000.0);
+		return buffer;
+	}
+
+	static std::string FormatRate(double perSecond, const char* unit)
+	{
+		char buffer[32];
+		if (perSecond >= 1e9)
+			snprintf(buffer, sizeof(buffer), "%.2f G%s/s", perSecond / 1e9, unit);
+		else if (perSecond >= 1e6)
+			snprintf(buffer, sizeof(buffer), "%.2f M%s/s", perSecond / 1e6, unit);
+		else if (perSecond >= 1e3)
+			snprintf(buffer, sizeof(buffer), "%.2f k%s/s", perSecond / 1e3, unit);
+		else
+			snprintf(buffer, sizeof(buffer), "%.2f %s/s", perSecond, unit);
+		return buffer;
+	}
+
+	static void PrintHeader()
+	{
+		printf("%-40s %12s %12s %12s %8s %12s  %s\n", "Benchmark", "Median", "Mean", "Min", "CV", "Iterations", "Throughput");
+		printf("%s\n", std::string(120, '-').c_str());
+	}
+
+	static void PrintResult(const BenchmarkResult& result)
+	{
+		if (!result.SkipReason.empty())
+		{
+			printf("%-40s skipped: %s\n", result.Name.c_str(), result.SkipReason.c_str());
+			return;
+		}
+
+		std::string throughput;
+		if (result.BytesPerSecond > 0.0)
+			throughput = FormatRate(result.BytesPerSecond, "B");
+		if (result.ItemsPerSecond > 0.0)
+			throughput += (throughput.empty() ? "" : ", ") + FormatRate(result.ItemsPerSecond, "items");
+
+		// Coefficient of variation: how noisy the samples were, relative to their mean
+		double cv = result.Mean > 0.0 ? result.StdDev / result.Mean * 100.0 : 0.0;
+		printf("%-40s %12s %12s %12s %7.1f%% %12llu  %s\n", result.Name.c_str(), FormatTime(result.Median).c_str(), FormatTime(result.Mean).c_str(),
+			FormatTime(result.Min).c_str(), cv, (unsigned long long)result.Iterations, throughput.c_str());
+	}
+
+	static bool WriteCSV(const std::string& filepath, const std::vector<BenchmarkResult>& results)
+	{
+		FILE* file = fopen(filepath.c_str(), "w");
+		if (!file)
+		{
+			printf("Could not open '%s' for writing\n", filepath.c_str());
+			return false;
+		}
+
+		fprintf(file, "Benchmark,MedianNs,MeanNs,MinNs,StdDevNs,Iterations,ItemsPerSecond,BytesPerSecond\n");
+		for (const BenchmarkResult& result : results)
+		{
+			if (!result.SkipReason.empty())
+				continue;
+
+			fprintf(file, "%s,%.3f,%.3f,%.3f,%.3f,%llu,%.1f,%.1f\n", result.Name.c_str(), result.Median, result.Mean, result.Min, result.StdDev,
+				(unsigned long long)result.Iterations, result.ItemsPerSecond, result.BytesPerSecond);
+		}
+
+		fclose(file);
+		return true;
+	}
+
+	bool BenchmarkRunner::Run(const BenchmarkOptions& options, std::vector<BenchmarkResult>& outResults)
+	{
+		if (options.PinnedCPU >= 0 && !PinToCPU(options.PinnedCPU))
+			return false;
+
+		std::vector<BenchmarkDefinition> benchmarks = GetBenchmarks();
+		std::sort(benchmarks.begin(), benchmarks.end(), [](const BenchmarkDefinition& a, const BenchmarkDefinition& b) { return a.Name < b.Name; });
+
+		PrintHeader();
+		for (const BenchmarkDefinition& benchmark : benchmarks)
+		{
+			std::vector<int64_t> arguments = benchmark.Arguments;
+			if (arguments.empty())
+				arguments.push_back(0);
+
+			for (int64_t argument : arguments)
+			{
+				std::string name = benchmark.Arguments.empty() ? benchmark.Name : benchmark.Name + "/" + std::to_string(argument);
+				if (!options.Filter.empty() && name.find(options.Filter) == std::string::npos)
+					continue;
+
+				outResults.push_back(RunBenchmark(benchmark, argument, name, options));
+				PrintResult(outResults.back());
+			}
+		}
+
+		if (!options.CSVPath.empty())
+			return WriteCSV(options.CSVPath, outResults);
+
+		return true;
+	}
+
+	BenchmarkResult BenchmarkRunner::RunBenchmark(const BenchmarkDefinition& benchmark, int64_t argument, const std::string& name, const BenchmarkOptions& options)
+	{
+		BenchmarkResult result;
+		result.Name = name;
+
+		const double minSampleTime = options.MinSampleTime * 1000000.0;
+		const double warmupTime = options.WarmupTime * 1000000.0;
+
+		// Grow the iteration count until a sample takes long enough to time reliably, and keep
+		// running until the warmup is over so caches, the branch predictor and the clock speed settle
+		uint64_t iterations = 1;
+		double warmedUp = 0.0;
+		while (true)
+		{
+			BenchmarkState state = RunSample(benchmark, argument, iterations);
+			if (!state.m_SkipReason.empty())
+			{
+				result.SkipReason = state.m_SkipReason;
+				return result;
+			}
+			if (!state.m_Started)
+			{
+				result.SkipReason = "never ran its loop";
+				return result;
+			}
+
+			double elapsed = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(state.m_Elapsed).count();
+			warmedUp += elapsed;
+
+			if (elapsed < minSampleTime && iterations < MaxIterations)
+			{
+				// Aim a little past the minimum, but don't trust a prediction made from a tiny sample
+				double multiplier = elapsed > minSampleTime * 0.1 ? minSampleTime * 1.4 / elapsed : 10.0;
+				iterations = std::min(std::max(iterations + 1, (uint64_t)((double)iterations * multiplier)), MaxIterations);
+				continue;
+			}
+
+			if (warmedUp >= warmupTime)
+				break;
+		}
+
+		std::vector<double> samples;
+		samples.reserve(options.SampleCount);
+		uint64_t itemsPerIteration = 0, bytesPerIteration = 0;
+		for (uint32_t i = 0; i < options.SampleCount; i++)
+		{
+			BenchmarkState state = RunSample(benchmark, argument, iterations);
+			double elapsed = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(state.m_Elapsed).count();
+			samples.push_back(elapsed / (double)iterations);
+			itemsPerIteration = state.m_ItemsPerIteration;
+			bytesPerIteration = state.m_BytesPerIteration;
+		}
+
+		std::sort(samples.begin(), samples.end());
+		size_t count = samples.size();
+
+		double total = 0.0;
+		for (double sample : samples)
+			total += sample;
+		double mean = total / (double)count;
+
+		double variance = 0.0;
+		for (double sample : samples)
+			variance += (sample - mean) * (sample - mean);
+
+		result.Iterations = iterations;
+		result.Min = samples.front();
+		result.Median = count % 2 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) * 0.5;
+		result.Mean = mean;
+		result.StdDev = count > 1 ? std::sqrt(variance / (double)(count - 1)) : 0.0;
+		if (result.Median > 0.0)
+		{
+			result.ItemsPerSecond = (double)itemsPerIteration * 1e9 / result.Median;
+			result.BytesPerSecond = (double)bytesPerIteration * 1e9 / result.Median;
+		}
+		return result;
+	}
+
+	BenchmarkState BenchmarkRunner::RunSample(const BenchmarkDefinition& benchmark, int64_t argument, uint64_t iterations)
+	{
+		BenchmarkState state(iterations, argument);
+		benchmark.Function(state);
+		return state;
+	}
+
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include <intrin.h>
+
+namespace Hazel {
+
+	// What a benchmark function is handed. The function does its setup, then runs the code being
+	// measured in a loop over the state; the harness decides how many iterations that loop makes:
+	//
+	//     static void RefCopy(BenchmarkState& state)
+	//     {
+	//         Ref<Object> ref = Ref<Object>::Create();
+	//         for (auto _ : state)
+	//         {
+	//             Ref<Object> copy = ref;
+	//             DoNotOptimize(copy);
+	//         }
+	//     }
+	//     HZ_BENCHMARK("Ref/Copy", RefCopy);
+	class BenchmarkState
+	{
+	public:
+		BenchmarkState(uint64_t iterations, int64_t argument)
+			: m_Iterations(iterations), m_Argument(argument)
+		{
+		}
+
+		// The argument the benchmark was registered with, or 0
+		int64_t GetArgument() const { return m_Argument; }
+		uint64_t GetIterations() const { return m_Iterations; }
+
+		// Leaves setup done inside the loop out of the timing. Costs a clock read on each call,
+		// so keep it away from loops whose body takes less than a microsecond or so.
+		void PauseTiming()
+		{
+			m_Elapsed += Clock::now() - m_Start;
+		}
+
+		void ResumeTiming()
+		{
+			m_Start = Clock::now();
+		}
+
+		// Work done per iteration, for the throughput columns
+		void SetItemsPerIteration(uint64_t items) { m_ItemsPerIteration = items; }
+		void SetBytesPerIteration(uint64_t bytes) { m_BytesPerIteration = bytes; }
+
+		// Reports the benchmark as skipped, e.g. when something it needs isn't available.
+		// Call before the loop; the loop then doesn't run.
+		void Skip(const std::string& reason)
+		{
+			m_SkipReason = reason;
+			m_Iterations = 0;
+		}
+
+		struct Iterator
+		{
+			struct Value {};
+
+			BenchmarkState* State;
+			uint64_t Remaining;
+
+			Value operator*() const { return {}; }
+			Iterator& operator++() { Remaining--; return *this; }
+
+			bool operator!=(const Iterator&)
+			{
+				if (Remaining)
+					return true;
+
+				State->Stop();
+				return false;
+			}
+		};
+
+		Iterator begin()
+		{
+			Start();
+			return { this, m_Iterations };
+		}
+
+		Iterator end() { return { this, 0 }; }
+	private:
+		using Clock = std::chrono::high_resolution_clock;
+
+		void Start()
+		{
+			m_Started = true;
+			m_Start = Clock::now();
+		}
+
+		void Stop()
+		{
+			m_Elapsed += Clock::now() - m_Start;
+		}
+	private:
+		uint64_t m_Iterations;
+		int64_t m_Argument;
+		uint64_t m_ItemsPerIteration = 0;
+		uint64_t m_BytesPerIteration = 0;
+		std::string m_SkipReason;
+
+		bool m_Started = false;
+		Clock::time_point m_Start;
+		Clock::duration m_Elapsed = Clock::duration::zero();
+
+		friend class BenchmarkRunner;
+	};
+
+	namespace Internal {
+
+		void UseCharPointer(const volatile char* pointer);
+
+	}
+
+	// Makes the compiler assume value is read, so the computation producing it isn't dropped
+	template<typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+		Internal::UseCharPointer(&reinterpret_cast<const volatile char&>(value));
+		_ReadWriteBarrier();
+	}
+
+	// Makes the compiler assume all memory is read and written, so stores aren't dropped
+	inline void ClobberMemory()
+	{
+		_ReadWriteBarrier();
+	}
+
+	using BenchmarkFunction = void(*)(BenchmarkState& state);
+
+	struct BenchmarkDefinition
+	{
+		std::string Name;
+		BenchmarkFunction Function;
+		// Runs once per argument, as "Name/argument"; once with 0 if there are none
+		std::vector<int64_t> Arguments;
+	};
+
+	// Benchmarks register themselves before main with HZ_BENCHMARK
+	std::vector<BenchmarkDefinition>& GetBenchmarks();
+
+	struct BenchmarkRegistration
+	{
+		BenchmarkRegistration(const char* name, BenchmarkFunction function, std::initializer_list<int64_t> arguments = {})
+		{
+			GetBenchmarks().push_back({ name, function, arguments });
+		}
+	};
+
+	struct BenchmarkOptions
+	{
+		std::string Filter;            // Runs the benchmarks whose name contains it; all if empty
+		uint32_t SampleCount = 20;
+		float MinSampleTime = 10.0f;   // ms; iterations per sample are chosen to take at least this long
+		float WarmupTime = 100.0f;     // ms, run and thrown away before the samples
+		int32_t PinnedCPU = -1;        // Runs on this logical CPU only, at high priority; -1 leaves scheduling alone
+		std::string CSVPath;           // Also writes the results here if set
+	};
+
+	struct BenchmarkResult
+	{
+		std::string Name;
+		uint64_t Iterations = 0; // Per sample
+
+		// Nanoseconds per iteration, over the samples
+		double Min = 0.0;
+		double Median = 0.0;
+		double Mean = 0.0;
+		double StdDev = 0.0;
+
+		double ItemsPerSecond = 0.0;
+		double BytesPerSecond = 0.0;
+
+		std::string SkipReason;
+	};
+
+	class BenchmarkRunner
+	{
+	public:
+		// Returns false if the options couldn't be applied (an invalid CPU to pin to, the CSV file)
+		static bool Run(const BenchmarkOptions& options, std::vector<BenchmarkResult>& outResults);
+	private:
+		static BenchmarkResult RunBenchmark(const BenchmarkDefinition& benchmark, int64_t argument, const std::string& name, const BenchmarkOptions& options);
+		static BenchmarkState RunSample(const BenchmarkDefinition& benchmark, int64_t argument, uint64_t iterations);
+	};
+
+}
+
+#define HZ_BENCHMARK(name, function, ...) static ::Hazel::BenchmarkRegistration s_##function##Registration(name, function, { __VA_ARGS__ })
@@ -0,0 +1,259 @@
+#include "Benchmark.h"
+
+#include "Hazel/Core/Base.h"
+#include "Hazel/Core/Buffer.h"
+#include "Hazel/Core/UUID.h"
+#include "Hazel/Core/Math/Ray.h"
+#include "Hazel/Scene/Components.h"
+
+#include <random>
+
+using namespace Hazel;
+
+namespace {
+
+	struct BenchObject : public RefCounted
+	{
+		uint64_t Value = 0;
+	};
+
+}
+
+static const uint32_t BatchSize = 1024;
+
+//////////////////////////////////////////////////////////////////////////////////
+// Ref
+//////////////////////////////////////////////////////////////////////////////////
+
+static void RefCreate(BenchmarkState& state)
+{
+	for (auto _ : state)
+	{
+		Ref<BenchObject> ref = Ref<BenchObject>::Create();
+		DoNotOptimize(ref);
+	}
+}
+HZ_BENCHMARK("Ref/Create", RefCreate);
+
+// An increment and a decrement of the atomic count
+static void RefCopy(BenchmarkState& state)
+{
+	Ref<BenchObject> ref = Ref<BenchObject>::Create();
+	for (auto _ : state)
+	{
+		Ref<BenchObject> copy = ref;
+		DoNotOptimize(copy);
+	}
+}
+HZ_BENCHMARK("Ref/Copy", RefCopy);
+
+static void RefMove(BenchmarkState& state)
+{
+	Ref<BenchObject> a = Ref<BenchObject>::Create();
+	Ref<BenchObject> b;
+	for (auto _ : state)
+	{
+		b = std::move(a);
+		a = std::move(b);
+		DoNotOptimize(a);
+	}
+}
+HZ_BENCHMARK("Ref/Move", RefMove);
+
+static void RefViewCopy(BenchmarkState& state)
+{
+	Ref<BenchObject> ref = Ref<BenchObject>::Create();
+	for (auto _ : state)
+	{
+		RefView<BenchObject> view = ref;
+		DoNotOptimize(view);
+	}
+}
+HZ_BENCHMARK("RefView/Copy", RefViewCopy);
+
+static void WeakRefLock(BenchmarkState& state)
+{
+	Ref<BenchObject> ref = Ref<BenchObject>::Create();
+	WeakRef<BenchObject> weak = ref;
+	for (auto _ : state)
+	{
+		Ref<BenchObject> locked = weak.Lock();
+		DoNotOptimize(locked);
+	}
+}
+HZ_BENCHMARK("WeakRef/Lock", WeakRefLock);
+
+//////////////////////////////////////////////////////////////////////////////////
+// Buffer
+//////////////////////////////////////////////////////////////////////////////////
+
+// Allocation plus copy, as when taking ownership of data handed to a render command
+static void BufferCopy(BenchmarkState& state)
+{
+	uint32_t size = (uint32_t)state.GetArgument();
+	ScopedBuffer source(size);
+	source.ZeroInitialize();
+
+	for (auto _ : state)
+	{
+		ScopedBuffer copy = ScopedBuffer::Copy(source);
+		DoNotOptimize(copy.GetData());
+	}
+	state.SetBytesPerIteration(size);
+}
+HZ_BENCHMARK("Buffer/Copy", BufferCopy, 64, 4096, 256 * 1024, 16 * 1024 * 1024);
+
+static void BufferWrite(BenchmarkState& state)
+{
+	uint32_t size = (uint32_t)state.GetArgument();
+	ScopedBuffer source(size), destination(size);
+	source.ZeroInitialize();
+
+	for (auto _ : state)
+	{
+		destination.Write(source.GetData(), size);
+		ClobberMemory();
+	}
+	state.SetBytesPerIteration(size);
+}
+HZ_BENCHMARK("Buffer/Write", BufferWrite, 64, 4096, 256 * 1024, 16 * 1024 * 1024);
+
+// Reading fields out of a view, the way uniform and vertex data is picked apart
+static void BufferViewRead(BenchmarkState& state)
+{
+	ScopedBuffer buffer(BatchSize * sizeof(glm::vec4));
+	buffer.ZeroInitialize();
+	BufferView view = buffer.View();
+
+	for (auto _ : state)
+	{
+		glm::vec4 sum(0.0f);
+		for (uint32_t i = 0; i < BatchSize; i++)
+			sum += view.Slice(i * sizeof(glm::vec4), sizeof(glm::vec4)).Read<glm::vec4>();
+		DoNotOptimize(sum);
+	}
+	state.SetItemsPerIteration(BatchSize);
+}
+HZ_BENCHMARK("BufferView/Read", BufferViewRead);
+
+//////////////////////////////////////////////////////////////////////////////////
+// UUID
+//////////////////////////////////////////////////////////////////////////////////
+
+static void UUIDGenerate(BenchmarkState& state)
+{
+	for (auto _ : state)
+	{
+		Hazel::UUID uuid;
+		DoNotOptimize(uuid);
+	}
+}
+HZ_BENCHMARK("UUID/Generate", UUIDGenerate);
+
+//////////////////////////////////////////////////////////////////////////////////
+// Transform
+//////////////////////////////////////////////////////////////////////////////////
+
+static void TransformGetTransform(BenchmarkState& state)
+{
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> angle(0.0f, glm::two_pi<float>());
+	std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+	std::vector<TransformComponent> transforms(BatchSize);
+	for (TransformComponent& transform : transforms)
+	{
+		transform.Translation = { position(rng), position(rng), position(rng) };
+		transform.Rotation = { angle(rng), angle(rng), angle(rng) };
+		transform.Scale = { scale(rng), scale(rng), scale(rng) };
+	}
+
+	for (auto _ : state)
+	{
+		for (const TransformComponent& transform : transforms)
+		{
+			glm::mat4 matrix = transform.GetTransform();
+			DoNotOptimize(matrix);
+		}
+	}
+	state.SetItemsPerIteration(BatchSize);
+}
+HZ_BENCHMARK("TransformComponent/GetTransform", TransformGetTransform);
+
+//////////////////////////////////////////////////////////////////////////////////
+// Ray
+//////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+	// Primitives scattered through a volume and a ray aimed through it, so a fair share are hit
+	struct RayTargets
+	{
+		Ray TestRay = Ray::Zero();
+		std::vector<AABB> Boxes;
+		std::vector<glm::vec3> Vertices;
+
+		RayTargets()
+		{
+			std::mt19937 rng(1337);
+			std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+			std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+			std::uniform_real_distribution<float> size(0.5f, 4.0f);
+
+			Boxes.reserve(BatchSize);
+			Vertices.reserve(BatchSize * 3);
+			for (uint32_t i = 0; i < BatchSize; i++)
+			{
+				glm::vec3 center = { position(rng), position(rng), position(rng) };
+				glm::vec3 extents = { size(rng), size(rng), size(rng) };
+				Boxes.emplace_back(center - extents, center + extents);
+
+				Vertices.push_back(center);
+				Vertices.push_back(center + glm::vec3(offset(rng), offset(rng), offset(rng)));
+				Vertices.push_back(center + glm::vec3(offset(rng), offset(rng), offset(rng)));
+			}
+
+			TestRay = Ray({ 0.0f, 0.0f, -50.0f }, glm::normalize(glm::vec3(0.1f, 0.05f, 1.0f)));
+		}
+	};
+
+}
+
+static void RayIntersectsAABB(BenchmarkState& state)
+{
+	RayTargets targets;
+	glm::vec3 inverseDirection = targets.TestRay.GetInverseDirection();
+
+	for (auto _ : state)
+	{
+		uint32_t hits = 0;
+		for (const AABB& box : targets.Boxes)
+		{
+			float t;
+			hits += targets.TestRay.IntersectsAABB(box, inverseDirection, t);
+		}
+		DoNotOptimize(hits);
+	}
+	state.SetItemsPerIteration(BatchSize);
+}
+HZ_BENCHMARK("Ray/IntersectsAABB", RayIntersectsAABB);
+
+static void RayIntersectsTriangle(BenchmarkState& state)
+{
+	RayTargets targets;
+
+	for (auto _ : state)
+	{
+		uint32_t hits = 0;
+		for (uint32_t i = 0; i < BatchSize; i++)
+		{
+			float t;
+			const glm::vec3* v = &targets.Vertices[i * 3];
+			hits += targets.TestRay.IntersectsTriangle(v[0], v[1], v[2], t);
+		}
+		DoNotOptimize(hits);
+	}
+	state.SetItemsPerIteration(BatchSize);
+}
+HZ_BENCHMARK("Ray/IntersectsTriangle", RayIntersectsTriangle);
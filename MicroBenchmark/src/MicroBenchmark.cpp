@@ -0,0 +1,115 @@
+// Times the engine's core primitives in isolation: Ref, Buffer, the render command queue, material
+// uniforms, transforms, UUIDs, ray tests and scene serialization. Each benchmark is run for a warmup,
+// then sampled; results are per iteration, as median, mean, min and coefficient of variation.
+// The renderer runs on the null device. Material and scene benchmarks need the engine's shaders, so
+// run from the directory Hazelnut runs from to include them; they're skipped otherwise.
+// Usage: MicroBenchmark [--filter <substring>] [--samples <count>] [--min-time <ms>] [--warmup <ms>]
+//                       [--pin <cpu>] [--csv <results.csv>] [--list]
+
+#include "Benchmark.h"
+
+#include "Hazel/Core/Base.h"
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Core/Log.h"
+#include "Hazel/FileSystem/FileSystem.h"
+#include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/StreamingBuffer.h"
+#include "Hazel/Renderer/TextureStreamer.h"
+#include "Hazel/Renderer/TextureUploader.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace Hazel;
+
+static void PrintUsage()
+{
+	printf("Usage: MicroBenchmark [--filter <substring>] [--samples <count>] [--min-time <ms>] [--warmup <ms>]\n");
+	printf("                      [--pin <cpu>] [--csv <results.csv>] [--list]\n");
+	printf("  --filter    Runs the benchmarks whose name contains it\n");
+	printf("  --samples   Samples taken per benchmark (default 20)\n");
+	printf("  --min-time  Shortest a sample may take, in ms (default 10)\n");
+	printf("  --warmup    Time each benchmark runs before sampling, in ms (default 100)\n");
+	printf("  --pin       Runs on the given logical CPU only, at high priority, for steadier numbers\n");
+	printf("  --csv       Also writes the results to a CSV file\n");
+	printf("  --list      Prints the benchmarks and exits\n");
+}
+
+static void PrintBenchmarks()
+{
+	for (const BenchmarkDefinition& benchmark : GetBenchmarks())
+	{
+		printf("  %s", benchmark.Name.c_str());
+		for (size_t i = 0; i < benchmark.Arguments.size(); i++)
+			printf("%s%lld", i ? ", " : " (", (long long)benchmark.Arguments[i]);
+		printf("%s\n", benchmark.Arguments.empty() ? "" : ")");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--filter" && hasValue)
+			options.Filter = argv[++i];
+		else if (arg == "--samples" && hasValue)
+			options.SampleCount = (uint32_t)atoi(argv[++i]);
+		else if (arg == "--min-time" && hasValue)
+			options.MinSampleTime = (float)atof(argv[++i]);
+		else if (arg == "--warmup" && hasValue)
+			options.WarmupTime = (float)atof(argv[++i]);
+		else if (arg == "--pin" && hasValue)
+			options.PinnedCPU = atoi(argv[++i]);
+		else if (arg == "--csv" && hasValue)
+			options.CSVPath = argv[++i];
+		else if (arg == "--list")
+		{
+			PrintBenchmarks();
+			return 0;
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if (options.SampleCount == 0)
+	{
+		printf("--samples must be at least 1\n");
+		return 1;
+	}
+
+	InitializeCore();
+	// Loading a scene logs every entity; keep that out of the timings and the results
+	Log::GetCoreLogger()->set_level(spdlog::level::warn);
+	FileSystem::Init();
+	FrameAllocator::Init();
+
+	// Only the material and scene benchmarks need the renderer; without the assets they're skipped
+	bool renderer = FileSystem::Exists("assets/shaders/HazelPBR_Static.glsl");
+	if (renderer)
+	{
+		Renderer::SetNullDevice(true);
+		Renderer::Init();
+		Renderer::WaitAndRender();
+	}
+
+	std::vector<BenchmarkResult> results;
+	bool succeeded = BenchmarkRunner::Run(options, results);
+
+	if (renderer)
+	{
+		Renderer::WaitAndRender();
+		TextureStreamer::Shutdown();
+		TextureUploader::Shutdown();
+		StreamingBuffer::Shutdown();
+	}
+	FileSystem::Shutdown();
+	FrameAllocator::Shutdown();
+
+	return succeeded ? 0 : 1;
+}
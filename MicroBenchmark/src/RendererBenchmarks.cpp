@@ -0,0 +1,106 @@
+#include "Benchmark.h"
+
+#include "Hazel/Renderer/Material.h"
+#include "Hazel/Renderer/RenderCommandQueue.h"
+#include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/Shader.h"
+
+#include <glm/glm.hpp>
+
+using namespace Hazel;
+
+static const uint32_t CommandCount = 256;
+
+// A typical command: a uniform upload, capturing its value by copy
+static void RecordCommands(RenderCommandQueue& queue, glm::mat4* target)
+{
+	for (uint32_t i = 0; i < CommandCount; i++)
+	{
+		glm::mat4 value((float)i);
+		queue.Submit([target, value]()
+		{
+			*target = value;
+		});
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+// RenderCommandQueue
+//////////////////////////////////////////////////////////////////////////////////
+
+static void RenderCommandQueueAllocate(BenchmarkState& state)
+{
+	RenderCommandQueue queue;
+	glm::mat4 target;
+
+	for (auto _ : state)
+	{
+		RecordCommands(queue, &target);
+
+		state.PauseTiming();
+		queue.Discard();
+		state.ResumeTiming();
+	}
+	state.SetItemsPerIteration(CommandCount);
+}
+HZ_BENCHMARK("RenderCommandQueue/Allocate", RenderCommandQueueAllocate);
+
+static void RenderCommandQueueExecute(BenchmarkState& state)
+{
+	RenderCommandQueue queue;
+	glm::mat4 target;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		RecordCommands(queue, &target);
+		state.ResumeTiming();
+
+		queue.Execute();
+		DoNotOptimize(target);
+	}
+	state.SetItemsPerIteration(CommandCount);
+}
+HZ_BENCHMARK("RenderCommandQueue/Execute", RenderCommandQueueExecute);
+
+//////////////////////////////////////////////////////////////////////////////////
+// Material
+//////////////////////////////////////////////////////////////////////////////////
+
+// The PBR shader is parsed by Renderer::Init, which only runs when the engine's assets were found
+static Ref<Shader> GetPBRShader(BenchmarkState& state)
+{
+	Ref<ShaderLibrary> library = Renderer::GetShaderLibrary();
+	if (!library)
+	{
+		state.Skip("needs the engine's assets; run from the Hazelnut directory");
+		return nullptr;
+	}
+	return library->Get("HazelPBR_Static");
+}
+
+static void MaterialSet(BenchmarkState& state)
+{
+	Ref<Shader> shader = GetPBRShader(state);
+	if (!shader)
+		return;
+
+	Ref<Material> material = Material::Create(shader);
+	for (auto _ : state)
+		material->Set("u_Metalness", 0.5f);
+}
+HZ_BENCHMARK("Material/Set", MaterialSet);
+
+static void MaterialInstanceSet(BenchmarkState& state)
+{
+	Ref<Shader> shader = GetPBRShader(state);
+	if (!shader)
+		return;
+
+	Ref<Material> material = Material::Create(shader);
+	Ref<MaterialInstance> instance = MaterialInstance::Create(material);
+	glm::vec3 color(0.8f);
+	for (auto _ : state)
+		instance->Set("u_AlbedoColor", color);
+}
+HZ_BENCHMARK("MaterialInstance/Set", MaterialInstanceSet);
@@ -0,0 +1,215 @@
+#include "Benchmark.h"
+
+#include "Hazel/Core/Base.h"
+#include "Hazel/Core/Buffer.h"
+#include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Scene/Components.h"
+#include "Hazel/Scene/Entity.h"
+#include "Hazel/Scene/Scene.h"
+#include "Hazel/Scene/SceneSerializer.h"
+
+#include <random>
+#include <sstream>
+
+// The same entities (ID, tag and transform) saved and loaded as a scene by SceneSerializer, and
+// written and read back as a flat binary stream, to show what the text format costs
+
+using namespace Hazel;
+
+namespace {
+
+	struct SerializedEntity
+	{
+		uint64_t ID = 0;
+		std::string Tag;
+		TransformComponent Transform;
+	};
+
+}
+
+static std::vector<SerializedEntity> GenerateEntities(uint32_t count)
+{
+	std::mt19937_64 rng(1337);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> angle(0.0f, glm::two_pi<float>());
+
+	std::vector<SerializedEntity> entities(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		SerializedEntity& entity = entities[i];
+		entity.ID = rng();
+		entity.Tag = "Entity " + std::to_string(i);
+		entity.Transform.Translation = { position(rng), position(rng), position(rng) };
+		entity.Transform.Rotation = { angle(rng), angle(rng), angle(rng) };
+		entity.Transform.Scale = glm::vec3(1.0f);
+	}
+	return entities;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+// Scene
+//////////////////////////////////////////////////////////////////////////////////
+
+// Scenes load their skybox shader, so they need the renderer, which only runs when the engine's
+// assets were found. Editor scenes don't create a physics scene.
+static Ref<Scene> CreateScene(BenchmarkState& state)
+{
+	if (!Renderer::GetShaderLibrary())
+	{
+		state.Skip("needs the engine's assets; run from the Hazelnut directory");
+		return nullptr;
+	}
+
+	Ref<Scene> scene = Ref<Scene>::Create("Benchmark", true);
+	// The null device drops the shader's commands, rather than letting them pile up over the samples
+	Renderer::WaitAndRender();
+	return scene;
+}
+
+static Ref<Scene> GenerateScene(BenchmarkState& state, const std::vector<SerializedEntity>& entities)
+{
+	Ref<Scene> scene = CreateScene(state);
+	if (!scene)
+		return nullptr;
+
+	for (const SerializedEntity& source : entities)
+	{
+		Entity entity = scene->CreateEntityWithID(source.ID, source.Tag);
+		entity.GetComponent<TransformComponent>() = source.Transform;
+	}
+	return scene;
+}
+
+static void SerializeScene(BenchmarkState& state)
+{
+	std::vector<SerializedEntity> entities = GenerateEntities((uint32_t)state.GetArgument());
+	Ref<Scene> scene = GenerateScene(state, entities);
+	if (!scene)
+		return;
+
+	SceneSerializer serializer(scene);
+	size_t size = 0;
+	for (auto _ : state)
+	{
+		std::ostringstream stream;
+		serializer.Serialize(stream);
+		size = (size_t)stream.tellp();
+		DoNotOptimize(size);
+	}
+	state.SetItemsPerIteration(entities.size());
+	state.SetBytesPerIteration(size);
+}
+HZ_BENCHMARK("Serialization/SceneWrite", SerializeScene, 100, 1000, 10000);
+
+static void DeserializeScene(BenchmarkState& state)
+{
+	std::vector<SerializedEntity> entities = GenerateEntities((uint32_t)state.GetArgument());
+	Ref<Scene> source = GenerateScene(state, entities);
+	if (!source)
+		return;
+
+	std::ostringstream yaml;
+	SceneSerializer(source).Serialize(yaml);
+	source = nullptr;
+
+	// Entity IDs have to be unique within a scene, so every iteration loads into a new one
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		Ref<Scene> scene = CreateScene(state);
+		std::istringstream stream(yaml.str());
+		state.ResumeTiming();
+
+		bool loaded = SceneSerializer(scene).Deserialize(stream);
+		DoNotOptimize(loaded);
+
+		state.PauseTiming();
+		scene = nullptr;
+		state.ResumeTiming();
+	}
+	state.SetItemsPerIteration(entities.size());
+	state.SetBytesPerIteration(yaml.str().size());
+}
+HZ_BENCHMARK("Serialization/SceneRead", DeserializeScene, 100, 1000, 10000);
+
+//////////////////////////////////////////////////////////////////////////////////
+// Binary
+//////////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+static void WriteValue(std::vector<byte>& out, const T& value)
+{
+	const byte* data = (const byte*)&value;
+	out.insert(out.end(), data, data + sizeof(T));
+}
+
+static void WriteBinary(const std::vector<SerializedEntity>& entities, std::vector<byte>& out)
+{
+	out.clear();
+	WriteValue(out, (uint32_t)entities.size());
+	for (const SerializedEntity& entity : entities)
+	{
+		WriteValue(out, entity.ID);
+		WriteValue(out, (uint32_t)entity.Tag.size());
+		out.insert(out.end(), entity.Tag.begin(), entity.Tag.end());
+		WriteValue(out, entity.Transform.Translation);
+		WriteValue(out, entity.Transform.Rotation);
+		WriteValue(out, entity.Transform.Scale);
+	}
+}
+
+static void ReadBinary(BufferView data, std::vector<SerializedEntity>& outEntities)
+{
+	uint32_t offset = 0;
+	uint32_t count = data.Read<uint32_t>(offset);
+	offset += sizeof(uint32_t);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		SerializedEntity& entity = outEntities.emplace_back();
+		entity.ID = data.Read<uint64_t>(offset);
+		offset += sizeof(uint64_t);
+
+		uint32_t tagLength = data.Read<uint32_t>(offset);
+		offset += sizeof(uint32_t);
+		entity.Tag.assign((const char*)data.Data + offset, tagLength);
+		offset += tagLength;
+
+		entity.Transform.Translation = data.Read<glm::vec3>(offset);
+		offset += sizeof(glm::vec3);
+		entity.Transform.Rotation = data.Read<glm::vec3>(offset);
+		offset += sizeof(glm::vec3);
+		entity.Transform.Scale = data.Read<glm::vec3>(offset);
+		offset += sizeof(glm::vec3);
+	}
+}
+
+static void SerializeBinary(BenchmarkState& state)
+{
+	std::vector<SerializedEntity> entities = GenerateEntities((uint32_t)state.GetArgument());
+	std::vector<byte> binary;
+	for (auto _ : state)
+	{
+		WriteBinary(entities, binary);
+		DoNotOptimize(binary.data());
+	}
+	state.SetItemsPerIteration(entities.size());
+	state.SetBytesPerIteration(binary.size());
+}
+HZ_BENCHMARK("Serialization/BinaryWrite", SerializeBinary, 100, 1000, 10000);
+
+static void DeserializeBinary(BenchmarkState& state)
+{
+	std::vector<SerializedEntity> entities = GenerateEntities((uint32_t)state.GetArgument());
+	std::vector<byte> binary;
+	WriteBinary(entities, binary);
+	for (auto _ : state)
+	{
+		std::vector<SerializedEntity> result;
+		result.reserve(entities.size());
+		ReadBinary(BufferView(binary.data(), (uint32_t)binary.size()), result);
+		DoNotOptimize(result.data());
+	}
+	state.SetItemsPerIteration(entities.size());
+	state.SetBytesPerIteration(binary.size());
+}
+HZ_BENCHMARK("Serialization/BinaryRead", DeserializeBinary, 100, 1000, 10000);
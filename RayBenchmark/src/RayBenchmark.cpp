@@ -0,0 +1,217 @@
+// Compares the batch ray kernels against the scalar Ray tests at every SIMD level the CPU supports.
+// Usage: RayBenchmark [primitiveCount] [rayCount]
+
+#include "Hazel/Core/Math/RayKernels.h"
+#include "Hazel/Core/Timer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace Hazel;
+
+static const char* GetLevelName(SIMDLevel level)
+{
+	switch (level)
+	{
+		case SIMDLevel::Scalar: return "Scalar";
+		case SIMDLevel::SSE:    return "SSE";
+		case SIMDLevel::AVX2:   return "AVX2";
+	}
+	return "Unknown";
+}
+
+struct Scene
+{
+	std::vector<glm::vec3> Vertices;
+	std::vector<AABB> Boxes;
+	std::vector<Ray> Rays;
+
+	TriangleBatch TriangleSoA;
+	AABBBatch BoxSoA;
+	RayBatch RaySoA;
+};
+
+static Scene GenerateScene(uint32_t primitiveCount, uint32_t rayCount)
+{
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+	std::uniform_real_distribution<float> size(0.1f, 2.0f);
+
+	Scene scene;
+	scene.Vertices.reserve(primitiveCount * 3);
+	scene.Boxes.reserve(primitiveCount);
+	scene.TriangleSoA.Reserve(primitiveCount);
+	scene.BoxSoA.Reserve(primitiveCount);
+	for (uint32_t i = 0; i < primitiveCount; i++)
+	{
+		glm::vec3 a = { position(rng), position(rng), position(rng) };
+		glm::vec3 b = a + glm::vec3(offset(rng), offset(rng), offset(rng));
+		glm::vec3 c = a + glm::vec3(offset(rng), offset(rng), offset(rng));
+		scene.Vertices.push_back(a);
+		scene.Vertices.push_back(b);
+		scene.Vertices.push_back(c);
+		scene.TriangleSoA.Add(a, b, c);
+
+		glm::vec3 extents = { size(rng), size(rng), size(rng) };
+		scene.Boxes.emplace_back(a - extents, a + extents);
+		scene.BoxSoA.Add(scene.Boxes.back());
+	}
+
+	// Rays start outside the volume and aim through it so a useful fraction of them hit something
+	std::uniform_real_distribution<float> target(-40.0f, 40.0f);
+	scene.Rays.reserve(rayCount);
+	scene.RaySoA.Reserve(rayCount);
+	for (uint32_t i = 0; i < rayCount; i++)
+	{
+		glm::vec3 origin = { position(rng), position(rng), -100.0f };
+		glm::vec3 direction = glm::normalize(glm::vec3(target(rng), target(rng), 0.0f) - origin);
+		scene.Rays.emplace_back(origin, direction);
+		scene.RaySoA.Add(scene.Rays.back());
+	}
+
+	return scene;
+}
+
+static void PrintResult(const char* name, float milliseconds, float baselineMilliseconds, uint64_t tests)
+{
+	float nsPerTest = milliseconds * 1000000.0f / (float)tests;
+	printf("  %-28s %10.3f ms  %7.2f ns/test  %6.2fx\n", name, milliseconds, nsPerTest, baselineMilliseconds / milliseconds);
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t primitiveCount = argc > 1 ? (uint32_t)atoi(argv[1]) : 4096;
+	uint32_t rayCount = argc > 2 ? (uint32_t)atoi(argv[2]) : 1024;
+
+	Scene scene = GenerateScene(primitiveCount, rayCount);
+	uint64_t tests = (uint64_t)primitiveCount * rayCount;
+
+	SIMDLevel supported = RayKernels::GetSupportedLevel();
+	printf("RayBenchmark: %u primitives, %u rays, supported level %s\n\n", primitiveCount, rayCount, GetLevelName(supported));
+
+	uint32_t mismatches = 0;
+
+	// Ray vs triangles
+	{
+		printf("Ray vs triangles (closest hit)\n");
+
+		std::vector<int32_t> reference(rayCount, -1);
+		Timer timer;
+		for (uint32_t r = 0; r < rayCount; r++)
+		{
+			float closest = std::numeric_limits<float>::max();
+			for (uint32_t i = 0; i < primitiveCount; i++)
+			{
+				float t;
+				const glm::vec3* v = &scene.Vertices[i * 3];
+				if (scene.Rays[r].IntersectsTriangle(v[0], v[1], v[2], t) && t < closest)
+				{
+					closest = t;
+					reference[r] = (int32_t)i;
+				}
+			}
+		}
+		float baseline = timer.ElapsedMillis();
+		PrintResult("Ray::IntersectsTriangle", baseline, baseline, tests);
+
+		for (int level = 0; level <= (int)supported; level++)
+		{
+			RayKernels::SetLevel((SIMDLevel)level);
+			std::vector<int32_t> results(rayCount);
+			timer.Reset();
+			for (uint32_t r = 0; r < rayCount; r++)
+			{
+				float distance;
+				results[r] = RayKernels::IntersectTriangles(scene.Rays[r], scene.TriangleSoA, distance);
+			}
+			float elapsed = timer.ElapsedMillis();
+			PrintResult(GetLevelName((SIMDLevel)level), elapsed, baseline, tests);
+
+			for (uint32_t r = 0; r < rayCount; r++)
+				mismatches += results[r] != reference[r];
+		}
+		printf("\n");
+	}
+
+	// Ray vs boxes
+	{
+		printf("Ray vs boxes\n");
+
+		uint64_t referenceHits = 0;
+		Timer timer;
+		for (uint32_t r = 0; r < rayCount; r++)
+		{
+			const Ray& ray = scene.Rays[r];
+			glm::vec3 inverseDirection = ray.GetInverseDirection();
+			for (uint32_t i = 0; i < primitiveCount; i++)
+			{
+				float t;
+				referenceHits += ray.IntersectsAABB(scene.Boxes[i], inverseDirection, t);
+			}
+		}
+		float baseline = timer.ElapsedMillis();
+		PrintResult("Ray::IntersectsAABB", baseline, baseline, tests);
+
+		std::vector<float> distances(primitiveCount);
+		for (int level = 0; level <= (int)supported; level++)
+		{
+			RayKernels::SetLevel((SIMDLevel)level);
+			uint64_t hits = 0;
+			timer.Reset();
+			for (uint32_t r = 0; r < rayCount; r++)
+				hits += RayKernels::IntersectAABBs(scene.Rays[r], scene.BoxSoA, distances.data());
+			float elapsed = timer.ElapsedMillis();
+			PrintResult(GetLevelName((SIMDLevel)level), elapsed, baseline, tests);
+
+			// All ray origins are outside the boxes, so both tests agree on hits
+			mismatches += hits != referenceHits;
+		}
+		printf("\n");
+	}
+
+	// Rays vs box
+	{
+		printf("Rays vs box\n");
+
+		uint64_t referenceHits = 0;
+		Timer timer;
+		for (uint32_t i = 0; i < primitiveCount; i++)
+		{
+			for (uint32_t r = 0; r < rayCount; r++)
+			{
+				float t;
+				referenceHits += scene.Rays[r].IntersectsAABB(scene.Boxes[i], t);
+			}
+		}
+		float baseline = timer.ElapsedMillis();
+		PrintResult("Ray::IntersectsAABB", baseline, baseline, tests);
+
+		std::vector<float> distances(rayCount);
+		for (int level = 0; level <= (int)supported; level++)
+		{
+			RayKernels::SetLevel((SIMDLevel)level);
+			uint64_t hits = 0;
+			timer.Reset();
+			for (uint32_t i = 0; i < primitiveCount; i++)
+				hits += RayKernels::IntersectRays(scene.RaySoA, scene.Boxes[i], distances.data());
+			float elapsed = timer.ElapsedMillis();
+			PrintResult(GetLevelName((SIMDLevel)level), elapsed, baseline, tests);
+
+			mismatches += hits != referenceHits;
+		}
+		printf("\n");
+	}
+
+	RayKernels::SetLevel(supported);
+
+	if (mismatches)
+	{
+		printf("FAILED: %u results differ from the scalar reference\n", mismatches);
+		return 1;
+	}
+
+	printf("All kernels match the scalar reference\n");
+	return 0;
+}
@@ -314,7 +314,9 @@ void main()
 	m_Params.Normal = normalize(vs_Input.Normal);
 	if (u_NormalTexToggle > 0.5)
 	{
-		m_Params.Normal = normalize(2.0 * texture(u_NormalTexture, vs_Input.TexCoord).rgb - 1.0);
+		// Z is rebuilt from XY so two channel (BC5) normal maps work too
+		vec2 normalXY = 2.0 * texture(u_NormalTexture, vs_Input.TexCoord).rg - 1.0;
+		m_Params.Normal = normalize(vec3(normalXY, sqrt(max(1.0 - dot(normalXY, normalXY), 0.0))));
 		m_Params.Normal = normalize(vs_Input.WorldNormals * m_Params.Normal);
 	}
 
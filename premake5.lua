@@ -29,6 +29,7 @@ IncludeDir["entt"] = "Hazel/vendor/entt/include"
 IncludeDir["FastNoise"] = "Hazel/vendor/FastNoise"
 IncludeDir["mono"] = "Hazel/vendor/mono/include"
 IncludeDir["PhysX"] = "Hazel/vendor/PhysX/include"
+IncludeDir["yaml_cpp"] = "Hazel/vendor/yaml-cpp/include"
 
 LibraryDir = {}
 LibraryDir["mono"] = "vendor/mono/lib/Debug/mono-2.0-sgen.lib"
@@ -40,6 +41,84 @@ LibraryDir["PhysXExtensions"] = "vendor/PhysX/lib/%{cfg.buildcfg}/PhysXExtension
 LibraryDir["PhysXFoundation"] = "vendor/PhysX/lib/%{cfg.buildcfg}/PhysXFoundation_static_64.lib"
 LibraryDir["PhysXPvd"] = "vendor/PhysX/lib/%{cfg.buildcfg}/PhysXPvdSDK_static_64.lib"
 
+-- An executable linking the engine, with everything it needs to run copied next to it.
+-- Returns with the project active and filters cleared, so callers can add to it.
+function ConsoleApp(name)
+	project(name)
+		location(name)
+		kind "ConsoleApp"
+		language "C++"
+		cppdialect "C++17"
+		staticruntime "on"
+		
+		targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+		objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+
+		links 
+		{ 
+			"Hazel"
+		}
+		
+		files 
+		{ 
+			"%{prj.name}/src/**.h", 
+			"%{prj.name}/src/**.cpp" 
+		}
+		
+		includedirs 
+		{
+			"%{prj.name}/src",
+			"Hazel/src",
+			"Hazel/vendor",
+			"%{IncludeDir.glm}"
+		}
+
+		filter "system:windows"
+			systemversion "latest"
+					
+			defines 
+			{ 
+				"HZ_PLATFORM_WINDOWS"
+			}
+		
+		filter "configurations:Debug"
+			defines "HZ_DEBUG"
+			symbols "on"
+
+			links
+			{
+				"Hazel/vendor/assimp/bin/Debug/assimp-vc141-mtd.lib"
+			}
+
+			postbuildcommands 
+			{
+				'{COPY} "../Hazel/vendor/assimp/bin/Debug/assimp-vc141-mtd.dll" "%{cfg.targetdir}"',
+				'{COPY} "../Hazel/vendor/mono/bin/Debug/mono-2.0-sgen.dll" "%{cfg.targetdir}"'
+			}
+					
+		filter "configurations:Release or configurations:Dist"
+			optimize "on"
+
+			links
+			{
+				"Hazel/vendor/assimp/bin/Release/assimp-vc141-mt.lib"
+			}
+
+			postbuildcommands 
+			{
+				'{COPY} "../Hazel/vendor/assimp/bin/Release/assimp-vc141-mt.dll" "%{cfg.targetdir}"',
+				'{COPY} "../Hazel/vendor/mono/bin/Debug/mono-2.0-sgen.dll" "%{cfg.targetdir}"'
+			}
+
+		filter "configurations:Release"
+			defines "HZ_RELEASE"
+
+		filter "configurations:Dist"
+			defines "HZ_DIST"
+
+		filter {}
+end
+
 group "Dependencies"
 include "Hazel/vendor/GLFW"
 include "Hazel/vendor/Glad"
@@ -90,7 +169,7 @@ project "Hazel"
 		"%{IncludeDir.PhysX}",
 		"%{prj.name}/vendor/assimp/include",
 		"%{prj.name}/vendor/stb/include",
-		"%{prj.name}/vendor/yaml-cpp/include"
+		"%{IncludeDir.yaml_cpp}"
 	}
 	
 	links 
@@ -159,96 +238,48 @@ project "Hazel-ScriptCore"
 group ""
 
 group "Tools"
-project "Hazelnut"
-	location "Hazelnut"
-	kind "ConsoleApp"
-	language "C++"
-	cppdialect "C++17"
-	staticruntime "on"
-	
-	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
-	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
-
-	links 
-	{ 
-		"Hazel"
-	}
-	
+ConsoleApp "Hazelnut"
 	files 
 	{ 
-		"%{prj.name}/src/**.h", 
 		"%{prj.name}/src/**.c", 
-		"%{prj.name}/src/**.hpp", 
-		"%{prj.name}/src/**.cpp" 
+		"%{prj.name}/src/**.hpp"
 	}
-	
+
 	includedirs 
 	{
-		"%{prj.name}/src",
-		"Hazel/src",
-		"Hazel/vendor",
-		"%{IncludeDir.entt}",
-		"%{IncludeDir.glm}"
+		"%{IncludeDir.entt}"
 	}
 
 	postbuildcommands 
 	{
 		'{COPY} "../Hazelnut/assets" "%{cfg.targetdir}/assets"'
 	}
-	
-	filter "system:windows"
-		systemversion "latest"
-				
-		defines 
-		{ 
-			"HZ_PLATFORM_WINDOWS"
-		}
-	
-	filter "configurations:Debug"
-		defines "HZ_DEBUG"
-		symbols "on"
 
-		links
-		{
-			"Hazel/vendor/assimp/bin/Debug/assimp-vc141-mtd.lib"
-		}
+ConsoleApp "RayBenchmark"
 
-		postbuildcommands 
-		{
-			'{COPY} "../Hazel/vendor/assimp/bin/Debug/assimp-vc141-mtd.dll" "%{cfg.targetdir}"',
-			'{COPY} "../Hazel/vendor/mono/bin/Debug/mono-2.0-sgen.dll" "%{cfg.targetdir}"'
-		}
-				
-	filter "configurations:Release"
-		defines "HZ_RELEASE"
-		optimize "on"
+ConsoleApp "HashMapBenchmark"
 
-		links
-		{
-			"Hazel/vendor/assimp/bin/Release/assimp-vc141-mt.lib"
-		}
+ConsoleApp "AssetCooker"
 
-		postbuildcommands 
-		{
-			'{COPY} "../Hazel/vendor/assimp/bin/Release/assimp-vc141-mt.dll" "%{cfg.targetdir}"',
-			'{COPY} "../Hazel/vendor/mono/bin/Debug/mono-2.0-sgen.dll" "%{cfg.targetdir}"'
+ConsoleApp "HazelBench"
+	includedirs 
+	{
+		"%{IncludeDir.entt}",
+		"%{IncludeDir.yaml_cpp}"
+	}
 
-		}
+	-- Loads the engine's assets by relative path, like Hazelnut
+	debugdir "Hazelnut"
 
-	filter "configurations:Dist"
-		defines "HZ_DIST"
-		optimize "on"
+ConsoleApp "MicroBenchmark"
+	includedirs 
+	{
+		"%{IncludeDir.entt}",
+		"%{IncludeDir.yaml_cpp}"
+	}
 
-		links
-		{
-			"Hazel/vendor/assimp/bin/Release/assimp-vc141-mt.lib"
-		}
+	debugdir "Hazelnut"
 
-		postbuildcommands 
-		{
-			'{COPY} "../Hazel/vendor/assimp/bin/Release/assimp-vc141-mtd.dll" "%{cfg.targetdir}"',
-			'{COPY} "../Hazel/vendor/mono/bin/Debug/mono-2.0-sgen.dll" "%{cfg.targetdir}"'
-		}
 group ""
 
 workspace "Sandbox"